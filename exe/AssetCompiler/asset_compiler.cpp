@@ -6,7 +6,20 @@ int main(int32 argc, int8** argv)
     if (argc > 1)
     {
         Slice<int8*> l_args = Slice<int8*>::build_memory_elementnb(argv, argc);
-        if (l_args.Size >= 4)
+        Slice<int8> l_first_arg = slice_int8_build_rawstr(l_args.get(1));
+        Slice<int8> l_archive_flag = slice_int8_build_rawstr("--archive");
+        // --archive <asset database path> <asset archive path> : packs all assets of the database into an AssetArchive
+        if (l_args.Size >= 4 && l_first_arg.Size == l_archive_flag.Size && l_first_arg.compare(l_archive_flag))
+        {
+            Slice<int8> l_asset_database_path = slice_int8_build_rawstr(l_args.get(2));
+            Slice<int8> l_asset_archive_path = slice_int8_build_rawstr(l_args.get(3));
+
+            AssetDatabase::initialize_database(l_asset_database_path);
+            AssetDatabase l_asset_database = AssetDatabase::allocate_reader(l_asset_database_path);
+            AssetArchive::write_from_database(l_asset_database, l_asset_archive_path);
+            l_asset_database.free();
+        }
+        else if (l_args.Size >= 4)
         {
             Slice<int8> l_asset_database_path = slice_int8_build_rawstr(l_args.get(1));
             Slice<int8> l_root_path = slice_int8_build_rawstr(l_args.get(2));
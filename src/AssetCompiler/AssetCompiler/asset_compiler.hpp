@@ -3,7 +3,11 @@
 #include "AssetRessource/asset_ressource.hpp"
 #include "./asset_types_json.hpp"
 #include "./obj_compiler.hpp"
+#include "./mesh_optimizer.hpp"
+#include "./mesh_simplifier.hpp"
+#include "./mesh_lod_compiler.hpp"
 #include "./img_compiler.hpp"
+#include "./bcn_compiler.hpp"
 #include "./shader_compiler.hpp"
 
 // TODO -> handling errors by using the shader compiler silent :)
@@ -41,16 +45,25 @@ inline Span<int8> AssetCompiler_compile_single_file(ShaderCompiler& p_shader_com
         }
         else if (l_asset_path.compare(slice_int8_build_rawstr("obj")))
         {
-            Span<int8> l_buffer = p_asset_file.read_file_allocate();
             Vector<Vertex> l_vertices = Vector<Vertex>::allocate(0);
             Vector<uint32> l_indices = Vector<uint32>::allocate(0);
-            ObjCompiler::ReadObj(l_buffer.slice, l_vertices, l_indices);
+            // MeshRessource has no normal stream
+            ObjCompiler::ReadObj_streamed(p_asset_file, &l_vertices, &l_indices, NULL);
+
+            Slice<uint32> l_indices_slice = l_indices.to_slice();
+            Slice<Vertex> l_vertices_slice = l_vertices.to_slice();
+            MeshOptimizer::optimize_vertex_cache(l_indices_slice, l_vertices.Size);
+            // Vertices that are not used by the obj faces are removed
+            l_vertices_slice.Size = MeshOptimizer::optimize_vertex_fetch(l_vertices_slice, l_indices_slice);
 
-            MeshRessource::Asset l_mesh_asset = MeshRessource::Asset::allocate_from_values(MeshRessource::Asset::Value{l_vertices.to_slice(), l_indices.to_slice()});
+            MeshLODCompiler::LODs l_lods = MeshLODCompiler::allocate_lods(l_vertices_slice, l_indices_slice);
+            MeshRessource::Asset::Value l_mesh_value = MeshRessource::Asset::Value{l_vertices_slice, l_indices_slice};
+            l_lods.fill_asset_value(&l_mesh_value);
+            MeshRessource::Asset l_mesh_asset = MeshRessource::Asset::allocate_from_values(l_mesh_value);
 
+            l_lods.free();
             l_vertices.free();
             l_indices.free();
-            l_buffer.free();
             return l_mesh_asset.allocated_binary;
         }
         else if (l_asset_path.compare(slice_int8_build_rawstr("jpg")) || l_asset_path.compare(slice_int8_build_rawstr("png")))
@@ -62,8 +75,17 @@ inline Span<int8> AssetCompiler_compile_single_file(ShaderCompiler& p_shader_com
             Span<int8> l_pixels;
             ImgCompiler::compile(l_buffer.slice, &l_size, &l_channel_nb, &l_pixels);
 
-            TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{l_size, l_channel_nb, l_pixels.slice});
+            // Opaque textures are compressed in BC1 (8:1), textures with transparency in BC7 (4:1)
+            TextureAssetFormat l_format = ImgCompiler::has_transparent_pixels(l_pixels.slice) ? TextureAssetFormat::BC7_SRGB : TextureAssetFormat::BC1_SRGB;
+            uint32 l_mip_count = ImgCompiler::get_mip_count(l_size);
+            Span<int8> l_mips = ImgCompiler::allocate_mip_chain(l_size, l_pixels.slice, l_mip_count);
+            Span<int8> l_compressed_mips = BCnCompiler::allocate_compressed_mips(l_format, l_size, l_mip_count, l_mips.slice);
 
+            TextureRessource::Asset l_texture_asset =
+                TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{l_size, l_channel_nb, l_format, l_mip_count, l_compressed_mips.slice});
+
+            l_compressed_mips.free();
+            l_mips.free();
             l_pixels.free();
             l_buffer.free();
             return l_texture_asset.allocated_binary;
@@ -155,6 +177,7 @@ inline void AssetCompiler_compile_and_push_to_database_single_file(ShaderCompile
     Span<int8> l_asset_full_path = Span<int8>::allocate_slice_3(p_root_path, p_relative_asset_path, Slice<int8>::build_begin_end("\0", 0, 1));
     File l_asset_file = File::open(l_asset_full_path.slice);
     Span<int8> l_compiled_asset = AssetCompiler_compile_single_file(p_shader_compiler, l_asset_file);
+    p_asset_database.begin_write_session();
     if (l_compiled_asset.Memory)
     {
         p_asset_database.insert_or_update_asset_blob(p_relative_asset_path, l_compiled_asset.slice);
@@ -166,7 +189,201 @@ inline void AssetCompiler_compile_and_push_to_database_single_file(ShaderCompile
         p_asset_database.insert_asset_dependencies_blob(p_relative_asset_path, l_compiled_dependencies.slice);
         l_compiled_dependencies.free();
     }
+    p_asset_database.end_write_session();
 
     l_asset_file.free();
     l_asset_full_path.free();
-};
\ No newline at end of file
+};
+
+/*
+    All compiled assets are written to the database in the same write session.
+*/
+inline void AssetCompiler_compile_and_push_to_database_multiple_files(ShaderCompiler& p_shader_compiler, AssetDatabase& p_asset_database, const Slice<int8>& p_root_path,
+                                                                      const Slice<Slice<int8>>& p_relative_asset_paths)
+{
+    p_asset_database.begin_write_session();
+    for (loop(i, 0, p_relative_asset_paths.Size))
+    {
+        AssetCompiler_compile_and_push_to_database_single_file(p_shader_compiler, p_asset_database, p_root_path, p_relative_asset_paths.get(i));
+    }
+    p_asset_database.end_write_session();
+};
+namespace AssetCompiler_Const
+{
+// Must be incremented when a compiler changes it's output, so that all assets are compiled again
+static const uimax COMPILER_VERSION = 5;
+}; // namespace AssetCompiler_Const
+
+/*
+    Hash of the source file content and of the compiler settings.
+    Materials read the shader asset file they reference when their dependencies are compiled, so it's content is part of the material hash.
+*/
+inline hash_t AssetCompiler_hash_source_file(const Slice<int8>& p_root_path, const Slice<int8>& p_relative_asset_path)
+{
+    Span<int8> l_buffer = AssetCompiler_open_and_read_asset_file(p_root_path, p_relative_asset_path);
+    hash_t l_source_hash = HashCombineFunction(HashSlice(l_buffer.slice), AssetCompiler_Const::COMPILER_VERSION);
+
+    Slice<int8> l_extension = p_relative_asset_path;
+    uimax l_last_dot_index = -1;
+    while (l_extension.find(slice_int8_build_rawstr("."), &l_last_dot_index))
+    {
+        l_extension.slide(l_last_dot_index + 1);
+    };
+
+    if (l_extension.compare(slice_int8_build_rawstr("json")))
+    {
+        Vector<int8> l_buffer_vector = Vector<int8>{l_buffer.Capacity, l_buffer};
+        JSONDeserializer l_json_deserializer = JSONDeserializer::start(l_buffer_vector);
+        JSONDeserializer l_json_value_deserializer;
+        if (AssetJSON::get_value_of_asset_json(&l_json_deserializer, &l_json_value_deserializer) == AssetJSONTypes::MATERIAL)
+        {
+            l_json_value_deserializer.next_field("shader");
+            Span<int8> l_shader_buffer = AssetCompiler_open_and_read_asset_file(p_root_path, l_json_value_deserializer.get_currentfield().value);
+            l_source_hash = HashCombineFunction(l_source_hash, HashSlice(l_shader_buffer.slice));
+            l_shader_buffer.free();
+        }
+        l_json_value_deserializer.free();
+        l_json_deserializer.free();
+    }
+
+    l_buffer.free();
+    return l_source_hash;
+};
+
+/*
+    State of a file compiled by AssetCompiler_compile_and_push_to_database_incremental.
+    The compilation job reads the stored source hash, writes it's results and decrements the counter, the writer thread reads them once the counter is done.
+*/
+struct AssetCompilerIncrementalFile
+{
+    Slice<int8> relative_path;
+    int8 has_stored_source_hash;
+    hash_t stored_source_hash;
+    hash_t source_hash;
+    int8 compiled;
+    Span<int8> compiled_asset;
+    Span<int8> compiled_dependencies;
+    JobCounter counter;
+};
+
+struct AssetCompilerIncrementalJob
+{
+    JobSystem* job_system;
+    AssetDatabaseReaderPool* asset_database_readers;
+    Slice<int8> root_path;
+    Span<AssetCompilerIncrementalFile> files;
+    // glslang can't be used by multiple threads with the same ShaderCompiler, compilers are allocated by the first job executed by a thread
+    Span<ShaderCompiler> shader_compilers;
+    Span<int8> shader_compilers_allocated;
+
+    inline static void execute(void* p_data, const uimax p_begin, const uimax p_end)
+    {
+        AssetCompilerIncrementalJob* thiz = (AssetCompilerIncrementalJob*)p_data;
+        uimax l_thread_index = thiz->job_system->get_current_thread_index();
+        if (!thiz->shader_compilers_allocated.get(l_thread_index))
+        {
+            thiz->shader_compilers.get(l_thread_index) = ShaderCompiler::allocate();
+            thiz->shader_compilers_allocated.get(l_thread_index) = 1;
+        }
+        ShaderCompiler& l_shader_compiler = thiz->shader_compilers.get(l_thread_index);
+
+        for (loop(i, p_begin, p_end))
+        {
+            AssetCompilerIncrementalFile& l_file = thiz->files.get(i);
+            l_file.has_stored_source_hash = thiz->asset_database_readers->get_reader(l_thread_index).get_asset_source_hash(HashSlice(l_file.relative_path), &l_file.stored_source_hash);
+            l_file.source_hash = AssetCompiler_hash_source_file(thiz->root_path, l_file.relative_path);
+            if (l_file.has_stored_source_hash && l_file.stored_source_hash == l_file.source_hash)
+            {
+                continue;
+            }
+
+            Span<int8> l_asset_full_path = Span<int8>::allocate_slice_3(thiz->root_path, l_file.relative_path, Slice<int8>::build_begin_end("\0", 0, 1));
+            File l_asset_file = File::open(l_asset_full_path.slice);
+            l_file.compiled_asset = AssetCompiler_compile_single_file(l_shader_compiler, l_asset_file);
+            l_file.compiled_dependencies = AssetCompiler_compile_dependencies_of_file(l_shader_compiler, thiz->root_path, l_asset_file);
+            l_file.compiled = 1;
+            l_asset_file.free();
+            l_asset_full_path.free();
+        }
+    };
+};
+
+/*
+    Compiles the files whose source hash differs from the one stored in the database, the other files are skipped.
+    Files are compiled by jobs of the JobSystem, the calling thread is the only one that writes to the database. It writes the compiled files in order, and executes
+    compilation jobs while the next file is not compiled yet.
+    Jobs read stored source hashes from the p_asset_database_readers (one reader per thread of the p_job_system) while the calling thread writes.
+    Returns the number of compiled files.
+*/
+inline uimax AssetCompiler_compile_and_push_to_database_incremental(JobSystem& p_job_system, AssetDatabase& p_asset_database, AssetDatabaseReaderPool& p_asset_database_readers,
+                                                                   const Slice<int8>& p_root_path, const Slice<Slice<int8>>& p_relative_asset_paths)
+{
+#if ASSET_COMPILER_BOUND_TEST
+    assert_true(p_asset_database_readers.readers.Capacity == p_job_system.get_thread_count());
+#endif
+
+    AssetCompilerIncrementalJob l_job;
+    l_job.job_system = &p_job_system;
+    l_job.asset_database_readers = &p_asset_database_readers;
+    l_job.root_path = p_root_path;
+    l_job.files = Span<AssetCompilerIncrementalFile>::allocate(p_relative_asset_paths.Size);
+    l_job.shader_compilers = Span<ShaderCompiler>::allocate(p_job_system.get_thread_count());
+    l_job.shader_compilers_allocated = Span<int8>::callocate(p_job_system.get_thread_count());
+
+    for (loop(i, 0, p_relative_asset_paths.Size))
+    {
+        AssetCompilerIncrementalFile& l_file = l_job.files.get(i);
+        l_file.relative_path = p_relative_asset_paths.get(i);
+        l_file.has_stored_source_hash = 0;
+        l_file.stored_source_hash = 0;
+        l_file.source_hash = 0;
+        l_file.compiled = 0;
+        l_file.compiled_asset = Span<int8>::build_default();
+        l_file.compiled_dependencies = Span<int8>::build_default();
+        l_file.counter = JobCounter::build_default();
+    }
+
+    for (loop(i, 0, l_job.files.Capacity))
+    {
+        p_job_system.schedule(Job::build_range(AssetCompilerIncrementalJob::execute, &l_job, i, i + 1, &l_job.files.get(i).counter));
+    }
+
+    uimax l_compiled_count = 0;
+    p_asset_database.begin_write_session();
+    for (loop(i, 0, l_job.files.Capacity))
+    {
+        AssetCompilerIncrementalFile& l_file = l_job.files.get(i);
+        p_job_system.wait(l_file.counter);
+        if (!l_file.compiled)
+        {
+            continue;
+        }
+
+        if (l_file.compiled_asset.Memory)
+        {
+            p_asset_database.insert_or_update_asset_blob(l_file.relative_path, l_file.compiled_asset.slice);
+            l_file.compiled_asset.free();
+        }
+        if (l_file.compiled_dependencies.Memory)
+        {
+            p_asset_database.insert_or_update_asset_dependencies_blob(l_file.relative_path, l_file.compiled_dependencies.slice);
+            l_file.compiled_dependencies.free();
+        }
+        p_asset_database.insert_or_update_asset_source_hash(l_file.relative_path, l_file.source_hash);
+        l_compiled_count += 1;
+    }
+    p_asset_database.end_write_session();
+
+    for (loop(i, 0, l_job.shader_compilers.Capacity))
+    {
+        if (l_job.shader_compilers_allocated.get(i))
+        {
+            l_job.shader_compilers.get(i).free();
+        }
+    }
+    l_job.shader_compilers_allocated.free();
+    l_job.shader_compilers.free();
+    l_job.files.free();
+
+    return l_compiled_count;
+};
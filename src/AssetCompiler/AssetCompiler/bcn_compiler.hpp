@@ -0,0 +1,434 @@
+#pragma once
+
+/*
+    Offline CPU encoder of block compressed textures (BC1, BC3 and BC7).
+    Every block encodes 4x4 pixels. Blocks that are on the edge of the image repeat the edge pixels.
+    Block endpoints are the extremities of the block pixels projected on their principal axis, every pixel is then matched to the nearest color of the block palette.
+*/
+struct BCnCompiler
+{
+    /*
+        Compresses every mip of p_pixels, mips are stored as described in TextureRessource::Asset::Value.
+        p_pixels are R8G8B8A8 pixels of all mips.
+    */
+    inline static Span<int8> allocate_compressed_mips(const TextureAssetFormat p_format, const v3ui& p_size, const uint32 p_mip_count, const Slice<int8>& p_pixels)
+    {
+        uimax l_compressed_size = 0;
+        for (loop(i, 0, p_mip_count))
+        {
+            l_compressed_size += TextureRessource::Asset::Value::get_mip_memory_size(p_format, p_size, (uint32)i);
+        }
+
+        Span<int8> l_compressed = Span<int8>::allocate(l_compressed_size);
+        uimax l_block_size = TextureRessource::Asset::Value::get_block_size(p_format);
+        int8* l_block_cursor = l_compressed.Memory;
+        uimax l_pixel_offset = 0;
+        for (loop(l_mip, 0, p_mip_count))
+        {
+            v3ui l_mip_size = TextureRessource::Asset::Value::get_mip_size(p_size, (uint32)l_mip);
+            Slice<color> l_mip_pixels = slice_cast<color>(Slice<int8>::build_memory_offset_elementnb(p_pixels.Begin, l_pixel_offset, (uimax)l_mip_size.x * l_mip_size.y * sizeof(color)));
+            for (uint32 l_block_y = 0; l_block_y < l_mip_size.y; l_block_y += 4)
+            {
+                for (uint32 l_block_x = 0; l_block_x < l_mip_size.x; l_block_x += 4)
+                {
+                    color l_block[16];
+                    fetch_block(l_mip_pixels, l_mip_size, l_block_x, l_block_y, l_block);
+                    encode_block(p_format, l_block, l_block_cursor);
+                    l_block_cursor += l_block_size;
+                }
+            }
+            l_pixel_offset += l_mip_pixels.Size * sizeof(color);
+        }
+
+        return l_compressed;
+    };
+
+    inline static void encode_block(const TextureAssetFormat p_format, const color* p_block, int8* out_block)
+    {
+        switch (p_format)
+        {
+        case TextureAssetFormat::BC1_SRGB:
+            encode_bc1_block(p_block, out_block);
+            break;
+        case TextureAssetFormat::BC3_SRGB:
+            encode_bc3_block(p_block, out_block);
+            break;
+        case TextureAssetFormat::BC7_SRGB:
+            encode_bc7_block(p_block, out_block);
+            break;
+        default:
+            abort();
+        }
+    };
+
+    // Opaque colors, alpha is ignored
+    inline static void encode_bc1_block(const color* p_block, int8* out_block)
+    {
+        encode_color_block(p_block, out_block);
+    };
+
+    // 8 bytes of alpha, followed by a BC1 color block
+    inline static void encode_bc3_block(const color* p_block, int8* out_block)
+    {
+        encode_alpha_block(p_block, out_block);
+        encode_color_block(p_block, out_block + 8);
+    };
+
+    /*
+        BC7 blocks are encoded with the mode 6 only : a single subset with RGBA endpoints of 7 bits plus a shared bit per endpoint and 4 bits indices.
+    */
+    inline static void encode_bc7_block(const color* p_block, int8* out_block)
+    {
+        float32 l_min[4], l_max[4];
+        compute_endpoints(p_block, 4, l_min, l_max);
+
+        uint8 l_quantized[2][4];
+        uint8 l_pbits[2];
+        quantize_bc7_mode6_endpoint(l_min, l_quantized[0], &l_pbits[0]);
+        quantize_bc7_mode6_endpoint(l_max, l_quantized[1], &l_pbits[1]);
+
+        int32 l_palette[16][4];
+        for (loop(c, 0, 4))
+        {
+            int32 l_endpoint_0 = (int32)((l_quantized[0][c] << 1) | l_pbits[0]);
+            int32 l_endpoint_1 = (int32)((l_quantized[1][c] << 1) | l_pbits[1]);
+            for (loop(i, 0, 16))
+            {
+                int32 l_weight = bc7_weights_4()[i];
+                l_palette[i][c] = (((64 - l_weight) * l_endpoint_0) + (l_weight * l_endpoint_1) + 32) >> 6;
+            }
+        }
+
+        uint8 l_indices[16];
+        for (loop(i, 0, 16))
+        {
+            l_indices[i] = (uint8)find_nearest(p_block[i], &l_palette[0][0], 16, 4);
+        }
+
+        // The most significant bit of the first index is not stored, it must be 0
+        if (l_indices[0] & 8)
+        {
+            for (loop(c, 0, 4))
+            {
+                uint8 l_tmp = l_quantized[0][c];
+                l_quantized[0][c] = l_quantized[1][c];
+                l_quantized[1][c] = l_tmp;
+            }
+            uint8 l_tmp_pbit = l_pbits[0];
+            l_pbits[0] = l_pbits[1];
+            l_pbits[1] = l_tmp_pbit;
+            for (loop(i, 0, 16))
+            {
+                l_indices[i] = 15 - l_indices[i];
+            }
+        }
+
+        BlockBitWriter l_writer = BlockBitWriter::build(out_block, 16);
+        l_writer.write(1 << 6, 7);
+        for (loop(c, 0, 4))
+        {
+            l_writer.write(l_quantized[0][c], 7);
+            l_writer.write(l_quantized[1][c], 7);
+        }
+        l_writer.write(l_pbits[0], 1);
+        l_writer.write(l_pbits[1], 1);
+        l_writer.write(l_indices[0], 3);
+        for (loop(i, 1, 16))
+        {
+            l_writer.write(l_indices[i], 4);
+        }
+    };
+
+  private:
+    struct BlockBitWriter
+    {
+        uint8* block;
+        uimax bit_index;
+
+        inline static BlockBitWriter build(int8* p_block, const uimax p_block_size)
+        {
+            memory_zero(p_block, p_block_size);
+            return BlockBitWriter{(uint8*)p_block, 0};
+        };
+
+        // Bits are written from the least significant bit of the block
+        inline void write(const uint32 p_value, const uimax p_bit_count)
+        {
+            for (loop(i, 0, p_bit_count))
+            {
+                if ((p_value >> i) & 1)
+                {
+                    this->block[this->bit_index >> 3] |= (uint8)(1 << (this->bit_index & 7));
+                }
+                this->bit_index += 1;
+            }
+        };
+    };
+
+    inline static const int32* bc7_weights_4()
+    {
+        static const int32 l_weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        return l_weights;
+    };
+
+    inline static void fetch_block(const Slice<color>& p_pixels, const v3ui& p_size, const uint32 p_block_x, const uint32 p_block_y, color* out_block)
+    {
+        for (loop(y, 0, 4))
+        {
+            uint32 l_y = p_block_y + (uint32)y;
+            l_y = l_y < p_size.y ? l_y : p_size.y - 1;
+            for (loop(x, 0, 4))
+            {
+                uint32 l_x = p_block_x + (uint32)x;
+                l_x = l_x < p_size.x ? l_x : p_size.x - 1;
+                out_block[(y * 4) + x] = p_pixels.get(((uimax)l_y * p_size.x) + l_x);
+            }
+        }
+    };
+
+    /*
+        Extremities of the segment of the principal axis that contains the projection of all pixels.
+        Only the p_channel_count first channels are taken into account, other channels of the endpoints are set to 0.
+    */
+    inline static void compute_endpoints(const color* p_block, const uimax p_channel_count, float32* out_min, float32* out_max)
+    {
+        float32 l_mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (loop(i, 0, 16))
+        {
+            for (loop(c, 0, p_channel_count))
+            {
+                l_mean[c] += (float32)p_block[i].Points[c];
+            }
+        }
+        for (loop(c, 0, p_channel_count))
+        {
+            l_mean[c] /= 16.0f;
+        }
+
+        float32 l_covariance[4][4];
+        memory_zero((int8*)l_covariance, sizeof(l_covariance));
+        for (loop(i, 0, 16))
+        {
+            for (loop(c0, 0, p_channel_count))
+            {
+                for (loop(c1, 0, p_channel_count))
+                {
+                    l_covariance[c0][c1] += ((float32)p_block[i].Points[c0] - l_mean[c0]) * ((float32)p_block[i].Points[c1] - l_mean[c1]);
+                }
+            }
+        }
+
+        // Power iteration, starting from the diagonal of the bounding box
+        float32 l_axis[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (loop(c, 0, p_channel_count))
+        {
+            float32 l_channel_min = 255.0f, l_channel_max = 0.0f;
+            for (loop(i, 0, 16))
+            {
+                float32 l_value = (float32)p_block[i].Points[c];
+                l_channel_min = l_value < l_channel_min ? l_value : l_channel_min;
+                l_channel_max = l_value > l_channel_max ? l_value : l_channel_max;
+            }
+            l_axis[c] = l_channel_max - l_channel_min;
+        }
+        for (loop(l_iteration, 0, 8))
+        {
+            float32 l_next_axis[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            float32 l_length = 0.0f;
+            for (loop(c0, 0, p_channel_count))
+            {
+                for (loop(c1, 0, p_channel_count))
+                {
+                    l_next_axis[c0] += l_covariance[c0][c1] * l_axis[c1];
+                }
+                l_length += l_next_axis[c0] * l_next_axis[c0];
+            }
+            if (l_length <= 0.0f)
+            {
+                break;
+            }
+            l_length = sqrtf(l_length);
+            for (loop(c, 0, p_channel_count))
+            {
+                l_axis[c] = l_next_axis[c] / l_length;
+            }
+        }
+
+        float32 l_axis_length = 0.0f;
+        for (loop(c, 0, p_channel_count))
+        {
+            l_axis_length += l_axis[c] * l_axis[c];
+        }
+
+        float32 l_min_projection = 0.0f, l_max_projection = 0.0f;
+        if (l_axis_length > 0.0f)
+        {
+            l_axis_length = sqrtf(l_axis_length);
+            for (loop(c, 0, p_channel_count))
+            {
+                l_axis[c] /= l_axis_length;
+            }
+
+            l_min_projection = FLT_MAX;
+            l_max_projection = -FLT_MAX;
+            for (loop(i, 0, 16))
+            {
+                float32 l_projection = 0.0f;
+                for (loop(c, 0, p_channel_count))
+                {
+                    l_projection += ((float32)p_block[i].Points[c] - l_mean[c]) * l_axis[c];
+                }
+                l_min_projection = l_projection < l_min_projection ? l_projection : l_min_projection;
+                l_max_projection = l_projection > l_max_projection ? l_projection : l_max_projection;
+            }
+        }
+
+        for (loop(c, 0, 4))
+        {
+            out_min[c] = 0.0f;
+            out_max[c] = 0.0f;
+        }
+        for (loop(c, 0, p_channel_count))
+        {
+            out_min[c] = Math::clamp_f32(l_mean[c] + (l_axis[c] * l_min_projection), 0.0f, 255.0f);
+            out_max[c] = Math::clamp_f32(l_mean[c] + (l_axis[c] * l_max_projection), 0.0f, 255.0f);
+        }
+    };
+
+    // Index of the palette color that is the nearest of p_color on the p_channel_count first channels
+    inline static uimax find_nearest(const color& p_color, const int32* p_palette, const uimax p_palette_size, const uimax p_channel_count)
+    {
+        uimax l_nearest = 0;
+        int32 l_nearest_distance = INT_MAX;
+        for (loop(i, 0, p_palette_size))
+        {
+            int32 l_distance = 0;
+            for (loop(c, 0, p_channel_count))
+            {
+                int32 l_delta = (int32)p_color.Points[c] - p_palette[(i * p_channel_count) + c];
+                l_distance += l_delta * l_delta;
+            }
+            if (l_distance < l_nearest_distance)
+            {
+                l_nearest = i;
+                l_nearest_distance = l_distance;
+            }
+        }
+        return l_nearest;
+    };
+
+    inline static uint16 to_rgb565(const float32* p_color)
+    {
+        uint16 l_r = (uint16)nearbyintf((p_color[0] * 31.0f) / 255.0f);
+        uint16 l_g = (uint16)nearbyintf((p_color[1] * 63.0f) / 255.0f);
+        uint16 l_b = (uint16)nearbyintf((p_color[2] * 31.0f) / 255.0f);
+        return (uint16)((l_r << 11) | (l_g << 5) | l_b);
+    };
+
+    inline static void from_rgb565(const uint16 p_color, int32* out_color)
+    {
+        int32 l_r = (p_color >> 11) & 31;
+        int32 l_g = (p_color >> 5) & 63;
+        int32 l_b = p_color & 31;
+        out_color[0] = (l_r << 3) | (l_r >> 2);
+        out_color[1] = (l_g << 2) | (l_g >> 4);
+        out_color[2] = (l_b << 3) | (l_b >> 2);
+    };
+
+    // Color block in the 4 colors mode (first endpoint greater than the second)
+    inline static void encode_color_block(const color* p_block, int8* out_block)
+    {
+        float32 l_min[4], l_max[4];
+        compute_endpoints(p_block, 3, l_min, l_max);
+
+        uint16 l_endpoint_0 = to_rgb565(l_max);
+        uint16 l_endpoint_1 = to_rgb565(l_min);
+        if (l_endpoint_0 < l_endpoint_1)
+        {
+            uint16 l_tmp = l_endpoint_0;
+            l_endpoint_0 = l_endpoint_1;
+            l_endpoint_1 = l_tmp;
+        }
+
+        uint32 l_indices = 0;
+        if (l_endpoint_0 != l_endpoint_1)
+        {
+            int32 l_palette[4][3];
+            from_rgb565(l_endpoint_0, l_palette[0]);
+            from_rgb565(l_endpoint_1, l_palette[1]);
+            for (loop(c, 0, 3))
+            {
+                l_palette[2][c] = ((2 * l_palette[0][c]) + l_palette[1][c]) / 3;
+                l_palette[3][c] = (l_palette[0][c] + (2 * l_palette[1][c])) / 3;
+            }
+
+            for (loop(i, 0, 16))
+            {
+                l_indices |= (uint32)find_nearest(p_block[i], &l_palette[0][0], 4, 3) << (i * 2);
+            }
+        }
+
+        BlockBitWriter l_writer = BlockBitWriter::build(out_block, 8);
+        l_writer.write(l_endpoint_0, 16);
+        l_writer.write(l_endpoint_1, 16);
+        l_writer.write(l_indices, 32);
+    };
+
+    // Alpha block in the 8 alphas mode (first endpoint greater than the second)
+    inline static void encode_alpha_block(const color* p_block, int8* out_block)
+    {
+        int32 l_alpha_min = 255, l_alpha_max = 0;
+        for (loop(i, 0, 16))
+        {
+            int32 l_alpha = (int32)p_block[i].w;
+            l_alpha_min = l_alpha < l_alpha_min ? l_alpha : l_alpha_min;
+            l_alpha_max = l_alpha > l_alpha_max ? l_alpha : l_alpha_max;
+        }
+
+        BlockBitWriter l_writer = BlockBitWriter::build(out_block, 8);
+        l_writer.write((uint32)l_alpha_max, 8);
+        l_writer.write((uint32)l_alpha_min, 8);
+        if (l_alpha_max == l_alpha_min)
+        {
+            return;
+        }
+
+        int32 l_palette[8];
+        l_palette[0] = l_alpha_max;
+        l_palette[1] = l_alpha_min;
+        for (loop(i, 2, 8))
+        {
+            l_palette[i] = ((((int32)(8 - i)) * l_alpha_max) + (((int32)(i - 1)) * l_alpha_min)) / 7;
+        }
+
+        for (loop(i, 0, 16))
+        {
+            color l_alpha = color{p_block[i].w, 0, 0, 0};
+            l_writer.write((uint32)find_nearest(l_alpha, l_palette, 8, 1), 3);
+        }
+    };
+
+    // The shared bit is the one that gives the smallest error once the endpoint is expanded to 8 bits
+    inline static void quantize_bc7_mode6_endpoint(const float32* p_endpoint, uint8* out_quantized, uint8* out_pbit)
+    {
+        float32 l_best_error = FLT_MAX;
+        for (loop(l_pbit, 0, 2))
+        {
+            uint8 l_quantized[4];
+            float32 l_error = 0.0f;
+            for (loop(c, 0, 4))
+            {
+                float32 l_value = Math::clamp_f32(nearbyintf((p_endpoint[c] - (float32)l_pbit) / 2.0f), 0.0f, 127.0f);
+                l_quantized[c] = (uint8)l_value;
+                float32 l_delta = (float32)((l_quantized[c] << 1) | l_pbit) - p_endpoint[c];
+                l_error += l_delta * l_delta;
+            }
+            if (l_error < l_best_error)
+            {
+                l_best_error = l_error;
+                *out_pbit = (uint8)l_pbit;
+                memory_cpy((int8*)out_quantized, (int8*)l_quantized, sizeof(l_quantized));
+            }
+        }
+    };
+};
@@ -22,6 +22,94 @@ struct ImgCompiler
 #endif
     };
 
+    inline static uint32 get_mip_count(const v3ui& p_size)
+    {
+        uint32 l_mip_count = 1;
+        uint32 l_max_extent = p_size.x > p_size.y ? p_size.x : p_size.y;
+        while (l_max_extent > 1)
+        {
+            l_max_extent >>= 1;
+            l_mip_count += 1;
+        }
+        return l_mip_count;
+    };
+
+    /*
+        Pixels of all mips of the R8G8B8A8 p_pixels, stored one after the other like in TextureRessource::Asset::Value.
+        Every mip pixel is the average of 2x2 pixels of the previous mip, colors are averaged in linear space.
+    */
+    inline static Span<int8> allocate_mip_chain(const v3ui& p_size, const Slice<int8>& p_pixels, const uint32 p_mip_count)
+    {
+        uimax l_pixel_count = 0;
+        for (loop(i, 0, p_mip_count))
+        {
+            v3ui l_mip_size = TextureRessource::Asset::Value::get_mip_size(p_size, (uint32)i);
+            l_pixel_count += (uimax)l_mip_size.x * l_mip_size.y;
+        }
+
+        Span<int8> l_mips = Span<int8>::allocate(l_pixel_count * sizeof(color));
+        l_mips.slice.copy_memory(p_pixels);
+
+        float32 l_srgb_to_linear[256];
+        for (loop(i, 0, 256))
+        {
+            l_srgb_to_linear[i] = Math::sRGB_to_linear_float32((float32)i / (float32)uint8_max);
+        }
+
+        color* l_source = (color*)l_mips.Memory;
+        for (loop(l_mip, 1, p_mip_count))
+        {
+            v3ui l_source_size = TextureRessource::Asset::Value::get_mip_size(p_size, (uint32)(l_mip - 1));
+            v3ui l_target_size = TextureRessource::Asset::Value::get_mip_size(p_size, (uint32)l_mip);
+            color* l_target = l_source + ((uimax)l_source_size.x * l_source_size.y);
+            for (loop(y, 0, l_target_size.y))
+            {
+                uimax l_y0 = y * 2;
+                uimax l_y1 = (l_y0 + 1) < l_source_size.y ? (l_y0 + 1) : l_y0;
+                for (loop(x, 0, l_target_size.x))
+                {
+                    uimax l_x0 = x * 2;
+                    uimax l_x1 = (l_x0 + 1) < l_source_size.x ? (l_x0 + 1) : l_x0;
+                    SliceN<color, 4> l_samples = {l_source[(l_y0 * l_source_size.x) + l_x0], l_source[(l_y0 * l_source_size.x) + l_x1], l_source[(l_y1 * l_source_size.x) + l_x0],
+                                                  l_source[(l_y1 * l_source_size.x) + l_x1]};
+
+                    color& l_pixel = l_target[(y * l_target_size.x) + x];
+                    for (loop(c, 0, 3))
+                    {
+                        float32 l_linear = 0.0f;
+                        for (loop(i, 0, 4))
+                        {
+                            l_linear += l_srgb_to_linear[l_samples.get(i).Points[c]];
+                        }
+                        l_pixel.Points[c] = (uint8)nearbyintf(Math::linear_to_sRGB_float32(l_linear * 0.25f) * (float32)uint8_max);
+                    }
+                    uint32 l_alpha = 0;
+                    for (loop(i, 0, 4))
+                    {
+                        l_alpha += l_samples.get(i).w;
+                    }
+                    l_pixel.w = (uint8)((l_alpha + 2) / 4);
+                }
+            }
+            l_source = l_target;
+        }
+
+        return l_mips;
+    };
+
+    inline static int8 has_transparent_pixels(const Slice<int8>& p_pixels)
+    {
+        Slice<color> l_pixels = slice_cast<color>(p_pixels);
+        for (loop(i, 0, l_pixels.Size))
+        {
+            if (l_pixels.get(i).w != uint8_max)
+            {
+                return 1;
+            }
+        }
+        return 0;
+    };
+
     inline static void write_to_image(const Slice<int8>& p_path, const uint32 p_width, const uint32 p_height, const int8 p_channel_number, const Slice<int8>& p_pixels)
     {
 #if ASSET_COMPILER_BOUND_TEST
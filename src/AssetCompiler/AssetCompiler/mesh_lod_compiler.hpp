@@ -0,0 +1,83 @@
+#pragma once
+
+namespace MeshLODCompiler_Const
+{
+// Every LOD targets this fraction of the triangles of the previous one
+constexpr float32 TRIANGLE_RATIO = 0.5f;
+// The chain stops when a LOD keeps more than this fraction of the previous one triangles, locked borders and seams prevent further simplification
+constexpr float32 MAX_KEPT_TRIANGLE_RATIO = 0.8f;
+}; // namespace MeshLODCompiler_Const
+
+/*
+    Generates the LOD chain of a mesh. Every LOD is simplified from the full resolution mesh, optimized for the vertex cache and only keeps the vertices that it uses.
+*/
+struct MeshLODCompiler
+{
+    struct LODs
+    {
+        uimax count;
+        SliceN<Span<Vertex>, MeshRessource_Const::MAX_LOD_COUNT> vertices;
+        SliceN<Span<uint32>, MeshRessource_Const::MAX_LOD_COUNT> indices;
+        SliceN<uimax, MeshRessource_Const::MAX_LOD_COUNT> vertex_counts;
+        SliceN<uimax, MeshRessource_Const::MAX_LOD_COUNT> index_counts;
+        SliceN<float32, MeshRessource_Const::MAX_LOD_COUNT> errors;
+
+        inline void free()
+        {
+            for (loop(i, 0, this->count))
+            {
+                this->vertices.get(i).free();
+                this->indices.get(i).free();
+            }
+            this->count = 0;
+        };
+
+        inline void fill_asset_value(MeshRessource::Asset::Value* in_out_value) const
+        {
+            in_out_value->lod_count = this->count;
+            for (loop(i, 0, this->count))
+            {
+                in_out_value->lods.get(i) =
+                    MeshRessource::Asset::LOD{this->errors.get(i), Slice<Vertex>::build_memory_elementnb(this->vertices.get(i).Memory, this->vertex_counts.get(i)),
+                                              Slice<uint32>::build_memory_elementnb(this->indices.get(i).Memory, this->index_counts.get(i)), Slice<uint16>::build_default()};
+            }
+        };
+    };
+
+    inline static LODs allocate_lods(const Slice<Vertex>& p_vertices, const Slice<uint32>& p_indices)
+    {
+        LODs l_lods;
+        l_lods.count = 0;
+
+        uimax l_previous_index_count = p_indices.Size;
+        for (loop(i, 0, MeshRessource_Const::MAX_LOD_COUNT))
+        {
+            uimax l_target_index_count = ((uimax)((float32)(l_previous_index_count / 3) * MeshLODCompiler_Const::TRIANGLE_RATIO)) * 3;
+            Span<Vertex> l_vertices = Span<Vertex>::allocate_slice(p_vertices);
+            Span<uint32> l_indices = Span<uint32>::allocate_slice(p_indices);
+
+            MeshSimplifier::Result l_simplification = MeshSimplifier::simplify(l_vertices.slice, l_indices.slice, l_target_index_count);
+            if (l_simplification.index_count == 0 || (float32)l_simplification.index_count > ((float32)l_previous_index_count * MeshLODCompiler_Const::MAX_KEPT_TRIANGLE_RATIO))
+            {
+                l_indices.free();
+                l_vertices.free();
+                break;
+            }
+
+            Slice<uint32> l_lod_indices = Slice<uint32>::build_memory_elementnb(l_indices.Memory, l_simplification.index_count);
+            Slice<Vertex> l_lod_vertices = l_vertices.slice;
+            MeshOptimizer::optimize_vertex_cache(l_lod_indices, l_lod_vertices.Size);
+            l_lod_vertices.Size = MeshOptimizer::optimize_vertex_fetch(l_lod_vertices, l_lod_indices);
+
+            l_lods.vertices.get(l_lods.count) = l_vertices;
+            l_lods.indices.get(l_lods.count) = l_indices;
+            l_lods.vertex_counts.get(l_lods.count) = l_lod_vertices.Size;
+            l_lods.index_counts.get(l_lods.count) = l_lod_indices.Size;
+            l_lods.errors.get(l_lods.count) = l_simplification.error;
+            l_lods.count += 1;
+            l_previous_index_count = l_simplification.index_count;
+        }
+
+        return l_lods;
+    };
+};
@@ -0,0 +1,260 @@
+#pragma once
+
+namespace MeshOptimizer_Const
+{
+// Size of the simulated LRU cache used to score vertices. It is larger than the post transform cache of GPUs so that the order still works for bigger caches.
+constexpr uimax CACHE_SIZE = 32;
+constexpr float32 CACHE_DECAY_POWER = 1.5f;
+// Vertices used by the last triangle, their score is lowered so that the strip doesn't go back on itself
+constexpr float32 LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float32 VALENCE_BOOST_SCALE = 2.0f;
+constexpr float32 VALENCE_BOOST_POWER = 0.5f;
+}; // namespace MeshOptimizer_Const
+
+/*
+    Reorders the triangles and the vertices of an indexed triangle list, so that the GPU transforms less vertices and fetches them from contiguous memory.
+    The triangle order follows "Linear-Speed Vertex Cache Optimisation" (Tom Forsyth) : the next triangle is the one with the best score,
+    vertices score higher when they are recently used and when they have few remaining triangles.
+    Triangles keep their winding, only their order changes.
+*/
+struct MeshOptimizer
+{
+    inline static void optimize_vertex_cache(Slice<uint32>& in_out_indices, const uimax p_vertex_count)
+    {
+        uimax l_triangle_count = in_out_indices.Size / 3;
+        if (l_triangle_count == 0)
+        {
+            return;
+        }
+
+        // Triangles using every vertex, stored contiguously per vertex
+        Span<uint32> l_vertex_triangles_begin = Span<uint32>::callocate(p_vertex_count + 1);
+        for (loop(i, 0, in_out_indices.Size))
+        {
+            l_vertex_triangles_begin.get(in_out_indices.get(i) + 1) += 1;
+        }
+        for (loop(i, 0, p_vertex_count))
+        {
+            l_vertex_triangles_begin.get(i + 1) += l_vertex_triangles_begin.get(i);
+        }
+        Span<uint32> l_vertex_triangles = Span<uint32>::allocate(in_out_indices.Size);
+        Span<uint32> l_vertex_remaining_triangles = Span<uint32>::callocate(p_vertex_count);
+        for (loop(i, 0, in_out_indices.Size))
+        {
+            uint32 l_vertex = in_out_indices.get(i);
+            l_vertex_triangles.get(l_vertex_triangles_begin.get(l_vertex) + l_vertex_remaining_triangles.get(l_vertex)) = (uint32)(i / 3);
+            l_vertex_remaining_triangles.get(l_vertex) += 1;
+        }
+
+        Span<float32> l_vertex_score = Span<float32>::allocate(p_vertex_count);
+        for (loop(i, 0, p_vertex_count))
+        {
+            l_vertex_score.get(i) = vertex_score(-1, l_vertex_remaining_triangles.get(i));
+        }
+
+        Span<int8> l_triangle_emitted = Span<int8>::callocate(l_triangle_count);
+        Span<float32> l_triangle_score = Span<float32>::allocate(l_triangle_count);
+        for (loop(i, 0, l_triangle_count))
+        {
+            l_triangle_score.get(i) = l_vertex_score.get(in_out_indices.get(i * 3)) + l_vertex_score.get(in_out_indices.get((i * 3) + 1)) +
+                                      l_vertex_score.get(in_out_indices.get((i * 3) + 2));
+        }
+
+        // The cache has room for the 3 vertices of the emitted triangle before being trimmed
+        uint32 l_cache[MeshOptimizer_Const::CACHE_SIZE + 3];
+        uimax l_cache_size = 0;
+        uint32 l_next_cache[MeshOptimizer_Const::CACHE_SIZE + 3];
+
+        Span<uint32> l_optimized_indices = Span<uint32>::allocate(l_triangle_count * 3);
+        uimax l_next_unemitted_triangle = 0;
+        uimax l_best_triangle = find_next_unemitted_triangle(l_triangle_emitted.slice, &l_next_unemitted_triangle);
+
+        for (loop(l_emitted_count, 0, l_triangle_count))
+        {
+            l_triangle_emitted.get(l_best_triangle) = 1;
+            for (loop(j, 0, 3))
+            {
+                uint32 l_vertex = in_out_indices.get((l_best_triangle * 3) + j);
+                l_optimized_indices.get((l_emitted_count * 3) + j) = l_vertex;
+
+                // The emitted triangle is removed from the remaining triangles of it's vertices
+                uint32* l_triangles = l_vertex_triangles.Memory + l_vertex_triangles_begin.get(l_vertex);
+                uint32& l_remaining = l_vertex_remaining_triangles.get(l_vertex);
+                for (loop(k, 0, l_remaining))
+                {
+                    if (l_triangles[k] == l_best_triangle)
+                    {
+                        l_triangles[k] = l_triangles[l_remaining - 1];
+                        l_remaining -= 1;
+                        break;
+                    }
+                }
+            }
+
+            // Vertices of the emitted triangle are moved to the front of the cache
+            uimax l_next_cache_size = 0;
+            for (loop(j, 0, 3))
+            {
+                l_next_cache[l_next_cache_size] = in_out_indices.get((l_best_triangle * 3) + j);
+                l_next_cache_size += 1;
+            }
+            for (loop(j, 0, l_cache_size))
+            {
+                uint32 l_vertex = l_cache[j];
+                if (l_vertex != l_next_cache[0] && l_vertex != l_next_cache[1] && l_vertex != l_next_cache[2])
+                {
+                    l_next_cache[l_next_cache_size] = l_vertex;
+                    l_next_cache_size += 1;
+                }
+            }
+
+            // Scores of all vertices that were in the cache have changed
+            for (loop(j, 0, l_next_cache_size))
+            {
+                uint32 l_vertex = l_next_cache[j];
+                int32 l_cache_position = j < MeshOptimizer_Const::CACHE_SIZE ? (int32)j : -1;
+                float32 l_score = vertex_score(l_cache_position, l_vertex_remaining_triangles.get(l_vertex));
+                float32 l_score_delta = l_score - l_vertex_score.get(l_vertex);
+                l_vertex_score.get(l_vertex) = l_score;
+
+                uint32* l_triangles = l_vertex_triangles.Memory + l_vertex_triangles_begin.get(l_vertex);
+                for (loop(k, 0, l_vertex_remaining_triangles.get(l_vertex)))
+                {
+                    l_triangle_score.get(l_triangles[k]) += l_score_delta;
+                }
+            }
+
+            l_cache_size = l_next_cache_size < MeshOptimizer_Const::CACHE_SIZE ? l_next_cache_size : MeshOptimizer_Const::CACHE_SIZE;
+            memory_cpy((int8*)l_cache, (int8*)l_next_cache, l_cache_size * sizeof(uint32));
+
+            // The best triangle is searched in the triangles of the cached vertices
+            float32 l_best_score = -1.0f;
+            for (loop(j, 0, l_cache_size))
+            {
+                uint32 l_vertex = l_cache[j];
+                uint32* l_triangles = l_vertex_triangles.Memory + l_vertex_triangles_begin.get(l_vertex);
+                for (loop(k, 0, l_vertex_remaining_triangles.get(l_vertex)))
+                {
+                    uint32 l_triangle = l_triangles[k];
+                    if (l_triangle_score.get(l_triangle) > l_best_score)
+                    {
+                        l_best_score = l_triangle_score.get(l_triangle);
+                        l_best_triangle = l_triangle;
+                    }
+                }
+            }
+
+            if (l_best_score < 0.0f && (l_emitted_count + 1) < l_triangle_count)
+            {
+                l_best_triangle = find_next_unemitted_triangle(l_triangle_emitted.slice, &l_next_unemitted_triangle);
+            }
+        }
+
+        in_out_indices.copy_memory(l_optimized_indices.slice);
+
+        l_optimized_indices.free();
+        l_triangle_score.free();
+        l_triangle_emitted.free();
+        l_vertex_score.free();
+        l_vertex_remaining_triangles.free();
+        l_vertex_triangles.free();
+        l_vertex_triangles_begin.free();
+    };
+
+    /*
+        Vertices are sorted in the order they are first used by the indices, so that consecutive triangles read close vertices.
+        Vertices that are not used by any index are removed. Returns the new vertex count, in_out_vertices is not resized.
+    */
+    template <class VertexType> inline static uimax optimize_vertex_fetch(Slice<VertexType>& in_out_vertices, Slice<uint32>& in_out_indices)
+    {
+        Span<uint32> l_remap = Span<uint32>::allocate(in_out_vertices.Size);
+        for (loop(i, 0, l_remap.Capacity))
+        {
+            l_remap.get(i) = (uint32)-1;
+        }
+
+        Span<VertexType> l_vertices = Span<VertexType>::allocate(in_out_vertices.Size);
+        uimax l_vertex_count = 0;
+        for (loop(i, 0, in_out_indices.Size))
+        {
+            uint32& l_index = in_out_indices.get(i);
+            if (l_remap.get(l_index) == (uint32)-1)
+            {
+                l_remap.get(l_index) = (uint32)l_vertex_count;
+                l_vertices.get(l_vertex_count) = in_out_vertices.get(l_index);
+                l_vertex_count += 1;
+            }
+            l_index = l_remap.get(l_index);
+        }
+
+        in_out_vertices.copy_memory(Slice<VertexType>::build_memory_elementnb(l_vertices.Memory, l_vertex_count));
+
+        l_vertices.free();
+        l_remap.free();
+        return l_vertex_count;
+    };
+
+    /*
+        Average number of vertices transformed per triangle with a FIFO post transform cache of p_cache_size vertices.
+        It goes from 3 (no reuse) to 0.5 (best case of a regular grid).
+    */
+    inline static float32 compute_acmr(const Slice<uint32>& p_indices, const uimax p_vertex_count, const uimax p_cache_size)
+    {
+        if (p_indices.Size == 0)
+        {
+            return 0.0f;
+        }
+
+        // A vertex is in the cache if it has been pushed less than p_cache_size pushes ago
+        Span<uimax> l_vertex_push_time = Span<uimax>::callocate(p_vertex_count);
+        uimax l_push_count = 0;
+        for (loop(i, 0, p_indices.Size))
+        {
+            uimax& l_push_time = l_vertex_push_time.get(p_indices.get(i));
+            if (l_push_time == 0 || (l_push_count - (l_push_time - 1)) >= p_cache_size)
+            {
+                l_push_count += 1;
+                l_push_time = l_push_count;
+            }
+        }
+        l_vertex_push_time.free();
+
+        return (float32)l_push_count / (float32)(p_indices.Size / 3);
+    };
+
+  private:
+    inline static float32 vertex_score(const int32 p_cache_position, const uimax p_remaining_triangles)
+    {
+        // The vertex is no more used
+        if (p_remaining_triangles == 0)
+        {
+            return -1.0f;
+        }
+
+        float32 l_score = 0.0f;
+        if (p_cache_position >= 0)
+        {
+            if (p_cache_position < 3)
+            {
+                l_score = MeshOptimizer_Const::LAST_TRIANGLE_SCORE;
+            }
+            else
+            {
+                float32 l_scaler = 1.0f / (float32)(MeshOptimizer_Const::CACHE_SIZE - 3);
+                l_score = powf(1.0f - ((float32)(p_cache_position - 3) * l_scaler), MeshOptimizer_Const::CACHE_DECAY_POWER);
+            }
+        }
+
+        return l_score + (MeshOptimizer_Const::VALENCE_BOOST_SCALE * powf((float32)p_remaining_triangles, -MeshOptimizer_Const::VALENCE_BOOST_POWER));
+    };
+
+    // When no triangle is reachable from the cache, the next one is taken in index order
+    inline static uimax find_next_unemitted_triangle(const Slice<int8>& p_triangle_emitted, uimax* in_out_next_unemitted_triangle)
+    {
+        while (p_triangle_emitted.get(*in_out_next_unemitted_triangle))
+        {
+            *in_out_next_unemitted_triangle += 1;
+        }
+        return *in_out_next_unemitted_triangle;
+    };
+};
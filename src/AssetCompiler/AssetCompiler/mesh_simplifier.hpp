@@ -0,0 +1,419 @@
+#pragma once
+
+namespace MeshSimplifier_Const
+{
+// A collapse is rejected if the normal of one of the moved triangles turns by more than ~75 degrees
+constexpr float32 MIN_NORMAL_DOT = 0.25f;
+}; // namespace MeshSimplifier_Const
+
+/*
+    Reduces the triangle count of an indexed triangle list by collapsing edges (one vertex of the edge is moved onto the other one).
+    Collapses are ordered by the quadric error metric ("Surface Simplification Using Quadric Error Metrics", Garland & Heckbert) : every vertex accumulates
+    the planes of it's triangles, and the cost of moving it is the weighted squared distance from the new position to these planes.
+    No vertex is created, simplified indices only reference input vertices so that their attributes stay valid.
+    Vertices on mesh borders and attribute seams (several vertices at the same position) are never moved.
+*/
+struct MeshSimplifier
+{
+    struct Result
+    {
+        uimax index_count;
+        // Error of the most expensive collapse : root mean square distance from the moved vertex to the planes of the original triangles it has absorbed
+        float32 error;
+    };
+
+    /*
+        The simplified indices are written at the beginning of in_out_indices.
+        Collapses are done by passes, a pass collapses every edge that doesn't overlap a previous collapse of the pass, from the cheapest to the most expensive.
+        The simplification stops when the index count is lower or equal than p_target_index_count, or when no edge can be collapsed.
+    */
+    template <class VertexType> inline static Result simplify(const Slice<VertexType>& p_vertices, Slice<uint32>& in_out_indices, const uimax p_target_index_count)
+    {
+        Result l_result = Result{in_out_indices.Size, 0.0f};
+        uimax l_vertex_count = p_vertices.Size;
+
+        Span<uint32> l_welded = Span<uint32>::allocate(l_vertex_count);
+        weld_positions(p_vertices, l_welded.slice);
+
+        Span<int8> l_locked = Span<int8>::callocate(l_vertex_count);
+        Span<Quadric> l_quadrics = Span<Quadric>::callocate(l_vertex_count);
+        {
+            // Every welded vertex that is referenced by more than one vertex is on a seam
+            Span<uint32> l_welded_references = Span<uint32>::callocate(l_vertex_count);
+            for (loop(i, 0, l_vertex_count))
+            {
+                l_welded_references.get(l_welded.get(i)) += 1;
+            }
+
+            Adjacency l_welded_adjacency = Adjacency::allocate(in_out_indices, l_welded.slice, l_vertex_count);
+            for (loop(i, 0, in_out_indices.Size / 3))
+            {
+                v3f l_positions[3];
+                for (loop(j, 0, 3))
+                {
+                    uint32 l_welded_vertex = l_welded.get(in_out_indices.get((i * 3) + j));
+                    uint32 l_welded_next = l_welded.get(in_out_indices.get((i * 3) + ((j + 1) % 3)));
+                    l_positions[j] = p_vertices.get(l_welded_vertex).position;
+
+                    l_locked.get(l_welded_vertex) |= l_welded_references.get(l_welded_vertex) > 1;
+                    // An edge that is not shared by a triangle in the opposite direction is on a border
+                    if (!l_welded_adjacency.has_edge(in_out_indices, l_welded.slice, l_welded_next, l_welded_vertex))
+                    {
+                        l_locked.get(l_welded_vertex) = 1;
+                        l_locked.get(l_welded_next) = 1;
+                    }
+                }
+
+                v3f l_normal = (l_positions[1] - l_positions[0]).cross(l_positions[2] - l_positions[0]);
+                float32 l_double_area = l_normal.length();
+                if (l_double_area > 0.0f)
+                {
+                    l_normal = l_normal * (1.0f / l_double_area);
+                    for (loop(j, 0, 3))
+                    {
+                        l_quadrics.get(l_welded.get(in_out_indices.get((i * 3) + j))).add_plane(l_normal, -l_normal.dot(l_positions[0]), l_double_area * 0.5f);
+                    }
+                }
+            }
+            l_welded_adjacency.free();
+            l_welded_references.free();
+        }
+
+        Span<uint32> l_remap = Span<uint32>::allocate(l_vertex_count);
+        Span<int8> l_collapse_locked = Span<int8>::allocate(l_vertex_count);
+        Vector<Collapse> l_collapses = Vector<Collapse>::allocate(0);
+        // Buffer of the collapses sort
+        Vector<Collapse> l_collapses_scratch = Vector<Collapse>::allocate(0);
+
+        while (l_result.index_count > p_target_index_count)
+        {
+            Slice<uint32> l_indices = Slice<uint32>::build_memory_elementnb(in_out_indices.Begin, l_result.index_count);
+
+            // Every interior edge is shared by two triangles in opposite directions, it is pushed by the triangle where it goes to the greater vertex
+            l_collapses.clear();
+            for (loop(i, 0, l_indices.Size))
+            {
+                uint32 l_from = l_indices.get(i);
+                uint32 l_to = l_indices.get(((i / 3) * 3) + ((i + 1) % 3));
+                if (l_from < l_to)
+                {
+                    push_collapse_if_unlocked(p_vertices, l_welded.slice, l_locked.slice, l_quadrics.slice, l_from, l_to, &l_collapses);
+                    push_collapse_if_unlocked(p_vertices, l_welded.slice, l_locked.slice, l_quadrics.slice, l_to, l_from, &l_collapses);
+                }
+            }
+            if (l_collapses.Size == 0)
+            {
+                break;
+            }
+            l_collapses_scratch.clear();
+            l_collapses_scratch.push_back_array_empty(l_collapses.Size);
+            Slice<Collapse> l_collapses_slice = l_collapses.to_slice();
+            Sort::Radix(l_collapses_slice, l_collapses_scratch.to_slice(), [](const Collapse& p_collapse) { return get_sort_key(p_collapse.error); });
+
+            Adjacency l_adjacency = Adjacency::allocate(l_indices, Slice<uint32>::build_default(), l_vertex_count);
+            for (loop(i, 0, l_vertex_count))
+            {
+                l_remap.get(i) = (uint32)i;
+            }
+            l_collapse_locked.slice.zero();
+
+            uimax l_triangles_to_remove = (l_result.index_count - p_target_index_count + 2) / 3;
+            uimax l_removed_triangles = 0;
+            for (loop(i, 0, l_collapses.Size))
+            {
+                Collapse& l_collapse = l_collapses.get(i);
+                if (l_collapse_locked.get(l_collapse.from) || l_collapse_locked.get(l_collapse.to) || !l_adjacency.can_collapse(p_vertices, l_indices, l_welded.slice, l_collapse))
+                {
+                    continue;
+                }
+
+                // Neighbours are locked for the pass, the moved triangles stay checked against their final positions
+                Slice<uint32> l_triangles = l_adjacency.get_triangles(l_collapse.from);
+                for (loop(j, 0, l_triangles.Size))
+                {
+                    uint32 l_triangle = l_triangles.get(j);
+                    int8 l_triangle_removed = 0;
+                    for (loop(k, 0, 3))
+                    {
+                        uint32 l_vertex = l_indices.get((l_triangle * 3) + k);
+                        l_collapse_locked.get(l_vertex) = 1;
+                        l_triangle_removed |= l_welded.get(l_vertex) == l_welded.get(l_collapse.to);
+                    }
+                    l_removed_triangles += l_triangle_removed;
+                }
+
+                l_remap.get(l_collapse.from) = l_collapse.to;
+                l_quadrics.get(l_welded.get(l_collapse.to)).add(l_quadrics.get(l_welded.get(l_collapse.from)));
+                l_result.error = l_collapse.error > l_result.error ? l_collapse.error : l_result.error;
+
+                if (l_removed_triangles >= l_triangles_to_remove)
+                {
+                    break;
+                }
+            }
+            l_adjacency.free();
+
+            if (l_removed_triangles == 0)
+            {
+                break;
+            }
+
+            // Triangles that have two vertices at the same position after the collapse are removed
+            uimax l_index_count = 0;
+            for (loop(i, 0, l_indices.Size / 3))
+            {
+                uint32 l_0 = l_remap.get(l_indices.get(i * 3));
+                uint32 l_1 = l_remap.get(l_indices.get((i * 3) + 1));
+                uint32 l_2 = l_remap.get(l_indices.get((i * 3) + 2));
+                if (l_welded.get(l_0) != l_welded.get(l_1) && l_welded.get(l_1) != l_welded.get(l_2) && l_welded.get(l_2) != l_welded.get(l_0))
+                {
+                    l_indices.get(l_index_count) = l_0;
+                    l_indices.get(l_index_count + 1) = l_1;
+                    l_indices.get(l_index_count + 2) = l_2;
+                    l_index_count += 3;
+                }
+            }
+            l_result.index_count = l_index_count;
+        }
+
+        l_collapses_scratch.free();
+        l_collapses.free();
+        l_collapse_locked.free();
+        l_remap.free();
+        l_quadrics.free();
+        l_locked.free();
+        l_welded.free();
+
+        return l_result;
+    };
+
+  private:
+    // Symmetric 4x4 matrix of the sum of squared distances to planes (a, b, c, d), multiplied by the plane weight
+    struct Quadric
+    {
+        float32 a2, b2, c2, d2, ab, ac, ad, bc, bd, cd;
+        float32 weight;
+
+        inline void add_plane(const v3f& p_normal, const float32 p_distance, const float32 p_weight)
+        {
+            this->a2 += p_normal.x * p_normal.x * p_weight;
+            this->b2 += p_normal.y * p_normal.y * p_weight;
+            this->c2 += p_normal.z * p_normal.z * p_weight;
+            this->d2 += p_distance * p_distance * p_weight;
+            this->ab += p_normal.x * p_normal.y * p_weight;
+            this->ac += p_normal.x * p_normal.z * p_weight;
+            this->ad += p_normal.x * p_distance * p_weight;
+            this->bc += p_normal.y * p_normal.z * p_weight;
+            this->bd += p_normal.y * p_distance * p_weight;
+            this->cd += p_normal.z * p_distance * p_weight;
+            this->weight += p_weight;
+        };
+
+        inline void add(const Quadric& p_other)
+        {
+            this->a2 += p_other.a2;
+            this->b2 += p_other.b2;
+            this->c2 += p_other.c2;
+            this->d2 += p_other.d2;
+            this->ab += p_other.ab;
+            this->ac += p_other.ac;
+            this->ad += p_other.ad;
+            this->bc += p_other.bc;
+            this->bd += p_other.bd;
+            this->cd += p_other.cd;
+            this->weight += p_other.weight;
+        };
+
+        // Root mean square distance from p_position to the planes
+        inline float32 distance(const v3f& p_position) const
+        {
+            if (this->weight <= 0.0f)
+            {
+                return 0.0f;
+            }
+            float32 l_x = p_position.x, l_y = p_position.y, l_z = p_position.z;
+            float32 l_squared_distance = (this->a2 * l_x * l_x) + (this->b2 * l_y * l_y) + (this->c2 * l_z * l_z) + this->d2 +
+                                         (2.0f * ((this->ab * l_x * l_y) + (this->ac * l_x * l_z) + (this->ad * l_x) + (this->bc * l_y * l_z) + (this->bd * l_y) + (this->cd * l_z)));
+            l_squared_distance /= this->weight;
+            return l_squared_distance > 0.0f ? sqrtf(l_squared_distance) : 0.0f;
+        };
+    };
+
+    struct Collapse
+    {
+        uint32 from;
+        uint32 to;
+        float32 error;
+    };
+
+    /*
+        Triangles that use every vertex, stored contiguously per vertex.
+        When p_welded is not empty, triangles are referenced by the welded vertices instead of the vertices.
+    */
+    struct Adjacency
+    {
+        Span<uint32> vertex_triangles_begin;
+        Span<uint32> triangles;
+
+        inline static Adjacency allocate(const Slice<uint32>& p_indices, const Slice<uint32>& p_welded, const uimax p_vertex_count)
+        {
+            Adjacency l_adjacency = Adjacency{Span<uint32>::callocate(p_vertex_count + 1), Span<uint32>::allocate(p_indices.Size)};
+            for (loop(i, 0, p_indices.Size))
+            {
+                l_adjacency.vertex_triangles_begin.get(get_vertex(p_indices, p_welded, i) + 1) += 1;
+            }
+            for (loop(i, 0, p_vertex_count))
+            {
+                l_adjacency.vertex_triangles_begin.get(i + 1) += l_adjacency.vertex_triangles_begin.get(i);
+            }
+            // vertex_triangles_begin is used as an insertion cursor, it is shifted back to the begin of the vertex when the insertion is done
+            for (loop(i, 0, p_indices.Size))
+            {
+                uint32& l_cursor = l_adjacency.vertex_triangles_begin.get(get_vertex(p_indices, p_welded, i));
+                l_adjacency.triangles.get(l_cursor) = (uint32)(i / 3);
+                l_cursor += 1;
+            }
+            for (loop_reverse(i, 0, p_vertex_count))
+            {
+                l_adjacency.vertex_triangles_begin.get(i + 1) = l_adjacency.vertex_triangles_begin.get(i);
+            }
+            l_adjacency.vertex_triangles_begin.get(0) = 0;
+            return l_adjacency;
+        };
+
+        inline void free()
+        {
+            this->triangles.free();
+            this->vertex_triangles_begin.free();
+        };
+
+        inline Slice<uint32> get_triangles(const uint32 p_vertex)
+        {
+            uint32 l_begin = this->vertex_triangles_begin.get(p_vertex);
+            return Slice<uint32>::build_memory_elementnb(this->triangles.Memory + l_begin, this->vertex_triangles_begin.get(p_vertex + 1) - l_begin);
+        };
+
+        inline int8 has_edge(const Slice<uint32>& p_indices, const Slice<uint32>& p_welded, const uint32 p_from, const uint32 p_to)
+        {
+            Slice<uint32> l_triangles = this->get_triangles(p_from);
+            for (loop(i, 0, l_triangles.Size))
+            {
+                uimax l_triangle = l_triangles.get(i);
+                for (loop(j, 0, 3))
+                {
+                    if (get_vertex(p_indices, p_welded, (l_triangle * 3) + j) == p_from && get_vertex(p_indices, p_welded, (l_triangle * 3) + ((j + 1) % 3)) == p_to)
+                    {
+                        return 1;
+                    }
+                }
+            }
+            return 0;
+        };
+
+        // Moving p_collapse.from must not flip the triangles that are not removed by the collapse
+        template <class VertexType> inline int8 can_collapse(const Slice<VertexType>& p_vertices, const Slice<uint32>& p_indices, const Slice<uint32>& p_welded, const Collapse& p_collapse)
+        {
+            Slice<uint32> l_triangles = this->get_triangles(p_collapse.from);
+            for (loop(i, 0, l_triangles.Size))
+            {
+                uimax l_triangle = l_triangles.get(i);
+                v3f l_positions[3];
+                v3f l_moved_positions[3];
+                int8 l_removed = 0;
+                for (loop(j, 0, 3))
+                {
+                    uint32 l_vertex = p_indices.get((l_triangle * 3) + j);
+                    l_removed |= p_welded.get(l_vertex) == p_welded.get(p_collapse.to);
+                    l_positions[j] = p_vertices.get(l_vertex).position;
+                    l_moved_positions[j] = l_vertex == p_collapse.from ? p_vertices.get(p_collapse.to).position : l_positions[j];
+                }
+                if (l_removed)
+                {
+                    continue;
+                }
+
+                v3f l_normal = (l_positions[1] - l_positions[0]).cross(l_positions[2] - l_positions[0]);
+                v3f l_moved_normal = (l_moved_positions[1] - l_moved_positions[0]).cross(l_moved_positions[2] - l_moved_positions[0]);
+                if (l_normal.dot(l_moved_normal) <= (MeshSimplifier_Const::MIN_NORMAL_DOT * l_normal.length() * l_moved_normal.length()))
+                {
+                    return 0;
+                }
+            }
+            return 1;
+        };
+
+      private:
+        inline static uint32 get_vertex(const Slice<uint32>& p_indices, const Slice<uint32>& p_welded, const uimax p_index)
+        {
+            uint32 l_vertex = p_indices.get(p_index);
+            return p_welded.Size != 0 ? p_welded.get(l_vertex) : l_vertex;
+        };
+    };
+
+    // Every vertex is mapped to the first vertex that has the same position
+    template <class VertexType> inline static void weld_positions(const Slice<VertexType>& p_vertices, Slice<uint32>& out_welded)
+    {
+        uimax l_table_size = 1;
+        while (l_table_size < (p_vertices.Size * 2))
+        {
+            l_table_size *= 2;
+        }
+        Span<uint32> l_table = Span<uint32>::allocate(l_table_size);
+        for (loop(i, 0, l_table_size))
+        {
+            l_table.get(i) = (uint32)-1;
+        }
+
+        for (loop(i, 0, p_vertices.Size))
+        {
+            const v3f& l_position = p_vertices.get(i).position;
+            uint32 l_bits[3];
+            memory_cpy((int8*)l_bits, (const int8*)&l_position, sizeof(l_bits));
+            // Low bits of round floats are zeros, they are mixed with the high bits
+            uint32 l_hash = (l_bits[0] * 73856093U) ^ (l_bits[1] * 19349663U) ^ (l_bits[2] * 83492791U);
+            l_hash ^= l_hash >> 16;
+            l_hash *= 0x85EBCA6BU;
+            l_hash ^= l_hash >> 13;
+            uimax l_bucket = l_hash & (l_table_size - 1);
+            while (1)
+            {
+                uint32& l_entry = l_table.get(l_bucket);
+                if (l_entry == (uint32)-1)
+                {
+                    l_entry = (uint32)i;
+                    out_welded.get(i) = (uint32)i;
+                    break;
+                }
+                if (memory_compare((const int8*)&p_vertices.get(l_entry).position, (const int8*)&l_position, sizeof(v3f)))
+                {
+                    out_welded.get(i) = l_entry;
+                    break;
+                }
+                l_bucket = (l_bucket + 1) & (l_table_size - 1);
+            }
+        }
+
+        l_table.free();
+    };
+
+    template <class VertexType>
+    inline static void push_collapse_if_unlocked(const Slice<VertexType>& p_vertices, const Slice<uint32>& p_welded, const Slice<int8>& p_locked, const Slice<Quadric>& p_quadrics,
+                                                 const uint32 p_from, const uint32 p_to, Vector<Collapse>* in_out_collapses)
+    {
+        if (!p_locked.get(p_welded.get(p_from)))
+        {
+            in_out_collapses->push_back_element(Collapse{p_from, p_to, p_quadrics.get(p_welded.get(p_from)).distance(p_vertices.get(p_to).position)});
+        }
+    };
+
+    /*
+        Key of the collapse error whose unsigned order is the float order. Positive floats have their sign bit set and negative ones are fully flipped,
+        so that errors that are slightly negative because of the quadric rounding are still sorted before the others.
+    */
+    inline static uint32 get_sort_key(const float32 p_error)
+    {
+        uint32 l_bits;
+        memory_cpy((int8*)&l_bits, (const int8*)&p_error, sizeof(uint32));
+        return (l_bits & ((uint32)1 << 31)) ? ~l_bits : (l_bits | ((uint32)1 << 31));
+    };
+};
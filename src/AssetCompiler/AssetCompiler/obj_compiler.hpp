@@ -1,134 +1,445 @@
 #pragma once
 
+namespace ObjCompiler_const
+{
+// Size of the chunks read from an obj file, lines can span multiple chunks
+constexpr uimax STREAM_CHUNK_SIZE = 1024 * 1024;
+}; // namespace ObjCompiler_const
+
+/*
+    Indices of the obj attributes used by a face corner. Missing attributes are -1.
+    The normal index is always -1 if normals are not read.
+*/
+struct ObjVertexKey
+{
+    uimax position_index;
+    uimax uv_index;
+    uimax normal_index;
+};
+
+template <> struct HashMap_HashFn<ObjVertexKey>
+{
+    inline static hash_t hash(const ObjVertexKey& p_key)
+    {
+        uint64 l_hash = (uint64)p_key.position_index;
+        l_hash = (l_hash * 0x9e3779b97f4a7c15) ^ (uint64)p_key.uv_index;
+        l_hash = (l_hash * 0x9e3779b97f4a7c15) ^ (uint64)p_key.normal_index;
+        return (hash_t)l_hash;
+    };
+};
+
 struct ObjCompiler
 {
-    struct VertexKey
+    /*
+        Single pass tokenizer over one line of an obj file.
+    */
+    struct LineTokenizer
     {
-        uimax position_index;
-        uimax uv_index;
+        Slice<int8> line;
+        uimax cursor;
 
-        uimax computed_indice;
+        inline static LineTokenizer build(const Slice<int8>& p_line)
+        {
+            return LineTokenizer{p_line, 0};
+        };
 
-        inline int8 equals(const VertexKey& p_other)
+        inline void skip_spaces()
         {
-            return this->position_index == p_other.position_index && this->uv_index == p_other.uv_index;
-        }
-    };
+            while (this->cursor < this->line.Size && (this->line.get(this->cursor) == ' ' || this->line.get(this->cursor) == '\t'))
+            {
+                this->cursor += 1;
+            }
+        };
 
-    inline static void ReadObj(const Slice<int8>& p_obj_content, Vector<Vertex>& out_vertices, Vector<uint32>& out_indices)
-    {
-        Vector<VertexKey> l_vertices_indexed = Vector<VertexKey>::allocate(0);
-        Vector<v3f> l_positions = Vector<v3f>::allocate(0);
-        Vector<v2f> l_uvs = Vector<v2f>::allocate(0);
+        // The token ends at the next space or at the end of the line
+        inline Slice<int8> next_token()
+        {
+            this->skip_spaces();
+            uimax l_begin = this->cursor;
+            while (this->cursor < this->line.Size && this->line.get(this->cursor) != ' ' && this->line.get(this->cursor) != '\t')
+            {
+                this->cursor += 1;
+            }
+            return Slice<int8>::build_begin_end(this->line.Begin, l_begin, this->cursor);
+        };
 
-        uimax l_begin_line_index = 0;
-        for (loop(l_reader_index, 0, p_obj_content.Size))
+        inline float32 next_float32()
         {
-            if (p_obj_content.get(l_reader_index) == '\n')
+            this->skip_spaces();
+
+            int8 l_negative = 0;
+            if (this->cursor < this->line.Size && (this->line.get(this->cursor) == '-' || this->line.get(this->cursor) == '+'))
             {
-                Slice<int8> l_line = p_obj_content.slide_rv(l_begin_line_index);
-                l_line.Size = l_reader_index - l_begin_line_index;
+                l_negative = this->line.get(this->cursor) == '-';
+                this->cursor += 1;
+            }
 
-                if (l_line.compare(slice_int8_build_rawstr("vn")))
+            // Digits are accumulated in an integer and scaled once, 19 digits always fit in an uint64
+            uint64 l_mantissa = 0;
+            int32 l_exponent = 0;
+            uimax l_digit_count = 0;
+            while (this->cursor < this->line.Size && is_digit(this->line.get(this->cursor)))
+            {
+                push_digit(this->line.get(this->cursor), &l_mantissa, &l_exponent, &l_digit_count);
+                this->cursor += 1;
+            }
+            if (this->cursor < this->line.Size && this->line.get(this->cursor) == '.')
+            {
+                this->cursor += 1;
+                while (this->cursor < this->line.Size && is_digit(this->line.get(this->cursor)))
                 {
+                    push_digit(this->line.get(this->cursor), &l_mantissa, &l_exponent, &l_digit_count);
+                    l_exponent -= 1;
+                    this->cursor += 1;
                 }
-                else if (l_line.compare(slice_int8_build_rawstr("vt")))
+            }
+            if (this->cursor < this->line.Size && (this->line.get(this->cursor) == 'e' || this->line.get(this->cursor) == 'E'))
+            {
+                this->cursor += 1;
+                int8 l_exponent_negative = 0;
+                if (this->cursor < this->line.Size && (this->line.get(this->cursor) == '-' || this->line.get(this->cursor) == '+'))
+                {
+                    l_exponent_negative = this->line.get(this->cursor) == '-';
+                    this->cursor += 1;
+                }
+                int32 l_written_exponent = 0;
+                while (this->cursor < this->line.Size && is_digit(this->line.get(this->cursor)))
                 {
-                    v2f l_uv;
+                    if (l_written_exponent < 1000)
+                    {
+                        l_written_exponent = (l_written_exponent * 10) + (this->line.get(this->cursor) - '0');
+                    }
+                    this->cursor += 1;
+                }
+                l_exponent += l_exponent_negative ? -l_written_exponent : l_written_exponent;
+            }
+
+            float64 l_value = (float64)l_mantissa;
+            if (l_exponent < 0)
+            {
+                l_value /= pow10(-l_exponent);
+            }
+            else if (l_exponent > 0)
+            {
+                l_value *= pow10(l_exponent);
+            }
 
-                    uimax l_first_space, l_second_space;
-                    l_line.find(slice_int8_build_rawstr(" "), &l_first_space);
-                    l_first_space += 1;
-                    l_line.slide_rv(l_first_space).find(slice_int8_build_rawstr(" "), &l_second_space);
-                    l_second_space += l_first_space + 1;
+            return (float32)(l_negative ? -l_value : l_value);
+        };
 
-                    l_uv.x = FromString::afloat32(Slice<int8>::build_begin_end(l_line.Begin, l_first_space, l_second_space - 1));
-                    l_uv.y = 1.0f - FromString::afloat32(Slice<int8>::build_begin_end(l_line.Begin, l_second_space, l_line.Size));
+        /*
+            Parses a face corner "v", "v/vt", "v//vn" or "v/vt/vn".
+            Obj indices start at 1, negative indices are relative to the number of attributes already read.
+        */
+        inline int8 next_face_corner(const uimax p_position_count, const uimax p_uv_count, const uimax p_normal_count, ObjVertexKey* out_key)
+        {
+            Slice<int8> l_corner = this->next_token();
+            if (l_corner.Size == 0)
+            {
+                return 0;
+            }
 
-                    l_uvs.push_back_element(l_uv);
-                }
-                else if (l_line.compare(slice_int8_build_rawstr("v")))
+            uimax l_corner_cursor = 0;
+            out_key->position_index = parse_index(l_corner, &l_corner_cursor, p_position_count);
+            out_key->uv_index = -1;
+            out_key->normal_index = -1;
+            if (l_corner_cursor < l_corner.Size && l_corner.get(l_corner_cursor) == '/')
+            {
+                l_corner_cursor += 1;
+                out_key->uv_index = parse_index(l_corner, &l_corner_cursor, p_uv_count);
+                if (l_corner_cursor < l_corner.Size && l_corner.get(l_corner_cursor) == '/')
                 {
-                    v3f l_local_position;
-                    uimax l_first_space, l_second_space, l_third_space;
-                    l_line.find(slice_int8_build_rawstr(" "), &l_first_space);
-                    l_first_space += 1;
-                    l_line.slide_rv(l_first_space).find(slice_int8_build_rawstr(" "), &l_second_space);
-                    l_second_space += l_first_space + 1;
-                    l_line.slide_rv(l_second_space).find(slice_int8_build_rawstr(" "), &l_third_space);
-                    l_third_space += l_second_space + 1;
-
-                    l_local_position.x = FromString::afloat32(Slice<int8>::build_begin_end(l_line.Begin, l_first_space, l_second_space - 1));
-                    l_local_position.y = FromString::afloat32(Slice<int8>::build_begin_end(l_line.Begin, l_second_space, l_third_space - 1));
-                    l_local_position.z = FromString::afloat32(Slice<int8>::build_begin_end(l_line.Begin, l_third_space, l_line.Size));
-
-                    l_positions.push_back_element(l_local_position);
+                    l_corner_cursor += 1;
+                    out_key->normal_index = parse_index(l_corner, &l_corner_cursor, p_normal_count);
                 }
+            }
+            return 1;
+        };
+
+      private:
+        inline static int8 is_digit(const int8 p_char)
+        {
+            return p_char >= '0' && p_char <= '9';
+        };
 
-                else if (l_line.compare(slice_int8_build_rawstr("f")))
+        inline static void push_digit(const int8 p_char, uint64* in_out_mantissa, int32* in_out_exponent, uimax* in_out_digit_count)
+        {
+            if (*in_out_digit_count < 19)
+            {
+                *in_out_mantissa = (*in_out_mantissa * 10) + (uint64)(p_char - '0');
+                if (*in_out_mantissa != 0)
                 {
-                    uimax l_first_space, l_second_space, l_third_space;
-                    l_line.find(slice_int8_build_rawstr(" "), &l_first_space);
-                    l_first_space += 1;
-                    l_line.slide_rv(l_first_space).find(slice_int8_build_rawstr(" "), &l_second_space);
-                    l_second_space += l_first_space + 1;
-                    l_line.slide_rv(l_second_space).find(slice_int8_build_rawstr(" "), &l_third_space);
-                    l_third_space += l_second_space + 1;
-
-                    process_obj_face(Slice<int8>::build_begin_end(l_line.Begin, l_first_space, l_second_space - 1), l_vertices_indexed, l_positions, l_uvs, out_vertices, out_indices);
-                    process_obj_face(Slice<int8>::build_begin_end(l_line.Begin, l_second_space, l_third_space - 1), l_vertices_indexed, l_positions, l_uvs, out_vertices, out_indices);
-                    process_obj_face(Slice<int8>::build_begin_end(l_line.Begin, l_third_space, l_line.Size), l_vertices_indexed, l_positions, l_uvs, out_vertices, out_indices);
-
-                    // l_line.substr(l_first_space, l_second_space - l_first_space).
+                    *in_out_digit_count += 1;
                 }
+            }
+            else
+            {
+                // Digits that don't fit are dropped, they are way below the float32 precision
+                *in_out_exponent += 1;
+            }
+        };
 
-                l_begin_line_index = l_reader_index + 1;
+        inline static float64 pow10(const int32 p_exponent)
+        {
+            static const float64 l_pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            if (p_exponent <= 22)
+            {
+                return l_pow10[p_exponent];
             }
-        }
+            return pow(10.0, (float64)p_exponent);
+        };
 
-        l_vertices_indexed.free();
-        l_positions.free();
-        l_uvs.free();
-    }
+        /*
+            Returns -1 if there is no index at the cursor.
+            An index that doesn't refer to an attribute already read is returned out of range (greater or equal to p_attribute_count).
+        */
+        inline static uimax parse_index(const Slice<int8>& p_corner, uimax* in_out_cursor, const uimax p_attribute_count)
+        {
+            int8 l_relative = 0;
+            if (*in_out_cursor < p_corner.Size && p_corner.get(*in_out_cursor) == '-')
+            {
+                l_relative = 1;
+                *in_out_cursor += 1;
+            }
 
-    inline static void process_obj_face(const Slice<int8> p_face, Vector<VertexKey>& p_vertices_indexed, Vector<v3f>& p_positions, Vector<v2f>& p_uvs, Vector<Vertex>& out_vertices,
-                                        Vector<uint32>& out_indices)
+            uimax l_begin = *in_out_cursor;
+            uimax l_index = 0;
+            while (*in_out_cursor < p_corner.Size && is_digit(p_corner.get(*in_out_cursor)))
+            {
+                l_index = (l_index * 10) + (uimax)(p_corner.get(*in_out_cursor) - '0');
+                *in_out_cursor += 1;
+            }
+
+            if (*in_out_cursor == l_begin)
+            {
+                return -1;
+            }
+
+            if (l_relative)
+            {
+                return l_index <= p_attribute_count ? p_attribute_count - l_index : p_attribute_count;
+            }
+            return l_index != 0 ? l_index - 1 : p_attribute_count;
+        };
+    };
+
+    /*
+        Parses an obj file that is pushed by consecutive chunks of any size, so that the whole file never has to be loaded.
+        Face corners are deduplicated by their attribute indices with a hash map, faces with more than three corners are triangulated as a fan.
+        Faces with a corner that has no position or that refers to an attribute not read yet are malformed, they are skipped.
+        If normals are requested, out_normals has one normal per output vertex.
+    */
+    struct Reader
     {
-        uimax l_first_slash, l_second_slash;
-        p_face.find(slice_int8_build_rawstr("/"), &l_first_slash);
-        l_first_slash += 1;
-        p_face.slide_rv(l_first_slash).find(slice_int8_build_rawstr("/"), &l_second_slash);
-        l_second_slash += l_first_slash + 1;
+        Vector<v3f> positions;
+        Vector<v2f> uvs;
+        Vector<v3f> normals;
+        HashMap<ObjVertexKey, uint32> vertices_indexed;
+        // The end of the last pushed chunk when it doesn't end with a new line
+        Vector<int8> pending_line;
+        Vector<ObjVertexKey> face_keys;
+        Vector<uint32> face_indices;
+
+        Vector<Vertex>* out_vertices;
+        Vector<uint32>* out_indices;
+        Vector<v3f>* out_normals;
 
-        uimax l_position_index = FromString::auimax(Slice<int8>::build_begin_end(p_face.Begin, 0, l_first_slash - 1)) - 1;
-        uimax l_uv_index = FromString::auimax(Slice<int8>::build_begin_end(p_face.Begin, l_first_slash, l_second_slash - 1)) - 1;
+        // out_normals can be NULL if normals are not needed, they are then ignored from deduplication.
+        inline static Reader allocate(Vector<Vertex>* out_vertices, Vector<uint32>* out_indices, Vector<v3f>* out_normals)
+        {
+            return Reader{Vector<v3f>::allocate(0),
+                          Vector<v2f>::allocate(0),
+                          Vector<v3f>::allocate(0),
+                          HashMap<ObjVertexKey, uint32>::allocate_default(),
+                          Vector<int8>::allocate(0),
+                          Vector<ObjVertexKey>::allocate(0),
+                          Vector<uint32>::allocate(0),
+                          out_vertices,
+                          out_indices,
+                          out_normals};
+        };
 
-        VertexKey l_key;
-        l_key.position_index = l_position_index;
-        l_key.uv_index = l_uv_index;
+        inline void free()
+        {
+            this->positions.free();
+            this->uvs.free();
+            this->normals.free();
+            this->vertices_indexed.free();
+            this->pending_line.free();
+            this->face_keys.free();
+            this->face_indices.free();
+        };
 
-        int8 l_key_already_indexed = 0;
-        uimax l_key_already_indexed_index = 0;
-        for (loop(i, 0, p_vertices_indexed.Size))
+        inline void push_chunk(const Slice<int8>& p_chunk)
         {
-            if (p_vertices_indexed.get(i).equals(l_key))
+            uimax l_begin_line_index = 0;
+            for (loop(l_reader_index, 0, p_chunk.Size))
             {
-                l_key_already_indexed = 1;
-                l_key.computed_indice = i;
-                break;
+                if (p_chunk.get(l_reader_index) == '\n')
+                {
+                    Slice<int8> l_line = Slice<int8>::build_begin_end(p_chunk.Begin, l_begin_line_index, l_reader_index);
+                    if (this->pending_line.Size != 0)
+                    {
+                        this->pending_line.push_back_array(l_line);
+                        this->read_line(this->pending_line.to_slice());
+                        this->pending_line.clear();
+                    }
+                    else
+                    {
+                        this->read_line(l_line);
+                    }
+                    l_begin_line_index = l_reader_index + 1;
+                }
             }
-        }
 
-        if (!l_key_already_indexed)
+            if (l_begin_line_index < p_chunk.Size)
+            {
+                this->pending_line.push_back_array(Slice<int8>::build_begin_end(p_chunk.Begin, l_begin_line_index, p_chunk.Size));
+            }
+        };
+
+        // Reads the last line if the obj doesn't end with a new line
+        inline void end()
+        {
+            if (this->pending_line.Size != 0)
+            {
+                this->read_line(this->pending_line.to_slice());
+                this->pending_line.clear();
+            }
+        };
+
+      private:
+        inline void read_line(Slice<int8> p_line)
         {
-            l_key.computed_indice = p_vertices_indexed.Size;
-            p_vertices_indexed.push_back_element(l_key);
+            if (p_line.Size > 0 && p_line.get(p_line.Size - 1) == '\r')
+            {
+                p_line.Size -= 1;
+            }
+
+            LineTokenizer l_tokenizer = LineTokenizer::build(p_line);
+            Slice<int8> l_keyword = l_tokenizer.next_token();
+
+            if (l_keyword.Size == 1 && l_keyword.compare(slice_int8_build_rawstr("v")))
+            {
+                v3f l_position;
+                l_position.x = l_tokenizer.next_float32();
+                l_position.y = l_tokenizer.next_float32();
+                l_position.z = l_tokenizer.next_float32();
+                this->positions.push_back_element(l_position);
+            }
+            else if (l_keyword.Size == 2 && l_keyword.compare(slice_int8_build_rawstr("vt")))
+            {
+                v2f l_uv;
+                l_uv.x = l_tokenizer.next_float32();
+                l_uv.y = 1.0f - l_tokenizer.next_float32();
+                this->uvs.push_back_element(l_uv);
+            }
+            else if (l_keyword.Size == 2 && l_keyword.compare(slice_int8_build_rawstr("vn")))
+            {
+                if (this->out_normals != NULL)
+                {
+                    v3f l_normal;
+                    l_normal.x = l_tokenizer.next_float32();
+                    l_normal.y = l_tokenizer.next_float32();
+                    l_normal.z = l_tokenizer.next_float32();
+                    this->normals.push_back_element(l_normal);
+                }
+            }
+            else if (l_keyword.Size == 1 && l_keyword.compare(slice_int8_build_rawstr("f")))
+            {
+                this->face_keys.clear();
+                this->face_indices.clear();
+                ObjVertexKey l_key;
+                while (l_tokenizer.next_face_corner(this->positions.Size, this->uvs.Size, this->normals.Size, &l_key))
+                {
+                    if (this->out_normals == NULL)
+                    {
+                        l_key.normal_index = -1;
+                    }
+                    if (!this->is_vertex_key_valid(l_key))
+                    {
+                        return;
+                    }
+                    this->face_keys.push_back_element(l_key);
+                }
+
+                for (loop(i, 0, this->face_keys.Size))
+                {
+                    this->face_indices.push_back_element(this->get_or_push_vertex(this->face_keys.get(i)));
+                }
+
+                for (loop(i, 2, this->face_indices.Size))
+                {
+                    this->out_indices->push_back_element(this->face_indices.get(0));
+                    this->out_indices->push_back_element(this->face_indices.get(i - 1));
+                    this->out_indices->push_back_element(this->face_indices.get(i));
+                }
+            }
+        };
+
+        inline int8 is_vertex_key_valid(const ObjVertexKey& p_key)
+        {
+            return p_key.position_index < this->positions.Size && (p_key.uv_index == (uimax)-1 || p_key.uv_index < this->uvs.Size) &&
+                   (p_key.normal_index == (uimax)-1 || p_key.normal_index < this->normals.Size);
+        };
+
+        inline uint32 get_or_push_vertex(const ObjVertexKey& p_key)
+        {
+            uint32* l_indexed_vertex = this->vertices_indexed.get_value_nothashed(p_key);
+            if (l_indexed_vertex != NULL)
+            {
+                return *l_indexed_vertex;
+            }
+
+            uint32 l_vertex_index = (uint32)this->out_vertices->Size;
+            this->vertices_indexed.push_key_value_nothashed(p_key, l_vertex_index);
+
             Vertex l_vertex;
-            l_vertex.position = p_positions.get(l_position_index);
-            l_vertex.uv = p_uvs.get(l_uv_index);
-            out_vertices.push_back_element(l_vertex);
+            l_vertex.position = this->positions.get(p_key.position_index);
+            l_vertex.uv = p_key.uv_index != (uimax)-1 ? this->uvs.get(p_key.uv_index) : v2f{0.0f, 0.0f};
+            this->out_vertices->push_back_element(l_vertex);
+
+            if (this->out_normals != NULL)
+            {
+                this->out_normals->push_back_element(p_key.normal_index != (uimax)-1 ? this->normals.get(p_key.normal_index) : v3f{0.0f, 0.0f, 0.0f});
+            }
+
+            return l_vertex_index;
+        };
+    };
+
+    inline static void ReadObj(const Slice<int8>& p_obj_content, Vector<Vertex>& out_vertices, Vector<uint32>& out_indices)
+    {
+        ReadObj(p_obj_content, &out_vertices, &out_indices, NULL);
+    };
+
+    inline static void ReadObj(const Slice<int8>& p_obj_content, Vector<Vertex>* out_vertices, Vector<uint32>* out_indices, Vector<v3f>* out_normals)
+    {
+        Reader l_reader = Reader::allocate(out_vertices, out_indices, out_normals);
+        l_reader.push_chunk(p_obj_content);
+        l_reader.end();
+        l_reader.free();
+    };
+
+    /*
+        Reads the obj file by chunks of ObjCompiler_const::STREAM_CHUNK_SIZE.
+    */
+    inline static void ReadObj_streamed(const File& p_obj_file, Vector<Vertex>* out_vertices, Vector<uint32>* out_indices, Vector<v3f>* out_normals)
+    {
+        Reader l_reader = Reader::allocate(out_vertices, out_indices, out_normals);
+        Span<int8> l_chunk_buffer = Span<int8>::allocate(ObjCompiler_const::STREAM_CHUNK_SIZE);
+
+        uimax l_file_size = p_obj_file.get_size();
+        for (uimax l_offset = 0; l_offset < l_file_size;)
+        {
+            Slice<int8> l_chunk = l_chunk_buffer.slice;
+            p_obj_file.read_file_chunk(l_offset, &l_chunk);
+            l_reader.push_chunk(l_chunk);
+            l_offset += l_chunk.Size;
         }
+        l_reader.end();
 
-        out_indices.push_back_element((uint32)l_key.computed_indice);
-    }
-};
\ No newline at end of file
+        l_chunk_buffer.free();
+        l_reader.free();
+    };
+};
@@ -0,0 +1,97 @@
+#include "AssetCompiler/asset_compiler.hpp"
+
+/*
+    Compilation and load time of the AssetCompiler test assets.
+    Assets are compiled to a new database with AssetCompiler_compile_and_push_to_database_incremental, then compiled again (nothing has changed, so nothing is compiled).
+    The compiled assets are then loaded by the calling thread with a single connection, and by the jobs of a JobSystem with an AssetDatabaseReaderPool.
+*/
+
+const uimax asset_compiler_benchmark_load_iteration_count = 256;
+
+inline void asset_compiler_benchmark_load_sequential(AssetDatabase& p_asset_database, const Slice<hash_t>& p_ids)
+{
+    uimax l_total_size = 0;
+    time_t l_begin = clock_currenttime_mics();
+    for (loop(i, 0, p_ids.Size))
+    {
+        Span<int8> l_blob = p_asset_database.get_asset_blob(p_ids.get(i));
+        l_total_size += l_blob.Capacity;
+        p_asset_database.release_asset_blob(l_blob);
+    }
+    float64 l_time = (float64)(clock_currenttime_mics() - l_begin) / 1000000.0;
+    printf("load, single connection : %f MiB/s\n", ((float64)l_total_size / (1024.0 * 1024.0)) / l_time);
+};
+
+inline void asset_compiler_benchmark_load_jobs(JobSystem& p_job_system, AssetDatabaseReaderPool& p_asset_database_readers, const Slice<hash_t>& p_ids)
+{
+    Span<uimax> l_thread_sizes = Span<uimax>::callocate(p_job_system.get_thread_count());
+    time_t l_begin = clock_currenttime_mics();
+    p_job_system.parallel_for(p_ids, 16, [&](const uimax p_index, const hash_t p_id) {
+        uimax l_thread_index = p_job_system.get_current_thread_index();
+        AssetDatabase& l_reader = p_asset_database_readers.get_reader(l_thread_index);
+        Span<int8> l_blob = l_reader.get_asset_blob(p_id);
+        l_thread_sizes.get(l_thread_index) += l_blob.Capacity;
+        l_reader.release_asset_blob(l_blob);
+    });
+    float64 l_time = (float64)(clock_currenttime_mics() - l_begin) / 1000000.0;
+
+    uimax l_total_size = 0;
+    for (loop(i, 0, l_thread_sizes.Capacity))
+    {
+        l_total_size += l_thread_sizes.get(i);
+    }
+    printf("load, %lld jobs threads : %f MiB/s\n", (long long)p_job_system.get_thread_count(), ((float64)l_total_size / (1024.0 * 1024.0)) / l_time);
+
+    l_thread_sizes.free();
+};
+
+int main()
+{
+    String l_database_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_database_path.append(slice_int8_build_rawstr("asset_compiler_benchmark.db"));
+    {
+        File l_tmp_file = File::create_or_open(l_database_path.to_slice());
+        l_tmp_file.erase_with_slicepath();
+    }
+    AssetDatabase::initialize_database(l_database_path.to_slice());
+
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+    JobSystem l_job_system = JobSystem::allocate_default();
+    AssetDatabaseReaderPool l_asset_database_readers = AssetDatabaseReaderPool::allocate(l_database_path.to_slice(), l_job_system.get_thread_count());
+    Span<int8> l_asset_root_path = Span<int8>::allocate_slice(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+
+    SliceN<Slice<int8>, 6> l_relative_asset_paths = {slice_int8_build_rawstr("shad.vert"),          slice_int8_build_rawstr("shad.frag"),
+                                                     slice_int8_build_rawstr("shader_asset_test.json"), slice_int8_build_rawstr("material_asset_test.json"),
+                                                     slice_int8_build_rawstr("texture.png"),        slice_int8_build_rawstr("cube.obj")};
+
+    {
+        time_t l_begin = clock_currenttime_mics();
+        uimax l_compiled_count =
+            AssetCompiler_compile_and_push_to_database_incremental(l_job_system, l_asset_database, l_asset_database_readers, l_asset_root_path.slice, l_relative_asset_paths.to_slice());
+        printf("compile : %lld assets, %f ms\n", (long long)l_compiled_count, (float64)(clock_currenttime_mics() - l_begin) / 1000.0);
+    }
+    {
+        time_t l_begin = clock_currenttime_mics();
+        uimax l_compiled_count =
+            AssetCompiler_compile_and_push_to_database_incremental(l_job_system, l_asset_database, l_asset_database_readers, l_asset_root_path.slice, l_relative_asset_paths.to_slice());
+        printf("compile unchanged : %lld assets, %f ms\n", (long long)l_compiled_count, (float64)(clock_currenttime_mics() - l_begin) / 1000.0);
+    }
+
+    Span<hash_t> l_ids = Span<hash_t>::allocate(l_relative_asset_paths.Size() * asset_compiler_benchmark_load_iteration_count);
+    for (loop(i, 0, l_ids.Capacity))
+    {
+        l_ids.get(i) = HashSlice(l_relative_asset_paths.get(i % l_relative_asset_paths.Size()));
+    }
+
+    asset_compiler_benchmark_load_sequential(l_asset_database, l_ids.slice);
+    asset_compiler_benchmark_load_jobs(l_job_system, l_asset_database_readers, l_ids.slice);
+
+    l_ids.free();
+    l_asset_root_path.free();
+    l_asset_database_readers.free();
+    l_job_system.free();
+    l_asset_database.free();
+    l_database_path.free();
+
+    memleak_ckeck();
+};
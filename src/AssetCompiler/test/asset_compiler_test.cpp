@@ -1,6 +1,7 @@
 
 #include "AssetCompiler/asset_compiler.hpp"
 #include "asset_database_test_utils.hpp"
+#include "test_random.hpp"
 
 inline void shader_module_compilation(ShaderCompiler& p_shader_compiler)
 {
@@ -148,8 +149,45 @@ inline void mesh_asset_compilation(ShaderCompiler& p_shader_compiler)
                                  Vertex{l_positions[1], l_uvs[12]}, Vertex{l_positions[1], l_uvs[13]}};
         SliceN<uint32, 36> l_indices = {0, 1, 2, 3, 4, 1, 5, 6, 4, 7, 8, 6, 4, 9, 10, 11, 7, 5, 0, 3, 1, 3, 5, 4, 5, 7, 6, 7, 12, 8, 4, 6, 9, 11, 13, 7};
 
-        assert_true(l_mesh_value.initial_vertices.compare(l_vertices.to_slice()));
-        assert_true(l_mesh_value.initial_indices.compare(l_indices.to_slice()));
+        // Triangles and vertices are reordered by the MeshOptimizer, every source triangle must be found with the same winding
+        assert_true(l_mesh_value.has_16_bit_indices());
+        assert_true(l_mesh_value.initial_vertices.Size == l_vertices.Size());
+        assert_true(l_mesh_value.initial_indices_16.Size == l_indices.Size());
+        for (loop(i, 0, l_indices.Size() / 3))
+        {
+            int8 l_triangle_found = 0;
+            for (loop(j, 0, l_mesh_value.initial_indices_16.Size / 3))
+            {
+                int8 l_triangle_equals = 1;
+                for (loop(k, 0, 3))
+                {
+                    Slice<Vertex> l_source_vertex = Slice<Vertex>::build_memory_elementnb(&l_vertices.get(l_indices.get((i * 3) + k)), 1);
+                    Slice<Vertex> l_compiled_vertex = Slice<Vertex>::build_memory_elementnb(&l_mesh_value.initial_vertices.get(l_mesh_value.initial_indices_16.get((j * 3) + k)), 1);
+                    l_triangle_equals &= l_source_vertex.compare(l_compiled_vertex);
+                }
+                l_triangle_found |= l_triangle_equals;
+            }
+            assert_true(l_triangle_found);
+        }
+
+        // Vertices are stored in the order they are first used by the indices
+        uimax l_next_new_vertex = 0;
+        for (loop(i, 0, l_mesh_value.initial_indices_16.Size))
+        {
+            uint16 l_index = l_mesh_value.initial_indices_16.get(i);
+            assert_true(l_index <= l_next_new_vertex);
+            if (l_index == l_next_new_vertex)
+            {
+                l_next_new_vertex += 1;
+            }
+        }
+        assert_true(l_next_new_vertex == l_vertices.Size());
+        // Cube corners that are not on an uv seam are collapsed once, the next LOD would not remove enough triangles
+        assert_true(l_mesh_value.lod_count == 1);
+        assert_true(l_mesh_value.lods.get(0).has_16_bit_indices());
+        assert_true(l_mesh_value.lods.get(0).indices_16.Size < l_indices.Size());
+        assert_true(l_mesh_value.lods.get(0).vertices.Size < l_vertices.Size());
+        assert_true(l_mesh_value.lods.get(0).error > 0.0f);
 
         l_mesh_ressource_compiled.free();
     }
@@ -159,6 +197,182 @@ inline void mesh_asset_compilation(ShaderCompiler& p_shader_compiler)
     l_asset_database_path.free();
 };
 
+inline void mesh_optimization()
+{
+    // A grid of quads where triangles are shuffled
+    const uimax l_grid_size = 32;
+    const uimax l_vertex_count = (l_grid_size + 1) * (l_grid_size + 1);
+    Span<v3f> l_vertices = Span<v3f>::allocate(l_vertex_count);
+    for (loop(y, 0, l_grid_size + 1))
+    {
+        for (loop(x, 0, l_grid_size + 1))
+        {
+            l_vertices.get((y * (l_grid_size + 1)) + x) = v3f{(float32)x, (float32)y, 0.0f};
+        }
+    }
+
+    Span<uint32> l_indices = Span<uint32>::allocate(l_grid_size * l_grid_size * 6);
+    for (loop(y, 0, l_grid_size))
+    {
+        for (loop(x, 0, l_grid_size))
+        {
+            uint32 l_vertex = (uint32)((y * (l_grid_size + 1)) + x);
+            uint32 l_quad[6] = {l_vertex, l_vertex + 1, l_vertex + (uint32)l_grid_size + 1, l_vertex + 1, l_vertex + (uint32)l_grid_size + 2, l_vertex + (uint32)l_grid_size + 1};
+            l_indices.slice.slide_rv((((y * l_grid_size) + x) * 6)).copy_memory(Slice<uint32>::build_memory_elementnb(l_quad, 6));
+        }
+    }
+    uint32 l_random = 12345;
+    for (loop_reverse(i, 1, l_indices.Capacity / 3))
+    {
+        test_random_next(&l_random);
+        uimax l_swapped = (l_random >> 8) % (i + 1);
+        for (loop(k, 0, 3))
+        {
+            uint32 l_tmp = l_indices.get((i * 3) + k);
+            l_indices.get((i * 3) + k) = l_indices.get((l_swapped * 3) + k);
+            l_indices.get((l_swapped * 3) + k) = l_tmp;
+        }
+    }
+
+    // The sum of triangle signed areas doesn't change if triangles keep their winding
+    auto l_signed_area = [](const Slice<v3f>& p_vertices, const Slice<uint32>& p_indices) {
+        float32 l_area = 0.0f;
+        for (loop(i, 0, p_indices.Size / 3))
+        {
+            v3f l_0 = p_vertices.get(p_indices.get(i * 3));
+            v3f l_1 = p_vertices.get(p_indices.get((i * 3) + 1));
+            v3f l_2 = p_vertices.get(p_indices.get((i * 3) + 2));
+            l_area += ((l_1.x - l_0.x) * (l_2.y - l_0.y)) - ((l_2.x - l_0.x) * (l_1.y - l_0.y));
+        }
+        return l_area;
+    };
+
+    float32 l_area_before = l_signed_area(l_vertices.slice, l_indices.slice);
+    float32 l_acmr_before = MeshOptimizer::compute_acmr(l_indices.slice, l_vertex_count, 16);
+
+    MeshOptimizer::optimize_vertex_cache(l_indices.slice, l_vertex_count);
+    float32 l_acmr_after = MeshOptimizer::compute_acmr(l_indices.slice, l_vertex_count, 16);
+    // With a 16 entries cache, the ACMR of the shuffled grid goes from about 3.0 to about 0.7
+    assert_true(l_acmr_before > 2.5f);
+    assert_true(l_acmr_after < 0.75f);
+    assert_true(l_signed_area(l_vertices.slice, l_indices.slice) == l_area_before);
+
+    uimax l_optimized_vertex_count = MeshOptimizer::optimize_vertex_fetch(l_vertices.slice, l_indices.slice);
+    assert_true(l_optimized_vertex_count == l_vertex_count);
+    assert_true(MeshOptimizer::compute_acmr(l_indices.slice, l_vertex_count, 16) == l_acmr_after);
+    assert_true(l_signed_area(l_vertices.slice, l_indices.slice) == l_area_before);
+
+    l_indices.free();
+    l_vertices.free();
+
+    // Vertices that are not indexed are removed
+    {
+        SliceN<v3f, 4> l_unused_vertices = {v3f{0.0f, 0.0f, 0.0f}, v3f{1.0f, 0.0f, 0.0f}, v3f{2.0f, 0.0f, 0.0f}, v3f{3.0f, 0.0f, 0.0f}};
+        SliceN<uint32, 3> l_unused_indices = {3, 1, 3};
+        Slice<v3f> l_unused_vertices_slice = l_unused_vertices.to_slice();
+        Slice<uint32> l_unused_indices_slice = l_unused_indices.to_slice();
+        assert_true(MeshOptimizer::optimize_vertex_fetch(l_unused_vertices_slice, l_unused_indices_slice) == 2);
+        assert_true(l_unused_indices.get(0) == 0 && l_unused_indices.get(1) == 1 && l_unused_indices.get(2) == 0);
+        assert_true(l_unused_vertices.get(0).x == 3.0f && l_unused_vertices.get(1).x == 1.0f);
+    }
+};
+
+inline void mesh_simplification()
+{
+    // A grid of quads with a height of p_amplitude * sin(x) * cos(y)
+    const uimax l_grid_size = 32;
+    auto l_allocate_grid = [&](const float32 p_amplitude, Span<Vertex>* out_vertices, Span<uint32>* out_indices) {
+        *out_vertices = Span<Vertex>::allocate((l_grid_size + 1) * (l_grid_size + 1));
+        for (loop(y, 0, l_grid_size + 1))
+        {
+            for (loop(x, 0, l_grid_size + 1))
+            {
+                out_vertices->get((y * (l_grid_size + 1)) + x) =
+                    Vertex{v3f{(float32)x, (float32)y, p_amplitude * sinf((float32)x * 0.3f) * cosf((float32)y * 0.2f)}, v2f{(float32)x / l_grid_size, (float32)y / l_grid_size}};
+            }
+        }
+        *out_indices = Span<uint32>::allocate(l_grid_size * l_grid_size * 6);
+        for (loop(y, 0, l_grid_size))
+        {
+            for (loop(x, 0, l_grid_size))
+            {
+                uint32 l_vertex = (uint32)((y * (l_grid_size + 1)) + x);
+                uint32 l_quad[6] = {l_vertex, l_vertex + 1, l_vertex + (uint32)l_grid_size + 1, l_vertex + 1, l_vertex + (uint32)l_grid_size + 2, l_vertex + (uint32)l_grid_size + 1};
+                out_indices->slice.slide_rv(((y * l_grid_size) + x) * 6).copy_memory(Slice<uint32>::build_memory_elementnb(l_quad, 6));
+            }
+        }
+    };
+    auto l_projected_area = [](const Slice<Vertex>& p_vertices, const Slice<uint32>& p_indices) {
+        float32 l_area = 0.0f;
+        for (loop(i, 0, p_indices.Size / 3))
+        {
+            v3f l_0 = p_vertices.get(p_indices.get(i * 3)).position;
+            v3f l_1 = p_vertices.get(p_indices.get((i * 3) + 1)).position;
+            v3f l_2 = p_vertices.get(p_indices.get((i * 3) + 2)).position;
+            l_area += ((l_1.x - l_0.x) * (l_2.y - l_0.y)) - ((l_2.x - l_0.x) * (l_1.y - l_0.y));
+        }
+        return l_area;
+    };
+
+    Span<Vertex> l_vertices;
+    Span<uint32> l_indices;
+
+    // A flat grid is simplified without error, border vertices are not moved so the grid still covers the same area
+    {
+        l_allocate_grid(0.0f, &l_vertices, &l_indices);
+        float32 l_area = l_projected_area(l_vertices.slice, l_indices.slice);
+        MeshSimplifier::Result l_result = MeshSimplifier::simplify(l_vertices.slice, l_indices.slice, l_indices.Capacity / 4);
+        assert_true(l_result.index_count <= (l_indices.Capacity / 4));
+        assert_true(l_result.index_count > 0);
+        assert_true(l_result.error == 0.0f);
+        assert_true(l_projected_area(l_vertices.slice, Slice<uint32>::build_memory_elementnb(l_indices.Memory, l_result.index_count)) == l_area);
+        l_vertices.free();
+        l_indices.free();
+    }
+
+    // Simplifying more introduces more error
+    {
+        l_allocate_grid(2.0f, &l_vertices, &l_indices);
+        Span<uint32> l_indices_copy = Span<uint32>::allocate_slice(l_indices.slice);
+        MeshSimplifier::Result l_half = MeshSimplifier::simplify(l_vertices.slice, l_indices.slice, l_indices.Capacity / 2);
+        MeshSimplifier::Result l_eighth = MeshSimplifier::simplify(l_vertices.slice, l_indices_copy.slice, l_indices.Capacity / 8);
+        assert_true(l_half.index_count <= (l_indices.Capacity / 2));
+        assert_true(l_eighth.index_count <= (l_indices.Capacity / 8));
+        assert_true(l_half.error > 0.0f);
+        assert_true(l_eighth.error > l_half.error);
+        l_indices_copy.free();
+
+        MeshLODCompiler::LODs l_lods = MeshLODCompiler::allocate_lods(l_vertices.slice, l_indices.slice);
+        assert_true(l_lods.count == MeshRessource_Const::MAX_LOD_COUNT);
+        for (loop(i, 1, l_lods.count))
+        {
+            assert_true(l_lods.index_counts.get(i) < l_lods.index_counts.get(i - 1));
+            assert_true(l_lods.vertex_counts.get(i) < l_lods.vertex_counts.get(i - 1));
+            assert_true(l_lods.errors.get(i) >= l_lods.errors.get(i - 1));
+        }
+        l_lods.free();
+
+        l_vertices.free();
+        l_indices.free();
+    }
+
+    // Vertices that share a position with another vertex are on an uv seam, they are never moved
+    {
+        l_allocate_grid(0.0f, &l_vertices, &l_indices);
+        l_vertices.get(((l_grid_size / 2) * (l_grid_size + 1)) + (l_grid_size / 2)).position = l_vertices.get(((l_grid_size / 2) * (l_grid_size + 1)) + (l_grid_size / 2) + 1).position;
+        uint32 l_seam_vertex = (uint32)(((l_grid_size / 2) * (l_grid_size + 1)) + (l_grid_size / 2) + 1);
+        MeshSimplifier::Result l_result = MeshSimplifier::simplify(l_vertices.slice, l_indices.slice, 0);
+        int8 l_seam_vertex_found = 0;
+        for (loop(i, 0, l_result.index_count))
+        {
+            l_seam_vertex_found |= l_indices.get(i) == l_seam_vertex;
+        }
+        assert_true(l_seam_vertex_found);
+        l_vertices.free();
+        l_indices.free();
+    }
+};
+
 inline void texture_asset_compilation(ShaderCompiler& p_shader_compiler)
 {
     String l_asset_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
@@ -173,15 +387,11 @@ inline void texture_asset_compilation(ShaderCompiler& p_shader_compiler)
         TextureRessource::Asset::Value l_texture_value = TextureRessource::Asset::Value::build_from_asset(TextureRessource::Asset{l_texture_ressource_compiled});
         assert_true(l_texture_value.size == v3ui{4, 4, 1});
         assert_true(l_texture_value.channel_nb == 4);
-        Slice<color> l_pixels = slice_cast<color>(l_texture_value.pixels);
-        assert_true(l_pixels.Size == 16);
-        Slice<color> l_awaited_pixels = SliceN<color, 16>{color{UINT8_MAX, 0, 0, UINT8_MAX}, color{0, UINT8_MAX, 0, UINT8_MAX}, color{0, 0, UINT8_MAX, UINT8_MAX}, color{0, 0, 0, UINT8_MAX},
-                                                          color{UINT8_MAX, 0, 0, UINT8_MAX}, color{0, UINT8_MAX, 0, UINT8_MAX}, color{0, 0, UINT8_MAX, UINT8_MAX}, color{0, 0, 0, UINT8_MAX},
-                                                          color{UINT8_MAX, 0, 0, UINT8_MAX}, color{0, UINT8_MAX, 0, UINT8_MAX}, color{0, 0, UINT8_MAX, UINT8_MAX}, color{0, 0, 0, UINT8_MAX},
-                                                          color{UINT8_MAX, 0, 0, UINT8_MAX}, color{0, UINT8_MAX, 0, UINT8_MAX}, color{0, 0, UINT8_MAX, UINT8_MAX}, color{0, 0, 0, UINT8_MAX}}
-                                            .to_slice();
-
-        assert_true(l_pixels.compare(l_awaited_pixels));
+        // the texture is opaque
+        assert_true(l_texture_value.format == TextureAssetFormat::BC1_SRGB);
+        assert_true(l_texture_value.mip_count == 3);
+        assert_true(l_texture_value.pixels.Size == (3 * TextureRessource::Asset::Value::get_block_size(TextureAssetFormat::BC1_SRGB)));
+        assert_true(l_texture_value.get_mip_pixels(2).Size == TextureRessource::Asset::Value::get_block_size(TextureAssetFormat::BC1_SRGB));
         l_texture_ressource_compiled.free();
     }
 
@@ -190,6 +400,207 @@ inline void texture_asset_compilation(ShaderCompiler& p_shader_compiler)
     l_asset_database_path.free();
 }
 
+inline void bcn_block_compression()
+{
+    color l_block[16];
+    for (loop(i, 0, 16))
+    {
+        l_block[i] = color{UINT8_MAX, 0, 0, UINT8_MAX};
+    }
+
+    {
+        int8 l_compressed[8];
+        BCnCompiler::encode_bc1_block(l_block, l_compressed);
+        // both endpoints are pure red in rgb565 and all indices point to the first endpoint
+        SliceN<int8, 8> l_awaited_compressed = {0x00, (int8)0xF8, 0x00, (int8)0xF8, 0, 0, 0, 0};
+        assert_true(Slice<int8>::build_memory_elementnb(l_compressed, 8).compare(l_awaited_compressed.to_slice()));
+
+        color l_decoded_block[16];
+        BCnDecoder::decode_bc1_block(l_compressed, l_decoded_block);
+        assert_true(Slice<color>::build_memory_elementnb(l_decoded_block, 16).compare(Slice<color>::build_memory_elementnb(l_block, 16)));
+    }
+    {
+        int8 l_compressed[16];
+        BCnCompiler::encode_bc7_block(l_block, l_compressed);
+        // mode 6
+        assert_true((l_compressed[0] & 0x7F) == 0x40);
+
+        // endpoints are quantized to 7 bits plus a shared bit
+        color l_decoded_block[16];
+        BCnDecoder::decode_bc7_block(l_compressed, l_decoded_block);
+        for (loop(i, 0, 16))
+        {
+            for (loop(c, 0, 4))
+            {
+                int32 l_delta = (int32)l_decoded_block[i].Points[c] - (int32)l_block[i].Points[c];
+                assert_true(l_delta >= -1 && l_delta <= 1);
+            }
+        }
+    }
+    {
+        int8 l_compressed[16];
+        BCnCompiler::encode_bc3_block(l_block, l_compressed);
+        // both alpha endpoints are opaque
+        assert_true((uint8)l_compressed[0] == UINT8_MAX);
+        assert_true((uint8)l_compressed[1] == UINT8_MAX);
+
+        color l_decoded_block[16];
+        BCnDecoder::decode_bc3_block(l_compressed, l_decoded_block);
+        assert_true(Slice<color>::build_memory_elementnb(l_decoded_block, 16).compare(Slice<color>::build_memory_elementnb(l_block, 16)));
+    }
+};
+
+inline void multiple_files_compilation(ShaderCompiler& p_shader_compiler)
+{
+    String l_asset_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_asset_database_path.to_slice());
+
+    Span<int8> l_asset_root_path = Span<int8>::allocate_slice(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+
+    SliceN<Slice<int8>, 3> l_relative_asset_paths = {slice_int8_build_rawstr("shad.frag"), slice_int8_build_rawstr("texture.png"), slice_int8_build_rawstr("material_asset_test.json")};
+    AssetCompiler_compile_and_push_to_database_multiple_files(p_shader_compiler, l_asset_database, l_asset_root_path.slice, l_relative_asset_paths.to_slice());
+
+    assert_true(l_asset_database.write_session_depth == 0);
+    for (loop(i, 0, l_relative_asset_paths.Size()))
+    {
+        assert_true(l_asset_database.does_asset_exists(HashSlice(l_relative_asset_paths.get(i))));
+    }
+    Span<int8> l_material_dependencies = l_asset_database.get_asset_dependencies_blob(HashSlice(slice_int8_build_rawstr("material_asset_test.json")));
+    assert_true(l_material_dependencies.Capacity != 0);
+    l_material_dependencies.free();
+
+    l_asset_root_path.free();
+    l_asset_database.free();
+    l_asset_database_path.free();
+};
+
+/*
+    Files are compiled a second time only if their source hash has changed.
+*/
+inline void incremental_compilation()
+{
+    String l_asset_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_asset_database_path.to_slice());
+    JobSystem l_job_system = JobSystem::allocate(4);
+    AssetDatabaseReaderPool l_asset_database_readers = AssetDatabaseReaderPool::allocate(l_asset_database_path.to_slice(), l_job_system.get_thread_count());
+
+    Span<int8> l_asset_root_path = Span<int8>::allocate_slice(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+
+    SliceN<Slice<int8>, 3> l_relative_asset_paths = {slice_int8_build_rawstr("shad.frag"), slice_int8_build_rawstr("texture.png"), slice_int8_build_rawstr("material_asset_test.json")};
+    assert_true(AssetCompiler_compile_and_push_to_database_incremental(l_job_system, l_asset_database, l_asset_database_readers, l_asset_root_path.slice, l_relative_asset_paths.to_slice()) == 3);
+    for (loop(i, 0, l_relative_asset_paths.Size()))
+    {
+        assert_true(l_asset_database.does_asset_exists(HashSlice(l_relative_asset_paths.get(i))));
+        hash_t l_source_hash;
+        assert_true(l_asset_database.get_asset_source_hash(HashSlice(l_relative_asset_paths.get(i)), &l_source_hash));
+        assert_true(l_source_hash == AssetCompiler_hash_source_file(l_asset_root_path.slice, l_relative_asset_paths.get(i)));
+    }
+
+    assert_true(AssetCompiler_compile_and_push_to_database_incremental(l_job_system, l_asset_database, l_asset_database_readers, l_asset_root_path.slice, l_relative_asset_paths.to_slice()) == 0);
+
+    // the source of the texture has changed
+    l_asset_database.insert_or_update_asset_source_hash(slice_int8_build_rawstr("texture.png"), 0);
+    assert_true(AssetCompiler_compile_and_push_to_database_incremental(l_job_system, l_asset_database, l_asset_database_readers, l_asset_root_path.slice, l_relative_asset_paths.to_slice()) == 1);
+
+    l_asset_root_path.free();
+    l_asset_database_readers.free();
+    l_job_system.free();
+    l_asset_database.free();
+    l_asset_database_path.free();
+};
+
+/*
+    The obj is pushed by chunks of every size to check that lines spanning multiple chunks are read as a whole.
+*/
+inline void obj_compilation()
+{
+    const int8* l_obj = "# quad and triangle sharing an edge\r\n"
+                        "v -1.0 0.0 1e-1\r\n"
+                        "v 1.0 0.0 0.1\n"
+                        "v\t1.0 2.5 +0.1\n"
+                        "v -1.0 2.5 0.1\n"
+                        "vt 0.0 0.0\n"
+                        "vt 1.0 0.0\n"
+                        "vt 1.0 1.0\n"
+                        "vn 0.0 0.0 1.0\n"
+                        "vn 0.0 0.0 -1.0\n"
+                        "f 1/1/1 2/2/1 3/3/1 4/3/1\n"
+                        "f -4/1/2 -2/3/2 -1/3/1";
+
+    // The first corner of the second face only differs from the vertex 0 by it's normal
+    Vertex l_vertices[6] = {Vertex{v3f{-1.0f, 0.0f, 0.1f}, v2f{0.0f, 1.0f}}, Vertex{v3f{1.0f, 0.0f, 0.1f}, v2f{1.0f, 1.0f}},  Vertex{v3f{1.0f, 2.5f, 0.1f}, v2f{1.0f, 0.0f}},
+                            Vertex{v3f{-1.0f, 2.5f, 0.1f}, v2f{1.0f, 0.0f}}, Vertex{v3f{-1.0f, 0.0f, 0.1f}, v2f{0.0f, 1.0f}}, Vertex{v3f{1.0f, 2.5f, 0.1f}, v2f{1.0f, 0.0f}}};
+    v3f l_normals[6] = {v3f{0.0f, 0.0f, 1.0f}, v3f{0.0f, 0.0f, 1.0f}, v3f{0.0f, 0.0f, 1.0f}, v3f{0.0f, 0.0f, 1.0f}, v3f{0.0f, 0.0f, -1.0f}, v3f{0.0f, 0.0f, -1.0f}};
+    uint32 l_indices[9] = {0, 1, 2, 0, 2, 3, 4, 5, 3};
+    uint32 l_indices_without_normals[9] = {0, 1, 2, 0, 2, 3, 0, 2, 3};
+
+    Slice<int8> l_obj_slice = slice_int8_build_rawstr(l_obj);
+    for (loop(l_chunk_size, 1, l_obj_slice.Size + 1))
+    {
+        Vector<Vertex> l_read_vertices = Vector<Vertex>::allocate(0);
+        Vector<uint32> l_read_indices = Vector<uint32>::allocate(0);
+        Vector<v3f> l_read_normals = Vector<v3f>::allocate(0);
+
+        ObjCompiler::Reader l_reader = ObjCompiler::Reader::allocate(&l_read_vertices, &l_read_indices, &l_read_normals);
+        for (uimax l_offset = 0; l_offset < l_obj_slice.Size; l_offset += l_chunk_size)
+        {
+            uimax l_end = l_offset + l_chunk_size;
+            if (l_end > l_obj_slice.Size)
+            {
+                l_end = l_obj_slice.Size;
+            }
+            l_reader.push_chunk(Slice<int8>::build_begin_end(l_obj_slice.Begin, l_offset, l_end));
+        }
+        l_reader.end();
+        l_reader.free();
+
+        assert_true(l_read_vertices.to_slice().compare(Slice<Vertex>::build_memory_elementnb(l_vertices, 6)));
+        assert_true(l_read_normals.to_slice().compare(Slice<v3f>::build_memory_elementnb(l_normals, 6)));
+        assert_true(l_read_indices.to_slice().compare(Slice<uint32>::build_memory_elementnb(l_indices, 9)));
+
+        l_read_vertices.free();
+        l_read_indices.free();
+        l_read_normals.free();
+    }
+
+    {
+        Vector<Vertex> l_read_vertices = Vector<Vertex>::allocate(0);
+        Vector<uint32> l_read_indices = Vector<uint32>::allocate(0);
+        ObjCompiler::ReadObj(l_obj_slice, l_read_vertices, l_read_indices);
+
+        // Without normals, corners are only deduplicated by position and uv
+        assert_true(l_read_vertices.to_slice().compare(Slice<Vertex>::build_memory_elementnb(l_vertices, 4)));
+        assert_true(l_read_indices.to_slice().compare(Slice<uint32>::build_memory_elementnb(l_indices_without_normals, 9)));
+
+        l_read_vertices.free();
+        l_read_indices.free();
+    }
+
+    // Faces with a missing position, a zero index or an index past the attributes already read are skipped
+    {
+        const int8* l_malformed_obj = "v 0.0 0.0 0.0\n"
+                                      "v 1.0 0.0 0.0\n"
+                                      "v 0.0 1.0 0.0\n"
+                                      "f 1 2 3\n"
+                                      "f 1 /1 3\n"
+                                      "f 0 1 2\n"
+                                      "f 1 2 4\n"
+                                      "f -4 1 2\n"
+                                      "f 1/2 2 3\n";
+
+        Vector<Vertex> l_read_vertices = Vector<Vertex>::allocate(0);
+        Vector<uint32> l_read_indices = Vector<uint32>::allocate(0);
+        ObjCompiler::ReadObj(slice_int8_build_rawstr(l_malformed_obj), l_read_vertices, l_read_indices);
+
+        uint32 l_malformed_indices[3] = {0, 1, 2};
+        assert_true(l_read_vertices.Size == 3);
+        assert_true(l_read_indices.to_slice().compare(Slice<uint32>::build_memory_elementnb(l_malformed_indices, 3)));
+
+        l_read_vertices.free();
+        l_read_indices.free();
+    }
+};
+
 int main()
 {
     ShaderCompiler l_shader_compiler = ShaderCompiler::allocate();
@@ -198,7 +609,13 @@ int main()
     shader_asset_compilation(l_shader_compiler);
     material_asset_compilation(l_shader_compiler);
     mesh_asset_compilation(l_shader_compiler);
+    obj_compilation();
+    mesh_optimization();
+    mesh_simplification();
     texture_asset_compilation(l_shader_compiler);
+    bcn_block_compression();
+    multiple_files_compilation(l_shader_compiler);
+    incremental_compilation();
     
     l_shader_compiler.free();
 
@@ -7,6 +7,7 @@ namespace AssetDatabase_Const
 
 static const int8* DB_ASSET_TABLE_INITIALIZATION = MULTILINE(create table if not exists asset(id integer PRIMARY KEY, path text, value blob););
 static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create table if not exists asset_dependencies(id integer PRIMARY KEY, dependencies blob););
+static const int8* DB_ASSET_SOURCE_HASH_TABLE_INITIALIZATION = MULTILINE(create table if not exists asset_source_hash(id integer PRIMARY KEY, hash integer););
 
     static const int8* ASSET_BLOB_SELECT_QUERY = MULTILINE(
 			select value from asset where asset.id = ?;
@@ -32,8 +33,245 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
         insert into asset_dependencies(id, dependencies) values( ?, ?);
     );
 
+    static const int8* ASSET_DEPENDENCIES_BLOB_INSERT_OR_REPLACE_QUERY = MULTILINE(
+        insert or replace into asset_dependencies(id, dependencies) values( ?, ?);
+    );
+
+    static const int8* ASSET_SOURCE_HASH_SELECT_QUERY = MULTILINE(
+        select hash from asset_source_hash where asset_source_hash.id = ?;
+    );
+
+    static const int8* ASSET_SOURCE_HASH_INSERT_OR_REPLACE_QUERY = MULTILINE(
+        insert or replace into asset_source_hash(id, hash) values( ?, ?);
+    );
+
+    // The id parameters of the batch query are appended when the query is prepared. Dependencies are joined, the third column tells if the asset has some.
+    static const int8* ASSET_BLOB_BATCH_SELECT_QUERY_BEGIN = "select asset.id, asset.value, asset_dependencies.id is not null, asset_dependencies.dependencies from asset "
+                                                             "left join asset_dependencies on asset_dependencies.id = asset.id where asset.id in (";
+    static const int8* ASSET_BLOB_BATCH_SELECT_QUERY_END = ") order by asset.id;";
+    static const uimax ASSET_BLOB_BATCH_SIZE = 64;
+    // Blobs of a batch are aligned like heap allocated blobs, so that values can be read from them in place
+    static const uimax ASSET_BLOB_BATCH_ALIGNMENT = 16;
+
+    static const uimax CACHE_SIZE_KIB = 64 * 1024;
+    static const uimax MMAP_SIZE = 256 * 1024 * 1024;
+    static const int32 BUSY_TIMEOUT_MS = 5000;
+
+    static const int8* TRANSACTION_BEGIN_QUERY = MULTILINE(begin immediate;);
+    static const int8* TRANSACTION_COMMIT_QUERY = MULTILINE(commit;);
+    // Long write sessions are split in multiple transactions so that the WAL can be checkpointed
+    static const uimax WRITE_SESSION_MAX_WRITE_COUNT = 1024;
+
+    static const int8* ASSET_SIZE_SELECT_ALL_QUERY = MULTILINE(
+        select id, length(value) from asset order by id;
+    );
+
+    static const int8* ASSET_BLOB_SELECT_ALL_QUERY = MULTILINE(
+        select id, value from asset order by id;
+    );
+
+    static const int8* ASSET_DEPENDENCIES_SIZE_SELECT_ALL_QUERY = MULTILINE(
+        select id, length(dependencies) from asset_dependencies order by id;
+    );
+
+    static const int8* ASSET_DEPENDENCIES_BLOB_SELECT_ALL_QUERY = MULTILINE(
+        select id, dependencies from asset_dependencies order by id;
+    );
+
+    /*
+        Version of the database layout, stored in the user_version of the database.
+        Version 0 databases have been written before asset blobs had an AssetBlobHeader, their blobs are raw.
+    */
+    static const int64 SCHEMA_VERSION = 1;
+    static const int8* SCHEMA_VERSION_SELECT_QUERY = MULTILINE(pragma user_version;);
+
     } // namespace AssetDatabase_Const
 
+enum class AssetBlobCompression : int8
+{
+    NONE = 0,
+    LZ4 = 1
+};
+
+/*
+    Asset blobs are stored in the database after an AssetBlobHeader, compressed with the compression of the header.
+    Blobs that are not made smaller by their compression are stored uncompressed.
+*/
+struct AssetBlobHeader
+{
+    uint64 size;
+    AssetBlobCompression compression;
+
+    inline static Vector<int8> allocate_encoded_blob(const Slice<int8>& p_blob, const AssetBlobCompression p_compression)
+    {
+        uimax l_max_payload_size = p_compression == AssetBlobCompression::LZ4 ? LZ4::get_max_compressed_size(p_blob.Size) : p_blob.Size;
+        Vector<int8> l_encoded_blob = Vector<int8>::allocate(sizeof(AssetBlobHeader) + l_max_payload_size);
+
+        AssetBlobHeader l_header;
+        memory_zero((int8*)&l_header, sizeof(AssetBlobHeader));
+        l_header.size = p_blob.Size;
+        l_header.compression = AssetBlobCompression::NONE;
+        l_encoded_blob.push_back_array(Slice<AssetBlobHeader>::build_asint8_memory_singleelement(&l_header));
+
+        if (p_compression == AssetBlobCompression::LZ4)
+        {
+            Slice<int8> l_payload = Slice<int8>::build_memory_elementnb(l_encoded_blob.Memory.Memory + sizeof(AssetBlobHeader), l_max_payload_size);
+            uimax l_compressed_size = LZ4::compress(p_blob, l_payload);
+            if (l_compressed_size < p_blob.Size)
+            {
+                ((AssetBlobHeader*)l_encoded_blob.Memory.Memory)->compression = AssetBlobCompression::LZ4;
+                l_encoded_blob.push_back_array_empty(l_compressed_size);
+                return l_encoded_blob;
+            }
+        }
+
+        l_encoded_blob.push_back_array(p_blob);
+        return l_encoded_blob;
+    };
+
+    inline static AssetBlobHeader read(const Slice<int8>& p_encoded_blob)
+    {
+#if DATABASE_BOUND_TEST
+        assert_true(p_encoded_blob.Size >= sizeof(AssetBlobHeader));
+#endif
+        AssetBlobHeader l_header;
+        memory_cpy((int8*)&l_header, p_encoded_blob.Begin, sizeof(AssetBlobHeader));
+        return l_header;
+    };
+
+    // out_blob must be exactly the uncompressed size stored in the header of p_encoded_blob (AssetBlobHeader::read(p_encoded_blob).size)
+    inline static void decode(const Slice<int8>& p_encoded_blob, const Slice<int8>& out_blob)
+    {
+        AssetBlobHeader l_header = read(p_encoded_blob);
+        Slice<int8> l_payload = p_encoded_blob;
+        l_payload.slide(sizeof(AssetBlobHeader));
+#if DATABASE_BOUND_TEST
+        assert_true(out_blob.Size == (uimax)l_header.size);
+#endif
+        switch (l_header.compression)
+        {
+        case AssetBlobCompression::NONE:
+#if DATABASE_BOUND_TEST
+            assert_true(l_payload.Size == out_blob.Size);
+#endif
+            memory_cpy(out_blob.Begin, l_payload.Begin, out_blob.Size);
+            break;
+        case AssetBlobCompression::LZ4:
+#if DATABASE_BOUND_TEST
+            assert_true(
+#endif
+                LZ4::decompress(l_payload, out_blob)
+#if DATABASE_BOUND_TEST
+            )
+#endif
+                ;
+            break;
+        default:
+            abort();
+        }
+    };
+};
+
+/*
+    Location of an asset blob in a memory that contains the blobs of multiple assets.
+    Entries are sorted by id, in the order of the database primary key (signed integer).
+*/
+struct AssetBlobEntry
+{
+    hash_t id;
+    uint64 offset;
+    uint64 size;
+
+    inline static AssetBlobEntry* find(const Slice<AssetBlobEntry>& p_entries, const hash_t p_asset_id)
+    {
+        int64 l_asset_id = (int64)p_asset_id;
+        uimax l_begin = 0;
+        uimax l_end = p_entries.Size;
+        while (l_begin < l_end)
+        {
+            uimax l_middle = l_begin + ((l_end - l_begin) / 2);
+            int64 l_middle_id = (int64)p_entries.get(l_middle).id;
+            if (l_middle_id < l_asset_id)
+            {
+                l_begin = l_middle + 1;
+            }
+            else if (l_middle_id > l_asset_id)
+            {
+                l_end = l_middle;
+            }
+            else
+            {
+                return &p_entries.get(l_middle);
+            }
+        }
+        return NULL;
+    };
+};
+
+/*
+    Blobs and dependencies blobs of multiple assets read with AssetDatabase::get_asset_blobs. All blobs are stored contiguously in the same memory.
+    Blobs returned by get_asset_blob and get_asset_dependencies_blob point to the batch memory, they are valid until the AssetBlobBatch is freed.
+*/
+struct AssetBlobBatch
+{
+    Vector<int8> memory;
+    Vector<AssetBlobEntry> entries;
+    // Only assets that have dependencies have an entry
+    Vector<AssetBlobEntry> dependencies_entries;
+
+    inline static AssetBlobBatch allocate_default()
+    {
+        return AssetBlobBatch{Vector<int8>::allocate(0), Vector<AssetBlobEntry>::allocate(0), Vector<AssetBlobEntry>::allocate(0)};
+    };
+
+    inline void free()
+    {
+        this->dependencies_entries.free();
+        this->entries.free();
+        this->memory.free();
+    };
+
+    inline int8 does_asset_exists(const hash_t p_asset_id)
+    {
+        return AssetBlobEntry::find(this->entries.to_slice(), p_asset_id) != NULL;
+    };
+
+    inline Span<int8> get_asset_blob(const hash_t p_asset_id)
+    {
+        return this->get_entry_blob(AssetBlobEntry::find(this->entries.to_slice(), p_asset_id));
+    };
+
+    inline Span<int8> get_asset_dependencies_blob(const hash_t p_asset_id)
+    {
+        return this->get_entry_blob(AssetBlobEntry::find(this->dependencies_entries.to_slice(), p_asset_id));
+    };
+
+    // Blobs are owned by the batch, nothing is freed
+    inline void release_asset_blob(Span<int8>& p_blob)
+    {
+        p_blob = Span<int8>::build_default();
+    };
+
+    // Pushes an aligned blob of p_size bytes at the end of the batch memory and returns it's entry
+    inline AssetBlobEntry push_blob_empty(const hash_t p_asset_id, const uimax p_size)
+    {
+        uimax l_alignment = AssetDatabase_Const::ASSET_BLOB_BATCH_ALIGNMENT;
+        this->memory.push_back_array_empty(((this->memory.Size + l_alignment - 1) & ~(l_alignment - 1)) - this->memory.Size);
+        AssetBlobEntry l_entry = AssetBlobEntry{p_asset_id, (uint64)this->memory.Size, (uint64)p_size};
+        this->memory.push_back_array_empty(p_size);
+        return l_entry;
+    };
+
+  private:
+    inline Span<int8> get_entry_blob(const AssetBlobEntry* p_entry)
+    {
+#if DATABASE_BOUND_TEST
+        assert_true(p_entry != NULL);
+#endif
+        return Span<int8>::build(this->memory.Memory.Memory + p_entry->offset, (uimax)p_entry->size);
+    };
+};
+
     /*
         All queries are sync for now
      */
@@ -45,9 +283,22 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
         SQLitePreparedQuery asset_blob_select_query;
         SQLitePreparedQuery asset_insert_query;
         SQLitePreparedQuery asset_update_query;
+        SQLitePreparedQuery asset_blob_batch_select_query;
 
         SQLitePreparedQuery asset_dependencies_blob_select_query;
         SQLitePreparedQuery asset_dependencies_insert_query;
+        SQLitePreparedQuery asset_dependencies_insert_or_replace_query;
+
+        SQLitePreparedQuery asset_source_hash_select_query;
+        SQLitePreparedQuery asset_source_hash_insert_or_replace_query;
+
+        SQLitePreparedQuery transaction_begin_query;
+        SQLitePreparedQuery transaction_commit_query;
+        uimax write_session_depth;
+        uimax write_session_write_count;
+
+        // Compression of the asset blobs written by insert_asset_blob and insert_or_update_asset_blob
+        AssetBlobCompression blob_compression;
 
         inline static void initialize_database(const Slice<int8>& p_database_file_path)
         {
@@ -62,13 +313,76 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
                 SQliteQueryExecution::execute_sync(l_connection, l_query.statement, []() {});
                 l_query.free(l_connection);
             }
+            {
+                SQLiteQuery l_query = SQLiteQuery::allocate(l_connection, slice_int8_build_rawstr(AssetDatabase_Const::DB_ASSET_SOURCE_HASH_TABLE_INITIALIZATION));
+                SQliteQueryExecution::execute_sync(l_connection, l_query.statement, []() {});
+                l_query.free(l_connection);
+            }
+            int64 l_schema_version = get_schema_version(l_connection);
             l_connection.free();
+
+            if (l_schema_version == 0)
+            {
+                AssetDatabase l_asset_database = allocate_with_profile_unchecked(p_database_file_path, build_profile(DatabaseSynchronous::FULL));
+                l_asset_database.migrate_from_raw_blobs();
+                l_asset_database.free();
+            }
+        };
+
+        /*
+            The database is in WAL mode so that readers are not blocked while assets are written.
+            With DatabaseSynchronous::FULL, every commit is synced to the disk. DatabaseSynchronous::NORMAL only syncs on checkpoints, it is faster to write
+            but the database may lose it's last commits (it is not corrupted) on power loss. It is opt-in, for databases that can be compiled again from the asset sources.
+        */
+        inline static DatabaseConnectionProfile build_profile(const DatabaseSynchronous p_synchronous)
+        {
+            DatabaseConnectionProfile l_profile = DatabaseConnectionProfile::build_default();
+            l_profile.wal = 1;
+            l_profile.synchronous = p_synchronous;
+            l_profile.cache_size_kib = AssetDatabase_Const::CACHE_SIZE_KIB;
+            l_profile.mmap_size = AssetDatabase_Const::MMAP_SIZE;
+            l_profile.busy_timeout_ms = AssetDatabase_Const::BUSY_TIMEOUT_MS;
+            return l_profile;
+        };
+
+        inline static DatabaseConnectionProfile build_reader_profile()
+        {
+            DatabaseConnectionProfile l_profile = build_profile(DatabaseSynchronous::FULL);
+            l_profile.query_only = 1;
+            return l_profile;
         };
 
         inline static AssetDatabase allocate(const Slice<int8>& p_database_file_path)
+        {
+            return allocate_with_profile(p_database_file_path, build_profile(DatabaseSynchronous::FULL));
+        };
+
+        // A reader can read assets while another AssetDatabase is writing them, it can't write assets itself
+        inline static AssetDatabase allocate_reader(const Slice<int8>& p_database_file_path)
+        {
+            return allocate_with_profile(p_database_file_path, build_reader_profile());
+        };
+
+        /*
+            Databases must be at the AssetDatabase_Const::SCHEMA_VERSION, older databases are rejected. They are migrated by initialize_database.
+        */
+        inline static AssetDatabase allocate_with_profile(const Slice<int8>& p_database_file_path, const DatabaseConnectionProfile& p_profile)
+        {
+            AssetDatabase l_asset_database = allocate_with_profile_unchecked(p_database_file_path, p_profile);
+            int64 l_schema_version = get_schema_version(l_asset_database.connection);
+            if (l_schema_version != AssetDatabase_Const::SCHEMA_VERSION)
+            {
+                printf("AssetDatabase : the database has the schema version %lld instead of %lld, it must be migrated with AssetDatabase::initialize_database.\n", (long long)l_schema_version,
+                       (long long)AssetDatabase_Const::SCHEMA_VERSION);
+                abort();
+            }
+            return l_asset_database;
+        };
+
+        inline static AssetDatabase allocate_with_profile_unchecked(const Slice<int8>& p_database_file_path, const DatabaseConnectionProfile& p_profile)
         {
             AssetDatabase l_asset_database;
-            l_asset_database.connection = DatabaseConnection::allocate(p_database_file_path);
+            l_asset_database.connection = DatabaseConnection::allocate_with_profile(p_database_file_path, p_profile);
             l_asset_database.asset_count_query = SQLitePreparedQuery::allocate(
                 l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_COUNT_SELECT_QUERY),
                 SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(SliceN<SQLiteQueryPrimitiveTypes, 1>{SQLiteQueryPrimitiveTypes::INT64}.to_slice())),
@@ -85,6 +399,23 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
                                                                                 SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(
                                                                                     SliceN<SQLiteQueryPrimitiveTypes, 2>{SQLiteQueryPrimitiveTypes::BLOB, SQLiteQueryPrimitiveTypes::INT64}.to_slice())),
                                                                                 SQLiteQueryLayout::build_default());
+            {
+                String l_batch_query = String::allocate_elements(slice_int8_build_rawstr(AssetDatabase_Const::ASSET_BLOB_BATCH_SELECT_QUERY_BEGIN));
+                Span<SQLiteQueryPrimitiveTypes> l_batch_parameters = Span<SQLiteQueryPrimitiveTypes>::allocate(AssetDatabase_Const::ASSET_BLOB_BATCH_SIZE);
+                for (loop(i, 0, AssetDatabase_Const::ASSET_BLOB_BATCH_SIZE))
+                {
+                    l_batch_query.append(i == 0 ? slice_int8_build_rawstr("?") : slice_int8_build_rawstr(", ?"));
+                    l_batch_parameters.get(i) = SQLiteQueryPrimitiveTypes::INT64;
+                }
+                l_batch_query.append(slice_int8_build_rawstr(AssetDatabase_Const::ASSET_BLOB_BATCH_SELECT_QUERY_END));
+                l_asset_database.asset_blob_batch_select_query = SQLitePreparedQuery::allocate(
+                    l_asset_database.connection, l_batch_query.to_slice(), SQLiteQueryLayout::allocate_span(l_batch_parameters),
+                    SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(
+                        SliceN<SQLiteQueryPrimitiveTypes, 4>{SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::BLOB, SQLiteQueryPrimitiveTypes::INT64,
+                                                             SQLiteQueryPrimitiveTypes::BLOB}
+                            .to_slice())));
+                l_batch_query.free();
+            }
 
             l_asset_database.asset_dependencies_blob_select_query = SQLitePreparedQuery::allocate(
                 l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_DEPENDENCIES_BLOB_SELECT_QUERY),
@@ -96,18 +427,50 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
                                               SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(
                                                   SliceN<SQLiteQueryPrimitiveTypes, 2>{SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::BLOB}.to_slice())),
                                               SQLiteQueryLayout::build_default());
+            l_asset_database.asset_dependencies_insert_or_replace_query =
+                SQLitePreparedQuery::allocate(l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_DEPENDENCIES_BLOB_INSERT_OR_REPLACE_QUERY),
+                                              SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(
+                                                  SliceN<SQLiteQueryPrimitiveTypes, 2>{SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::BLOB}.to_slice())),
+                                              SQLiteQueryLayout::build_default());
+
+            l_asset_database.asset_source_hash_select_query = SQLitePreparedQuery::allocate(
+                l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_SOURCE_HASH_SELECT_QUERY),
+                SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(SliceN<SQLiteQueryPrimitiveTypes, 1>{SQLiteQueryPrimitiveTypes::INT64}.to_slice())),
+                SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(SliceN<SQLiteQueryPrimitiveTypes, 1>{SQLiteQueryPrimitiveTypes::INT64}.to_slice())));
+            l_asset_database.asset_source_hash_insert_or_replace_query =
+                SQLitePreparedQuery::allocate(l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_SOURCE_HASH_INSERT_OR_REPLACE_QUERY),
+                                              SQLiteQueryLayout::allocate_span(Span<SQLiteQueryPrimitiveTypes>::allocate_slice(
+                                                  SliceN<SQLiteQueryPrimitiveTypes, 2>{SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::INT64}.to_slice())),
+                                              SQLiteQueryLayout::build_default());
+
+            l_asset_database.transaction_begin_query = SQLitePreparedQuery::allocate(l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::TRANSACTION_BEGIN_QUERY),
+                                                                                     SQLiteQueryLayout::build_default(), SQLiteQueryLayout::build_default());
+            l_asset_database.transaction_commit_query = SQLitePreparedQuery::allocate(l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::TRANSACTION_COMMIT_QUERY),
+                                                                                      SQLiteQueryLayout::build_default(), SQLiteQueryLayout::build_default());
+            l_asset_database.write_session_depth = 0;
+            l_asset_database.write_session_write_count = 0;
+            l_asset_database.blob_compression = AssetBlobCompression::LZ4;
 
             return l_asset_database;
         };
 
         inline void free()
         {
+#if CONTAINER_BOUND_TEST
+            assert_true(this->write_session_depth == 0);
+#endif
+            this->transaction_commit_query.free(this->connection);
+            this->transaction_begin_query.free(this->connection);
             this->asset_count_query.free_with_parameterlayout_and_returnlayout(this->connection);
             this->asset_update_query.free_with_parameterlayout(this->connection);
             this->asset_insert_query.free_with_parameterlayout(this->connection);
             this->asset_blob_select_query.free_with_parameterlayout_and_returnlayout(this->connection);
+            this->asset_blob_batch_select_query.free_with_parameterlayout_and_returnlayout(this->connection);
             this->asset_dependencies_blob_select_query.free_with_parameterlayout_and_returnlayout(this->connection);
             this->asset_dependencies_insert_query.free_with_parameterlayout(this->connection);
+            this->asset_dependencies_insert_or_replace_query.free_with_parameterlayout(this->connection);
+            this->asset_source_hash_select_query.free_with_parameterlayout_and_returnlayout(this->connection);
+            this->asset_source_hash_insert_or_replace_query.free_with_parameterlayout(this->connection);
             this->connection.free();
         };
 
@@ -124,46 +487,176 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
         };
 
         inline Span<int8> get_asset_blob(const hash_t p_asset_id)
+        {
+            Span<int8> l_asset_blob = Span<int8>::build_default();
+#if DATABASE_BOUND_TEST
+            assert_true(
+#endif
+                this->read_asset_blob(p_asset_id, [&l_asset_blob](const uimax p_blob_size) {
+                    l_asset_blob = Span<int8>::allocate(p_blob_size);
+                    return l_asset_blob.slice;
+                })
+#if DATABASE_BOUND_TEST
+            )
+#endif
+                ;
+            return l_asset_blob;
+        };
+
+        /*
+            Decompresses the blob of p_asset_id directly from the database memory to the destination returned by p_allocate_blob(uimax blob_size) -> Slice<int8>.
+            The destination can be any memory, like a mapped staging buffer. Returns 0 if the asset doesn't exist, p_allocate_blob is not called.
+        */
+        template <class AllocateBlob_t> inline int8 read_asset_blob(const hash_t p_asset_id, const AllocateBlob_t& p_allocate_blob)
         {
             SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
             l_binder.bind_sqlitepreparedquery(this->asset_blob_select_query, this->connection);
             l_binder.bind_int64(p_asset_id, this->connection);
 
-            Span<int8> l_asset_blob = Span<int8>::build_default();
+            int8 l_found = 0;
             SQLiteResultSet l_asset_rs = SQLiteResultSet::build_from_prepared_query(this->asset_blob_select_query);
-            SQliteQueryExecution::execute_sync(this->connection, this->asset_blob_select_query.statement, [&l_asset_rs, &l_asset_blob]() { l_asset_blob = l_asset_rs.get_blob(0); });
+            SQliteQueryExecution::execute_sync(this->connection, this->asset_blob_select_query.statement, [&l_asset_rs, &l_found, &p_allocate_blob]() {
+                Slice<int8> l_encoded_blob = l_asset_rs.get_blob_slice(0);
+                AssetBlobHeader::decode(l_encoded_blob, p_allocate_blob((uimax)AssetBlobHeader::read(l_encoded_blob).size));
+                l_found = 1;
+            });
 
-            return l_asset_blob;
+            return l_found;
+        };
+
+        /*
+            Reads the blobs of all p_asset_ids with one query per AssetDatabase_Const::ASSET_BLOB_BATCH_SIZE ids, instead of one query per id.
+            Dependencies blobs are read by the same queries. Every id must be in the database.
+        */
+        inline AssetBlobBatch get_asset_blobs(const Slice<hash_t>& p_asset_ids)
+        {
+            AssetBlobBatch l_batch = AssetBlobBatch::allocate_default();
+            if (p_asset_ids.Size == 0)
+            {
+                return l_batch;
+            }
+
+            // Ids are sorted so that the rows of every query follow the rows of the previous one.
+            // The sign bit is flipped to sort in the int64 order of the database keys.
+            Span<hash_t> l_asset_ids = Span<hash_t>::allocate_slice(p_asset_ids);
+            Sort::Radix(l_asset_ids.slice, [](const hash_t p_id) { return (uint64)p_id ^ ((uint64)1 << 63); });
+
+            SQLiteResultSet l_asset_rs = SQLiteResultSet::build_from_prepared_query(this->asset_blob_batch_select_query);
+            for (uimax l_begin = 0; l_begin < l_asset_ids.Capacity; l_begin += AssetDatabase_Const::ASSET_BLOB_BATCH_SIZE)
+            {
+                SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
+                l_binder.bind_sqlitepreparedquery(this->asset_blob_batch_select_query, this->connection);
+                for (loop(i, 0, AssetDatabase_Const::ASSET_BLOB_BATCH_SIZE))
+                {
+                    // The last query repeats it's last id to fill it's parameters
+                    uimax l_index = l_begin + i;
+                    l_binder.bind_int64(l_asset_ids.get(l_index < l_asset_ids.Capacity ? l_index : l_asset_ids.Capacity - 1), this->connection);
+                }
+
+                SQliteQueryExecution::execute_sync(this->connection, this->asset_blob_batch_select_query.statement, [&l_asset_rs, &l_batch]() {
+                    hash_t l_id = (hash_t)l_asset_rs.get_int64(0);
+                    // The same id can be at the end of a query and the beginning of the next one if it has been requested multiple times
+                    if (l_batch.entries.Size == 0 || l_batch.entries.get(l_batch.entries.Size - 1).id != l_id)
+                    {
+                        // Blobs are decompressed in the batch memory
+                        Slice<int8> l_encoded_blob = l_asset_rs.get_blob_slice(1);
+                        AssetBlobEntry l_entry = l_batch.push_blob_empty(l_id, (uimax)AssetBlobHeader::read(l_encoded_blob).size);
+                        l_batch.entries.push_back_element(l_entry);
+                        AssetBlobHeader::decode(l_encoded_blob, Slice<int8>::build_memory_elementnb(l_batch.memory.Memory.Memory + l_entry.offset, (uimax)l_entry.size));
+
+                        if (l_asset_rs.get_int64(2))
+                        {
+                            Slice<int8> l_dependencies_blob = l_asset_rs.get_blob_slice(3);
+                            AssetBlobEntry l_dependencies_entry = l_batch.push_blob_empty(l_id, l_dependencies_blob.Size);
+                            l_batch.dependencies_entries.push_back_element(l_dependencies_entry);
+                            memory_cpy(l_batch.memory.Memory.Memory + l_dependencies_entry.offset, l_dependencies_blob.Begin, l_dependencies_blob.Size);
+                        }
+                    }
+                });
+            }
+
+#if DATABASE_BOUND_TEST
+            // Ids are sorted, every distinct id must have been read
+            uimax l_distinct_id_count = 0;
+            for (loop(i, 0, l_asset_ids.Capacity))
+            {
+                if (i == 0 || l_asset_ids.get(i) != l_asset_ids.get(i - 1))
+                {
+                    l_distinct_id_count += 1;
+                }
+            }
+            assert_true(l_distinct_id_count == l_batch.entries.Size);
+#endif
+
+            l_asset_ids.free();
+            return l_batch;
+        };
+
+        // Blobs returned by get_asset_blob and get_asset_dependencies_blob are heap allocated
+        inline void release_asset_blob(Span<int8>& p_blob)
+        {
+            p_blob.free();
+        };
+
+        /*
+            Writes made between begin_write_session and end_write_session are grouped in a single transaction, so the database is synced once instead of once per write.
+            Sessions can be nested, the transaction is committed when the outermost session ends.
+        */
+        inline void begin_write_session()
+        {
+            if (this->write_session_depth == 0)
+            {
+                this->execute_transaction_query(this->transaction_begin_query);
+                this->write_session_write_count = 0;
+            }
+            this->write_session_depth += 1;
+        };
+
+        inline void end_write_session()
+        {
+#if CONTAINER_BOUND_TEST
+            assert_true(this->write_session_depth != 0);
+#endif
+            this->write_session_depth -= 1;
+            if (this->write_session_depth == 0)
+            {
+                this->execute_transaction_query(this->transaction_commit_query);
+            }
         };
 
         inline hash_t insert_asset_blob(const Slice<int8>& p_asset_path, const Slice<int8>& p_blob)
         {
             hash_t l_id = HashSlice(p_asset_path);
+            Vector<int8> l_encoded_blob = AssetBlobHeader::allocate_encoded_blob(p_blob, this->blob_compression);
 
             SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
             l_binder.bind_sqlitepreparedquery(this->asset_insert_query, this->connection);
             l_binder.bind_int64(l_id, this->connection);
             l_binder.bind_text(p_asset_path, this->connection);
-            l_binder.bind_blob(p_blob, this->connection);
+            l_binder.bind_blob(l_encoded_blob.to_slice(), this->connection);
 
             SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+            this->on_write();
 
+            l_encoded_blob.free();
             return l_id;
         };
 
         inline hash_t insert_or_update_asset_blob(const Slice<int8>& p_asset_path, const Slice<int8>& p_blob)
         {
             hash_t l_id = HashSlice(p_asset_path);
+            Vector<int8> l_encoded_blob = AssetBlobHeader::allocate_encoded_blob(p_blob, this->blob_compression);
 
             if (this->does_asset_exists(l_id))
             {
                 SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
                 l_binder = SQLiteQueryBinder::build_default();
                 l_binder.bind_sqlitepreparedquery(this->asset_update_query, this->connection);
-                l_binder.bind_blob(p_blob, this->connection);
+                l_binder.bind_blob(l_encoded_blob.to_slice(), this->connection);
                 l_binder.bind_int64(l_id, this->connection);
 
                 SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+                this->on_write();
             }
             else
             {
@@ -171,11 +664,13 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
                 l_binder.bind_sqlitepreparedquery(this->asset_insert_query, this->connection);
                 l_binder.bind_int64(l_id, this->connection);
                 l_binder.bind_text(p_asset_path, this->connection);
-                l_binder.bind_blob(p_blob, this->connection);
+                l_binder.bind_blob(l_encoded_blob.to_slice(), this->connection);
 
                 SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+                this->on_write();
             }
 
+            l_encoded_blob.free();
             return l_id;
         };
 
@@ -186,9 +681,15 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
             l_binder.bind_int64(p_asset_id, this->connection);
 
             Span<int8> l_asset_dependencies_blob = Span<int8>::build_default();
+            int8 l_found = 0;
             SQLiteResultSet l_asset_rs = SQLiteResultSet::build_from_prepared_query(this->asset_dependencies_blob_select_query);
-            SQliteQueryExecution::execute_sync(this->connection, this->asset_dependencies_blob_select_query.statement,
-                                               [&l_asset_rs, &l_asset_dependencies_blob]() { l_asset_dependencies_blob = l_asset_rs.get_blob(0); });
+            SQliteQueryExecution::execute_sync(this->connection, this->asset_dependencies_blob_select_query.statement, [&l_asset_rs, &l_asset_dependencies_blob, &l_found]() {
+                l_asset_dependencies_blob = l_asset_rs.get_blob(0);
+                l_found = 1;
+            });
+#if DATABASE_BOUND_TEST
+            assert_true(l_found);
+#endif
 
             return l_asset_dependencies_blob;
         };
@@ -203,7 +704,562 @@ static const int8* DB_ASSET_RESSOURCE_TABLE_INITIALIZATION = MULTILINE(create ta
             l_binder.bind_blob(p_blob, this->connection);
 
             SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+            this->on_write();
+
+            return l_id;
+        };
+
+        inline hash_t insert_or_update_asset_dependencies_blob(const Slice<int8>& p_asset_path, const Slice<int8>& p_blob)
+        {
+            hash_t l_id = HashSlice(p_asset_path);
+
+            SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
+            l_binder.bind_sqlitepreparedquery(this->asset_dependencies_insert_or_replace_query, this->connection);
+            l_binder.bind_int64(l_id, this->connection);
+            l_binder.bind_blob(p_blob, this->connection);
+
+            SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+            this->on_write();
+
+            return l_id;
+        };
+
+        /*
+            The source hash identifies the source file (and compiler settings) an asset has been compiled from.
+            It is used by the AssetCompiler to skip assets whose source has not changed since they have been compiled.
+        */
+        inline int8 get_asset_source_hash(const hash_t p_asset_id, hash_t* out_source_hash)
+        {
+            SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
+            l_binder.bind_sqlitepreparedquery(this->asset_source_hash_select_query, this->connection);
+            l_binder.bind_int64(p_asset_id, this->connection);
+
+            int8 l_found = 0;
+            SQLiteResultSet l_asset_rs = SQLiteResultSet::build_from_prepared_query(this->asset_source_hash_select_query);
+            SQliteQueryExecution::execute_sync(this->connection, this->asset_source_hash_select_query.statement, [&l_found, &l_asset_rs, out_source_hash]() {
+                *out_source_hash = (hash_t)l_asset_rs.get_int64(0);
+                l_found = 1;
+            });
+            return l_found;
+        };
+
+        inline hash_t insert_or_update_asset_source_hash(const Slice<int8>& p_asset_path, const hash_t p_source_hash)
+        {
+            hash_t l_id = HashSlice(p_asset_path);
+
+            SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
+            l_binder.bind_sqlitepreparedquery(this->asset_source_hash_insert_or_replace_query, this->connection);
+            l_binder.bind_int64(l_id, this->connection);
+            l_binder.bind_int64(p_source_hash, this->connection);
+
+            SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+            this->on_write();
 
             return l_id;
         };
-    };
\ No newline at end of file
+
+      private:
+        inline static int64 get_schema_version(DatabaseConnection& p_connection)
+        {
+            SliceN<SQLiteQueryPrimitiveTypes, 1> l_return_types = {SQLiteQueryPrimitiveTypes::INT64};
+            SQLitePreparedQuery l_query = SQLitePreparedQuery::allocate(p_connection, slice_int8_build_rawstr(AssetDatabase_Const::SCHEMA_VERSION_SELECT_QUERY), SQLiteQueryLayout::build_default(),
+                                                                        SQLiteQueryLayout::build_slice(l_return_types.to_slice()));
+            int64 l_schema_version = 0;
+            SQLiteResultSet l_rs = SQLiteResultSet::build_from_prepared_query(l_query);
+            SQliteQueryExecution::execute_sync(p_connection, l_query.statement, [&l_rs, &l_schema_version]() { l_schema_version = l_rs.get_int64(0); });
+            l_query.free(p_connection);
+            return l_schema_version;
+        };
+
+        /*
+            Asset blobs of a version 0 database are encoded with an AssetBlobHeader, and the database is set to the AssetDatabase_Const::SCHEMA_VERSION.
+            It is done in a single transaction, so that blobs are never encoded twice.
+        */
+        inline void migrate_from_raw_blobs()
+        {
+            this->execute_transaction_query(this->transaction_begin_query);
+
+            Vector<hash_t> l_ids = Vector<hash_t>::allocate(0);
+            {
+                SliceN<SQLiteQueryPrimitiveTypes, 2> l_return_types = {SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::INT64};
+                SQLitePreparedQuery l_query = SQLitePreparedQuery::allocate(this->connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_SIZE_SELECT_ALL_QUERY),
+                                                                            SQLiteQueryLayout::build_default(), SQLiteQueryLayout::build_slice(l_return_types.to_slice()));
+                SQLiteResultSet l_rs = SQLiteResultSet::build_from_prepared_query(l_query);
+                SQliteQueryExecution::execute_sync(this->connection, l_query.statement, [&l_rs, &l_ids]() { l_ids.push_back_element((hash_t)l_rs.get_int64(0)); });
+                l_query.free(this->connection);
+            }
+
+            for (loop(i, 0, l_ids.Size))
+            {
+                SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
+                l_binder.bind_sqlitepreparedquery(this->asset_blob_select_query, this->connection);
+                l_binder.bind_int64(l_ids.get(i), this->connection);
+
+                Span<int8> l_raw_blob = Span<int8>::build_default();
+                SQLiteResultSet l_asset_rs = SQLiteResultSet::build_from_prepared_query(this->asset_blob_select_query);
+                SQliteQueryExecution::execute_sync(this->connection, this->asset_blob_select_query.statement, [&l_asset_rs, &l_raw_blob]() { l_raw_blob = l_asset_rs.get_blob(0); });
+
+                Vector<int8> l_encoded_blob = AssetBlobHeader::allocate_encoded_blob(l_raw_blob.slice, this->blob_compression);
+                l_binder = SQLiteQueryBinder::build_default();
+                l_binder.bind_sqlitepreparedquery(this->asset_update_query, this->connection);
+                l_binder.bind_blob(l_encoded_blob.to_slice(), this->connection);
+                l_binder.bind_int64(l_ids.get(i), this->connection);
+                SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+
+                l_encoded_blob.free();
+                l_raw_blob.free();
+            }
+            l_ids.free();
+
+            {
+                String l_pragma = String::allocate_elements(slice_int8_build_rawstr("pragma user_version = "));
+                ToString::auimax_append((uimax)AssetDatabase_Const::SCHEMA_VERSION, l_pragma);
+                l_pragma.append(slice_int8_build_rawstr(";"));
+                SQLiteQuery l_query = SQLiteQuery::allocate(this->connection, l_pragma.to_slice());
+                SQliteQueryExecution::execute_sync(this->connection, l_query.statement, []() {});
+                l_query.free(this->connection);
+                l_pragma.free();
+            }
+
+            this->execute_transaction_query(this->transaction_commit_query);
+        };
+
+        inline void execute_transaction_query(SQLitePreparedQuery& p_transaction_query)
+        {
+            SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
+            l_binder.bind_sqlitepreparedquery(p_transaction_query, this->connection);
+            SQliteQueryExecution::execute_sync(this->connection, l_binder.binded_statement, []() {});
+        };
+
+        inline void on_write()
+        {
+            if (this->write_session_depth != 0)
+            {
+                this->write_session_write_count += 1;
+                if (this->write_session_write_count == AssetDatabase_Const::WRITE_SESSION_MAX_WRITE_COUNT)
+                {
+                    this->execute_transaction_query(this->transaction_commit_query);
+                    this->execute_transaction_query(this->transaction_begin_query);
+                    this->write_session_write_count = 0;
+                }
+            }
+        };
+    };
+
+/*
+    Read only connections to the asset database, one per thread of a JobSystem, so that assets can be read by multiple jobs at the same time.
+    Every reader has it's own connection and prepared queries. A job must only read from the reader of the thread executing it (JobSystem::get_current_thread_index).
+*/
+struct AssetDatabaseReaderPool
+{
+    Span<AssetDatabase> readers;
+
+    inline static AssetDatabaseReaderPool allocate(const Slice<int8>& p_database_file_path, const uimax p_thread_count)
+    {
+        AssetDatabaseReaderPool l_pool = AssetDatabaseReaderPool{Span<AssetDatabase>::allocate(p_thread_count)};
+        for (loop(i, 0, p_thread_count))
+        {
+            l_pool.readers.get(i) = AssetDatabase::allocate_reader(p_database_file_path);
+        }
+        return l_pool;
+    };
+
+    inline void free()
+    {
+        for (loop(i, 0, this->readers.Capacity))
+        {
+            this->readers.get(i).free();
+        }
+        this->readers.free();
+    };
+
+    inline AssetDatabase& get_reader(const uimax p_thread_index)
+    {
+        return this->readers.get(p_thread_index);
+    };
+
+    inline AssetDatabase& get_reader(JobSystem& p_job_system)
+    {
+        return this->get_reader(p_job_system.get_current_thread_index());
+    };
+};
+
+/*
+    Reads asset blobs on a dedicated thread, so that the thread requesting them is never blocked by the database.
+    The streaming thread owns it's own AssetDatabase connection. Requests are served in the order they have been made.
+    A blob is requested and retrieved by calling fetch with it's asset id until the blob has been read.
+*/
+struct AssetStreamer
+{
+    enum class StreamState : int8
+    {
+        QUEUED = 0,
+        READING = 1,
+        READ = 2,
+        // The blob is being read but it is no more needed, it will be freed as soon as it has been read
+        DISCARDED = 3
+    };
+
+    struct Stream
+    {
+        StreamState state;
+        Span<int8> blob;
+    };
+
+    // Heap allocated because it is shared with the streaming thread
+    struct Shared
+    {
+        AssetDatabase asset_database;
+        ThreadMutex mutex;
+        ThreadSemaphore wake;
+        volatile int64 running;
+        Vector<hash_t> queued_streams;
+        HashMap<hash_t, Stream> streams;
+    };
+
+    Shared* shared;
+    thread_t thread;
+
+    inline static AssetStreamer allocate(const Slice<int8>& p_database_file_path)
+    {
+        AssetStreamer l_asset_streamer;
+        l_asset_streamer.shared = (Shared*)heap_malloc(sizeof(Shared));
+        l_asset_streamer.shared->asset_database = AssetDatabase::allocate_reader(p_database_file_path);
+        l_asset_streamer.shared->mutex = ThreadMutex::allocate();
+        l_asset_streamer.shared->wake = ThreadSemaphore::allocate();
+        l_asset_streamer.shared->running = 1;
+        l_asset_streamer.shared->queued_streams = Vector<hash_t>::allocate(0);
+        l_asset_streamer.shared->streams = HashMap<hash_t, Stream>::allocate_default();
+        l_asset_streamer.thread = Thread::spawn(AssetStreamer::main, l_asset_streamer.shared);
+        return l_asset_streamer;
+    };
+
+    // Blobs that have been read and not fetched are freed
+    inline void free()
+    {
+        atomic_store(&this->shared->running, 0);
+        this->shared->wake.notify(1);
+        Thread::join(this->thread);
+
+        this->shared->streams.foreach ([](const hash_t, Stream& p_stream) {
+            if (p_stream.state == StreamState::READ)
+            {
+                p_stream.blob.free();
+            }
+        });
+        this->shared->streams.free();
+        this->shared->queued_streams.free();
+        this->shared->wake.free();
+        this->shared->mutex.free();
+        this->shared->asset_database.free();
+        heap_free((int8*)this->shared);
+    };
+
+    /*
+        Returns 1 and gives the ownership of the blob if it has been read.
+        Otherwise, the blob is requested if it was not already.
+    */
+    inline int8 fetch(const hash_t p_asset_id, Span<int8>* out_blob)
+    {
+        int8 l_read = 0;
+        int8 l_requested = 0;
+
+        this->shared->mutex.lock();
+        Stream* l_stream = this->shared->streams.get_value_nothashed(p_asset_id);
+        if (l_stream == NULL)
+        {
+            this->shared->streams.push_key_value_nothashed(p_asset_id, Stream{StreamState::QUEUED, Span<int8>::build_default()});
+            this->shared->queued_streams.push_back_element(p_asset_id);
+            l_requested = 1;
+        }
+        else if (l_stream->state == StreamState::READ)
+        {
+            *out_blob = l_stream->blob;
+            this->shared->streams.erase_key_nothashed(p_asset_id);
+            l_read = 1;
+        }
+        else if (l_stream->state == StreamState::DISCARDED)
+        {
+            l_stream->state = StreamState::READING;
+        }
+        this->shared->mutex.unlock();
+
+        if (l_requested)
+        {
+            this->shared->wake.notify(1);
+        }
+        return l_read;
+    };
+
+    // The blob is no more needed. Requests that are not being read are cancelled.
+    inline void discard(const hash_t p_asset_id)
+    {
+        Span<int8> l_blob_to_free = Span<int8>::build_default();
+
+        this->shared->mutex.lock();
+        Stream* l_stream = this->shared->streams.get_value_nothashed(p_asset_id);
+        if (l_stream != NULL)
+        {
+            switch (l_stream->state)
+            {
+            case StreamState::QUEUED:
+                for (loop(i, 0, this->shared->queued_streams.Size))
+                {
+                    if (this->shared->queued_streams.get(i) == p_asset_id)
+                    {
+                        this->shared->queued_streams.erase_element_at_always(i);
+                        break;
+                    }
+                }
+                this->shared->streams.erase_key_nothashed(p_asset_id);
+                break;
+            case StreamState::READING:
+                l_stream->state = StreamState::DISCARDED;
+                break;
+            case StreamState::READ:
+                l_blob_to_free = l_stream->blob;
+                this->shared->streams.erase_key_nothashed(p_asset_id);
+                break;
+            default:
+                break;
+            }
+        }
+        this->shared->mutex.unlock();
+
+        if (l_blob_to_free.Memory != NULL)
+        {
+            l_blob_to_free.free();
+        }
+    };
+
+  private:
+    inline static thread_return_t THREAD_CALL main(void* p_shared)
+    {
+        Shared* l_shared = (Shared*)p_shared;
+        memory_tag_set(MemoryTag::ASSET);
+
+        // The semaphore is notified once per request, a notification can be left without a request when the request has been discarded
+        while (1)
+        {
+            l_shared->wake.wait();
+            if (!atomic_load(&l_shared->running))
+            {
+                break;
+            }
+
+            hash_t l_asset_id = 0;
+            int8 l_has_request = 0;
+            l_shared->mutex.lock();
+            if (l_shared->queued_streams.Size > 0)
+            {
+                l_asset_id = l_shared->queued_streams.get(0);
+                l_shared->queued_streams.erase_element_at_always(0);
+                l_shared->streams.get_value_nothashed(l_asset_id)->state = StreamState::READING;
+                l_has_request = 1;
+            }
+            l_shared->mutex.unlock();
+
+            if (!l_has_request)
+            {
+                continue;
+            }
+
+            Span<int8> l_blob = l_shared->asset_database.get_asset_blob(l_asset_id);
+
+            int8 l_discarded = 0;
+            l_shared->mutex.lock();
+            Stream* l_stream = l_shared->streams.get_value_nothashed(l_asset_id);
+            if (l_stream->state == StreamState::DISCARDED)
+            {
+                l_shared->streams.erase_key_nothashed(l_asset_id);
+                l_discarded = 1;
+            }
+            else
+            {
+                l_stream->state = StreamState::READ;
+                l_stream->blob = l_blob;
+            }
+            l_shared->mutex.unlock();
+
+            if (l_discarded)
+            {
+                l_blob.free();
+            }
+        }
+
+        ThreadArenas::free();
+        return 0;
+    };
+};
+
+namespace AssetArchive_Const
+{
+static const uint64 MAGIC = 0x31564843524154; // "TARCHV1"
+static const uint64 VERSION = 1;
+// Blobs are aligned on memory pages so that they can be read directly from the mapping
+static const uimax BLOB_ALIGNMENT = 4096;
+}; // namespace AssetArchive_Const
+
+struct AssetArchiveHeader
+{
+    uint64 magic;
+    uint64 version;
+    uint64 asset_count;
+    uint64 asset_dependencies_count;
+};
+
+/*
+    Immutable pack of all the blobs of an AssetDatabase, read through a FileMapping.
+    Layout : AssetArchiveHeader | asset entries | asset dependencies entries | blobs.
+    Entries are sorted by id (in the order of the database primary key) so that they are retrieved by binary search.
+    Asset blobs are decompressed when the archive is written, so that they can be read in place from the mapping.
+    Blobs returned by get_asset_blob and get_asset_dependencies_blob point to the mapped memory, they are valid until the AssetArchive is freed.
+    Like with the AssetDatabase, requested ids must be in the archive, does_asset_exists checks it.
+*/
+struct AssetArchive
+{
+    File file;
+    FileMapping mapping;
+    Slice<AssetBlobEntry> assets;
+    Slice<AssetBlobEntry> asset_dependencies;
+
+    inline static AssetArchive allocate(const Slice<int8>& p_archive_file_path)
+    {
+        AssetArchive l_asset_archive;
+        l_asset_archive.file = File::open(p_archive_file_path);
+        l_asset_archive.mapping = FileMapping::allocate(l_asset_archive.file);
+
+        AssetArchiveHeader* l_header = (AssetArchiveHeader*)l_asset_archive.mapping.memory.Begin;
+#if CONTAINER_BOUND_TEST
+        assert_true(l_asset_archive.mapping.memory.Size >= sizeof(AssetArchiveHeader));
+        assert_true(l_header->magic == AssetArchive_Const::MAGIC);
+        assert_true(l_header->version == AssetArchive_Const::VERSION);
+#endif
+        AssetBlobEntry* l_entries = (AssetBlobEntry*)(l_asset_archive.mapping.memory.Begin + sizeof(AssetArchiveHeader));
+        l_asset_archive.assets = Slice<AssetBlobEntry>::build_memory_elementnb(l_entries, (uimax)l_header->asset_count);
+        l_asset_archive.asset_dependencies = Slice<AssetBlobEntry>::build_memory_elementnb(l_entries + l_header->asset_count, (uimax)l_header->asset_dependencies_count);
+        return l_asset_archive;
+    };
+
+    inline void free()
+    {
+        this->mapping.free();
+        this->file.free();
+    };
+
+    inline int8 does_asset_exists(const hash_t p_asset_id)
+    {
+        return AssetBlobEntry::find(this->assets, p_asset_id) != NULL;
+    };
+
+    inline Span<int8> get_asset_blob(const hash_t p_asset_id)
+    {
+        return this->get_entry_blob(AssetBlobEntry::find(this->assets, p_asset_id));
+    };
+
+    inline Span<int8> get_asset_dependencies_blob(const hash_t p_asset_id)
+    {
+        return this->get_entry_blob(AssetBlobEntry::find(this->asset_dependencies, p_asset_id));
+    };
+
+    // Blobs are owned by the mapping, nothing is freed
+    inline void release_asset_blob(Span<int8>& p_blob)
+    {
+        p_blob = Span<int8>::build_default();
+    };
+
+    /*
+        Writes all the blobs of p_asset_database to a new archive file at p_archive_file_path.
+        Blobs are streamed from the database one by one, they are never all loaded at the same time.
+    */
+    inline static void write_from_database(AssetDatabase& p_asset_database, const Slice<int8>& p_archive_file_path)
+    {
+        Vector<AssetBlobEntry> l_assets = collect_entries(p_asset_database, AssetDatabase_Const::ASSET_SIZE_SELECT_ALL_QUERY);
+        Vector<AssetBlobEntry> l_asset_dependencies = collect_entries(p_asset_database, AssetDatabase_Const::ASSET_DEPENDENCIES_SIZE_SELECT_ALL_QUERY);
+
+        File l_file = File::create_or_open(p_archive_file_path);
+        l_file.erase_with_slicepath();
+        l_file = File::create(p_archive_file_path);
+
+        // The uncompressed size of asset blobs is only known when they are read, entries are written after the blobs
+        uimax l_index_size = sizeof(AssetArchiveHeader) + ((l_assets.Size + l_asset_dependencies.Size) * sizeof(AssetBlobEntry));
+        uimax l_offset = align_blob_offset(l_index_size);
+        l_offset = write_blobs(p_asset_database, l_file, AssetDatabase_Const::ASSET_BLOB_SELECT_ALL_QUERY, 1, l_assets.to_slice(), l_offset);
+        l_offset = write_blobs(p_asset_database, l_file, AssetDatabase_Const::ASSET_DEPENDENCIES_BLOB_SELECT_ALL_QUERY, 0, l_asset_dependencies.to_slice(), l_offset);
+
+        AssetArchiveHeader l_header = AssetArchiveHeader{AssetArchive_Const::MAGIC, AssetArchive_Const::VERSION, (uint64)l_assets.Size, (uint64)l_asset_dependencies.Size};
+        l_file.write_file_chunk(0, Slice<AssetArchiveHeader>::build_asint8_memory_singleelement(&l_header));
+        l_file.write_file_chunk(sizeof(AssetArchiveHeader), l_assets.to_slice().build_asint8());
+        l_file.write_file_chunk(sizeof(AssetArchiveHeader) + (l_assets.Size * sizeof(AssetBlobEntry)), l_asset_dependencies.to_slice().build_asint8());
+
+        l_file.free();
+        l_asset_dependencies.free();
+        l_assets.free();
+    };
+
+  private:
+    inline static uimax align_blob_offset(const uimax p_offset)
+    {
+        return (p_offset + AssetArchive_Const::BLOB_ALIGNMENT - 1) & ~(AssetArchive_Const::BLOB_ALIGNMENT - 1);
+    };
+
+    inline Span<int8> get_entry_blob(const AssetBlobEntry* p_entry)
+    {
+#if DATABASE_BOUND_TEST
+        assert_true(p_entry != NULL);
+#endif
+        return Span<int8>::build(this->mapping.memory.Begin + p_entry->offset, (uimax)p_entry->size);
+    };
+
+    inline static Vector<AssetBlobEntry> collect_entries(AssetDatabase& p_asset_database, const int8* p_size_query)
+    {
+        SliceN<SQLiteQueryPrimitiveTypes, 2> l_return_types = {SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::INT64};
+        SQLitePreparedQuery l_query = SQLitePreparedQuery::allocate(p_asset_database.connection, slice_int8_build_rawstr(p_size_query), SQLiteQueryLayout::build_default(),
+                                                                    SQLiteQueryLayout::build_slice(l_return_types.to_slice()));
+
+        Vector<AssetBlobEntry> l_entries = Vector<AssetBlobEntry>::allocate(0);
+        SQLiteResultSet l_rs = SQLiteResultSet::build_from_prepared_query(l_query);
+        SQliteQueryExecution::execute_sync(p_asset_database.connection, l_query.statement, [&l_rs, &l_entries]() {
+            l_entries.push_back_element(AssetBlobEntry{(hash_t)l_rs.get_int64(0), 0, (uint64)l_rs.get_int64(1)});
+        });
+
+        l_query.free(p_asset_database.connection);
+        return l_entries;
+    };
+
+    // Writes blobs from p_offset and sets the location of their in_out_entries. Returns the offset following the last blob.
+    inline static uimax write_blobs(AssetDatabase& p_asset_database, File& p_file, const int8* p_blob_query, const int8 p_blobs_encoded, Slice<AssetBlobEntry> in_out_entries, uimax p_offset)
+    {
+        SliceN<SQLiteQueryPrimitiveTypes, 2> l_return_types = {SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::BLOB};
+        SQLitePreparedQuery l_query = SQLitePreparedQuery::allocate(p_asset_database.connection, slice_int8_build_rawstr(p_blob_query), SQLiteQueryLayout::build_default(),
+                                                                    SQLiteQueryLayout::build_slice(l_return_types.to_slice()));
+
+        uimax l_entry_index = 0;
+        Vector<int8> l_decoded_blob = Vector<int8>::allocate(0);
+        SQLiteResultSet l_rs = SQLiteResultSet::build_from_prepared_query(l_query);
+        SQliteQueryExecution::execute_sync(p_asset_database.connection, l_query.statement, [&]() {
+            AssetBlobEntry& l_entry = in_out_entries.get(l_entry_index);
+#if CONTAINER_BOUND_TEST
+            assert_true(l_entry.id == (hash_t)l_rs.get_int64(0));
+#endif
+            Slice<int8> l_blob = l_rs.get_blob_slice(1);
+            if (p_blobs_encoded)
+            {
+                l_decoded_blob.clear();
+                l_decoded_blob.push_back_array_empty((uimax)AssetBlobHeader::read(l_blob).size);
+                AssetBlobHeader::decode(l_blob, l_decoded_blob.to_slice());
+                l_blob = l_decoded_blob.to_slice();
+            }
+
+            l_entry.offset = p_offset;
+            l_entry.size = l_blob.Size;
+            p_file.write_file_chunk(p_offset, l_blob);
+            p_offset = align_blob_offset(p_offset + l_blob.Size);
+            l_entry_index += 1;
+        });
+
+        l_decoded_blob.free();
+        l_query.free(p_asset_database.connection);
+        return p_offset;
+    };
+};
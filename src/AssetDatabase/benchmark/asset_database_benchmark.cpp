@@ -0,0 +1,124 @@
+#include "AssetDatabase/assetdatabase.hpp"
+
+/*
+    Load throughput of uncompressed and LZ4 compressed asset blobs.
+    The blobs of the sandbox databases are copied to one database per compression, then all assets are read with a newly opened reader.
+    Every iteration opens it's own connection so that the SQLite page cache is cold (the file may still be in the OS cache).
+*/
+
+const uimax asset_database_benchmark_iteration_count = 16;
+
+inline void asset_database_benchmark_collect_blobs(const Slice<int8>& p_database_local_path, Vector<Span<int8>>* in_out_blobs)
+{
+    String l_database_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_database_path.append(p_database_local_path);
+
+    FileHandle l_database_file = FileNative::open_file(l_database_path.to_slice());
+    if (!FileNative::handle_is_valid(l_database_file))
+    {
+        printf("%s not found, the sandbox must be run once to create it.\n", l_database_path.get_memory());
+        l_database_path.free();
+        return;
+    }
+    FileNative::close_file(l_database_file);
+    AssetDatabase::initialize_database(l_database_path.to_slice());
+
+    AssetDatabase l_asset_database = AssetDatabase::allocate_reader(l_database_path.to_slice());
+    SliceN<SQLiteQueryPrimitiveTypes, 2> l_return_types = {SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::INT64};
+    SQLitePreparedQuery l_query = SQLitePreparedQuery::allocate(l_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_SIZE_SELECT_ALL_QUERY),
+                                                                SQLiteQueryLayout::build_default(), SQLiteQueryLayout::build_slice(l_return_types.to_slice()));
+    Vector<hash_t> l_ids = Vector<hash_t>::allocate(0);
+    SQLiteResultSet l_rs = SQLiteResultSet::build_from_prepared_query(l_query);
+    SQliteQueryExecution::execute_sync(l_asset_database.connection, l_query.statement, [&l_rs, &l_ids]() { l_ids.push_back_element((hash_t)l_rs.get_int64(0)); });
+    l_query.free(l_asset_database.connection);
+
+    for (loop(i, 0, l_ids.Size))
+    {
+        in_out_blobs->push_back_element(l_asset_database.get_asset_blob(l_ids.get(i)));
+    }
+
+    l_ids.free();
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+inline void asset_database_benchmark_run(const Slice<Span<int8>>& p_blobs, const AssetBlobCompression p_compression, const int8* p_name)
+{
+    String l_database_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_database_path.append(slice_int8_build_rawstr("asset_database_benchmark.db"));
+    {
+        File l_tmp_file = File::create_or_open(l_database_path.to_slice());
+        l_tmp_file.erase_with_slicepath();
+    }
+    AssetDatabase::initialize_database(l_database_path.to_slice());
+
+    Span<hash_t> l_ids = Span<hash_t>::allocate(p_blobs.Size);
+    uimax l_total_size = 0;
+    {
+        AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+        l_asset_database.blob_compression = p_compression;
+        l_asset_database.begin_write_session();
+        for (loop(i, 0, p_blobs.Size))
+        {
+            // ids of the copied blobs are the hash of their index
+            l_ids.get(i) = l_asset_database.insert_asset_blob(Slice<uimax>::build_asint8_memory_singleelement(&i), p_blobs.get(i).slice);
+            l_total_size += p_blobs.get(i).Capacity;
+        }
+        l_asset_database.end_write_session();
+        l_asset_database.free();
+    }
+
+    uimax l_file_size;
+    {
+        File l_database_file = File::open(l_database_path.to_slice());
+        l_file_size = l_database_file.get_size();
+        l_database_file.free();
+    }
+
+    time_t l_begin = clock_currenttime_mics();
+    for (loop(l_iteration, 0, asset_database_benchmark_iteration_count))
+    {
+        AssetDatabase l_asset_database = AssetDatabase::allocate_reader(l_database_path.to_slice());
+        for (loop(i, 0, l_ids.Capacity))
+        {
+            Span<int8> l_blob = l_asset_database.get_asset_blob(l_ids.get(i));
+            l_asset_database.release_asset_blob(l_blob);
+        }
+        l_asset_database.free();
+    }
+    float64 l_time = (float64)(clock_currenttime_mics() - l_begin) / 1000000.0;
+
+    float64 l_loaded_mib = ((float64)l_total_size * (float64)asset_database_benchmark_iteration_count) / (1024.0 * 1024.0);
+    printf("%s : database %f MiB, %f MiB/s\n", p_name, (float64)l_file_size / (1024.0 * 1024.0), l_loaded_mib / l_time);
+
+    l_ids.free();
+    l_database_path.free();
+};
+
+int main()
+{
+    Vector<Span<int8>> l_blobs = Vector<Span<int8>>::allocate(0);
+    asset_database_benchmark_collect_blobs(slice_int8_build_rawstr("/d3renderer_cube/asset.db"), &l_blobs);
+    asset_database_benchmark_collect_blobs(slice_int8_build_rawstr("/boxcollision/asset.db"), &l_blobs);
+
+    uimax l_total_size = 0;
+    for (loop(i, 0, l_blobs.Size))
+    {
+        l_total_size += l_blobs.get(i).Capacity;
+    }
+    printf("assets: %lld, %f MiB\n", (long long)l_blobs.Size, (float64)l_total_size / (1024.0 * 1024.0));
+
+    if (l_blobs.Size > 0)
+    {
+        asset_database_benchmark_run(l_blobs.to_slice(), AssetBlobCompression::NONE, "uncompressed");
+        asset_database_benchmark_run(l_blobs.to_slice(), AssetBlobCompression::LZ4, "lz4         ");
+    }
+
+    for (loop(i, 0, l_blobs.Size))
+    {
+        l_blobs.get(i).free();
+    }
+    l_blobs.free();
+
+    memleak_ckeck();
+};
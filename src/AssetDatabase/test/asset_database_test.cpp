@@ -2,6 +2,7 @@
 
 #include "AssetDatabase/assetdatabase.hpp"
 #include "asset_database_test_utils.hpp"
+#include "test_random.hpp"
 
 inline void asset_blob_insert_read_write()
 {
@@ -10,14 +11,17 @@ inline void asset_blob_insert_read_write()
 
     {
         Slice<int8> l_path = slice_int8_build_rawstr("pathtest");
-        Slice<uimax> l_data = SliceN<uimax, 3>{0, 1, 2}.to_slice();
+        // The SliceN is kept alive, a Slice built from a temporary SliceN points to released stack memory once the statement ends
+        SliceN<uimax, 3> l_data_memory = {0, 1, 2};
+        Slice<uimax> l_data = l_data_memory.to_slice();
         hash_t l_inserted_id = l_asset_database.insert_asset_blob(l_path, l_data.build_asint8());
         Span<int8> l_retrieved_data = l_asset_database.get_asset_blob(l_inserted_id);
         assert_true(l_data.build_asint8().compare(l_retrieved_data.slice));
         l_retrieved_data.free();
 
         //insert_or_update_asset_blob -> doing update
-        l_data = SliceN<uimax, 3>{3, 4, 5}.to_slice();
+        SliceN<uimax, 3> l_updated_data_memory = {3, 4, 5};
+        l_data = l_updated_data_memory.to_slice();
         l_inserted_id =  l_asset_database.insert_or_update_asset_blob(l_path, l_data.build_asint8());
         l_retrieved_data = l_asset_database.get_asset_blob(l_inserted_id);
         assert_true(l_data.build_asint8().compare(l_retrieved_data.slice));
@@ -27,7 +31,8 @@ inline void asset_blob_insert_read_write()
     //insert_or_update_asset_blob -> doing insert
     {
         Slice<int8> l_path = slice_int8_build_rawstr("pathtest2");
-        Slice<uimax> l_data = SliceN<uimax, 3>{0, 1, 2}.to_slice();
+        SliceN<uimax, 3> l_data_memory = {0, 1, 2};
+        Slice<uimax> l_data = l_data_memory.to_slice();
         hash_t l_inserted_id = l_asset_database.insert_or_update_asset_blob(l_path, l_data.build_asint8());
         Span<int8> l_retrieved_data = l_asset_database.get_asset_blob(l_inserted_id);
         assert_true(l_data.build_asint8().compare(l_retrieved_data.slice));
@@ -38,6 +43,79 @@ inline void asset_blob_insert_read_write()
     l_database_path.free();
 };
 
+inline uimax asset_database_test_get_stored_blob_size(AssetDatabase& p_asset_database, const hash_t p_asset_id)
+{
+    SliceN<SQLiteQueryPrimitiveTypes, 2> l_return_types = {SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::INT64};
+    SQLitePreparedQuery l_query = SQLitePreparedQuery::allocate(p_asset_database.connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_SIZE_SELECT_ALL_QUERY),
+                                                                SQLiteQueryLayout::build_default(), SQLiteQueryLayout::build_slice(l_return_types.to_slice()));
+    uimax l_stored_size = 0;
+    SQLiteResultSet l_rs = SQLiteResultSet::build_from_prepared_query(l_query);
+    SQliteQueryExecution::execute_sync(p_asset_database.connection, l_query.statement, [&]() {
+        if ((hash_t)l_rs.get_int64(0) == p_asset_id)
+        {
+            l_stored_size = (uimax)l_rs.get_int64(1);
+        }
+    });
+    l_query.free(p_asset_database.connection);
+    return l_stored_size;
+};
+
+inline void asset_blob_compression()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+
+    const uimax l_blob_size = 10000;
+    Span<int8> l_compressible_blob = Span<int8>::allocate(l_blob_size);
+    Span<int8> l_random_blob = Span<int8>::allocate(l_blob_size);
+    uint32 l_seed = 42;
+    for (loop(i, 0, l_blob_size))
+    {
+        test_random_next(&l_seed);
+        l_compressible_blob.get(i) = (int8)(i % 13);
+        l_random_blob.get(i) = (int8)(l_seed >> 16);
+    }
+
+    // compressible blobs are stored compressed
+    hash_t l_compressible_id = l_asset_database.insert_or_update_asset_blob(slice_int8_build_rawstr("compressible"), l_compressible_blob.slice);
+    assert_true(asset_database_test_get_stored_blob_size(l_asset_database, l_compressible_id) < (l_blob_size / 10));
+    Span<int8> l_retrieved_blob = l_asset_database.get_asset_blob(l_compressible_id);
+    assert_true(l_retrieved_blob.slice.compare(l_compressible_blob.slice));
+    l_retrieved_blob.free();
+
+    // blobs that can't be compressed are stored as is
+    hash_t l_random_id = l_asset_database.insert_or_update_asset_blob(slice_int8_build_rawstr("random"), l_random_blob.slice);
+    assert_true(asset_database_test_get_stored_blob_size(l_asset_database, l_random_id) == (l_blob_size + sizeof(AssetBlobHeader)));
+    l_retrieved_blob = l_asset_database.get_asset_blob(l_random_id);
+    assert_true(l_retrieved_blob.slice.compare(l_random_blob.slice));
+    l_retrieved_blob.free();
+
+    // compression can be disabled
+    l_asset_database.blob_compression = AssetBlobCompression::NONE;
+    l_asset_database.insert_or_update_asset_blob(slice_int8_build_rawstr("compressible"), l_compressible_blob.slice);
+    assert_true(asset_database_test_get_stored_blob_size(l_asset_database, l_compressible_id) == (l_blob_size + sizeof(AssetBlobHeader)));
+
+    // the blob is decompressed in the memory given by the caller
+    l_asset_database.blob_compression = AssetBlobCompression::LZ4;
+    l_asset_database.insert_or_update_asset_blob(slice_int8_build_rawstr("compressible"), l_compressible_blob.slice);
+    Span<int8> l_destination = Span<int8>::allocate(l_blob_size);
+    assert_true(l_asset_database.read_asset_blob(l_compressible_id, [&l_destination](const uimax p_blob_size) {
+        assert_true(p_blob_size == l_destination.Capacity);
+        return l_destination.slice;
+    }));
+    assert_true(l_destination.slice.compare(l_compressible_blob.slice));
+    assert_true(!l_asset_database.read_asset_blob(HashSlice(slice_int8_build_rawstr("missing")), [&l_destination](const uimax) {
+        abort();
+        return l_destination.slice;
+    }));
+    l_destination.free();
+
+    l_random_blob.free();
+    l_compressible_blob.free();
+    l_asset_database.free();
+    l_database_path.free();
+};
+
 inline void asset_dependencies_blob_read_write()
 {
     String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
@@ -45,7 +123,8 @@ inline void asset_dependencies_blob_read_write()
     // insert select
     {
         Slice<int8> l_path = slice_int8_build_rawstr("pathtest2");
-        Slice<uimax> l_data = SliceN<uimax, 3>{0, 1, 2}.to_slice();
+        SliceN<uimax, 3> l_data_memory = {0, 1, 2};
+        Slice<uimax> l_data = l_data_memory.to_slice();
         hash_t l_inserted_id = l_asset_database.insert_asset_dependencies_blob(l_path, l_data.build_asint8());
         Span<int8> l_retrieved_data = l_asset_database.get_asset_dependencies_blob(l_inserted_id);
         assert_true(l_data.build_asint8().compare(l_retrieved_data.slice));
@@ -55,8 +134,490 @@ inline void asset_dependencies_blob_read_write()
     l_database_path.free();
 };
 
+inline void asset_source_hash_read_write()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+    {
+        Slice<int8> l_path = slice_int8_build_rawstr("pathtest");
+        hash_t l_source_hash;
+        assert_true(!l_asset_database.get_asset_source_hash(HashSlice(l_path), &l_source_hash));
+
+        hash_t l_inserted_id = l_asset_database.insert_or_update_asset_source_hash(l_path, 10);
+        assert_true(l_asset_database.get_asset_source_hash(l_inserted_id, &l_source_hash));
+        assert_true(l_source_hash == 10);
+
+        l_asset_database.insert_or_update_asset_source_hash(l_path, 20);
+        assert_true(l_asset_database.get_asset_source_hash(l_inserted_id, &l_source_hash));
+        assert_true(l_source_hash == 20);
+    }
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+inline void asset_blob_batch_read()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+
+    // more assets than a single batch query
+    const uimax l_asset_count = (AssetDatabase_Const::ASSET_BLOB_BATCH_SIZE * 2) + 3;
+    Span<hash_t> l_ids = Span<hash_t>::allocate(l_asset_count);
+    for (loop(i, 0, l_asset_count))
+    {
+        String l_path = String::allocate_elements(slice_int8_build_rawstr("batched"));
+        SliceN<int8, 2> l_path_suffix = {(int8)('a' + (i % 26)), (int8)('a' + (i / 26))};
+        l_path.append(l_path_suffix.to_slice());
+        Span<uimax> l_data = Span<uimax>::allocate((i % 5) + 1);
+        for (loop(j, 0, l_data.Capacity))
+        {
+            l_data.get(j) = i + j;
+        }
+        l_ids.get(i) = l_asset_database.insert_asset_blob(l_path.to_slice(), l_data.slice.build_asint8());
+        if ((i % 3) == 0)
+        {
+            l_asset_database.insert_asset_dependencies_blob(l_path.to_slice(), l_data.slice.build_asint8());
+        }
+        l_data.free();
+        l_path.free();
+    }
+
+    // ids are requested in reverse order, some of them multiple times
+    Vector<hash_t> l_requested_ids = Vector<hash_t>::allocate(0);
+    for (loop_reverse(i, 0, l_asset_count))
+    {
+        l_requested_ids.push_back_element(l_ids.get(i));
+        if ((i % 7) == 0)
+        {
+            l_requested_ids.push_back_element(l_ids.get(i));
+        }
+    }
+
+    AssetBlobBatch l_batch = l_asset_database.get_asset_blobs(l_requested_ids.to_slice());
+    assert_true(l_batch.entries.Size == l_asset_count);
+    assert_true(l_batch.dependencies_entries.Size == ((l_asset_count + 2) / 3));
+    for (loop(i, 0, l_asset_count))
+    {
+        Span<int8> l_database_blob = l_asset_database.get_asset_blob(l_ids.get(i));
+        Span<int8> l_batch_blob = l_batch.get_asset_blob(l_ids.get(i));
+        assert_true(((uimax)l_batch_blob.Memory % AssetDatabase_Const::ASSET_BLOB_BATCH_ALIGNMENT) == 0);
+        assert_true(l_database_blob.Capacity == l_batch_blob.Capacity);
+        assert_true(l_database_blob.slice.compare(l_batch_blob.slice));
+        l_batch.release_asset_blob(l_batch_blob);
+        l_asset_database.release_asset_blob(l_database_blob);
+
+        if ((i % 3) == 0)
+        {
+            Span<int8> l_database_dependencies_blob = l_asset_database.get_asset_dependencies_blob(l_ids.get(i));
+            Span<int8> l_batch_dependencies_blob = l_batch.get_asset_dependencies_blob(l_ids.get(i));
+            assert_true(((uimax)l_batch_dependencies_blob.Memory % AssetDatabase_Const::ASSET_BLOB_BATCH_ALIGNMENT) == 0);
+            assert_true(l_database_dependencies_blob.Capacity == l_batch_dependencies_blob.Capacity);
+            assert_true(l_database_dependencies_blob.slice.compare(l_batch_dependencies_blob.slice));
+            l_batch.release_asset_blob(l_batch_dependencies_blob);
+            l_asset_database.release_asset_blob(l_database_dependencies_blob);
+        }
+    }
+    assert_true(!l_batch.does_asset_exists(HashSlice(slice_int8_build_rawstr("missing"))));
+    l_batch.free();
+
+    l_batch = l_asset_database.get_asset_blobs(Slice<hash_t>::build_default());
+    assert_true(l_batch.entries.Size == 0);
+    l_batch.free();
+
+    l_requested_ids.free();
+    l_ids.free();
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+/*
+    Writes of nested sessions are grouped in a single transaction that is committed by the outermost session.
+    Sessions with more than WRITE_SESSION_MAX_WRITE_COUNT writes are committed by steps.
+*/
+inline void asset_database_write_session()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+
+    uimax l_asset_count = AssetDatabase_Const::WRITE_SESSION_MAX_WRITE_COUNT + 10;
+    l_asset_database.begin_write_session();
+    assert_true(sqlite3_get_autocommit(l_asset_database.connection.connection) == 0);
+    {
+        l_asset_database.begin_write_session();
+        for (loop(i, 0, l_asset_count))
+        {
+            String l_path = String::allocate_elements(slice_int8_build_rawstr("session"));
+            ToString::auimax_append(i, l_path);
+            l_asset_database.insert_asset_blob(l_path.to_slice(), Slice<uimax>::build_asint8_memory_singleelement(&i));
+            l_path.free();
+        }
+        l_asset_database.end_write_session();
+    }
+    assert_true(sqlite3_get_autocommit(l_asset_database.connection.connection) == 0);
+    l_asset_database.end_write_session();
+    assert_true(sqlite3_get_autocommit(l_asset_database.connection.connection) == 1);
+
+    AssetDatabase l_reader = AssetDatabase::allocate_reader(l_database_path.to_slice());
+    for (loop(i, 0, l_asset_count))
+    {
+        String l_path = String::allocate_elements(slice_int8_build_rawstr("session"));
+        ToString::auimax_append(i, l_path);
+        Span<int8> l_retrieved_data = l_reader.get_asset_blob(HashSlice(l_path.to_slice()));
+        assert_true(*(uimax*)l_retrieved_data.Memory == i);
+        l_retrieved_data.free();
+        l_path.free();
+    }
+    l_reader.free();
+
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+// A reader reads assets while another thread writes them, like the AssetStreamer thread does
+inline void asset_database_reader_concurrent_read()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+
+    const uimax l_asset_count = 64;
+    Span<hash_t> l_ids = Span<hash_t>::allocate(l_asset_count);
+    for (loop(i, 0, l_asset_count))
+    {
+        String l_path = String::allocate_elements(slice_int8_build_rawstr("read"));
+        ToString::auimax_append(i, l_path);
+        SliceN<uimax, 3> l_data = {i, i + 1, i + 2};
+        l_ids.get(i) = l_asset_database.insert_asset_blob(l_path.to_slice(), l_data.to_slice().build_asint8());
+        l_path.free();
+    }
+
+    // assets are written by another thread while they are read
+    struct Writer
+    {
+        AssetDatabase* asset_database;
+        uimax asset_count;
+
+        inline static thread_return_t THREAD_CALL main(void* p_writer)
+        {
+            Writer* l_writer = (Writer*)p_writer;
+            for (loop(i, 0, l_writer->asset_count))
+            {
+                String l_path = String::allocate_elements(slice_int8_build_rawstr("written"));
+                ToString::auimax_append(i, l_path);
+                SliceN<uimax, 1> l_data = {i};
+                l_writer->asset_database->insert_asset_blob(l_path.to_slice(), l_data.to_slice().build_asint8());
+                l_path.free();
+            }
+            return 0;
+        };
+    };
+
+    AssetDatabase l_reader = AssetDatabase::allocate_reader(l_database_path.to_slice());
+
+    Writer l_writer = Writer{&l_asset_database, l_asset_count};
+    thread_t l_writer_thread = Thread::spawn(Writer::main, &l_writer);
+
+    for (loop(l_iteration, 0, 8))
+    {
+        for (loop(i, 0, l_ids.Capacity))
+        {
+            Span<int8> l_blob = l_reader.get_asset_blob(l_ids.get(i));
+            SliceN<uimax, 3> l_data = {i, i + 1, i + 2};
+            assert_true(l_blob.Capacity == l_data.to_slice().build_asint8().Size);
+            assert_true(l_data.to_slice().build_asint8().compare(l_blob.slice));
+            l_reader.release_asset_blob(l_blob);
+        }
+    }
+
+    Thread::join(l_writer_thread);
+
+    // written assets are visible to the reader
+    {
+        String l_path = String::allocate_elements(slice_int8_build_rawstr("written"));
+        ToString::auimax_append(l_asset_count - 1, l_path);
+        assert_true(l_reader.does_asset_exists(HashSlice(l_path.to_slice())));
+        l_path.free();
+    }
+
+    l_reader.free();
+    l_ids.free();
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+/*
+    Assets are read by the jobs of a JobSystem, every job reads from the reader of it's thread.
+*/
+inline void asset_database_reader_pool()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+
+    const uimax l_asset_count = 256;
+    Span<hash_t> l_ids = Span<hash_t>::allocate(l_asset_count);
+    l_asset_database.begin_write_session();
+    for (loop(i, 0, l_asset_count))
+    {
+        String l_path = String::allocate_elements(slice_int8_build_rawstr("read"));
+        ToString::auimax_append(i, l_path);
+        SliceN<uimax, 3> l_data = {i, i + 1, i + 2};
+        l_ids.get(i) = l_asset_database.insert_asset_blob(l_path.to_slice(), l_data.to_slice().build_asint8());
+        l_path.free();
+    }
+    l_asset_database.end_write_session();
+
+    JobSystem l_job_system = JobSystem::allocate(4);
+    AssetDatabaseReaderPool l_readers = AssetDatabaseReaderPool::allocate(l_database_path.to_slice(), l_job_system.get_thread_count());
+
+    Span<int8> l_read = Span<int8>::callocate(l_asset_count);
+    for (loop(l_iteration, 0, 8))
+    {
+        l_job_system.parallel_for(l_ids.slice, 8, [&](const uimax p_index, const hash_t p_id) {
+            AssetDatabase& l_reader = l_readers.get_reader(l_job_system);
+            Span<int8> l_blob = l_reader.get_asset_blob(p_id);
+            SliceN<uimax, 3> l_data = {p_index, p_index + 1, p_index + 2};
+            assert_true(l_blob.Capacity == l_data.to_slice().build_asint8().Size);
+            assert_true(l_data.to_slice().build_asint8().compare(l_blob.slice));
+            l_reader.release_asset_blob(l_blob);
+            l_read.get(p_index) = 1;
+        });
+    }
+    for (loop(i, 0, l_asset_count))
+    {
+        assert_true(l_read.get(i));
+    }
+
+    l_read.free();
+    l_readers.free();
+    l_job_system.free();
+    l_ids.free();
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+inline void asset_streamer_fetch_discard()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+
+    const uimax l_asset_count = 64;
+    Span<hash_t> l_ids = Span<hash_t>::allocate(l_asset_count);
+    for (loop(i, 0, l_asset_count))
+    {
+        String l_path = String::allocate_elements(slice_int8_build_rawstr("streamed"));
+        l_path.append(SliceN<int8, 1>{(int8)('0' + (i % 64))}.to_slice());
+        SliceN<uimax, 3> l_data = {i, i + 1, i + 2};
+        l_ids.get(i) = l_asset_database.insert_asset_blob(l_path.to_slice(), l_data.to_slice().build_asint8());
+        l_path.free();
+    }
+
+    AssetStreamer l_asset_streamer = AssetStreamer::allocate(l_database_path.to_slice());
+
+    // every blob is read once, fetching a blob that is being read doesn't request it again
+    {
+        for (loop(i, 0, l_asset_count))
+        {
+            Span<int8> l_blob;
+            assert_true(!l_asset_streamer.fetch(l_ids.get(i), &l_blob));
+        }
+        for (loop(i, 0, l_asset_count))
+        {
+            Span<int8> l_blob;
+            while (!l_asset_streamer.fetch(l_ids.get(i), &l_blob))
+            {
+                Thread::yield();
+            }
+            SliceN<uimax, 3> l_data = {i, i + 1, i + 2};
+            assert_true(l_data.to_slice().build_asint8().compare(l_blob.slice));
+            l_blob.free();
+        }
+        assert_true(l_asset_streamer.shared->streams.empty());
+    }
+
+    // discarded blobs are freed wherever their request is
+    {
+        for (loop(i, 0, l_asset_count))
+        {
+            Span<int8> l_blob;
+            l_asset_streamer.fetch(l_ids.get(i), &l_blob);
+        }
+        for (loop(i, 0, l_asset_count))
+        {
+            if ((i % 2) == 0)
+            {
+                l_asset_streamer.discard(l_ids.get(i));
+            }
+        }
+        for (loop(i, 0, l_asset_count))
+        {
+            if ((i % 2) == 1)
+            {
+                Span<int8> l_blob;
+                while (!l_asset_streamer.fetch(l_ids.get(i), &l_blob))
+                {
+                    Thread::yield();
+                }
+                SliceN<uimax, 3> l_data = {i, i + 1, i + 2};
+                assert_true(l_data.to_slice().build_asint8().compare(l_blob.slice));
+                l_blob.free();
+            }
+        }
+    }
+
+    // a blob requested again after being discarded is still read
+    {
+        Span<int8> l_blob;
+        l_asset_streamer.fetch(l_ids.get(0), &l_blob);
+        l_asset_streamer.discard(l_ids.get(0));
+        while (!l_asset_streamer.fetch(l_ids.get(0), &l_blob))
+        {
+            Thread::yield();
+        }
+        SliceN<uimax, 3> l_data = {0, 1, 2};
+        assert_true(l_data.to_slice().build_asint8().compare(l_blob.slice));
+        l_blob.free();
+    }
+
+    // pending requests are freed with the streamer
+    for (loop(i, 0, l_asset_count))
+    {
+        Span<int8> l_blob;
+        l_asset_streamer.fetch(l_ids.get(i), &l_blob);
+    }
+    l_asset_streamer.free();
+
+    l_ids.free();
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+inline void asset_archive_write_read()
+{
+    String l_database_path = asset_database_test_initialize(slice_int8_build_rawstr("asset.db"));
+    AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+
+    const uimax l_asset_count = 16;
+    Span<hash_t> l_ids = Span<hash_t>::allocate(l_asset_count);
+    for (loop(i, 0, l_asset_count))
+    {
+        String l_path = String::allocate_elements(slice_int8_build_rawstr("archived"));
+        l_path.append(SliceN<int8, 1>{(int8)('a' + i)}.to_slice());
+        // blob sizes cross the alignment of the archive
+        Span<uimax> l_data = Span<uimax>::allocate(i * 100 + 1);
+        for (loop(j, 0, l_data.Capacity))
+        {
+            l_data.get(j) = i + j;
+        }
+        l_ids.get(i) = l_asset_database.insert_asset_blob(l_path.to_slice(), l_data.slice.build_asint8());
+        if ((i % 2) == 0)
+        {
+            l_asset_database.insert_asset_dependencies_blob(l_path.to_slice(), l_data.slice.build_asint8());
+        }
+        l_data.free();
+        l_path.free();
+    }
+
+    String l_archive_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_archive_path.append(slice_int8_build_rawstr("asset.archive"));
+    AssetArchive::write_from_database(l_asset_database, l_archive_path.to_slice());
+
+    AssetArchive l_asset_archive = AssetArchive::allocate(l_archive_path.to_slice());
+    assert_true(l_asset_archive.assets.Size == l_asset_count);
+    assert_true(l_asset_archive.asset_dependencies.Size == (l_asset_count / 2));
+    for (loop(i, 0, l_asset_count))
+    {
+        assert_true(l_asset_archive.does_asset_exists(l_ids.get(i)));
+
+        Span<int8> l_database_blob = l_asset_database.get_asset_blob(l_ids.get(i));
+        Span<int8> l_archive_blob = l_asset_archive.get_asset_blob(l_ids.get(i));
+        assert_true(((uimax)(l_archive_blob.Memory - l_asset_archive.mapping.memory.Begin) % AssetArchive_Const::BLOB_ALIGNMENT) == 0);
+        assert_true(l_database_blob.Capacity == l_archive_blob.Capacity);
+        assert_true(l_database_blob.slice.compare(l_archive_blob.slice));
+        l_asset_archive.release_asset_blob(l_archive_blob);
+        l_asset_database.release_asset_blob(l_database_blob);
+
+        // only even assets have dependencies
+        if ((i % 2) == 0)
+        {
+            Span<int8> l_database_dependencies_blob = l_asset_database.get_asset_dependencies_blob(l_ids.get(i));
+            Span<int8> l_archive_dependencies_blob = l_asset_archive.get_asset_dependencies_blob(l_ids.get(i));
+            assert_true(l_database_dependencies_blob.Capacity == l_archive_dependencies_blob.Capacity);
+            assert_true(l_database_dependencies_blob.slice.compare(l_archive_dependencies_blob.slice));
+            l_asset_archive.release_asset_blob(l_archive_dependencies_blob);
+            l_asset_database.release_asset_blob(l_database_dependencies_blob);
+        }
+    }
+
+    hash_t l_missing_id = HashSlice(slice_int8_build_rawstr("missing"));
+    assert_true(!l_asset_archive.does_asset_exists(l_missing_id));
+
+    l_asset_archive.free();
+    l_archive_path.free();
+    l_ids.free();
+    l_asset_database.free();
+    l_database_path.free();
+};
+
+/*
+    Blobs of a version 0 database are raw, they are encoded when the database is initialized.
+*/
+inline void asset_database_schema_migration()
+{
+    String l_database_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_database_path.append(slice_int8_build_rawstr("asset.db"));
+    {
+        File l_tmp_file = File::create_or_open(l_database_path.to_slice());
+        l_tmp_file.erase_with_slicepath();
+    }
+
+    Slice<int8> l_path = slice_int8_build_rawstr("raw");
+    SliceN<uimax, 3> l_data = {7, 8, 9};
+    {
+        DatabaseConnection l_connection = DatabaseConnection::allocate(l_database_path.to_slice());
+        SQLiteQuery l_table_query = SQLiteQuery::allocate(l_connection, slice_int8_build_rawstr(AssetDatabase_Const::DB_ASSET_TABLE_INITIALIZATION));
+        SQliteQueryExecution::execute_sync(l_connection, l_table_query.statement, []() {});
+        l_table_query.free(l_connection);
+
+        SliceN<SQLiteQueryPrimitiveTypes, 3> l_parameter_types = {SQLiteQueryPrimitiveTypes::INT64, SQLiteQueryPrimitiveTypes::TEXT, SQLiteQueryPrimitiveTypes::BLOB};
+        SQLitePreparedQuery l_insert_query = SQLitePreparedQuery::allocate(l_connection, slice_int8_build_rawstr(AssetDatabase_Const::ASSET_BLOB_INSERT_QUERY),
+                                                                           SQLiteQueryLayout::build_slice(l_parameter_types.to_slice()), SQLiteQueryLayout::build_default());
+        SQLiteQueryBinder l_binder = SQLiteQueryBinder::build_default();
+        l_binder.bind_sqlitepreparedquery(l_insert_query, l_connection);
+        l_binder.bind_int64(HashSlice(l_path), l_connection);
+        l_binder.bind_text(l_path, l_connection);
+        l_binder.bind_blob(l_data.to_slice().build_asint8(), l_connection);
+        SQliteQueryExecution::execute_sync(l_connection, l_binder.binded_statement, []() {});
+        l_insert_query.free(l_connection);
+        l_connection.free();
+    }
+
+    // initializing the database a second time doesn't encode the blobs again
+    for (loop(l_iteration, 0, 2))
+    {
+        AssetDatabase::initialize_database(l_database_path.to_slice());
+        AssetDatabase l_asset_database = AssetDatabase::allocate(l_database_path.to_slice());
+        Span<int8> l_blob = l_asset_database.get_asset_blob(HashSlice(l_path));
+        assert_true(l_blob.Capacity == l_data.to_slice().build_asint8().Size);
+        assert_true(l_data.to_slice().build_asint8().compare(l_blob.slice));
+        l_asset_database.release_asset_blob(l_blob);
+        l_asset_database.free();
+    }
+
+    l_database_path.free();
+};
+
 int main()
 {
     asset_blob_insert_read_write();
+    asset_blob_compression();
     asset_dependencies_blob_read_write();
+    asset_source_hash_read_write();
+    asset_blob_batch_read();
+    asset_database_write_session();
+    asset_database_reader_concurrent_read();
+    asset_database_reader_pool();
+    asset_streamer_fetch_discard();
+    asset_archive_write_read();
+    asset_database_schema_migration();
+
+    memleak_ckeck();
 }
\ No newline at end of file
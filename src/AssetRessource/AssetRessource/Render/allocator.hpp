@@ -43,18 +43,19 @@ struct ShaderModuleRessourceUnit
         }
     };
 
-    inline void allocation_step(GPUContext& p_gpu_context, AssetDatabase& p_asset_database)
+    template <class t_AssetSource>
+    inline void allocation_step(GPUContext& p_gpu_context, t_AssetSource& p_asset_source)
     {
         for (loop_reverse(i, 0, this->shader_modules_allocation_events.Size))
         {
             auto& l_event = this->shader_modules_allocation_events.get(i);
             ShaderModuleRessource& l_ressource = this->shader_modules.pool.get(l_event.allocated_ressource);
-            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_database, l_ressource.header, &l_event.asset);
+            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_source, l_ressource.header, &l_event.asset);
 
             ShaderModuleRessource::Asset::Value l_value = ShaderModuleRessource::Asset::Value::build_from_asset(l_event.asset);
             l_ressource.shader_module = p_gpu_context.graphics_allocator.allocate_shader_module(l_value.compiled_shader);
             l_ressource.header.allocated = 1;
-            l_event.asset.free();
+            RessourceComposition::release_ressource_asset(p_asset_source, l_ressource.header, &l_event.asset);
             this->shader_modules_allocation_events.pop_back();
         }
     };
@@ -135,11 +136,13 @@ struct TextureRessourceUnit
     PoolHashedCounted<hash_t, TextureRessource> textures;
     Vector<TextureRessource::AllocationEvent> textures_allocation_events;
     Vector<TextureRessource::FreeEvent> textures_free_events;
+    // Database textures released before being allocated, their blob is no more needed by the AssetStreamer
+    Vector<hash_t> textures_discarded_streams;
 
     inline static TextureRessourceUnit allocate()
     {
         return TextureRessourceUnit{PoolHashedCounted<hash_t, TextureRessource>::allocate_default(), Vector<TextureRessource::AllocationEvent>::allocate(0),
-                                    Vector<TextureRessource::FreeEvent>::allocate(0)};
+                                    Vector<TextureRessource::FreeEvent>::allocate(0), Vector<hash_t>::allocate(0)};
     };
 
     inline void free()
@@ -149,6 +152,7 @@ struct TextureRessourceUnit
         assert_true(this->textures_free_events.empty());
         assert_true(this->textures.empty());
 #endif
+        this->textures_discarded_streams.free();
         this->textures_free_events.free();
         this->textures_allocation_events.free();
         this->textures.free();
@@ -173,25 +177,50 @@ struct TextureRessourceUnit
         }
     };
 
-    inline void allocation_step(GPUContext& p_gpu_context, AssetDatabase& p_asset_database)
+    template <class t_AssetSource>
+    inline void allocation_step(GPUContext& p_gpu_context, t_AssetSource& p_asset_source)
     {
+        this->textures_discarded_streams.clear();
         for (loop_reverse(i, 0, this->textures_allocation_events.Size))
         {
             auto& l_event = this->textures_allocation_events.get(i);
             TextureRessource& l_ressource = this->textures.pool.get(l_event.allocated_ressource);
 
-            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_database, l_ressource.header, &l_event.asset);
+            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_source, l_ressource.header, &l_event.asset);
+            this->allocate_texture(p_gpu_context, l_ressource, l_event.asset);
+
+            RessourceComposition::release_ressource_asset(p_asset_source, l_ressource.header, &l_event.asset);
+            this->textures_allocation_events.pop_back();
+        }
+    };
+
+    /*
+        Database textures are read by the AssetStreamer, they stay in the allocation events until their blob has been read.
+        Textures are uploaded as long as there is some upload budget left.
+    */
+    inline void allocation_step_streamed(GPUContext& p_gpu_context, AssetStreamer& p_asset_streamer, uimax* in_out_upload_budget)
+    {
+        for (loop(i, 0, this->textures_discarded_streams.Size))
+        {
+            p_asset_streamer.discard(this->textures_discarded_streams.get(i));
+        }
+        this->textures_discarded_streams.clear();
 
-            TextureRessource::Asset::Value l_value = TextureRessource::Asset::Value::build_from_asset(l_event.asset);
-            l_ressource.texture = ShaderParameterBufferAllocationFunctions::allocate_texture_gpu_for_shaderparameter(p_gpu_context.graphics_allocator, p_gpu_context.buffer_memory,
-                                                                                                                     ImageFormat::build_color_2d(l_value.size, ImageUsageFlag::UNDEFINED));
-            TextureGPU& l_texture_gpu = p_gpu_context.graphics_allocator.heap.textures_gpu.get(l_ressource.texture);
-            BufferReadWrite::write_to_imagegpu(p_gpu_context.buffer_memory.allocator, p_gpu_context.buffer_memory.events, l_texture_gpu.Image,
-                                               p_gpu_context.buffer_memory.allocator.gpu_images.get(l_texture_gpu.Image), l_value.pixels);
+        for (loop_reverse(i, 0, this->textures_allocation_events.Size))
+        {
+            auto& l_event = this->textures_allocation_events.get(i);
+            TextureRessource& l_ressource = this->textures.pool.get(l_event.allocated_ressource);
+
+            if (!RessourceComposition::stream_ressource_asset_from_database_if_necessary(p_asset_streamer, l_ressource.header, &l_event.asset) || *in_out_upload_budget == 0)
+            {
+                continue;
+            }
+
+            this->allocate_texture(p_gpu_context, l_ressource, l_event.asset);
+            RessourceComposition::consume_upload_budget(l_event.asset.allocated_binary.Capacity, in_out_upload_budget);
 
             l_event.asset.free();
-            l_ressource.header.allocated = 1;
-            this->textures_allocation_events.pop_back();
+            this->textures_allocation_events.erase_element_at_always(i);
         }
     };
 
@@ -218,6 +247,11 @@ struct TextureRessourceUnit
             RessourceComposition::free_ressource_composition_2(this->textures, this->textures_free_events, this->textures_allocation_events, this->textures.pool.get(p_texture_ressource));
         if (l_free_return_code == RessourceComposition::FreeRessourceCompositionReturnCode::POOL_DEALLOCATION_AWAITING)
         {
+            TextureRessource& l_ressource = this->textures.pool.get(p_texture_ressource);
+            if (l_ressource.header.allocation_type == RessourceAllocationType::ASSET_DATABASE)
+            {
+                this->textures_discarded_streams.push_back_element(l_ressource.header.id);
+            }
             this->textures.pool.release_element(p_texture_ressource);
         }
     };
@@ -231,6 +265,48 @@ struct TextureRessourceUnit
     {
         return this->textures.has_key_nothashed(p_id);
     };
+
+  private:
+    inline void allocate_texture(GPUContext& p_gpu_context, TextureRessource& p_ressource, const TextureRessource::Asset& p_asset)
+    {
+        TextureRessource::Asset::Value l_value = TextureRessource::Asset::Value::build_from_asset(p_asset);
+
+        // Block compressed textures are decoded when the GraphicsCard can't sample them
+        Span<int8, ScratchAllocator> l_decoded_pixels = Span<int8, ScratchAllocator>::build_default();
+        if (l_value.format != TextureAssetFormat::R8G8B8A8_SRGB && !p_gpu_context.instance.graphics_card.texture_compression_bc)
+        {
+            l_decoded_pixels = BCnDecoder::allocate_decoded_mips(l_value);
+            l_value.format = TextureAssetFormat::R8G8B8A8_SRGB;
+            l_value.pixels = l_decoded_pixels.slice;
+        }
+
+        p_ressource.texture = ShaderParameterBufferAllocationFunctions::allocate_texture_gpu_for_shaderparameter(
+            p_gpu_context.graphics_allocator, p_gpu_context.buffer_memory,
+            ImageFormat::build_color_2d_with_format(l_value.size, get_vkformat(l_value.format), l_value.mip_count, ImageUsageFlag::UNDEFINED));
+        TextureGPU& l_texture_gpu = p_gpu_context.graphics_allocator.heap.textures_gpu.get(p_ressource.texture);
+        BufferReadWrite::write_to_imagegpu(p_gpu_context.buffer_memory.allocator, p_gpu_context.buffer_memory.events, l_texture_gpu.Image,
+                                           p_gpu_context.buffer_memory.allocator.gpu_images.get(l_texture_gpu.Image), l_value.pixels);
+        // Pixels have been copied to the staging buffer
+        l_decoded_pixels.free();
+        p_ressource.header.allocated = 1;
+    };
+
+    inline static VkFormat get_vkformat(const TextureAssetFormat p_format)
+    {
+        switch (p_format)
+        {
+        case TextureAssetFormat::R8G8B8A8_SRGB:
+            return VkFormat::VK_FORMAT_R8G8B8A8_SRGB;
+        case TextureAssetFormat::BC1_SRGB:
+            return VkFormat::VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case TextureAssetFormat::BC3_SRGB:
+            return VkFormat::VK_FORMAT_BC3_SRGB_BLOCK;
+        case TextureAssetFormat::BC7_SRGB:
+            return VkFormat::VK_FORMAT_BC7_SRGB_BLOCK;
+        default:
+            abort();
+        }
+    };
 };
 
 struct TextureRessourceComposition
@@ -271,10 +347,13 @@ struct MeshRessourceUnit
     PoolHashedCounted<hash_t, MeshRessource> meshes;
     Vector<MeshRessource::AllocationEvent> meshes_allocation_events;
     Vector<MeshRessource::FreeEvent> meshes_free_events;
+    // Database meshes released before being allocated, their blob is no more needed by the AssetStreamer
+    Vector<hash_t> meshes_discarded_streams;
 
     inline static MeshRessourceUnit allocate()
     {
-        return MeshRessourceUnit{PoolHashedCounted<hash_t, MeshRessource>::allocate_default(), Vector<MeshRessource::AllocationEvent>::allocate(0), Vector<MeshRessource::FreeEvent>::allocate(0)};
+        return MeshRessourceUnit{PoolHashedCounted<hash_t, MeshRessource>::allocate_default(), Vector<MeshRessource::AllocationEvent>::allocate(0), Vector<MeshRessource::FreeEvent>::allocate(0),
+                                 Vector<hash_t>::allocate(0)};
     };
 
     inline void free()
@@ -284,6 +363,7 @@ struct MeshRessourceUnit
         assert_true(this->meshes_free_events.empty());
         assert_true(this->meshes.empty());
 #endif
+        this->meshes_discarded_streams.free();
         this->meshes_free_events.free();
         this->meshes_allocation_events.free();
         this->meshes.free();
@@ -303,28 +383,62 @@ struct MeshRessourceUnit
             auto& l_event = this->meshes_free_events.get(i);
             MeshRessource& l_ressource = this->meshes.pool.get(l_event.ressource);
             D3RendererAllocatorComposition::free_mesh_with_buffers(p_gpu_context.buffer_memory, p_renderer.allocator, l_ressource.mesh);
+            for (loop(j, 0, l_ressource.lods.count))
+            {
+                D3RendererAllocatorComposition::free_mesh_with_buffers(p_gpu_context.buffer_memory, p_renderer.allocator, l_ressource.lods.meshes.get(j));
+            }
             this->meshes.pool.release_element(l_event.ressource);
             this->meshes_free_events.pop_back();
         }
     };
 
-    inline void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, AssetDatabase& p_asset_database)
+    template <class t_AssetSource>
+    inline void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, t_AssetSource& p_asset_source)
     {
+        this->meshes_discarded_streams.clear();
         for (loop_reverse(i, 0, this->meshes_allocation_events.Size))
         {
             auto& l_event = this->meshes_allocation_events.get(i);
 
             MeshRessource& l_ressource = this->meshes.pool.get(l_event.allocated_ressource);
-            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_database, l_ressource.header, &l_event.asset);
+            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_source, l_ressource.header, &l_event.asset);
+            this->allocate_mesh(p_renderer, p_gpu_context, l_ressource, l_event.asset);
 
-            MeshRessource::Asset::Value l_value = MeshRessource::Asset::Value::build_from_asset(l_event.asset);
-            l_ressource.mesh = D3RendererAllocatorComposition::allocate_mesh_with_buffers(p_gpu_context.buffer_memory, p_renderer.allocator, l_value.initial_vertices, l_value.initial_indices);
-            l_ressource.header.allocated = 1;
-            l_event.asset.free();
+            RessourceComposition::release_ressource_asset(p_asset_source, l_ressource.header, &l_event.asset);
             this->meshes_allocation_events.pop_back();
         }
     };
 
+    /*
+        Database meshes are read by the AssetStreamer, they stay in the allocation events until their blob has been read.
+        Meshes are uploaded as long as there is some upload budget left.
+    */
+    inline void allocation_step_streamed(D3Renderer& p_renderer, GPUContext& p_gpu_context, AssetStreamer& p_asset_streamer, uimax* in_out_upload_budget)
+    {
+        for (loop(i, 0, this->meshes_discarded_streams.Size))
+        {
+            p_asset_streamer.discard(this->meshes_discarded_streams.get(i));
+        }
+        this->meshes_discarded_streams.clear();
+
+        for (loop_reverse(i, 0, this->meshes_allocation_events.Size))
+        {
+            auto& l_event = this->meshes_allocation_events.get(i);
+            MeshRessource& l_ressource = this->meshes.pool.get(l_event.allocated_ressource);
+
+            if (!RessourceComposition::stream_ressource_asset_from_database_if_necessary(p_asset_streamer, l_ressource.header, &l_event.asset) || *in_out_upload_budget == 0)
+            {
+                continue;
+            }
+
+            this->allocate_mesh(p_renderer, p_gpu_context, l_ressource, l_event.asset);
+            RessourceComposition::consume_upload_budget(l_event.asset.allocated_binary.Capacity, in_out_upload_budget);
+
+            l_event.asset.free();
+            this->meshes_allocation_events.erase_element_at_always(i);
+        }
+    };
+
     inline Token(MeshRessource) allocate_ressource(const hash_t p_id, const RessourceAllocationType p_ressource_allocation_type, const MeshRessource::Asset& p_asset)
     {
         Token(MeshRessource) l_mesh_ressource = this->meshes.push_back_element(p_id, MeshRessource{RessourceIdentifiedHeader{p_ressource_allocation_type, 0, p_id}});
@@ -347,6 +461,11 @@ struct MeshRessourceUnit
         auto l_free_return_code = RessourceComposition::free_ressource_composition_2(this->meshes, this->meshes_free_events, this->meshes_allocation_events, this->meshes.pool.get(p_mesh_ressource));
         if (l_free_return_code == RessourceComposition::FreeRessourceCompositionReturnCode::POOL_DEALLOCATION_AWAITING)
         {
+            MeshRessource& l_ressource = this->meshes.pool.get(p_mesh_ressource);
+            if (l_ressource.header.allocation_type == RessourceAllocationType::ASSET_DATABASE)
+            {
+                this->meshes_discarded_streams.push_back_element(l_ressource.header.id);
+            }
             this->meshes.pool.release_element(p_mesh_ressource);
         }
     };
@@ -360,6 +479,26 @@ struct MeshRessourceUnit
     {
         return this->meshes.has_key_nothashed(p_id);
     };
+
+  private:
+    inline void allocate_mesh(D3Renderer& p_renderer, GPUContext& p_gpu_context, MeshRessource& p_ressource, const MeshRessource::Asset& p_asset)
+    {
+        MeshRessource::Asset::Value l_value = MeshRessource::Asset::Value::build_from_asset(p_asset);
+        p_ressource.mesh = allocate_lod_mesh(p_renderer, p_gpu_context, l_value.get_full_lod());
+        p_ressource.lods.count = l_value.lod_count;
+        for (loop(i, 0, l_value.lod_count))
+        {
+            p_ressource.lods.meshes.get(i) = allocate_lod_mesh(p_renderer, p_gpu_context, l_value.lods.get(i));
+            p_ressource.lods.errors.get(i) = l_value.lods.get(i).error;
+        }
+        p_ressource.header.allocated = 1;
+    };
+
+    inline static Token(Mesh) allocate_lod_mesh(D3Renderer& p_renderer, GPUContext& p_gpu_context, const MeshRessource::Asset::LOD& p_lod)
+    {
+        return D3RendererAllocatorComposition::allocate_mesh_with_buffers(p_gpu_context.buffer_memory, p_renderer.allocator, p_lod.vertices, p_lod.get_indices_binary(),
+                                                                          p_lod.has_16_bit_indices() ? BufferIndexType::UINT16 : BufferIndexType::UINT32);
+    };
 };
 
 struct MeshRessourceComposition
@@ -438,14 +577,15 @@ struct ShaderRessourceUnit
         }
     };
 
-    inline void allocation_step(ShaderModuleRessourceUnit& p_shader_module_unit, D3Renderer& p_renderer, GPUContext& p_gpu_context, AssetDatabase& p_asset_database)
+    template <class t_AssetSource>
+    inline void allocation_step(ShaderModuleRessourceUnit& p_shader_module_unit, D3Renderer& p_renderer, GPUContext& p_gpu_context, t_AssetSource& p_asset_source)
     {
         for (loop_reverse(i, 0, this->shaders_allocation_events.Size))
         {
             auto& l_event = this->shaders_allocation_events.get(i);
             ShaderRessource& l_ressource = this->shaders.pool.get(l_event.allocated_ressource);
 
-            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_database, l_ressource.header, &l_event.asset);
+            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_source, l_ressource.header, &l_event.asset);
 
             ShaderModuleRessource& l_vertex_shader = p_shader_module_unit.shader_modules.pool.get(l_ressource.dependencies.vertex_shader);
             ShaderModuleRessource& l_fragment_shader = p_shader_module_unit.shader_modules.pool.get(l_ressource.dependencies.fragment_shader);
@@ -455,7 +595,7 @@ struct ShaderRessourceUnit
                 p_gpu_context.graphics_allocator, p_renderer.allocator, l_value.specific_parameters, l_value.execution_order,
                 p_gpu_context.graphics_allocator.heap.graphics_pass.get(p_renderer.color_step.pass), l_value.shader_configuration,
                 p_gpu_context.graphics_allocator.heap.shader_modules.get(l_vertex_shader.shader_module), p_gpu_context.graphics_allocator.heap.shader_modules.get(l_fragment_shader.shader_module));
-            l_event.asset.free();
+            RessourceComposition::release_ressource_asset(p_asset_source, l_ressource.header, &l_event.asset);
             l_ressource.header.allocated = 1;
             this->shaders_allocation_events.pop_back();
         }
@@ -611,14 +751,21 @@ struct MaterialRessourceUnit
         }
     };
 
-    inline void allocation_step(ShaderRessourceUnit& p_shader_unit, TextureRessourceUnit& p_texture_unit, D3Renderer& p_renderer, GPUContext& p_gpu_context, AssetDatabase& p_asset_database)
+    template <class t_AssetSource>
+    inline void allocation_step(ShaderRessourceUnit& p_shader_unit, TextureRessourceUnit& p_texture_unit, D3Renderer& p_renderer, GPUContext& p_gpu_context, t_AssetSource& p_asset_source)
     {
         for (loop_reverse(i, 0, this->materials_allocation_events.Size))
         {
             auto& l_event = this->materials_allocation_events.get(i);
             MaterialRessource& l_ressource = this->materials.pool.get(l_event.allocated_ressource);
 
-            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_database, l_ressource.header, &l_event.asset);
+            // Streamed textures may not be allocated yet
+            if (!this->are_textures_allocated(p_texture_unit, l_ressource))
+            {
+                continue;
+            }
+
+            RessourceComposition::retrieve_ressource_asset_from_database_if_necessary(p_asset_source, l_ressource.header, &l_event.asset);
 
             ShaderRessource& l_shader = p_shader_unit.shaders.pool.get(l_ressource.dependencies.shader);
             ShaderIndex& l_shader_index = p_renderer.allocator.heap.shaders.get(l_shader.shader);
@@ -653,9 +800,9 @@ struct MaterialRessourceUnit
             l_ressource.material = p_renderer.allocator.allocate_material(l_material_value);
             p_renderer.allocator.heap.link_shader_with_material(l_shader.shader, l_ressource.material);
 
-            l_event.asset.free();
+            RessourceComposition::release_ressource_asset(p_asset_source, l_ressource.header, &l_event.asset);
             l_ressource.header.allocated = 1;
-            this->materials_allocation_events.pop_back();
+            this->materials_allocation_events.erase_element_at_always(i);
         }
     };
 
@@ -692,6 +839,33 @@ struct MaterialRessourceUnit
     {
         return this->materials.has_key_nothashed(p_id);
     };
+
+    // Ids of the database materials that will be allocated by the next allocation_step (their textures are allocated)
+    inline void push_allocatable_database_asset_ids(TextureRessourceUnit& p_texture_unit, Vector<hash_t>* in_out_asset_ids)
+    {
+        for (loop(i, 0, this->materials_allocation_events.Size))
+        {
+            MaterialRessource& l_ressource = this->materials.pool.get(this->materials_allocation_events.get(i).allocated_ressource);
+            if (l_ressource.header.allocation_type == RessourceAllocationType::ASSET_DATABASE && this->are_textures_allocated(p_texture_unit, l_ressource))
+            {
+                in_out_asset_ids->push_back_element(l_ressource.header.id);
+            }
+        }
+    };
+
+  private:
+    inline int8 are_textures_allocated(TextureRessourceUnit& p_texture_unit, const MaterialRessource& p_material)
+    {
+        Slice<MaterialRessource::DynamicDependency> l_dynamic_dependencies = this->material_dynamic_dependencies.get_vector(p_material.dependencies.dynamic_dependencies);
+        for (loop(i, 0, l_dynamic_dependencies.Size))
+        {
+            if (!p_texture_unit.textures.pool.get(l_dynamic_dependencies.get(i).dependency).header.allocated)
+            {
+                return 0;
+            }
+        }
+        return 1;
+    };
 };
 
 struct MaterialRessourceComposition
@@ -760,9 +934,10 @@ struct MaterialRessourceComposition
         }
     };
 
+    template <class t_AssetSource>
     inline static Token(MaterialRessource)
         allocate_or_increment_database_and_load_dependecies(MaterialRessourceUnit& p_unit, ShaderRessourceUnit& p_shader_unit, ShaderModuleRessourceUnit& p_shader_module_unit,
-                                                            TextureRessourceUnit& p_texture_unit, AssetDatabase& p_asset_database, const hash_t p_id)
+                                                            TextureRessourceUnit& p_texture_unit, t_AssetSource& p_asset_source, const hash_t p_id)
     {
         if (p_unit.is_ressource_id_allocated(p_id))
         {
@@ -770,7 +945,7 @@ struct MaterialRessourceComposition
         }
         else
         {
-            Span<int8> l_asset_dependencies = p_asset_database.get_asset_dependencies_blob(p_id);
+            Span<int8> l_asset_dependencies = p_asset_source.get_asset_dependencies_blob(p_id);
             MaterialRessource::AssetDependencies::Value l_asset_dependencies_value =
                 MaterialRessource::AssetDependencies::Value::build_from_asset(MaterialRessource::AssetDependencies{l_asset_dependencies});
 
@@ -782,7 +957,7 @@ struct MaterialRessourceComposition
                 allocate_database(p_unit, p_shader_unit, p_shader_module_unit, p_texture_unit, l_material_database_input, ShaderRessource::DatabaseAllocationInput{l_asset_dependencies_value.shader},
                                   ShaderModuleRessource::DatabaseAllocationInput{l_asset_dependencies_value.shader_dependencies.vertex_module},
                                   ShaderModuleRessource::DatabaseAllocationInput{l_asset_dependencies_value.shader_dependencies.fragment_module});
-            l_asset_dependencies.free();
+            p_asset_source.release_asset_blob(l_asset_dependencies);
             return l_material_ressource;
         }
     };
@@ -823,6 +998,12 @@ struct MaterialRessourceComposition
         }
     };
 };
+namespace RenderRessourceAllocator2_const
+{
+// Number of bytes of streamed mesh and texture assets that are uploaded to the GPU in a single allocation step
+constexpr uimax STREAMING_UPLOAD_BUDGET = 8 * 1024 * 1024;
+}; // namespace RenderRessourceAllocator2_const
+
 /*
     The RenderRessourceAllocator2 is resposible of allocating "AssetRessources" for the Render system.
     AssetRessources are internal data that can either be retrieved from the AssetDatabase or by providing an inline blob.
@@ -863,6 +1044,12 @@ struct RenderRessourceAllocator2
         this->material_unit.free();
     };
 
+    inline int8 has_deallocation_events()
+    {
+        return !this->material_unit.materials_free_events.empty() || !this->texture_unit.textures_free_events.empty() || !this->shader_unit.shaders_free_events.empty() ||
+               !this->mesh_unit.meshes_free_events.empty() || !this->shader_module_unit.shader_modules_free_events.empty();
+    };
+
     inline void deallocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context)
     {
         this->material_unit.deallocation_step(this->shader_unit, p_renderer, p_gpu_context);
@@ -872,12 +1059,75 @@ struct RenderRessourceAllocator2
         this->shader_module_unit.deallocation_step(p_gpu_context);
     };
 
+    /*
+        The p_asset_source is an AssetArchive or an AssetBlobBatch.
+        Assets read from an AssetArchive are uploaded from the mapped archive without being copied.
+    */
+    template <class t_AssetSource>
+    inline void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, t_AssetSource& p_asset_source)
+    {
+        this->shader_module_unit.allocation_step(p_gpu_context, p_asset_source);
+        this->mesh_unit.allocation_step(p_renderer, p_gpu_context, p_asset_source);
+        this->shader_unit.allocation_step(this->shader_module_unit, p_renderer, p_gpu_context, p_asset_source);
+        this->texture_unit.allocation_step(p_gpu_context, p_asset_source);
+        this->material_unit.allocation_step(this->shader_unit, this->texture_unit, p_renderer, p_gpu_context, p_asset_source);
+    };
+
+    // The blobs of all database ressources allocated by the step are read at once with AssetDatabase::get_asset_blobs
     inline void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, AssetDatabase& p_asset_database)
     {
-        this->shader_module_unit.allocation_step(p_gpu_context, p_asset_database);
-        this->mesh_unit.allocation_step(p_renderer, p_gpu_context, p_asset_database);
-        this->shader_unit.allocation_step(this->shader_module_unit, p_renderer, p_gpu_context, p_asset_database);
-        this->texture_unit.allocation_step(p_gpu_context, p_asset_database);
-        this->material_unit.allocation_step(this->shader_unit, this->texture_unit, p_renderer, p_gpu_context, p_asset_database);
+        Vector<hash_t> l_asset_ids = Vector<hash_t>::allocate(0);
+        push_database_asset_ids(this->shader_module_unit.shader_modules_allocation_events, this->shader_module_unit.shader_modules, &l_asset_ids);
+        push_database_asset_ids(this->mesh_unit.meshes_allocation_events, this->mesh_unit.meshes, &l_asset_ids);
+        push_database_asset_ids(this->shader_unit.shaders_allocation_events, this->shader_unit.shaders, &l_asset_ids);
+        push_database_asset_ids(this->texture_unit.textures_allocation_events, this->texture_unit.textures, &l_asset_ids);
+        push_database_asset_ids(this->material_unit.materials_allocation_events, this->material_unit.materials, &l_asset_ids);
+
+        AssetBlobBatch l_asset_blobs = p_asset_database.get_asset_blobs(l_asset_ids.to_slice());
+        this->allocation_step(p_renderer, p_gpu_context, l_asset_blobs);
+
+        l_asset_blobs.free();
+        l_asset_ids.free();
+    };
+
+    /*
+        Meshes and textures from the AssetDatabase are read by the AssetStreamer instead of being read by the calling thread.
+        They are allocated over multiple steps, as soon as their blob has been read and while the p_upload_budget (in bytes) is not consumed.
+        Ressources that depend on them (materials and renderable objects) are allocated once their dependencies are.
+        Blobs of the other ressources (shader modules, shaders and materials) are read at once with AssetDatabase::get_asset_blobs.
+    */
+    inline void allocation_step_streamed(D3Renderer& p_renderer, GPUContext& p_gpu_context, AssetDatabase& p_asset_database, AssetStreamer& p_asset_streamer, const uimax p_upload_budget)
+    {
+        uimax l_upload_budget = p_upload_budget;
+        this->mesh_unit.allocation_step_streamed(p_renderer, p_gpu_context, p_asset_streamer, &l_upload_budget);
+        this->texture_unit.allocation_step_streamed(p_gpu_context, p_asset_streamer, &l_upload_budget);
+
+        // Materials are batched once the textures streamed by this step are allocated
+        Vector<hash_t> l_asset_ids = Vector<hash_t>::allocate(0);
+        push_database_asset_ids(this->shader_module_unit.shader_modules_allocation_events, this->shader_module_unit.shader_modules, &l_asset_ids);
+        push_database_asset_ids(this->shader_unit.shaders_allocation_events, this->shader_unit.shaders, &l_asset_ids);
+        this->material_unit.push_allocatable_database_asset_ids(this->texture_unit, &l_asset_ids);
+
+        AssetBlobBatch l_asset_blobs = p_asset_database.get_asset_blobs(l_asset_ids.to_slice());
+        this->shader_module_unit.allocation_step(p_gpu_context, l_asset_blobs);
+        this->shader_unit.allocation_step(this->shader_module_unit, p_renderer, p_gpu_context, l_asset_blobs);
+        this->material_unit.allocation_step(this->shader_unit, this->texture_unit, p_renderer, p_gpu_context, l_asset_blobs);
+
+        l_asset_blobs.free();
+        l_asset_ids.free();
+    };
+
+  private:
+    template <class t_AllocationEvent, class t_Ressource>
+    inline static void push_database_asset_ids(Vector<t_AllocationEvent>& p_allocation_events, PoolHashedCounted<hash_t, t_Ressource>& p_ressources, Vector<hash_t>* in_out_asset_ids)
+    {
+        for (loop(i, 0, p_allocation_events.Size))
+        {
+            t_Ressource& l_ressource = p_ressources.pool.get(p_allocation_events.get(i).allocated_ressource);
+            if (l_ressource.header.allocation_type == RessourceAllocationType::ASSET_DATABASE)
+            {
+                in_out_asset_ids->push_back_element(l_ressource.header.id);
+            }
+        }
     };
 };
@@ -0,0 +1,229 @@
+#pragma once
+
+/*
+    CPU decoder of block compressed textures (BC1, BC3 and BC7), used when the GraphicsCard can't sample them.
+    BC7 blocks must be encoded with the mode 6, the only one written by the BCnCompiler.
+*/
+struct BCnDecoder
+{
+    /*
+        Decodes every mip of p_value to R8G8B8A8 pixels, mips are stored as described in TextureRessource::Asset::Value.
+        The pixels are allocated from the scratch arena of the calling thread.
+    */
+    inline static Span<int8, ScratchAllocator> allocate_decoded_mips(const TextureRessource::Asset::Value& p_value)
+    {
+        uimax l_decoded_size = 0;
+        for (loop(i, 0, p_value.mip_count))
+        {
+            l_decoded_size += TextureRessource::Asset::Value::get_mip_memory_size(TextureAssetFormat::R8G8B8A8_SRGB, p_value.size, (uint32)i);
+        }
+
+        Span<int8, ScratchAllocator> l_decoded = Span<int8, ScratchAllocator>::allocate(l_decoded_size);
+        uimax l_block_size = TextureRessource::Asset::Value::get_block_size(p_value.format);
+        const int8* l_block_cursor = p_value.pixels.Begin;
+        uimax l_pixel_offset = 0;
+        for (loop(l_mip, 0, p_value.mip_count))
+        {
+            v3ui l_mip_size = TextureRessource::Asset::Value::get_mip_size(p_value.size, (uint32)l_mip);
+            color* l_mip_pixels = (color*)(l_decoded.Memory + l_pixel_offset);
+            for (uint32 l_block_y = 0; l_block_y < l_mip_size.y; l_block_y += 4)
+            {
+                for (uint32 l_block_x = 0; l_block_x < l_mip_size.x; l_block_x += 4)
+                {
+                    color l_block[16];
+                    decode_block(p_value.format, l_block_cursor, l_block);
+                    l_block_cursor += l_block_size;
+
+                    // Pixels of edge blocks that are outside of the image are dropped
+                    for (uint32 y = 0; y < 4 && (l_block_y + y) < l_mip_size.y; y++)
+                    {
+                        for (uint32 x = 0; x < 4 && (l_block_x + x) < l_mip_size.x; x++)
+                        {
+                            l_mip_pixels[((uimax)(l_block_y + y) * l_mip_size.x) + l_block_x + x] = l_block[(y * 4) + x];
+                        }
+                    }
+                }
+            }
+            l_pixel_offset += (uimax)l_mip_size.x * l_mip_size.y * sizeof(color);
+        }
+
+        return l_decoded;
+    };
+
+    inline static void decode_block(const TextureAssetFormat p_format, const int8* p_block, color* out_block)
+    {
+        switch (p_format)
+        {
+        case TextureAssetFormat::BC1_SRGB:
+            decode_bc1_block(p_block, out_block);
+            break;
+        case TextureAssetFormat::BC3_SRGB:
+            decode_bc3_block(p_block, out_block);
+            break;
+        case TextureAssetFormat::BC7_SRGB:
+            decode_bc7_block(p_block, out_block);
+            break;
+        default:
+            abort();
+        }
+    };
+
+    inline static void decode_bc1_block(const int8* p_block, color* out_block)
+    {
+        decode_color_block(p_block, 1, out_block);
+    };
+
+    // 8 bytes of alpha, followed by a color block that is always in the 4 colors mode
+    inline static void decode_bc3_block(const int8* p_block, color* out_block)
+    {
+        decode_color_block(p_block + 8, 0, out_block);
+        decode_alpha_block(p_block, out_block);
+    };
+
+    inline static void decode_bc7_block(const int8* p_block, color* out_block)
+    {
+        BlockBitReader l_reader = BlockBitReader::build(p_block);
+#if RENDER_BOUND_TEST
+        assert_true(l_reader.read(7) == (1 << 6));
+#else
+        l_reader.read(7);
+#endif
+
+        int32 l_endpoints[2][4];
+        for (loop(c, 0, 4))
+        {
+            l_endpoints[0][c] = (int32)l_reader.read(7);
+            l_endpoints[1][c] = (int32)l_reader.read(7);
+        }
+        int32 l_pbit_0 = (int32)l_reader.read(1);
+        int32 l_pbit_1 = (int32)l_reader.read(1);
+
+        for (loop(i, 0, 16))
+        {
+            // The most significant bit of the first index is not stored, it is 0
+            int32 l_weight = bc7_weights_4()[l_reader.read(i == 0 ? 3 : 4)];
+            for (loop(c, 0, 4))
+            {
+                int32 l_endpoint_0 = (l_endpoints[0][c] << 1) | l_pbit_0;
+                int32 l_endpoint_1 = (l_endpoints[1][c] << 1) | l_pbit_1;
+                out_block[i].Points[c] = (uint8)((((64 - l_weight) * l_endpoint_0) + (l_weight * l_endpoint_1) + 32) >> 6);
+            }
+        }
+    };
+
+  private:
+    struct BlockBitReader
+    {
+        const uint8* block;
+        uimax bit_index;
+
+        inline static BlockBitReader build(const int8* p_block)
+        {
+            return BlockBitReader{(const uint8*)p_block, 0};
+        };
+
+        // Bits are read from the least significant bit of the block
+        inline uint32 read(const uimax p_bit_count)
+        {
+            uint32 l_value = 0;
+            for (loop(i, 0, p_bit_count))
+            {
+                l_value |= (uint32)((this->block[this->bit_index >> 3] >> (this->bit_index & 7)) & 1) << i;
+                this->bit_index += 1;
+            }
+            return l_value;
+        };
+    };
+
+    inline static const int32* bc7_weights_4()
+    {
+        static const int32 l_weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        return l_weights;
+    };
+
+    inline static void from_rgb565(const uint16 p_color, int32* out_color)
+    {
+        int32 l_r = (p_color >> 11) & 31;
+        int32 l_g = (p_color >> 5) & 63;
+        int32 l_b = p_color & 31;
+        out_color[0] = (l_r << 3) | (l_r >> 2);
+        out_color[1] = (l_g << 2) | (l_g >> 4);
+        out_color[2] = (l_b << 3) | (l_b >> 2);
+    };
+
+    /*
+        When p_three_colors_allowed is set and the first endpoint is not greater than the second, the block is in the 3 colors mode
+        where the last index is a transparent black. Otherwise colors are opaque.
+    */
+    inline static void decode_color_block(const int8* p_block, const int8 p_three_colors_allowed, color* out_block)
+    {
+        BlockBitReader l_reader = BlockBitReader::build(p_block);
+        uint16 l_endpoint_0 = (uint16)l_reader.read(16);
+        uint16 l_endpoint_1 = (uint16)l_reader.read(16);
+
+        int32 l_palette[4][4];
+        from_rgb565(l_endpoint_0, l_palette[0]);
+        from_rgb565(l_endpoint_1, l_palette[1]);
+        l_palette[0][3] = 255;
+        l_palette[1][3] = 255;
+        if (l_endpoint_0 > l_endpoint_1 || !p_three_colors_allowed)
+        {
+            for (loop(c, 0, 3))
+            {
+                l_palette[2][c] = ((2 * l_palette[0][c]) + l_palette[1][c]) / 3;
+                l_palette[3][c] = (l_palette[0][c] + (2 * l_palette[1][c])) / 3;
+            }
+            l_palette[2][3] = 255;
+            l_palette[3][3] = 255;
+        }
+        else
+        {
+            for (loop(c, 0, 3))
+            {
+                l_palette[2][c] = (l_palette[0][c] + l_palette[1][c]) / 2;
+                l_palette[3][c] = 0;
+            }
+            l_palette[2][3] = 255;
+            l_palette[3][3] = 0;
+        }
+
+        for (loop(i, 0, 16))
+        {
+            uint32 l_index = l_reader.read(2);
+            for (loop(c, 0, 4))
+            {
+                out_block[i].Points[c] = (uint8)l_palette[l_index][c];
+            }
+        }
+    };
+
+    // When the first endpoint is not greater than the second, the block is in the 6 alphas mode where the last two indices are 0 and 255
+    inline static void decode_alpha_block(const int8* p_block, color* out_block)
+    {
+        BlockBitReader l_reader = BlockBitReader::build(p_block);
+        int32 l_palette[8];
+        l_palette[0] = (int32)l_reader.read(8);
+        l_palette[1] = (int32)l_reader.read(8);
+        if (l_palette[0] > l_palette[1])
+        {
+            for (loop(i, 2, 8))
+            {
+                l_palette[i] = ((((int32)(8 - i)) * l_palette[0]) + (((int32)(i - 1)) * l_palette[1])) / 7;
+            }
+        }
+        else
+        {
+            for (loop(i, 2, 6))
+            {
+                l_palette[i] = ((((int32)(6 - i)) * l_palette[0]) + (((int32)(i - 1)) * l_palette[1])) / 5;
+            }
+            l_palette[6] = 0;
+            l_palette[7] = 255;
+        }
+
+        for (loop(i, 0, 16))
+        {
+            out_block[i].w = (uint8)l_palette[l_reader.read(3)];
+        }
+    };
+};
@@ -100,11 +100,63 @@ struct ShaderModuleRessource
     };
 };
 
+namespace MeshRessource_Const
+{
+// Simplified meshes generated by the AssetCompiler, the full resolution mesh is not counted
+constexpr uimax MAX_LOD_COUNT = 3;
+// A LOD is drawn if it's simplification error, divided by the camera distance, is lower than this ratio (roughly one pixel of a 1080p screen with a 60 degrees fov)
+constexpr float32 LOD_ERROR_PER_DISTANCE = 0.001f;
+// The LOD is changed only when the ratio crosses the threshold by this fraction, so that objects at the limit don't switch every frame
+constexpr float32 LOD_HYSTERESIS = 0.2f;
+}; // namespace MeshRessource_Const
+
 struct MeshRessource
 {
     RessourceIdentifiedHeader header;
     Token(Mesh) mesh;
 
+    /*
+        Simplified versions of the mesh, from the most detailed to the least detailed. The LOD 0 is the full resolution mesh.
+    */
+    struct LODs
+    {
+        uimax count;
+        SliceN<Token(Mesh), MeshRessource_Const::MAX_LOD_COUNT> meshes;
+        // Simplification error of every LOD, it is a distance in mesh space
+        SliceN<float32, MeshRessource_Const::MAX_LOD_COUNT> errors;
+
+        inline Token(Mesh) get_mesh(const Token(Mesh) p_full_mesh, const uimax p_lod) const
+        {
+            return p_lod == 0 ? p_full_mesh : this->meshes.get(p_lod - 1);
+        };
+
+        inline float32 get_error(const uimax p_lod) const
+        {
+            return p_lod == 0 ? 0.0f : this->errors.get(p_lod - 1);
+        };
+
+        /*
+            Returns the least detailed LOD whose error is not visible from p_distance (already scaled to mesh space).
+            A more detailed LOD is selected as soon as the current one becomes visible, a less detailed one only when it is clearly not visible.
+        */
+        inline uimax select(const uimax p_current_lod, const float32 p_distance) const
+        {
+            float32 l_max_error = p_distance * MeshRessource_Const::LOD_ERROR_PER_DISTANCE;
+            uimax l_lod = p_current_lod > this->count ? this->count : p_current_lod;
+            while (l_lod > 0 && this->get_error(l_lod) > (l_max_error * (1.0f + MeshRessource_Const::LOD_HYSTERESIS)))
+            {
+                l_lod -= 1;
+            }
+            while (l_lod < this->count && this->get_error(l_lod + 1) < (l_max_error * (1.0f - MeshRessource_Const::LOD_HYSTERESIS)))
+            {
+                l_lod += 1;
+            }
+            return l_lod;
+        };
+    };
+
+    LODs lods;
+
     inline static MeshRessource build_inline_from_id(const hash_t p_id)
     {
         return MeshRessource{RessourceIdentifiedHeader::build_inline_with_id(p_id), tk_bd(Mesh)};
@@ -124,19 +176,69 @@ struct MeshRessource
             this->allocated_binary.free();
         }
 
+        /*
+            Indices are stored on 16 bits when all vertices of the LOD can be indexed by them.
+            LODs read from an asset have either indices or indices_16 set, the other one is empty.
+        */
+        struct LOD
+        {
+            float32 error;
+            Slice<Vertex> vertices;
+            Slice<uint32> indices;
+            Slice<uint16> indices_16;
+
+            inline int8 has_16_bit_indices() const
+            {
+                return this->indices_16.Size != 0;
+            };
+
+            inline Slice<int8> get_indices_binary() const
+            {
+                return this->has_16_bit_indices() ? this->indices_16.build_asint8() : this->indices.build_asint8();
+            };
+        };
+
         struct Value
         {
             Slice<Vertex> initial_vertices;
             Slice<uint32> initial_indices;
+            Slice<uint16> initial_indices_16;
+            // Simplified meshes, each one has it's own vertices
+            uimax lod_count;
+            SliceN<LOD, MeshRessource_Const::MAX_LOD_COUNT> lods;
 
             inline static Value build_from_asset(const Asset& p_asset)
             {
                 Value l_value;
                 BinaryDeserializer l_deserializer = BinaryDeserializer::build(p_asset.allocated_binary.slice);
-                l_value.initial_vertices = slice_cast<Vertex>(l_deserializer.slice());
-                l_value.initial_indices = slice_cast<uint32>(l_deserializer.slice());
+                LOD l_full_lod = deserialize_lod(l_deserializer);
+                l_value.initial_vertices = l_full_lod.vertices;
+                l_value.initial_indices = l_full_lod.indices;
+                l_value.initial_indices_16 = l_full_lod.indices_16;
+                l_value.lod_count = *l_deserializer.type<uimax>();
+                for (loop(i, 0, l_value.lod_count))
+                {
+                    float32 l_error = *l_deserializer.type<float32>();
+                    l_value.lods.get(i) = deserialize_lod(l_deserializer);
+                    l_value.lods.get(i).error = l_error;
+                }
                 return l_value;
             };
+
+            inline LOD get_full_lod() const
+            {
+                return LOD{0.0f, this->initial_vertices, this->initial_indices, this->initial_indices_16};
+            };
+
+            inline int8 has_16_bit_indices() const
+            {
+                return this->get_full_lod().has_16_bit_indices();
+            };
+
+            inline Slice<int8> get_indices_binary() const
+            {
+                return this->get_full_lod().get_indices_binary();
+            };
         };
 
         inline static Asset build_from_binary(const Span<int8>& p_allocated_binary)
@@ -146,11 +248,67 @@ struct MeshRessource
 
         inline static Asset allocate_from_values(const Value& p_values)
         {
+#if RENDER_BOUND_TEST
+            assert_true(p_values.lod_count <= MeshRessource_Const::MAX_LOD_COUNT);
+#endif
             Vector<int8> l_binary = Vector<int8>::allocate(0);
-            BinarySerializer::slice(&l_binary, p_values.initial_vertices.build_asint8());
-            BinarySerializer::slice(&l_binary, p_values.initial_indices.build_asint8());
+            serialize_lod(&l_binary, p_values.get_full_lod());
+            BinarySerializer::type(&l_binary, p_values.lod_count);
+            for (loop(i, 0, p_values.lod_count))
+            {
+                const LOD& l_lod = p_values.lods.get(i);
+                BinarySerializer::type(&l_binary, l_lod.error);
+                serialize_lod(&l_binary, l_lod);
+            }
             return build_from_binary(l_binary.Memory);
         };
+
+      private:
+        inline static void serialize_lod(Vector<int8>* in_out_binary, const LOD& p_lod)
+        {
+            BinarySerializer::slice(in_out_binary, p_lod.vertices.build_asint8());
+            if (p_lod.has_16_bit_indices())
+            {
+                BinarySerializer::type(in_out_binary, (uimax)sizeof(uint16));
+                BinarySerializer::slice(in_out_binary, p_lod.indices_16.build_asint8());
+            }
+            else if (p_lod.vertices.Size <= ((uimax)uint16_max + 1))
+            {
+                Span<uint16> l_indices_16 = Span<uint16>::allocate(p_lod.indices.Size);
+                for (loop(i, 0, p_lod.indices.Size))
+                {
+                    l_indices_16.get(i) = (uint16)p_lod.indices.get(i);
+                }
+                BinarySerializer::type(in_out_binary, (uimax)sizeof(uint16));
+                BinarySerializer::slice(in_out_binary, l_indices_16.slice.build_asint8());
+                l_indices_16.free();
+            }
+            else
+            {
+                BinarySerializer::type(in_out_binary, (uimax)sizeof(uint32));
+                BinarySerializer::slice(in_out_binary, p_lod.indices.build_asint8());
+            }
+        };
+
+        inline static LOD deserialize_lod(BinaryDeserializer& p_deserializer)
+        {
+            LOD l_lod;
+            l_lod.error = 0.0f;
+            l_lod.vertices = slice_cast<Vertex>(p_deserializer.slice());
+            uimax l_index_size = *p_deserializer.type<uimax>();
+            Slice<int8> l_indices = p_deserializer.slice();
+            if (l_index_size == sizeof(uint16))
+            {
+                l_lod.indices = Slice<uint32>::build_default();
+                l_lod.indices_16 = slice_cast<uint16>(l_indices);
+            }
+            else
+            {
+                l_lod.indices = slice_cast<uint32>(l_indices);
+                l_lod.indices_16 = Slice<uint16>::build_default();
+            }
+            return l_lod;
+        };
     };
 
     struct InlineAllocationInput
@@ -310,6 +468,18 @@ struct ShaderRessource
     };
 };
 
+/*
+    Format of the pixels of a TextureRessource asset.
+    Block compressed formats (BC) store blocks of 4x4 pixels, pixels of blocks that are outside of the texture are undefined.
+*/
+enum class TextureAssetFormat : int8
+{
+    R8G8B8A8_SRGB = 0,
+    BC1_SRGB = 1,
+    BC3_SRGB = 2,
+    BC7_SRGB = 3
+};
+
 struct TextureRessource
 {
     RessourceIdentifiedHeader header;
@@ -319,10 +489,15 @@ struct TextureRessource
     {
         Span<int8> allocated_binary;
 
+        /*
+            Pixels of all mips are stored one after the other, from the mip 0 (of size) to the mip (mip_count - 1).
+        */
         struct Value
         {
             v3ui size;
             int8 channel_nb;
+            TextureAssetFormat format;
+            uint32 mip_count;
             Slice<int8> pixels;
 
             inline static Value build_from_asset(const Asset& p_asset)
@@ -331,9 +506,57 @@ struct TextureRessource
                 BinaryDeserializer l_deserializer = BinaryDeserializer::build(p_asset.allocated_binary.slice);
                 l_value.size = *l_deserializer.type<v3ui>();
                 l_value.channel_nb = *l_deserializer.type<int8>();
+                l_value.format = *l_deserializer.type<TextureAssetFormat>();
+                l_value.mip_count = *l_deserializer.type<uint32>();
                 l_value.pixels = l_deserializer.slice();
                 return l_value;
             };
+
+            // Width and height in pixels of the blocks of p_format
+            inline static uint32 get_block_extent(const TextureAssetFormat p_format)
+            {
+                return p_format == TextureAssetFormat::R8G8B8A8_SRGB ? 1 : 4;
+            };
+
+            inline static uimax get_block_size(const TextureAssetFormat p_format)
+            {
+                switch (p_format)
+                {
+                case TextureAssetFormat::R8G8B8A8_SRGB:
+                    return 4;
+                case TextureAssetFormat::BC1_SRGB:
+                    return 8;
+                case TextureAssetFormat::BC3_SRGB:
+                case TextureAssetFormat::BC7_SRGB:
+                    return 16;
+                default:
+                    abort();
+                }
+            };
+
+            inline static v3ui get_mip_size(const v3ui& p_size, const uint32 p_mip_level)
+            {
+                uint32 l_width = p_size.x >> p_mip_level;
+                uint32 l_height = p_size.y >> p_mip_level;
+                return v3ui{l_width == 0 ? 1 : l_width, l_height == 0 ? 1 : l_height, 1};
+            };
+
+            inline static uimax get_mip_memory_size(const TextureAssetFormat p_format, const v3ui& p_size, const uint32 p_mip_level)
+            {
+                v3ui l_mip_size = get_mip_size(p_size, p_mip_level);
+                uint32 l_block_extent = get_block_extent(p_format);
+                return (uimax)((l_mip_size.x + l_block_extent - 1) / l_block_extent) * (uimax)((l_mip_size.y + l_block_extent - 1) / l_block_extent) * get_block_size(p_format);
+            };
+
+            inline Slice<int8> get_mip_pixels(const uint32 p_mip_level) const
+            {
+                uimax l_offset = 0;
+                for (loop(i, 0, p_mip_level))
+                {
+                    l_offset += get_mip_memory_size(this->format, this->size, (uint32)i);
+                }
+                return Slice<int8>::build_memory_offset_elementnb(this->pixels.Begin, l_offset, get_mip_memory_size(this->format, this->size, p_mip_level));
+            };
         };
 
         inline static Asset build_from_binary(const Span<int8>& p_allocated_binary)
@@ -346,6 +569,8 @@ struct TextureRessource
             Vector<int8> l_binary = Vector<int8>::allocate(0);
             BinarySerializer::type(&l_binary, p_value.size);
             BinarySerializer::type(&l_binary, p_value.channel_nb);
+            BinarySerializer::type(&l_binary, p_value.format);
+            BinarySerializer::type(&l_binary, p_value.mip_count);
             BinarySerializer::slice(&l_binary, p_value.pixels);
             return build_from_binary(l_binary.Memory);
         };
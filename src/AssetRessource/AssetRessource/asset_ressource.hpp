@@ -4,5 +4,6 @@
 #include "AssetDatabase/assetdatabase.hpp"
 
 #include "./Render/ressources.hpp"
+#include "./Render/bcn_decoder.hpp"
 #include "./ressource_util.hpp"
 #include "./Render/allocator.hpp"
\ No newline at end of file
@@ -55,21 +55,82 @@ struct RessourceComposition
 
 
     /*
-        If the the Ressource is allocated from the asset database, this function try to retrieve asset from database by it's id and map it to the asset value
+        If the the Ressource is allocated from the asset database, this function try to retrieve asset from database by it's id and map it to the asset value.
+        The asset source is either the AssetDatabase or an AssetArchive.
     */
-    template <class t_RessourceAssetType>
-    inline static void retrieve_ressource_asset_from_database_if_necessary(AssetDatabase& p_asset_database, const RessourceIdentifiedHeader& p_ressource_header, t_RessourceAssetType* in_out_asset)
+    template <class t_AssetSource, class t_RessourceAssetType>
+    inline static void retrieve_ressource_asset_from_database_if_necessary(t_AssetSource& p_asset_source, const RessourceIdentifiedHeader& p_ressource_header, t_RessourceAssetType* in_out_asset)
+    {
+        switch (p_ressource_header.allocation_type)
+        {
+        case RessourceAllocationType::INLINE:
+            break;
+        case RessourceAllocationType::ASSET_DATABASE:
+            *in_out_asset = in_out_asset->build_from_binary(p_asset_source.get_asset_blob(p_ressource_header.id));
+            break;
+        default:
+            abort();
+        }
+    };
+
+    // Releases an asset retrieved by retrieve_ressource_asset_from_database_if_necessary, blobs of the asset source are given back to it
+    template <class t_AssetSource, class t_RessourceAssetType>
+    inline static void release_ressource_asset(t_AssetSource& p_asset_source, const RessourceIdentifiedHeader& p_ressource_header, t_RessourceAssetType* in_out_asset)
     {
         switch (p_ressource_header.allocation_type)
         {
         case RessourceAllocationType::INLINE:
+            in_out_asset->free();
             break;
         case RessourceAllocationType::ASSET_DATABASE:
-            *in_out_asset = in_out_asset->build_from_binary(p_asset_database.get_asset_blob(p_ressource_header.id));
+            p_asset_source.release_asset_blob(in_out_asset->allocated_binary);
             break;
         default:
             abort();
         }
     };
 
+    /*
+        Streamed version of retrieve_ressource_asset_from_database_if_necessary.
+        Returns 0 as long as the asset blob is being read by the AssetStreamer.
+    */
+    template <class t_RessourceAssetType>
+    inline static int8 stream_ressource_asset_from_database_if_necessary(AssetStreamer& p_asset_streamer, const RessourceIdentifiedHeader& p_ressource_header, t_RessourceAssetType* in_out_asset)
+    {
+        switch (p_ressource_header.allocation_type)
+        {
+        case RessourceAllocationType::INLINE:
+            return 1;
+        case RessourceAllocationType::ASSET_DATABASE:
+        {
+            // The blob may have been read by a previous step that had no upload budget left
+            if (in_out_asset->allocated_binary.Memory != NULL)
+            {
+                return 1;
+            }
+            Span<int8> l_asset_blob;
+            if (p_asset_streamer.fetch(p_ressource_header.id, &l_asset_blob))
+            {
+                *in_out_asset = in_out_asset->build_from_binary(l_asset_blob);
+                return 1;
+            }
+            return 0;
+        }
+        default:
+            abort();
+        }
+    };
+
+    // Every upload consumes the budget, the last upload of the step can exceed it
+    inline static void consume_upload_budget(const uimax p_uploaded_size, uimax* in_out_upload_budget)
+    {
+        if (p_uploaded_size >= *in_out_upload_budget)
+        {
+            *in_out_upload_budget = 0;
+        }
+        else
+        {
+            *in_out_upload_budget -= p_uploaded_size;
+        }
+    };
 };
\ No newline at end of file
@@ -31,18 +31,66 @@ inline void render_asset_binary_serialization_deserialization_test()
         MeshRessource::Asset l_mesh = MeshRessource::Asset::allocate_from_values(l_value);
         MeshRessource::Asset::Value l_deserialized_value = MeshRessource::Asset::Value::build_from_asset(l_mesh);
         assert_true(l_deserialized_value.initial_vertices.compare(l_initial_vertices));
-        assert_true(l_deserialized_value.initial_indices.compare(l_initial_indices));
+        // The mesh has less than 65536 vertices, indices are stored on 16 bits
+        assert_true(l_deserialized_value.has_16_bit_indices());
+        assert_true(l_deserialized_value.initial_indices.Size == 0);
+        assert_true(l_deserialized_value.initial_indices_16.Size == l_initial_indices.Size);
+        for (loop(i, 0, l_initial_indices.Size))
+        {
+            assert_true(l_deserialized_value.initial_indices_16.get(i) == l_initial_indices.get(i));
+        }
+        l_mesh.free();
+    }
+    {
+        Slice<Vertex> l_lod_vertices = Slice<Vertex>::build_memory_elementnb(l_initial_vertices.Begin, 1);
+        Slice<uint32> l_lod_indices = Slice<uint32>::build_memory_elementnb(l_initial_indices.Begin, 1);
+        MeshRessource::Asset::Value l_value = MeshRessource::Asset::Value{l_initial_vertices, l_initial_indices};
+        l_value.lod_count = 1;
+        l_value.lods.get(0) = MeshRessource::Asset::LOD{0.5f, l_lod_vertices, l_lod_indices, Slice<uint16>::build_default()};
+        MeshRessource::Asset l_mesh = MeshRessource::Asset::allocate_from_values(l_value);
+        MeshRessource::Asset::Value l_deserialized_value = MeshRessource::Asset::Value::build_from_asset(l_mesh);
+        assert_true(l_deserialized_value.initial_vertices.compare(l_initial_vertices));
+        assert_true(l_deserialized_value.initial_indices_16.Size == l_initial_indices.Size);
+        assert_true(l_deserialized_value.lod_count == 1);
+        MeshRessource::Asset::LOD& l_deserialized_lod = l_deserialized_value.lods.get(0);
+        assert_true(l_deserialized_lod.error == 0.5f);
+        assert_true(l_deserialized_lod.vertices.compare(l_lod_vertices));
+        assert_true(l_deserialized_lod.has_16_bit_indices());
+        assert_true(l_deserialized_lod.indices_16.Size == 1 && l_deserialized_lod.indices_16.get(0) == l_lod_indices.get(0));
         l_mesh.free();
     }
     {
-        TextureRessource::Asset::Value l_value = TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, l_slice_int8};
+        TextureRessource::Asset::Value l_value = TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_slice_int8};
         TextureRessource::Asset l_texture = TextureRessource::Asset::allocate_from_values(l_value);
         TextureRessource::Asset::Value l_deserialized_value = TextureRessource::Asset::Value::build_from_asset(l_texture);
         assert_true(l_deserialized_value.size == l_value.size);
         assert_true(l_deserialized_value.channel_nb == 4);
+        assert_true(l_deserialized_value.format == TextureAssetFormat::R8G8B8A8_SRGB);
+        assert_true(l_deserialized_value.mip_count == 1);
         assert_true(l_deserialized_value.pixels.compare(l_value.pixels));
         l_texture.free();
     }
+    {
+        // 8x4 texture compressed in BC1 with 4 mips, the smallest mip is still stored in a full block
+        assert_true(TextureRessource::Asset::Value::get_mip_memory_size(TextureAssetFormat::BC1_SRGB, v3ui{8, 4, 1}, 0) == 16);
+        assert_true(TextureRessource::Asset::Value::get_mip_memory_size(TextureAssetFormat::BC1_SRGB, v3ui{8, 4, 1}, 1) == 8);
+        assert_true(TextureRessource::Asset::Value::get_mip_size(v3ui{8, 4, 1}, 3) == v3ui{1, 1, 1});
+        assert_true(TextureRessource::Asset::Value::get_mip_memory_size(TextureAssetFormat::BC1_SRGB, v3ui{8, 4, 1}, 3) == 8);
+
+        SliceN<int8, 40> l_blocks_memory;
+        for (loop(i, 0, l_blocks_memory.Size()))
+        {
+            l_blocks_memory.get(i) = (int8)i;
+        }
+        TextureRessource::Asset::Value l_value = TextureRessource::Asset::Value{v3ui{8, 4, 1}, 4, TextureAssetFormat::BC1_SRGB, 4, l_blocks_memory.to_slice()};
+        TextureRessource::Asset l_texture = TextureRessource::Asset::allocate_from_values(l_value);
+        TextureRessource::Asset::Value l_deserialized_value = TextureRessource::Asset::Value::build_from_asset(l_texture);
+        assert_true(l_deserialized_value.format == TextureAssetFormat::BC1_SRGB);
+        assert_true(l_deserialized_value.mip_count == 4);
+        assert_true(l_deserialized_value.get_mip_pixels(0).compare(Slice<int8>::build_memory_offset_elementnb(l_blocks_memory.Memory, 0, 16)));
+        assert_true(l_deserialized_value.get_mip_pixels(3).compare(Slice<int8>::build_memory_offset_elementnb(l_blocks_memory.Memory, 32, 8)));
+        l_texture.free();
+    }
 
     Slice<int8> l_material_parameters_memory = SliceN<ShaderParameter::Type, 2>{ShaderParameter::Type::TEXTURE_GPU, ShaderParameter::Type::UNIFORM_HOST}.to_slice().build_asint8();
     Slice<SliceIndex> l_chunkds =
@@ -229,6 +277,28 @@ struct AssetRessource_TestAssertion
     };
 };
 
+inline void mesh_lod_selection_test()
+{
+    MeshRessource::LODs l_lods;
+    l_lods.count = 2;
+    l_lods.meshes = SliceN<Token(Mesh), MeshRessource_Const::MAX_LOD_COUNT>{tk_b(Mesh, 1), tk_b(Mesh, 2)};
+    l_lods.errors = SliceN<float32, MeshRessource_Const::MAX_LOD_COUNT>{0.01f, 0.1f};
+
+    assert_true(tk_eq(l_lods.get_mesh(tk_b(Mesh, 0), 0), tk_b(Mesh, 0)));
+    assert_true(tk_eq(l_lods.get_mesh(tk_b(Mesh, 0), 2), tk_b(Mesh, 2)));
+
+    assert_true(l_lods.select(0, 1.0f) == 0);
+    assert_true(l_lods.select(0, 20.0f) == 1);
+    assert_true(l_lods.select(0, 1000.0f) == 2);
+    assert_true(l_lods.select(2, 1.0f) == 0);
+
+    // Around the LOD 1 distance (10), the current LOD is kept
+    assert_true(l_lods.select(0, 11.0f) == 0);
+    assert_true(l_lods.select(1, 11.0f) == 1);
+    assert_true(l_lods.select(1, 9.0f) == 1);
+    assert_true(l_lods.select(1, 8.0f) == 0);
+};
+
 inline void render_middleware_inline_allocation(CachedCompiledShaders& p_cached_compiled_shader)
 {
     AssetRessourceTestContext l_ctx = AssetRessourceTestContext::allocate();
@@ -266,7 +336,7 @@ inline void render_middleware_inline_allocation(CachedCompiledShaders& p_cached_
 
         hash_t l_material_texture_id = 14874879;
         Span<int8> l_material_texture_span = Span<int8>::allocate(8 * 8 * 4);
-        TextureRessource::Asset l_material_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, l_material_texture_span.slice});
+        TextureRessource::Asset l_material_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_material_texture_span.slice});
         l_material_texture_span.free();
 
         MaterialRessource::Asset l_material_asset_1;
@@ -472,7 +542,7 @@ inline void render_middleware_inline_alloc_dealloc_same_frame(CachedCompiledShad
 
         hash_t l_material_texture_id = 14874879;
         Span<int8> l_material_texture_span = Span<int8>::allocate(8 * 8 * 4);
-        TextureRessource::Asset l_material_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, l_material_texture_span.slice});
+        TextureRessource::Asset l_material_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_material_texture_span.slice});
         l_material_texture_span.free();
 
         MaterialRessource::Asset l_material_asset_1;
@@ -557,7 +627,7 @@ inline void render_middleware_database_allocation(CachedCompiledShaders p_cached
                                           ShaderConfiguration{1, ShaderConfiguration::CompareOp::LessOrEqual}});
 
         Span<int8> l_material_texture_span = Span<int8>::allocate(8 * 8 * 4);
-        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, l_material_texture_span.slice});
+        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_material_texture_span.slice});
         l_material_texture_span.free();
 
         MaterialRessource::Asset l_material_asset;
@@ -661,7 +731,7 @@ inline void render_middleware_get_dependencies_from_database(CachedCompiledShade
                                           ShaderConfiguration{1, ShaderConfiguration::CompareOp::LessOrEqual}});
 
         Span<int8> l_material_texture_span = Span<int8>::allocate(8 * 8 * 4);
-        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, l_material_texture_span.slice});
+        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_material_texture_span.slice});
         l_material_texture_span.free();
 
         MaterialRessource::Asset l_material_asset;
@@ -762,7 +832,7 @@ inline void render_middleware_multiple_database_allocation(CachedCompiledShaders
                                           ShaderConfiguration{1, ShaderConfiguration::CompareOp::LessOrEqual}});
 
         Span<int8> l_material_texture_span = Span<int8>::allocate(8 * 8 * 4);
-        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, l_material_texture_span.slice});
+        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_material_texture_span.slice});
         l_material_texture_span.free();
 
         MaterialRessource::Asset l_material_asset;
@@ -874,9 +944,249 @@ inline void render_middleware_multiple_database_allocation(CachedCompiledShaders
 };
 
 
+// Database meshes and textures are read by the AssetStreamer and their dependent ressources wait for them
+inline void render_middleware_database_streamed_allocation(CachedCompiledShaders& p_cached_compiled_shaders)
+{
+    AssetRessourceTestContext l_ctx = AssetRessourceTestContext::allocate();
+
+    const Slice<int8> l_vertex_shader_path = slice_int8_build_rawstr("shader/v.vert");
+    const Slice<int8> l_fragment_shader_path = slice_int8_build_rawstr("shader/f.frag");
+    const Slice<int8> l_shader_path = slice_int8_build_rawstr("shader");
+    const Slice<int8> l_texture_path = slice_int8_build_rawstr("texture");
+    const Slice<int8> l_material_path = slice_int8_build_rawstr("material");
+    const Slice<int8> l_mesh_path = slice_int8_build_rawstr("mesh");
+    const Slice<int8> l_mesh_2_path = slice_int8_build_rawstr("mesh_2");
+
+    const hash_t l_vertex_shader_id = HashSlice(l_vertex_shader_path);
+    const hash_t l_fragment_shader_id = HashSlice(l_fragment_shader_path);
+    const hash_t l_shader_id = HashSlice(l_shader_path);
+    const hash_t l_texture_id = HashSlice(l_texture_path);
+    const hash_t l_material_id = HashSlice(l_material_path);
+    const hash_t l_mesh_id = HashSlice(l_mesh_path);
+    const hash_t l_mesh_2_id = HashSlice(l_mesh_2_path);
+
+    {
+        ShaderRessource::Asset l_shader_asset = ShaderRessource::Asset::allocate_from_values(
+            ShaderRessource::Asset::Value{SliceN<ShaderLayoutParameterType, 2>{ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX, ShaderLayoutParameterType::TEXTURE_FRAGMENT}.to_slice(), 0,
+                                          ShaderConfiguration{1, ShaderConfiguration::CompareOp::LessOrEqual}});
+
+        Span<int8> l_material_texture_span = Span<int8>::allocate(8 * 8 * 4);
+        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_material_texture_span.slice});
+        l_material_texture_span.free();
+
+        MaterialRessource::Asset l_material_asset;
+        {
+            Span<int8> l_material_parameter_temp = Span<int8>::allocate(10);
+            auto l_obj = ShaderParameter::Type::UNIFORM_HOST;
+            auto l_tex = ShaderParameter::Type::TEXTURE_GPU;
+            VaryingVector l_varying_vector = VaryingVector::allocate_default();
+            l_varying_vector.push_back_2(Slice<ShaderParameter::Type>::build_asint8_memory_singleelement(&l_obj), l_material_parameter_temp.slice);
+            l_varying_vector.push_back_2(Slice<ShaderParameter::Type>::build_asint8_memory_singleelement(&l_tex), SliceN<hash_t, 1>{l_texture_id}.to_slice().build_asint8());
+            l_material_asset = MaterialRessource::Asset::allocate_from_values(MaterialRessource::Asset::Value{l_varying_vector.to_varying_slice()});
+            l_varying_vector.free();
+            l_material_parameter_temp.free();
+        }
+
+        MeshRessource::Asset l_mesh_asset;
+        {
+            Vertex l_vertices[14] = {};
+            uint32 l_indices[14 * 3] = {};
+
+            Slice<Vertex> l_vertices_span = Slice<Vertex>::build_memory_elementnb(l_vertices, 14);
+            Slice<uint32> l_indices_span = Slice<uint32>::build_memory_elementnb(l_indices, 14 * 3);
+
+            l_mesh_asset = MeshRessource::Asset::allocate_from_values(MeshRessource::Asset::Value{l_vertices_span, l_indices_span});
+        }
+
+        l_ctx.asset_database.insert_asset_blob(l_vertex_shader_path, p_cached_compiled_shaders.vertex_dummy_shader.slice);
+        l_ctx.asset_database.insert_asset_blob(l_fragment_shader_path, p_cached_compiled_shaders.fragment_dummy_shader.slice);
+        l_ctx.asset_database.insert_asset_blob(l_shader_path, l_shader_asset.allocated_binary.slice);
+        l_ctx.asset_database.insert_asset_blob(l_texture_path, l_texture_asset.allocated_binary.slice);
+        l_ctx.asset_database.insert_asset_blob(l_material_path, l_material_asset.allocated_binary.slice);
+        l_ctx.asset_database.insert_asset_blob(l_mesh_path, l_mesh_asset.allocated_binary.slice);
+        l_ctx.asset_database.insert_asset_blob(l_mesh_2_path, l_mesh_asset.allocated_binary.slice);
+
+        l_shader_asset.free();
+        l_texture_asset.free();
+        l_material_asset.free();
+        l_mesh_asset.free();
+    }
+
+    String l_asset_database_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_asset_database_path.append(slice_int8_build_rawstr("asset.db"));
+    AssetStreamer l_asset_streamer = AssetStreamer::allocate(l_asset_database_path.to_slice());
+    l_asset_database_path.free();
+
+    {
+        Token(MeshRessource) l_mesh_ressource = MeshRessourceComposition::allocate_or_increment_database(l_ctx.render_ressource_allocator.mesh_unit, MeshRessource::DatabaseAllocationInput{l_mesh_id});
+        Token(MaterialRessource) l_material_ressource = MaterialRessourceComposition::allocate_or_increment_database(
+            l_ctx.render_ressource_allocator.material_unit, l_ctx.render_ressource_allocator.shader_unit, l_ctx.render_ressource_allocator.shader_module_unit,
+            l_ctx.render_ressource_allocator.texture_unit,
+            MaterialRessource::DatabaseAllocationInput{l_material_id, SliceN<TextureRessource::DatabaseAllocationInput, 1>{TextureRessource::DatabaseAllocationInput{l_texture_id}}.to_slice()},
+            ShaderRessource::DatabaseAllocationInput{l_shader_id}, ShaderModuleRessource::DatabaseAllocationInput{l_vertex_shader_id},
+            ShaderModuleRessource::DatabaseAllocationInput{l_fragment_shader_id});
+
+        MeshRessource& l_mesh = l_ctx.render_ressource_allocator.mesh_unit.meshes.pool.get(l_mesh_ressource);
+        MaterialRessource& l_material = l_ctx.render_ressource_allocator.material_unit.materials.pool.get(l_material_ressource);
+        TextureRessource& l_texture = l_ctx.render_ressource_allocator.texture_unit.textures.pool.get(
+            l_ctx.render_ressource_allocator.material_unit.material_dynamic_dependencies.get_vector(l_material.dependencies.dynamic_dependencies).get(0).dependency);
+
+        // With an upload budget of one byte, a single mesh or texture is uploaded by step
+        while (!l_mesh.header.allocated || !l_material.header.allocated)
+        {
+            int8 l_mesh_allocated_before = l_mesh.header.allocated;
+            int8 l_texture_allocated_before = l_texture.header.allocated;
+
+            l_ctx.render_ressource_allocator.deallocation_step(l_ctx.renderer, l_ctx.gpu_ctx);
+            l_ctx.render_ressource_allocator.allocation_step_streamed(l_ctx.renderer, l_ctx.gpu_ctx, l_ctx.asset_database, l_asset_streamer, 1);
+
+            assert_true((l_mesh.header.allocated - l_mesh_allocated_before) + (l_texture.header.allocated - l_texture_allocated_before) <= 1);
+            if (l_material.header.allocated)
+            {
+                assert_true(l_texture.header.allocated);
+            }
+            Thread::yield();
+        }
+
+        {
+            AssetRessource_TestAssertion::assert_material_allocation(
+                l_ctx, l_material_ressource, AssetRessource_TestAssertion::AssertRessource{l_material_id, 1, 1},
+                SliceN<AssetRessource_TestAssertion::AssertRessource, 1>{AssetRessource_TestAssertion::AssertRessource{l_texture_id, 1, 1}}.to_slice(),
+                AssetRessource_TestAssertion::AssertRessource{l_shader_id, 1, 1}, AssetRessource_TestAssertion::AssertRessource{l_vertex_shader_id, 1, 1},
+                AssetRessource_TestAssertion::AssertRessource{l_fragment_shader_id, 1, 1});
+            AssetRessource_TestAssertion::assert_mesh_allocation(l_ctx, l_mesh_ressource, AssetRessource_TestAssertion::AssertRessource{l_mesh_id, 1, 1});
+        }
+
+        // A mesh released while it is being read is never allocated
+        Token(MeshRessource) l_mesh_2_ressource =
+            MeshRessourceComposition::allocate_or_increment_database(l_ctx.render_ressource_allocator.mesh_unit, MeshRessource::DatabaseAllocationInput{l_mesh_2_id});
+        l_ctx.render_ressource_allocator.allocation_step_streamed(l_ctx.renderer, l_ctx.gpu_ctx, l_ctx.asset_database, l_asset_streamer, 0);
+        l_ctx.render_ressource_allocator.mesh_unit.release_ressource(l_mesh_2_ressource);
+        assert_true(l_ctx.render_ressource_allocator.mesh_unit.meshes_allocation_events.Size == 0);
+        assert_true(l_ctx.render_ressource_allocator.mesh_unit.meshes_discarded_streams.Size == 1);
+        l_ctx.render_ressource_allocator.allocation_step_streamed(l_ctx.renderer, l_ctx.gpu_ctx, l_ctx.asset_database, l_asset_streamer, 0);
+        assert_true(l_ctx.render_ressource_allocator.mesh_unit.meshes_discarded_streams.Size == 0);
+
+        l_ctx.render_ressource_allocator.mesh_unit.release_ressource(l_mesh_ressource);
+        MaterialRessourceComposition::decrement_or_release(l_ctx.render_ressource_allocator.material_unit, l_ctx.render_ressource_allocator.shader_unit,
+                                                           l_ctx.render_ressource_allocator.shader_module_unit, l_ctx.render_ressource_allocator.texture_unit, l_material_ressource);
+    }
+
+    l_asset_streamer.free();
+    l_ctx.free();
+};
+
+// Ressources are read from an AssetArchive written from the database, blobs are used directly from the mapped archive
+inline void render_middleware_archive_allocation(CachedCompiledShaders& p_cached_compiled_shaders)
+{
+    AssetRessourceTestContext l_ctx = AssetRessourceTestContext::allocate();
+
+    const Slice<int8> l_vertex_shader_path = slice_int8_build_rawstr("shader/v.vert");
+    const Slice<int8> l_fragment_shader_path = slice_int8_build_rawstr("shader/f.frag");
+    const Slice<int8> l_shader_path = slice_int8_build_rawstr("shader");
+    const Slice<int8> l_texture_path = slice_int8_build_rawstr("texture");
+    const Slice<int8> l_material_path = slice_int8_build_rawstr("material");
+    const Slice<int8> l_mesh_path = slice_int8_build_rawstr("mesh");
+
+    const hash_t l_vertex_shader_id = HashSlice(l_vertex_shader_path);
+    const hash_t l_fragment_shader_id = HashSlice(l_fragment_shader_path);
+    const hash_t l_shader_id = HashSlice(l_shader_path);
+    const hash_t l_texture_id = HashSlice(l_texture_path);
+    const hash_t l_material_id = HashSlice(l_material_path);
+    const hash_t l_mesh_id = HashSlice(l_mesh_path);
+
+    {
+        ShaderRessource::Asset l_shader_asset = ShaderRessource::Asset::allocate_from_values(
+            ShaderRessource::Asset::Value{SliceN<ShaderLayoutParameterType, 2>{ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX, ShaderLayoutParameterType::TEXTURE_FRAGMENT}.to_slice(), 0,
+                                          ShaderConfiguration{1, ShaderConfiguration::CompareOp::LessOrEqual}});
+
+        Span<int8> l_material_texture_span = Span<int8>::allocate(8 * 8 * 4);
+        TextureRessource::Asset l_texture_asset = TextureRessource::Asset::allocate_from_values(TextureRessource::Asset::Value{v3ui{8, 8, 1}, 4, TextureAssetFormat::R8G8B8A8_SRGB, 1, l_material_texture_span.slice});
+        l_material_texture_span.free();
+
+        MaterialRessource::Asset l_material_asset;
+        {
+            Span<int8> l_material_parameter_temp = Span<int8>::allocate(10);
+            auto l_obj = ShaderParameter::Type::UNIFORM_HOST;
+            auto l_tex = ShaderParameter::Type::TEXTURE_GPU;
+            VaryingVector l_varying_vector = VaryingVector::allocate_default();
+            l_varying_vector.push_back_2(Slice<ShaderParameter::Type>::build_asint8_memory_singleelement(&l_obj), l_material_parameter_temp.slice);
+            l_varying_vector.push_back_2(Slice<ShaderParameter::Type>::build_asint8_memory_singleelement(&l_tex), SliceN<hash_t, 1>{HashSlice(l_texture_path)}.to_slice().build_asint8());
+            l_material_asset = MaterialRessource::Asset::allocate_from_values(MaterialRessource::Asset::Value{l_varying_vector.to_varying_slice()});
+            l_varying_vector.free();
+            l_material_parameter_temp.free();
+        }
+
+        MeshRessource::Asset l_mesh_asset;
+        {
+            Vertex l_vertices[14] = {};
+            uint32 l_indices[14 * 3] = {};
+
+            Slice<Vertex> l_vertices_span = Slice<Vertex>::build_memory_elementnb(l_vertices, 14);
+            Slice<uint32> l_indices_span = Slice<uint32>::build_memory_elementnb(l_indices, 14 * 3);
+
+            l_mesh_asset = MeshRessource::Asset::allocate_from_values(MeshRessource::Asset::Value{l_vertices_span, l_indices_span});
+        }
+
+        l_ctx.asset_database.insert_asset_blob(l_vertex_shader_path, p_cached_compiled_shaders.vertex_dummy_shader.slice);
+        l_ctx.asset_database.insert_asset_blob(l_fragment_shader_path, p_cached_compiled_shaders.fragment_dummy_shader.slice);
+        l_ctx.asset_database.insert_asset_blob(l_shader_path, l_shader_asset.allocated_binary.slice);
+        l_ctx.asset_database.insert_asset_blob(l_texture_path, l_texture_asset.allocated_binary.slice);
+        l_ctx.asset_database.insert_asset_blob(l_material_path, l_material_asset.allocated_binary.slice);
+        l_ctx.asset_database.insert_asset_blob(l_mesh_path, l_mesh_asset.allocated_binary.slice);
+
+        MaterialRessource::AssetDependencies l_material_asset_dependencies = MaterialRessource::AssetDependencies::allocate_from_values(
+            MaterialRessource::AssetDependencies::Value{HashSlice(l_shader_path), ShaderRessource::AssetDependencies::Value{HashSlice(l_vertex_shader_path), HashSlice(l_fragment_shader_path)},
+                                                        SliceN<hash_t, 1>{HashSlice(l_texture_path)}.to_slice()});
+
+        l_ctx.asset_database.insert_asset_dependencies_blob(l_material_path, l_material_asset_dependencies.allocated_binary.slice);
+
+        l_material_asset_dependencies.free();
+
+        l_shader_asset.free();
+        l_texture_asset.free();
+        l_material_asset.free();
+        l_mesh_asset.free();
+    }
+
+    String l_archive_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_archive_path.append(slice_int8_build_rawstr("asset.archive"));
+    AssetArchive::write_from_database(l_ctx.asset_database, l_archive_path.to_slice());
+    AssetArchive l_asset_archive = AssetArchive::allocate(l_archive_path.to_slice());
+
+    {
+        Token(MeshRessource) l_mesh_ressource = MeshRessourceComposition::allocate_or_increment_database(l_ctx.render_ressource_allocator.mesh_unit, MeshRessource::DatabaseAllocationInput{l_mesh_id});
+        Token(MaterialRessource) l_material = MaterialRessourceComposition::allocate_or_increment_database_and_load_dependecies(
+            l_ctx.render_ressource_allocator.material_unit, l_ctx.render_ressource_allocator.shader_unit, l_ctx.render_ressource_allocator.shader_module_unit,
+            l_ctx.render_ressource_allocator.texture_unit, l_asset_archive, l_material_id);
+
+        l_ctx.render_ressource_allocator.deallocation_step(l_ctx.renderer, l_ctx.gpu_ctx);
+        l_ctx.render_ressource_allocator.allocation_step(l_ctx.renderer, l_ctx.gpu_ctx, l_asset_archive);
+
+        {
+            AssetRessource_TestAssertion::assert_material_allocation(
+                l_ctx, l_material, AssetRessource_TestAssertion::AssertRessource{l_material_id, 1, 1},
+                SliceN<AssetRessource_TestAssertion::AssertRessource, 1>{AssetRessource_TestAssertion::AssertRessource{l_texture_id, 1, 1}}.to_slice(),
+                AssetRessource_TestAssertion::AssertRessource{l_shader_id, 1, 1}, AssetRessource_TestAssertion::AssertRessource{l_vertex_shader_id, 1, 1},
+                AssetRessource_TestAssertion::AssertRessource{l_fragment_shader_id, 1, 1});
+            AssetRessource_TestAssertion::assert_mesh_allocation(l_ctx, l_mesh_ressource, AssetRessource_TestAssertion::AssertRessource{l_mesh_id, 1, 1});
+        }
+
+        l_ctx.render_ressource_allocator.mesh_unit.release_ressource(l_mesh_ressource);
+        MaterialRessourceComposition::decrement_or_release(l_ctx.render_ressource_allocator.material_unit, l_ctx.render_ressource_allocator.shader_unit,
+                                                           l_ctx.render_ressource_allocator.shader_module_unit, l_ctx.render_ressource_allocator.texture_unit, l_material);
+        l_ctx.render_ressource_allocator.deallocation_step(l_ctx.renderer, l_ctx.gpu_ctx);
+    }
+
+    l_asset_archive.free();
+    l_archive_path.free();
+    l_ctx.free();
+};
+
 int main()
 {
     render_asset_binary_serialization_deserialization_test();
+    mesh_lod_selection_test();
 
     CachedCompiledShaders l_cached_compiled_shaders = CachedCompiledShaders::allocate();
 
@@ -885,6 +1195,8 @@ int main()
     render_middleware_database_allocation(l_cached_compiled_shaders);
     render_middleware_get_dependencies_from_database(l_cached_compiled_shaders);
     render_middleware_multiple_database_allocation(l_cached_compiled_shaders);
+    render_middleware_database_streamed_allocation(l_cached_compiled_shaders);
+    render_middleware_archive_allocation(l_cached_compiled_shaders);
 
     l_cached_compiled_shaders.free();
 
@@ -3,5 +3,6 @@
 #include "Common2/common2.hpp"
 #include "Math2/math.hpp"
 
+#include "./collision_broadphase.hpp"
 #include "./collision_definition.hpp"
 #include "./collision_src.hpp"
\ No newline at end of file
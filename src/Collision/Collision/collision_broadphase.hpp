@@ -0,0 +1,422 @@
+#pragma once
+
+struct BoxCollider;
+
+/*
+    World space axis aligned bounds stored as min and max points.
+    Used by the BroadPhase because union and overlap tests are cheaper than with the (center, radiuses) representation.
+*/
+struct BroadPhaseBounds
+{
+    v3f min;
+    v3f max;
+
+    /*
+        The obb::overlap2 SAT test orients radiuses per component (axis * radiuses) instead of scaling every axis by it's radius.
+        To always be conservative, bounds encloses the shape of both interpretations.
+    */
+    inline static BroadPhaseBounds build_from_obb(const obb& p_obb)
+    {
+        v3f l_extend;
+        for (int8 i = 0; i < 3; i++)
+        {
+            float32 l_axis_extend = (fabsf(p_obb.axis.Points2D[0].Points[i]) * p_obb.box.radiuses.Points[0]) + (fabsf(p_obb.axis.Points2D[1].Points[i]) * p_obb.box.radiuses.Points[1]) +
+                                    (fabsf(p_obb.axis.Points2D[2].Points[i]) * p_obb.box.radiuses.Points[2]);
+            float32 l_component_extend =
+                (fabsf(p_obb.axis.Points2D[0].Points[i]) + fabsf(p_obb.axis.Points2D[1].Points[i]) + fabsf(p_obb.axis.Points2D[2].Points[i])) * p_obb.box.radiuses.Points[i];
+            l_extend.Points[i] = l_axis_extend > l_component_extend ? l_axis_extend : l_component_extend;
+        }
+        return BroadPhaseBounds{p_obb.box.center - l_extend, p_obb.box.center + l_extend};
+    };
+
+    // Bounds that contains nothing, merging them with other bounds returns the other bounds
+    inline static BroadPhaseBounds build_empty()
+    {
+        return BroadPhaseBounds{v3f{FLT_MAX, FLT_MAX, FLT_MAX}, v3f{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+    };
+
+    inline BroadPhaseBounds merge(const BroadPhaseBounds& p_other) const
+    {
+        BroadPhaseBounds l_return;
+        for (int8 i = 0; i < 3; i++)
+        {
+            l_return.min.Points[i] = this->min.Points[i] < p_other.min.Points[i] ? this->min.Points[i] : p_other.min.Points[i];
+            l_return.max.Points[i] = this->max.Points[i] > p_other.max.Points[i] ? this->max.Points[i] : p_other.max.Points[i];
+        }
+        return l_return;
+    };
+
+    inline BroadPhaseBounds enlarge(const float32 p_margin) const
+    {
+        v3f l_margin = v3f{p_margin, p_margin, p_margin};
+        return BroadPhaseBounds{this->min - l_margin, this->max + l_margin};
+    };
+
+    inline int8 contains(const BroadPhaseBounds& p_other) const
+    {
+        return (this->min.x <= p_other.min.x) & (this->min.y <= p_other.min.y) & (this->min.z <= p_other.min.z) & (this->max.x >= p_other.max.x) & (this->max.y >= p_other.max.y) &
+               (this->max.z >= p_other.max.z);
+    };
+
+    inline int8 overlap(const BroadPhaseBounds& p_other) const
+    {
+        return (this->min.x <= p_other.max.x) & (this->max.x >= p_other.min.x) & (this->min.y <= p_other.max.y) & (this->max.y >= p_other.min.y) & (this->min.z <= p_other.max.z) &
+               (this->max.z >= p_other.min.z);
+    };
+
+    // Half of the surface area. Used as the insertion cost heuristic.
+    inline float32 perimeter() const
+    {
+        v3f l_size = this->max - this->min;
+        return (l_size.x * l_size.y) + (l_size.y * l_size.z) + (l_size.z * l_size.x);
+    };
+};
+
+/*
+    A node of the BroadPhase tree.
+    Leaf nodes are associated to a BoxCollider. Internal nodes bounds always contain their two childs bounds.
+*/
+struct BroadPhaseNode
+{
+    BroadPhaseBounds fat_bounds;
+    Token(BroadPhaseNode) parent;
+    Token(BroadPhaseNode) left;
+    Token(BroadPhaseNode) right;
+    int32 height;
+
+    // Leaf only
+    Token(BoxCollider) collider;
+    BroadPhaseBounds laststep_bounds;
+    BroadPhaseBounds current_bounds;
+
+    inline int8 is_leaf() const
+    {
+        return tk_eq(this->left, tk_bd(BroadPhaseNode));
+    };
+};
+
+/*
+    The BroadPhase is a dynamic AABB tree that spatially index BoxColliders world bounds.
+    It is used to retrieve intersection candidates without querying the whole world.
+
+    Leaves store "fat" bounds enlarged by a margin, so that small movements doesn't modify the tree.
+    Leaves also keep the bounds of the collider at the last step (laststep_bounds) in addition of the current ones (current_bounds).
+    Fat bounds always contains both of them. This is to be sure that a collider that was intersecting at the previous step is always retrieved
+    as a candidate, even if it has moved far away. Thus, exit intersections are never missed.
+*/
+struct BroadPhase
+{
+    static constexpr float32 fat_margin = 0.1f;
+
+    Pool<BroadPhaseNode> nodes;
+    Token(BroadPhaseNode) root;
+    Vector<Token(BroadPhaseNode)> query_stack;
+
+    inline static BroadPhase allocate_default()
+    {
+        return BroadPhase{Pool<BroadPhaseNode>::allocate(0), tk_bd(BroadPhaseNode), Vector<Token(BroadPhaseNode)>::allocate(0)};
+    };
+
+    inline void free()
+    {
+#if COLLIDER_BOUND_TEST
+        assert_true(tk_eq(this->root, tk_bd(BroadPhaseNode)));
+        assert_true(!this->nodes.has_allocated_elements());
+#endif
+        this->nodes.free();
+        this->query_stack.free();
+    };
+
+    /*
+        Allocates and inserts the leaf of a collider.
+        The collider has no last step bounds until it's movement is settled, so that it's first movement doesn't sweep from it's allocation position.
+    */
+    inline Token(BroadPhaseNode) allocate_leaf(const Token(BoxCollider) p_collider, const BroadPhaseBounds& p_world_bounds)
+    {
+        Token(BroadPhaseNode) l_leaf = this->nodes.alloc_element(BroadPhaseNode{p_world_bounds.enlarge(fat_margin), tk_bd(BroadPhaseNode), tk_bd(BroadPhaseNode), tk_bd(BroadPhaseNode), 0,
+                                                                                 p_collider, BroadPhaseBounds::build_empty(), p_world_bounds});
+        this->insert_leaf(l_leaf);
+        return l_leaf;
+    };
+
+    /*
+        Updates the current bounds of the collider leaf.
+        The tree is modified only if the fat bounds doesn't contain the last step and current bounds anymore.
+    */
+    inline void push_collider_bounds(const Token(BroadPhaseNode) p_leaf, const BroadPhaseBounds& p_world_bounds)
+    {
+        BroadPhaseNode& l_leaf = this->nodes.get(p_leaf);
+        l_leaf.current_bounds = p_world_bounds;
+        BroadPhaseBounds l_swept_bounds = l_leaf.laststep_bounds.merge(l_leaf.current_bounds);
+        if (!l_leaf.fat_bounds.contains(l_swept_bounds))
+        {
+            l_leaf.fat_bounds = l_swept_bounds.enlarge(fat_margin);
+            this->remove_leaf(p_leaf);
+            this->insert_leaf(p_leaf);
+        }
+    };
+
+    // Consumes the movement of the collider. Once called, the previous bounds are no longer considered by queries.
+    inline void settle_leaf(const Token(BroadPhaseNode) p_leaf)
+    {
+        BroadPhaseNode& l_leaf = this->nodes.get(p_leaf);
+        l_leaf.laststep_bounds = l_leaf.current_bounds;
+    };
+
+    // Bounds that covers the collider at the last step and now.
+    inline BroadPhaseBounds get_swept_bounds(const Token(BroadPhaseNode) p_leaf)
+    {
+        BroadPhaseNode& l_leaf = this->nodes.get(p_leaf);
+        return l_leaf.laststep_bounds.merge(l_leaf.current_bounds);
+    };
+
+    inline void free_leaf(const Token(BroadPhaseNode) p_leaf)
+    {
+        this->remove_leaf(p_leaf);
+        this->nodes.release_element(p_leaf);
+    };
+
+    /*
+        Calls p_foreach with every collider whose fat bounds overlaps with p_bounds.
+        The tree must not be modified while querying.
+    */
+    template <class ForeachFunc> inline void query(const BroadPhaseBounds& p_bounds, const ForeachFunc& p_foreach)
+    {
+        this->query_with_stack(p_bounds, &this->query_stack, p_foreach);
+    };
+
+    /*
+        Same as query, but the traversal uses the in_out_query_stack buffer.
+        Multiple threads can query the tree at the same time, as long as they have their own stack.
+    */
+    template <class ForeachFunc> inline void query_with_stack(const BroadPhaseBounds& p_bounds, Vector<Token(BroadPhaseNode)>* in_out_query_stack, const ForeachFunc& p_foreach)
+    {
+        if (tk_eq(this->root, tk_bd(BroadPhaseNode)))
+        {
+            return;
+        }
+
+        in_out_query_stack->clear();
+        in_out_query_stack->push_back_element(this->root);
+        while (in_out_query_stack->Size > 0)
+        {
+            Token(BroadPhaseNode) l_node_token = in_out_query_stack->get(in_out_query_stack->Size - 1);
+            in_out_query_stack->pop_back();
+
+            BroadPhaseNode& l_node = this->nodes.get(l_node_token);
+            if (l_node.fat_bounds.overlap(p_bounds))
+            {
+                if (l_node.is_leaf())
+                {
+                    p_foreach(l_node.collider);
+                }
+                else
+                {
+                    in_out_query_stack->push_back_element(l_node.left);
+                    in_out_query_stack->push_back_element(l_node.right);
+                }
+            }
+        }
+    };
+
+  private:
+    inline void insert_leaf(const Token(BroadPhaseNode) p_leaf)
+    {
+        if (tk_eq(this->root, tk_bd(BroadPhaseNode)))
+        {
+            this->root = p_leaf;
+            this->nodes.get(p_leaf).parent = tk_bd(BroadPhaseNode);
+            return;
+        }
+
+        BroadPhaseBounds l_leaf_bounds = this->nodes.get(p_leaf).fat_bounds;
+
+        // Finding the best sibling by descending the tree with the perimeter heuristic
+        Token(BroadPhaseNode) l_sibling = this->root;
+        while (!this->nodes.get(l_sibling).is_leaf())
+        {
+            BroadPhaseNode& l_node = this->nodes.get(l_sibling);
+
+            float32 l_area = l_node.fat_bounds.perimeter();
+            float32 l_combined_area = l_node.fat_bounds.merge(l_leaf_bounds).perimeter();
+
+            // Cost of creating a new parent for this node and the new leaf
+            float32 l_cost = 2.0f * l_combined_area;
+            // Minimum cost of pushing the leaf further down the tree
+            float32 l_inheritance_cost = 2.0f * (l_combined_area - l_area);
+
+            float32 l_left_cost = this->descend_cost(l_node.left, l_leaf_bounds) + l_inheritance_cost;
+            float32 l_right_cost = this->descend_cost(l_node.right, l_leaf_bounds) + l_inheritance_cost;
+
+            if (l_cost < l_left_cost && l_cost < l_right_cost)
+            {
+                break;
+            }
+
+            l_sibling = l_left_cost < l_right_cost ? l_node.left : l_node.right;
+        }
+
+        Token(BroadPhaseNode) l_old_parent = this->nodes.get(l_sibling).parent;
+        Token(BroadPhaseNode) l_new_parent =
+            this->nodes.alloc_element(BroadPhaseNode{l_leaf_bounds.merge(this->nodes.get(l_sibling).fat_bounds), l_old_parent, l_sibling, p_leaf, this->nodes.get(l_sibling).height + 1,
+                                                     tk_bd(BoxCollider), BroadPhaseBounds{}, BroadPhaseBounds{}});
+
+        if (tk_neq(l_old_parent, tk_bd(BroadPhaseNode)))
+        {
+            this->replace_child(l_old_parent, l_sibling, l_new_parent);
+        }
+        else
+        {
+            this->root = l_new_parent;
+        }
+        this->nodes.get(l_sibling).parent = l_new_parent;
+        this->nodes.get(p_leaf).parent = l_new_parent;
+
+        this->refit_ancestors(l_new_parent);
+    };
+
+    inline void remove_leaf(const Token(BroadPhaseNode) p_leaf)
+    {
+        if (tk_eq(this->root, p_leaf))
+        {
+            this->root = tk_bd(BroadPhaseNode);
+            return;
+        }
+
+        Token(BroadPhaseNode) l_parent = this->nodes.get(p_leaf).parent;
+        Token(BroadPhaseNode) l_grand_parent = this->nodes.get(l_parent).parent;
+        Token(BroadPhaseNode) l_sibling = tk_eq(this->nodes.get(l_parent).left, p_leaf) ? this->nodes.get(l_parent).right : this->nodes.get(l_parent).left;
+
+        this->nodes.release_element(l_parent);
+        this->nodes.get(p_leaf).parent = tk_bd(BroadPhaseNode);
+        this->nodes.get(l_sibling).parent = l_grand_parent;
+
+        if (tk_neq(l_grand_parent, tk_bd(BroadPhaseNode)))
+        {
+            this->replace_child(l_grand_parent, l_parent, l_sibling);
+            this->refit_ancestors(l_grand_parent);
+        }
+        else
+        {
+            this->root = l_sibling;
+        }
+    };
+
+    inline float32 descend_cost(const Token(BroadPhaseNode) p_child, const BroadPhaseBounds& p_leaf_bounds)
+    {
+        BroadPhaseNode& l_child = this->nodes.get(p_child);
+        if (l_child.is_leaf())
+        {
+            return l_child.fat_bounds.merge(p_leaf_bounds).perimeter();
+        }
+        return l_child.fat_bounds.merge(p_leaf_bounds).perimeter() - l_child.fat_bounds.perimeter();
+    };
+
+    inline void replace_child(const Token(BroadPhaseNode) p_parent, const Token(BroadPhaseNode) p_old_child, const Token(BroadPhaseNode) p_new_child)
+    {
+        BroadPhaseNode& l_parent = this->nodes.get(p_parent);
+        if (tk_eq(l_parent.left, p_old_child))
+        {
+            l_parent.left = p_new_child;
+        }
+        else
+        {
+            l_parent.right = p_new_child;
+        }
+    };
+
+    inline void refit(BroadPhaseNode& p_node)
+    {
+        BroadPhaseNode& l_left = this->nodes.get(p_node.left);
+        BroadPhaseNode& l_right = this->nodes.get(p_node.right);
+        p_node.fat_bounds = l_left.fat_bounds.merge(l_right.fat_bounds);
+        p_node.height = 1 + (l_left.height > l_right.height ? l_left.height : l_right.height);
+    };
+
+    // Walks up the tree from p_node by rebalancing and updating bounds.
+    inline void refit_ancestors(Token(BroadPhaseNode) p_node)
+    {
+        while (tk_neq(p_node, tk_bd(BroadPhaseNode)))
+        {
+            p_node = this->balance(p_node);
+            BroadPhaseNode& l_node = this->nodes.get(p_node);
+            this->refit(l_node);
+            p_node = l_node.parent;
+        }
+    };
+
+    /*
+        If the p_node subtree is unbalanced, performs a rotation to lift up the highest child.
+        Returns the new root of the subtree.
+    */
+    inline Token(BroadPhaseNode) balance(const Token(BroadPhaseNode) p_node)
+    {
+        BroadPhaseNode& l_a = this->nodes.get(p_node);
+        if (l_a.is_leaf() || l_a.height < 2)
+        {
+            return p_node;
+        }
+
+        Token(BroadPhaseNode) l_b_token = l_a.left;
+        Token(BroadPhaseNode) l_c_token = l_a.right;
+        BroadPhaseNode& l_b = this->nodes.get(l_b_token);
+        BroadPhaseNode& l_c = this->nodes.get(l_c_token);
+
+        int32 l_balance = l_c.height - l_b.height;
+
+        if (l_balance > 1)
+        {
+            this->rotate(p_node, l_a, l_c_token, l_c, &l_a.right);
+            return l_c_token;
+        }
+        else if (l_balance < -1)
+        {
+            this->rotate(p_node, l_a, l_b_token, l_b, &l_a.left);
+            return l_b_token;
+        }
+
+        return p_node;
+    };
+
+    /*
+        Lifts the p_lifted child of p_node to the p_node place.
+        The highest grand child stays in p_lifted, the lowest takes the place of p_lifted under p_node.
+    */
+    inline void rotate(const Token(BroadPhaseNode) p_node_token, BroadPhaseNode& p_node, const Token(BroadPhaseNode) p_lifted_token, BroadPhaseNode& p_lifted,
+                       Token(BroadPhaseNode) * p_node_lifted_slot)
+    {
+        Token(BroadPhaseNode) l_f_token = p_lifted.left;
+        Token(BroadPhaseNode) l_g_token = p_lifted.right;
+        BroadPhaseNode& l_f = this->nodes.get(l_f_token);
+        BroadPhaseNode& l_g = this->nodes.get(l_g_token);
+
+        p_lifted.left = p_node_token;
+        p_lifted.parent = p_node.parent;
+        p_node.parent = p_lifted_token;
+
+        if (tk_neq(p_lifted.parent, tk_bd(BroadPhaseNode)))
+        {
+            this->replace_child(p_lifted.parent, p_node_token, p_lifted_token);
+        }
+        else
+        {
+            this->root = p_lifted_token;
+        }
+
+        if (l_f.height > l_g.height)
+        {
+            p_lifted.right = l_f_token;
+            *p_node_lifted_slot = l_g_token;
+            l_g.parent = p_node_token;
+        }
+        else
+        {
+            p_lifted.right = l_g_token;
+            *p_node_lifted_slot = l_f_token;
+            l_f.parent = p_node_token;
+        }
+
+        this->refit(p_node);
+        this->refit(p_lifted);
+    };
+};
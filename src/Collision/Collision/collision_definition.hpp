@@ -51,8 +51,10 @@ struct CollisionHeap2
 {
     PoolIndexed<BoxCollider> box_colliders;
     Pool<Token(ColliderDetector)> box_colliders_to_collider_detector;
+    Pool<Token(BroadPhaseNode)> box_colliders_to_broadphase_leaf;
     PoolIndexed<ColliderDetector> collider_detectors;
     PoolOfVector<TriggerEvent> collider_detectors_events_2;
+    BroadPhase broad_phase;
 
     static CollisionHeap2 allocate_default();
     void free();
@@ -70,6 +72,17 @@ struct CollisionHeap2
     Slice<TriggerEvent> get_triggerevents_from_colliderdetector(const Token(ColliderDetector) p_collider_detector);
 
     int8 does_boxcollider_have_colliderdetector(const Token(BoxCollider) p_box_collider);
+
+    Token(BroadPhaseNode) & get_broadphaseleaf_from_boxcollider(const Token(BoxCollider) p_box_collider);
+
+    /*
+        Calls p_foreach with all BoxColliders that may intersect with p_box_collider, from the last step position to it's current position.
+    */
+    template <class ForeachFunc>
+    void query_boxcollider_broadphase_candidates(const Token(BoxCollider) p_box_collider, Vector<Token(BroadPhaseNode)>* in_out_query_stack, const ForeachFunc& p_foreach);
+
+    // The last step position of the BoxCollider is no longer considered by broad phase queries.
+    void settle_boxcollider_broadphase(const Token(BoxCollider) p_box_collider);
 };
 
 struct CollisionDetectionStep
@@ -97,6 +110,32 @@ struct CollisionDetectionStep
         inline static CollisionDetectorDeletionEvent build(const Token(BoxCollider) p_box_collider, const Token(ColliderDetector) p_collider_detector);
     };
 
+    /*
+        Buffers of a narrow phase job. A job processes a contiguous range of in_colliders_processed.
+        Intersection events are pushed in the same order as if the range was processed by the single threaded narrow phase.
+        Jobs are kept between steps to avoid reallocating their buffers.
+    */
+    struct NarrowPhaseJob
+    {
+        Vector<Token(BoxCollider)> broadphase_candidates;
+        Vector<Token(BroadPhaseNode)> broadphase_query_stack;
+        Vector<IntersectionEvent> enter_intersection_events;
+        Vector<IntersectionEvent> exit_intersection_events;
+        Vector<int8> candidates_overlap;
+
+        inline static NarrowPhaseJob allocate();
+        inline void free();
+    };
+
+    struct IndexedIntersectionEvent
+    {
+        IntersectionEvent event;
+        uimax index;
+    };
+
+    // Number of processed colliders handled by a single job of the parallel narrow phase
+    static constexpr uimax narrowphase_job_collider_count = 16;
+
     Vector<Token(BoxCollider)> in_colliders_disabled;
     Vector<Token(BoxCollider)> in_colliders_processed;
 
@@ -112,12 +151,23 @@ struct CollisionDetectionStep
     Vector<IntersectionEvent> is_waitingfor_trigger_stay_nextframe_detector;
     Vector<IntersectionEvent> is_waitingfor_trigger_none_nextframe_detector;
 
+    Vector<Token(BoxCollider)> broadphase_candidates;
+
+    Vector<NarrowPhaseJob> narrowphase_jobs;
+    Vector<IndexedIntersectionEvent> intersectionevents_deduplication_buffer;
+
     inline static CollisionDetectionStep allocate();
     inline void free(CollisionHeap2& p_collision_heap);
 
     /* A frame of the Collision engine. */
     inline void step(CollisionHeap2& p_collision_heap);
 
+    /*
+        Same as step, but the narrow phase of processed colliders is distributed across the threads of the JobSystem.
+        Generated events, and thus TriggerEvents, are identical to step.
+    */
+    inline void step_parallel(CollisionHeap2& p_collision_heap, JobSystem& p_job_system);
+
     inline void push_collider_for_process(const Token(BoxCollider) p_moved_collider);
     inline void push_collider_for_deletion(const Token(BoxCollider) p_collider);
     inline void push_collider_detector_for_deletion(const Token(BoxCollider) p_collider, const Token(ColliderDetector) p_detector);
@@ -140,8 +190,7 @@ struct CollisionDetectionStep
     // /!\ Do not take care of the associated ColliderDetectors.
     inline void remove_references_to_boxcollider(const Token(BoxCollider) p_box_collider);
 
-    // Norify all ColliderDetectors with an exit_collision event.
-    // TODO -> In the future, we want to partition the space to not notify the entire world
+    // Norify all ColliderDetectors that may have intersected with the collider with an exit_collision event.
     inline void generate_exit_collision_for_collider(CollisionHeap2& p_collision_heap, const Token(BoxCollider) p_box_collider);
 
     inline void process_deleted_collider_detectors(CollisionHeap2& p_collision_heap);
@@ -154,7 +203,35 @@ struct CollisionDetectionStep
     */
     inline void process_deleted_colliders(CollisionHeap2& p_collision_heap);
     inline void process_input_colliders(CollisionHeap2& p_collision_heap);
+    inline void process_input_colliders_parallel(CollisionHeap2& p_collision_heap, JobSystem& p_job_system);
+
+    /*
+        Calculates intersections of the processed collider with the broad phase candidates and pushes the resulting events to the job buffers.
+        The CollisionHeap2 is only read, so multiple processed colliders can be handled at the same time with different jobs.
+    */
+    inline static void process_input_collider(CollisionHeap2& p_collision_heap, const Token(BoxCollider) p_left_collider_token, NarrowPhaseJob& p_job);
+
+    /*
+        Tests p_left_projected against all candidates accepted by p_filter. Tests are done by batches of obbs with obb::overlap2_batch.
+        The returned slice has one overlap result per candidate, candidates rejected by the filter are not tested and are set to 0.
+    */
+    template <class CandidateFilterFunc>
+    inline static Slice<int8> calculate_candidates_overlap(CollisionHeap2& p_collision_heap, const obb& p_left_projected, const Slice<Token(BoxCollider)>& p_candidates,
+                                                           Vector<int8>* in_out_candidates_overlap, const CandidateFilterFunc& p_filter);
+
+    inline void allocate_narrowphase_jobs(const uimax p_job_count);
+
+    // Job events are appended to the current step events in job order, then processed colliders are consumed.
+    inline void merge_narrowphase_jobs(CollisionHeap2& p_collision_heap, const uimax p_job_count);
+
+    /*
+        Retrieves BoxColliders that may intersect with p_box_collider from the broad phase.
+        Candidates are sorted by token to keep events order independant of the broad phase tree layout.
+    */
+    inline static Slice<Token(BoxCollider)> query_broadphase_candidates(CollisionHeap2& p_collision_heap, const Token(BoxCollider) p_box_collider,
+                                                                        Vector<Token(BoxCollider)>* in_out_candidates, Vector<Token(BroadPhaseNode)>* in_out_query_stack);
 
+    // Only the first occurence of an event is kept, events order is preserved.
     inline void remove_intersectionevents_duplicate(Vector<IntersectionEvent>* in_out_intersection_events);
 
     /*
@@ -4,6 +4,7 @@ inline BoxCollider BoxCollider::build_from_local_aabb(const int8 p_enabled, cons
 {
     BoxCollider l_box_collider;
     l_box_collider.enabled = p_enabled;
+    l_box_collider.transform = transform_pa{v3f_const::ZERO, m33f_const::IDENTITY};
     l_box_collider.local_box = p_local_box;
     return l_box_collider;
 };
@@ -25,8 +26,8 @@ inline ColliderDetector ColliderDetector::build(const PoolOfVectorToken<TriggerE
 
 inline CollisionHeap2 CollisionHeap2::allocate_default()
 {
-    return CollisionHeap2{PoolIndexed<BoxCollider>::allocate_default(), Pool<Token(ColliderDetector)>::allocate(0), PoolIndexed<ColliderDetector>::allocate_default(),
-                          PoolOfVector<TriggerEvent>::allocate_default()};
+    return CollisionHeap2{PoolIndexed<BoxCollider>::allocate_default(),       Pool<Token(ColliderDetector)>::allocate(0), Pool<Token(BroadPhaseNode)>::allocate(0),
+                          PoolIndexed<ColliderDetector>::allocate_default(), PoolOfVector<TriggerEvent>::allocate_default(), BroadPhase::allocate_default()};
 };
 
 inline void CollisionHeap2::free()
@@ -34,14 +35,17 @@ inline void CollisionHeap2::free()
 #if COLLIDER_BOUND_TEST
     assert_true(!this->box_colliders.has_allocated_elements());
     assert_true(!this->box_colliders_to_collider_detector.has_allocated_elements());
+    assert_true(!this->box_colliders_to_broadphase_leaf.has_allocated_elements());
     assert_true(!this->collider_detectors.has_allocated_elements());
     assert_true(!this->collider_detectors_events_2.has_allocated_elements());
 #endif
 
     this->box_colliders.free();
     this->box_colliders_to_collider_detector.free();
+    this->box_colliders_to_broadphase_leaf.free();
     this->collider_detectors.free();
     this->collider_detectors_events_2.free();
+    this->broad_phase.free();
 };
 
 inline Token(ColliderDetector) CollisionHeap2::allocate_colliderdetector(const Token(BoxCollider) p_box_collider)
@@ -76,6 +80,9 @@ inline Token(BoxCollider) CollisionHeap2::allocate_boxcollider(const BoxCollider
 {
     Token(BoxCollider) l_box_collider_index = this->box_colliders.alloc_element(p_box_collider);
     this->box_colliders_to_collider_detector.alloc_element(tk_bd(ColliderDetector));
+    // The collider is indexed as soon as it is allocated, a collider that never moves must still be retrieved by queries
+    this->box_colliders_to_broadphase_leaf.alloc_element(this->broad_phase.allocate_leaf(
+        l_box_collider_index, BroadPhaseBounds::build_from_obb(p_box_collider.local_box.add_position_rotation(p_box_collider.transform))));
     return l_box_collider_index;
 };
 
@@ -83,6 +90,9 @@ inline void CollisionHeap2::push_boxcollider_transform(Token(BoxCollider) p_boxc
 {
     BoxCollider& l_boxcollider = this->box_colliders.get(p_boxcollider);
     l_boxcollider.transform = p_world_transform;
+
+    this->broad_phase.push_collider_bounds(this->get_broadphaseleaf_from_boxcollider(p_boxcollider),
+                                           BroadPhaseBounds::build_from_obb(l_boxcollider.local_box.add_position_rotation(l_boxcollider.transform)));
 };
 
 inline void CollisionHeap2::free_boxcollider(const Token(BoxCollider) p_box_collider)
@@ -92,8 +102,11 @@ inline void CollisionHeap2::free_boxcollider(const Token(BoxCollider) p_box_coll
     {
         this->free_colliderdetector(p_box_collider, l_collider_detector);
     }
+    this->broad_phase.free_leaf(this->get_broadphaseleaf_from_boxcollider(p_box_collider));
+
     this->box_colliders.release_element(p_box_collider);
     this->box_colliders_to_collider_detector.release_element(tk_bf(Token(ColliderDetector), p_box_collider));
+    this->box_colliders_to_broadphase_leaf.release_element(tk_bf(Token(BroadPhaseNode), p_box_collider));
 };
 
 inline Token(ColliderDetector) & CollisionHeap2::get_colliderdetector_from_boxcollider(const Token(BoxCollider) p_box_collider)
@@ -128,6 +141,22 @@ inline int8 CollisionHeap2::does_boxcollider_have_colliderdetector(const Token(B
     return 0;
 };
 
+inline Token(BroadPhaseNode) & CollisionHeap2::get_broadphaseleaf_from_boxcollider(const Token(BoxCollider) p_box_collider)
+{
+    return this->box_colliders_to_broadphase_leaf.get(tk_bf(Token(BroadPhaseNode), p_box_collider));
+};
+
+template <class ForeachFunc>
+inline void CollisionHeap2::query_boxcollider_broadphase_candidates(const Token(BoxCollider) p_box_collider, Vector<Token(BroadPhaseNode)>* in_out_query_stack, const ForeachFunc& p_foreach)
+{
+    this->broad_phase.query_with_stack(this->broad_phase.get_swept_bounds(this->get_broadphaseleaf_from_boxcollider(p_box_collider)), in_out_query_stack, p_foreach);
+};
+
+inline void CollisionHeap2::settle_boxcollider_broadphase(const Token(BoxCollider) p_box_collider)
+{
+    this->broad_phase.settle_leaf(this->get_broadphaseleaf_from_boxcollider(p_box_collider));
+};
+
 inline CollisionDetectionStep::IntersectionEvent CollisionDetectionStep::IntersectionEvent::build(const Token(ColliderDetector) p_detector, const Token(BoxCollider) p_other)
 {
     return IntersectionEvent{p_detector, p_other};
@@ -144,12 +173,28 @@ inline CollisionDetectionStep::CollisionDetectorDeletionEvent CollisionDetection
     return CollisionDetectorDeletionEvent{p_box_collider, p_collider_detector};
 };
 
+inline CollisionDetectionStep::NarrowPhaseJob CollisionDetectionStep::NarrowPhaseJob::allocate()
+{
+    return NarrowPhaseJob{Vector<Token(BoxCollider)>::allocate(0), Vector<Token(BroadPhaseNode)>::allocate(0), Vector<IntersectionEvent>::allocate(0), Vector<IntersectionEvent>::allocate(0),
+                          Vector<int8>::allocate(0)};
+};
+
+inline void CollisionDetectionStep::NarrowPhaseJob::free()
+{
+    this->broadphase_candidates.free();
+    this->broadphase_query_stack.free();
+    this->enter_intersection_events.free();
+    this->exit_intersection_events.free();
+    this->candidates_overlap.free();
+};
+
 inline CollisionDetectionStep CollisionDetectionStep::allocate()
 {
     return CollisionDetectionStep{
         Vector<Token(BoxCollider)>::allocate(0), Vector<Token(BoxCollider)>::allocate(0), Vector<Token(BoxCollider)>::allocate(0), Vector<CollisionDetectorDeletionEvent>::allocate(0),
         Vector<IntersectionEvent>::allocate(0),  Vector<IntersectionEvent>::allocate(0),  Vector<IntersectionEvent>::allocate(0),  Vector<IntersectionEvent>::allocate(0),
-        Vector<IntersectionEvent>::allocate(0),  Vector<IntersectionEvent>::allocate(0),
+        Vector<IntersectionEvent>::allocate(0),  Vector<IntersectionEvent>::allocate(0),  Vector<Token(BoxCollider)>::allocate(0), Vector<NarrowPhaseJob>::allocate(0),
+        Vector<IndexedIntersectionEvent>::allocate(0),
     };
 };
 
@@ -181,6 +226,13 @@ inline void CollisionDetectionStep::free(CollisionHeap2& p_collision_heap)
     this->is_waitingfor_trigger_stay_nextframe_detector.free();
     this->is_waitingfor_trigger_none_detector.free();
     this->is_waitingfor_trigger_none_nextframe_detector.free();
+    this->broadphase_candidates.free();
+    for (loop(i, 0, this->narrowphase_jobs.Size))
+    {
+        this->narrowphase_jobs.get(i).free();
+    }
+    this->narrowphase_jobs.free();
+    this->intersectionevents_deduplication_buffer.free();
 };
 
 /*
@@ -236,6 +288,24 @@ inline void CollisionDetectionStep::step(CollisionHeap2& p_collision_heap)
     this->free_deleted_colliders(p_collision_heap); // 9*
 };
 
+inline void CollisionDetectionStep::step_parallel(CollisionHeap2& p_collision_heap, JobSystem& p_job_system)
+{
+    this->swap_detector_events();
+
+    this->process_deleted_collider_detectors(p_collision_heap);
+    this->process_deleted_colliders(p_collision_heap);
+
+    this->process_input_colliders_parallel(p_collision_heap, p_job_system);
+    this->remove_current_step_event_duplicates();
+
+    this->udpate_triggerstate_from_lastframe_intersectionevents(p_collision_heap);
+    this->udpate_triggerstate_from_intersectionevents(p_collision_heap);
+
+    this->clear_current_step_events();
+
+    this->free_deleted_colliders(p_collision_heap);
+};
+
 inline void CollisionDetectionStep::push_collider_for_process(const Token(BoxCollider) p_moved_collider)
 {
     this->in_colliders_processed.push_back_element(p_moved_collider);
@@ -352,20 +422,24 @@ inline void CollisionDetectionStep::remove_references_to_boxcollider(const Token
     });
 };
 
-// Norify all ColliderDetectors with an exit_collision event.
-// TODO -> In the future, we want to partition the space to not notify the entire world
+// Norify all ColliderDetectors that may have intersected with the collider with an exit_collision event.
+// A ColliderDetector that is in an intersection state with the collider is always returned by the broad phase, because they were intersecting at the last step.
 inline void CollisionDetectionStep::generate_exit_collision_for_collider(CollisionHeap2& p_collision_heap, const Token(BoxCollider) p_box_collider)
 {
-    p_collision_heap.box_colliders.foreach ([&](const Token(BoxCollider) p_compared_boxcollider_token, const BoxCollider& p_compared_boxcollider) {
-        if (p_compared_boxcollider.enabled)
+    Slice<Token(BoxCollider)> l_candidates =
+        query_broadphase_candidates(p_collision_heap, p_box_collider, &this->broadphase_candidates, &p_collision_heap.broad_phase.query_stack);
+    for (loop(i, 0, l_candidates.Size))
+    {
+        Token(BoxCollider) l_compared_boxcollider_token = l_candidates.get(i);
+        if (p_collision_heap.box_colliders.get(l_compared_boxcollider_token).enabled)
         {
-            Token(ColliderDetector)& l_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(p_compared_boxcollider_token);
+            Token(ColliderDetector)& l_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_compared_boxcollider_token);
             if (tk_neq(l_collider_detector, tk_b(ColliderDetector, -1)))
             {
                 this->currentstep_exit_intersection_events.push_back_element(IntersectionEvent::build(l_collider_detector, p_box_collider));
             }
         }
-    });
+    }
 };
 
 inline void CollisionDetectionStep::process_deleted_collider_detectors(CollisionHeap2& p_collision_heap)
@@ -409,105 +483,282 @@ inline void CollisionDetectionStep::process_deleted_colliders(CollisionHeap2& p_
 
 inline void CollisionDetectionStep::process_input_colliders(CollisionHeap2& p_collision_heap)
 {
+    this->allocate_narrowphase_jobs(1);
+    NarrowPhaseJob& l_job = this->narrowphase_jobs.get(0);
     for (loop(i, 0, this->in_colliders_processed.Size))
     {
-        Token(BoxCollider)& l_left_collider_token = this->in_colliders_processed.get(i);
-        Token(ColliderDetector)& l_left_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_left_collider_token);
+        process_input_collider(p_collision_heap, this->in_colliders_processed.get(i), l_job);
+    }
 
-        // If the processed collider have a collider detector, we calculate intersection with other BoxColliders
-        // then push collision_event according to the intersection result
-        if (tk_neq(l_left_collider_detector, tk_b(ColliderDetector, -1)))
+    this->merge_narrowphase_jobs(p_collision_heap, 1);
+};
+
+inline void CollisionDetectionStep::process_input_colliders_parallel(CollisionHeap2& p_collision_heap, JobSystem& p_job_system)
+{
+    uimax l_job_count = (this->in_colliders_processed.Size + narrowphase_job_collider_count - 1) / narrowphase_job_collider_count;
+    this->allocate_narrowphase_jobs(l_job_count);
+
+    Slice<Token(BoxCollider)> l_processed_colliders = this->in_colliders_processed.to_slice();
+    p_job_system.parallel_for(Slice<NarrowPhaseJob>::build_memory_elementnb(this->narrowphase_jobs.Memory.Memory, l_job_count), 1,
+                              [&](const uimax p_job_index, NarrowPhaseJob& p_job) {
+                                  uimax l_end = (p_job_index + 1) * narrowphase_job_collider_count;
+                                  if (l_end > l_processed_colliders.Size)
+                                  {
+                                      l_end = l_processed_colliders.Size;
+                                  }
+                                  for (loop(i, p_job_index * narrowphase_job_collider_count, l_end))
+                                  {
+                                      process_input_collider(p_collision_heap, l_processed_colliders.get(i), p_job);
+                                  }
+                              });
+
+    this->merge_narrowphase_jobs(p_collision_heap, l_job_count);
+};
+
+inline void CollisionDetectionStep::process_input_collider(CollisionHeap2& p_collision_heap, const Token(BoxCollider) p_left_collider_token, NarrowPhaseJob& p_job)
+{
+    Token(ColliderDetector)& l_left_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(p_left_collider_token);
+
+    // If the processed collider have a collider detector, we calculate intersection with other BoxColliders
+    // then push collision_event according to the intersection result
+    if (tk_neq(l_left_collider_detector, tk_b(ColliderDetector, -1)))
+    {
+        BoxCollider& l_left_collider = p_collision_heap.box_colliders.get(p_left_collider_token);
+        if (l_left_collider.enabled)
         {
-            BoxCollider& l_left_collider = p_collision_heap.box_colliders.get(l_left_collider_token);
-            if (l_left_collider.enabled)
+            obb l_left_projected = l_left_collider.local_box.add_position_rotation(l_left_collider.transform);
+
+            Slice<Token(BoxCollider)> l_candidates = query_broadphase_candidates(p_collision_heap, p_left_collider_token, &p_job.broadphase_candidates, &p_job.broadphase_query_stack);
+            Slice<int8> l_candidates_overlap = calculate_candidates_overlap(p_collision_heap, l_left_projected, l_candidates, &p_job.candidates_overlap,
+                                                                            [&](const Token(BoxCollider) p_right_collider_token, BoxCollider& p_right_collider) {
+                                                                                return tk_neq(p_left_collider_token, p_right_collider_token) && p_right_collider.enabled;
+                                                                            });
+            for (loop(j, 0, l_candidates.Size))
             {
-                obb l_left_projected = l_left_collider.local_box.add_position_rotation(l_left_collider.transform);
-
-                // TODO -> In the future, we want to avoid to query the world
-                p_collision_heap.box_colliders.foreach ([&](const Token(BoxCollider) l_right_collider_token, BoxCollider& l_right_collider) {
-                    // Avoid self test
-                    if (tk_neq(l_left_collider_token, l_right_collider_token))
+                Token(BoxCollider) l_right_collider_token = l_candidates.get(j);
+                BoxCollider& l_right_collider = p_collision_heap.box_colliders.get(l_right_collider_token);
+                // Avoid self test
+                if (tk_neq(p_left_collider_token, l_right_collider_token))
+                {
+                    if (l_right_collider.enabled)
                     {
-                        if (l_right_collider.enabled)
+                        if (l_candidates_overlap.get(j))
                         {
-                            obb l_right_projected = l_left_collider.local_box.add_position_rotation(l_right_collider.transform);
+                            p_job.enter_intersection_events.push_back_element(IntersectionEvent::build(l_left_collider_detector, l_right_collider_token));
 
-                            if (l_left_projected.overlap2(l_right_projected))
+                            Token(ColliderDetector)& l_right_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_right_collider_token);
+                            if (tk_neq(l_right_collider_detector, tk_b(ColliderDetector, -1)))
                             {
-                                this->currentstep_enter_intersection_events.push_back_element(IntersectionEvent::build(l_left_collider_detector, l_right_collider_token));
-
-                                Token(ColliderDetector)& l_right_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_right_collider_token);
-                                if (tk_neq(l_right_collider_detector, tk_b(ColliderDetector, -1)))
-                                {
-                                    this->currentstep_enter_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, l_left_collider_token));
-                                }
+                                p_job.enter_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, p_left_collider_token));
                             }
-                            else
-                            {
-                                this->currentstep_exit_intersection_events.push_back_element(IntersectionEvent::build(l_left_collider_detector, l_right_collider_token));
+                        }
+                        else
+                        {
+                            p_job.exit_intersection_events.push_back_element(IntersectionEvent::build(l_left_collider_detector, l_right_collider_token));
 
-                                Token(ColliderDetector)& l_right_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_right_collider_token);
-                                if (tk_neq(l_right_collider_detector, tk_b(ColliderDetector, -1)))
-                                {
-                                    this->currentstep_exit_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, l_left_collider_token));
-                                }
+                            Token(ColliderDetector)& l_right_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_right_collider_token);
+                            if (tk_neq(l_right_collider_detector, tk_b(ColliderDetector, -1)))
+                            {
+                                p_job.exit_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, p_left_collider_token));
                             }
                         }
                     }
-                });
+                }
             }
         }
-        // If the processed collider doesn't have a collider detector, we get all other collider detectors and test collision
-        // then push collision_event according to the intersection result
-        else
+    }
+    // If the processed collider doesn't have a collider detector, we get all other collider detectors and test collision
+    // then push collision_event according to the intersection result
+    else
+    {
+        BoxCollider& l_left_collider = p_collision_heap.box_colliders.get(p_left_collider_token);
+        if (l_left_collider.enabled)
         {
-            BoxCollider& l_left_collider = p_collision_heap.box_colliders.get(l_left_collider_token);
-            if (l_left_collider.enabled)
+            obb l_left_projected = l_left_collider.local_box.add_position_rotation(l_left_collider.transform);
+
+            Slice<Token(BoxCollider)> l_candidates = query_broadphase_candidates(p_collision_heap, p_left_collider_token, &p_job.broadphase_candidates, &p_job.broadphase_query_stack);
+            Slice<int8> l_candidates_overlap = calculate_candidates_overlap(p_collision_heap, l_left_projected, l_candidates, &p_job.candidates_overlap,
+                                                                            [&](const Token(BoxCollider) p_right_collider_token, BoxCollider& p_right_collider) {
+                                                                                return p_right_collider.enabled &&
+                                                                                       tk_neq(p_collision_heap.get_colliderdetector_from_boxcollider(p_right_collider_token), tk_b(ColliderDetector, -1));
+                                                                            });
+            for (loop(j, 0, l_candidates.Size))
             {
-                obb l_left_projected = l_left_collider.local_box.add_position_rotation(l_left_collider.transform);
-
-                // TODO -> In the future, we want to avoid to query the world
-                p_collision_heap.box_colliders.foreach ([&](const Token(BoxCollider) l_right_collider_token, BoxCollider& l_right_collider) {
-                    if (l_right_collider.enabled)
+                Token(BoxCollider) l_right_collider_token = l_candidates.get(j);
+                BoxCollider& l_right_collider = p_collision_heap.box_colliders.get(l_right_collider_token);
+                if (l_right_collider.enabled)
+                {
+                    Token(ColliderDetector)& l_right_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_right_collider_token);
+                    if (tk_neq(l_right_collider_detector, tk_b(ColliderDetector, -1)))
                     {
-                        Token(ColliderDetector)& l_right_collider_detector = p_collision_heap.get_colliderdetector_from_boxcollider(l_right_collider_token);
-                        if (tk_neq(l_right_collider_detector, tk_b(ColliderDetector, -1)))
+                        if (l_candidates_overlap.get(j))
                         {
-                            obb l_right_projected = l_left_collider.local_box.add_position_rotation(l_right_collider.transform);
-
-                            if (l_left_projected.overlap2(l_right_projected))
-                            {
-                                this->currentstep_enter_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, l_left_collider_token));
-                            }
-                            else
-                            {
-                                this->currentstep_exit_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, l_left_collider_token));
-                            }
+                            p_job.enter_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, p_left_collider_token));
+                        }
+                        else
+                        {
+                            p_job.exit_intersection_events.push_back_element(IntersectionEvent::build(l_right_collider_detector, p_left_collider_token));
                         }
                     }
-                });
+                }
             }
         }
     }
+};
+
+template <class CandidateFilterFunc>
+inline Slice<int8> CollisionDetectionStep::calculate_candidates_overlap(CollisionHeap2& p_collision_heap, const obb& p_left_projected, const Slice<Token(BoxCollider)>& p_candidates,
+                                                                        Vector<int8>* in_out_candidates_overlap, const CandidateFilterFunc& p_filter)
+{
+    in_out_candidates_overlap->clear();
+
+    obb_batch l_batch = obb_batch::build_empty();
+    uimax l_batch_candidate_indices[simd_f32::Width];
+
+    for (loop(j, 0, p_candidates.Size))
+    {
+        in_out_candidates_overlap->push_back_element(0);
+
+        Token(BoxCollider) l_right_collider_token = p_candidates.get(j);
+        BoxCollider& l_right_collider = p_collision_heap.box_colliders.get(l_right_collider_token);
+        if (p_filter(l_right_collider_token, l_right_collider))
+        {
+            l_batch_candidate_indices[l_batch.count] = j;
+            l_batch.push_back(l_right_collider.local_box.add_position_rotation(l_right_collider.transform));
+
+            if (l_batch.is_full())
+            {
+                uint32 l_overlaps = p_left_projected.overlap2_batch(l_batch);
+                for (loop(l_lane, 0, l_batch.count))
+                {
+                    in_out_candidates_overlap->get(l_batch_candidate_indices[l_lane]) = (l_overlaps >> l_lane) & 1;
+                }
+                l_batch.clear();
+            }
+        }
+    }
+
+    if (l_batch.count != 0)
+    {
+        uint32 l_overlaps = p_left_projected.overlap2_batch(l_batch);
+        for (loop(l_lane, 0, l_batch.count))
+        {
+            in_out_candidates_overlap->get(l_batch_candidate_indices[l_lane]) = (l_overlaps >> l_lane) & 1;
+        }
+    }
+
+    return in_out_candidates_overlap->to_slice();
+};
+
+inline void CollisionDetectionStep::allocate_narrowphase_jobs(const uimax p_job_count)
+{
+    while (this->narrowphase_jobs.Size < p_job_count)
+    {
+        this->narrowphase_jobs.push_back_element(NarrowPhaseJob::allocate());
+    }
+};
+
+inline void CollisionDetectionStep::merge_narrowphase_jobs(CollisionHeap2& p_collision_heap, const uimax p_job_count)
+{
+    for (loop(i, 0, p_job_count))
+    {
+        NarrowPhaseJob& l_job = this->narrowphase_jobs.get(i);
+        this->currentstep_enter_intersection_events.push_back_array(l_job.enter_intersection_events.to_slice());
+        this->currentstep_exit_intersection_events.push_back_array(l_job.exit_intersection_events.to_slice());
+        l_job.enter_intersection_events.clear();
+        l_job.exit_intersection_events.clear();
+    }
+
+    // Movements have been consumed, the broad phase no more needs to consider the last step positions
+    for (loop(i, 0, this->in_colliders_processed.Size))
+    {
+        p_collision_heap.settle_boxcollider_broadphase(this->in_colliders_processed.get(i));
+    }
 
     this->in_colliders_processed.clear();
 };
 
-inline void CollisionDetectionStep::remove_intersectionevents_duplicate(Vector<IntersectionEvent>* in_out_intersection_events)
+inline Slice<Token(BoxCollider)> CollisionDetectionStep::query_broadphase_candidates(CollisionHeap2& p_collision_heap, const Token(BoxCollider) p_box_collider,
+                                                                                     Vector<Token(BoxCollider)>* in_out_candidates, Vector<Token(BroadPhaseNode)>* in_out_query_stack)
 {
-    for (loop(i, 0, in_out_intersection_events->Size))
+    in_out_candidates->clear();
+    p_collision_heap.query_boxcollider_broadphase_candidates(p_box_collider, in_out_query_stack, [&](const Token(BoxCollider) p_candidate) {
+        in_out_candidates->push_back_element(p_candidate);
+    });
+
+    struct BoxColliderSortByToken
     {
-        IntersectionEvent& l_left_intersection_event = in_out_intersection_events->get(i);
-        for (loop(j, i + 1, in_out_intersection_events->Size))
+        inline int8 operator()(const Token(BoxCollider) & p_left, const Token(BoxCollider) & p_right) const
         {
-            IntersectionEvent& l_right_intersection_event = in_out_intersection_events->get(j);
+            return tk_v(p_left) > tk_v(p_right);
+        };
+    };
+    Slice<Token(BoxCollider)> l_candidates = in_out_candidates->to_slice();
+    Sort::Intro(l_candidates, BoxColliderSortByToken{});
+    return l_candidates;
+};
+
+inline void CollisionDetectionStep::remove_intersectionevents_duplicate(Vector<IntersectionEvent>* in_out_intersection_events)
+{
+    if (in_out_intersection_events->Size < 2)
+    {
+        return;
+    }
 
-            if (l_left_intersection_event.equals_intersectionevent(l_right_intersection_event))
+    struct SortByEventThenIndex
+    {
+        inline int8 operator()(const IndexedIntersectionEvent& p_left, const IndexedIntersectionEvent& p_right) const
+        {
+            if (tk_v(p_left.event.detector) != tk_v(p_right.event.detector))
+            {
+                return tk_v(p_left.event.detector) > tk_v(p_right.event.detector);
+            }
+            if (tk_v(p_left.event.other) != tk_v(p_right.event.other))
             {
-                in_out_intersection_events->erase_element_at_always(j);
+                return tk_v(p_left.event.other) > tk_v(p_right.event.other);
             }
+            return p_left.index > p_right.index;
+        };
+    };
+
+    struct SortByIndex
+    {
+        inline int8 operator()(const IndexedIntersectionEvent& p_left, const IndexedIntersectionEvent& p_right) const
+        {
+            return p_left.index > p_right.index;
+        };
+    };
+
+    Vector<IndexedIntersectionEvent>& l_indexed_events = this->intersectionevents_deduplication_buffer;
+    l_indexed_events.clear();
+    for (loop(i, 0, in_out_intersection_events->Size))
+    {
+        l_indexed_events.push_back_element(IndexedIntersectionEvent{in_out_intersection_events->get(i), i});
+    }
+
+    // Duplicates are contiguous once sorted, the first one of them is the first occurence
+    Slice<IndexedIntersectionEvent> l_sorted_events = l_indexed_events.to_slice();
+    Sort::Intro(l_sorted_events, SortByEventThenIndex{});
+
+    uimax l_unique_count = 1;
+    for (loop(i, 1, l_sorted_events.Size))
+    {
+        IndexedIntersectionEvent& l_event = l_sorted_events.get(i);
+        if (!l_event.event.equals_intersectionevent(l_sorted_events.get(l_unique_count - 1).event))
+        {
+            l_sorted_events.get(l_unique_count) = l_event;
+            l_unique_count += 1;
         }
     }
+
+    Slice<IndexedIntersectionEvent> l_unique_events = Slice<IndexedIntersectionEvent>::build_memory_elementnb(l_sorted_events.Begin, l_unique_count);
+    Sort::Intro(l_unique_events, SortByIndex{});
+
+    in_out_intersection_events->clear();
+    for (loop(i, 0, l_unique_events.Size))
+    {
+        in_out_intersection_events->push_back_element(l_unique_events.get(i).event);
+    }
 };
 
 /*
@@ -582,7 +833,7 @@ inline void CollisionDetectionStep::free_deleted_colliders(CollisionHeap2& p_col
 
 /*
     The Collision engine provides a way to hook when a 3D geometric shape enters in collision with anoter one.
-    It is currently a "brute-force" implementation. Meaning that Colliders are not spatially indexed.
+    Colliders are spatially indexed by the BroadPhase, only candidates returned by the BroadPhase are tested for intersection.
 */
 struct Collision2
 {
@@ -608,6 +859,11 @@ struct Collision2
         this->collision_detection_step.step(this->collision_heap);
     };
 
+    inline void step_parallel(JobSystem& p_job_system)
+    {
+        this->collision_detection_step.step_parallel(this->collision_heap, p_job_system);
+    };
+
     inline Token(BoxCollider) allocate_boxcollider(const aabb& p_local_box)
     {
         return this->collision_heap.allocate_boxcollider(BoxCollider::build_from_local_aabb(true, p_local_box));
@@ -1,4 +1,22 @@
 #include "Collision/collision.hpp"
+#include "test_random.hpp"
+
+/*
+    Every test is executed with the single threaded step and then with the parallel step. Both must generate the same TriggerEvents.
+*/
+JobSystem* g_collision_test_job_system = NULL;
+
+inline void collision_test_step(Collision2& p_collision)
+{
+    if (g_collision_test_job_system)
+    {
+        p_collision.step_parallel(*g_collision_test_job_system);
+    }
+    else
+    {
+        p_collision.step();
+    }
+};
 
 /*
     3 BoxColliders that intersect each other : (1,2,3)
@@ -36,7 +54,7 @@ inline void collision_test_01()
 
     Token(ColliderDetector) l_box_collider_1_detector_handle = l_collision.allocate_colliderdetector(l_box_collider_1);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -48,7 +66,7 @@ inline void collision_test_01()
         assert_true(tk_eq(l_box_collider_1_events.get(1).other, l_box_collider_3));
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -63,7 +81,7 @@ inline void collision_test_01()
     l_box_collider_1_transform = transform_pa{v3f{1000000.0f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()};
     l_collision.on_collider_moved(l_box_collider_1, l_box_collider_1_transform);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -75,7 +93,7 @@ inline void collision_test_01()
         assert_true(tk_eq(l_box_collider_1_events.get(1).other, l_box_collider_3));
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -134,14 +152,14 @@ inline void collision_test_02()
         l_box_collider_1_detector_handle = l_collision.allocate_colliderdetector(l_box_collider_1);
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     l_box_collider_2_transform = transform_pa{v3f{1000000.0f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()};
     l_collision.on_collider_moved(l_box_collider_2, l_box_collider_2_transform);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -153,7 +171,7 @@ inline void collision_test_02()
         assert_true(tk_eq(l_box_collider_1_events.get(1).other, l_box_collider_3));
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -167,7 +185,7 @@ inline void collision_test_02()
     l_collision.free_collider(l_box_collider_3);
 
     // Taking deletion into account
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -178,7 +196,7 @@ inline void collision_test_02()
         assert_true(tk_eq(l_box_collider_1_events.get(1).other, l_box_collider_3));
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -243,7 +261,7 @@ inline void collision_test_03()
         l_box_collider_3_detector_handle = l_collision.allocate_colliderdetector(l_box_collider_3);
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -276,7 +294,7 @@ inline void collision_test_03()
     l_box_collider_2_transform = transform_pa{v3f{1000000.0f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()};
     l_collision.on_collider_moved(l_box_collider_2, l_box_collider_2_transform);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -308,7 +326,7 @@ inline void collision_test_03()
 
     l_collision.free_collider(l_box_collider_1);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_2_events = l_collision.get_collision_events(l_box_collider_2_detector_handle);
@@ -329,7 +347,7 @@ inline void collision_test_03()
         assert_true(tk_eq(l_box_collider_3_events.get(1).other, l_box_collider_2));
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_2_events = l_collision.get_collision_events(l_box_collider_2_detector_handle);
@@ -396,12 +414,12 @@ inline void collision_test_04()
         l_box_collider_3_detector_handle = l_collision.allocate_colliderdetector(l_box_collider_3);
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     l_collision.free_collider(l_box_collider_1);
     l_collision.free_colliderdetector(l_box_collider_2, l_box_collider_2_detector_handle);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_3_events = l_collision.get_collision_events(l_box_collider_3_detector_handle);
@@ -420,7 +438,7 @@ inline void collision_test_04()
     Token(BoxCollider) l_box_collider_4;
     l_box_collider_4 = l_collision.allocate_boxcollider(l_unit_aabb);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_3_events = l_collision.get_collision_events(l_box_collider_3_detector_handle);
@@ -478,7 +496,7 @@ inline void collision_test_05()
         l_box_collider_3_detector_handle = l_collision.allocate_colliderdetector(l_box_collider_3);
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         l_collision.free_collider(l_box_collider_1);
@@ -506,7 +524,7 @@ inline void collision_test_05()
         l_collision.on_collider_moved(l_box_collider_1, l_box_collider_1_transform);
     }
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -556,8 +574,8 @@ inline void collision_test_06()
         l_box_collider_2_detector_handle = l_collision.allocate_colliderdetector(l_box_collider_2);
     }
 
-    l_collision.step();
-    l_collision.step();
+    collision_test_step(l_collision);
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -572,7 +590,7 @@ inline void collision_test_06()
     l_box_collider_3_transform = transform_pa{v3f{20.0f, 0.0f, -0.25f}, quat_const::IDENTITY.to_axis()};
     l_collision.on_collider_moved(l_box_collider_3, l_box_collider_3_transform);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -587,7 +605,7 @@ inline void collision_test_06()
     l_box_collider_3_transform = transform_pa{v3f{22.0f, 0.0f, -0.25f}, quat_const::IDENTITY.to_axis()};
     l_collision.on_collider_moved(l_box_collider_3, l_box_collider_3_transform);
 
-    l_collision.step();
+    collision_test_step(l_collision);
 
     {
         Slice<TriggerEvent> l_box_collider_1_events = l_collision.get_collision_events(l_box_collider_1_detector_handle);
@@ -606,6 +624,214 @@ inline void collision_test_06()
     l_collision.free();
 };
 
+/*
+    A row of 64 BoxColliders spaced far away from each other.
+    One BoxCollider with a ColliderDetector (B_D) moves across the row.
+    B_D moves to B0
+        -> B_D~B0 : TRIGGER_ENTER
+    B_D jumps to B32
+        -> B_D~B0 : TRIGGER_EXIT, B_D~B32 : TRIGGER_ENTER
+    B32 moves far away
+        -> B_D~B0 : NONE, B_D~B32 : TRIGGER_EXIT
+    Half of the row is destroyed and B_D moves to B63
+        -> B_D~B63 : TRIGGER_ENTER
+*/
+inline void collision_test_07()
+{
+    Collision2 l_collision = Collision2::allocate();
+
+    aabb l_unit_aabb = aabb{v3f{0.0f, 0.0f, 0.0f}, v3f{0.5f, 0.5f, 0.5f}};
+    const uimax l_row_count = 64;
+    const float32 l_row_spacing = 10.0f;
+
+    Token(BoxCollider) l_row_colliders[l_row_count];
+    for (loop(i, 0, l_row_count))
+    {
+        l_row_colliders[i] = l_collision.allocate_boxcollider(l_unit_aabb);
+        l_collision.on_collider_moved(l_row_colliders[i], transform_pa{v3f{(float32)i * l_row_spacing, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()});
+    }
+
+    Token(BoxCollider) l_detector_collider = l_collision.allocate_boxcollider(l_unit_aabb);
+    Token(ColliderDetector) l_detector = l_collision.allocate_colliderdetector(l_detector_collider);
+    l_collision.on_collider_moved(l_detector_collider, transform_pa{v3f{0.25f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()});
+
+    collision_test_step(l_collision);
+
+    {
+        Slice<TriggerEvent> l_events = l_collision.get_collision_events(l_detector);
+        assert_true(l_events.Size == 1);
+        assert_true(tk_eq(l_events.get(0).other, l_row_colliders[0]));
+        assert_true(l_events.get(0).state == Trigger::State::TRIGGER_ENTER);
+    }
+
+    l_collision.on_collider_moved(l_detector_collider, transform_pa{v3f{(32 * l_row_spacing) + 0.25f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()});
+    collision_test_step(l_collision);
+
+    {
+        Slice<TriggerEvent> l_events = l_collision.get_collision_events(l_detector);
+        assert_true(l_events.Size == 2);
+        assert_true(tk_eq(l_events.get(0).other, l_row_colliders[0]));
+        assert_true(l_events.get(0).state == Trigger::State::TRIGGER_EXIT);
+        assert_true(tk_eq(l_events.get(1).other, l_row_colliders[32]));
+        assert_true(l_events.get(1).state == Trigger::State::TRIGGER_ENTER);
+    }
+
+    l_collision.on_collider_moved(l_row_colliders[32], transform_pa{v3f{0.0f, 1000000.0f, 0.0f}, quat_const::IDENTITY.to_axis()});
+    collision_test_step(l_collision);
+
+    {
+        Slice<TriggerEvent> l_events = l_collision.get_collision_events(l_detector);
+        assert_true(l_events.Size == 2);
+        assert_true(l_events.get(0).state == Trigger::State::NONE);
+        assert_true(tk_eq(l_events.get(1).other, l_row_colliders[32]));
+        assert_true(l_events.get(1).state == Trigger::State::TRIGGER_EXIT);
+    }
+
+    for (loop(i, 0, l_row_count / 2))
+    {
+        l_collision.free_collider(l_row_colliders[i]);
+    }
+    l_collision.on_collider_moved(l_detector_collider, transform_pa{v3f{(63 * l_row_spacing) + 0.25f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()});
+    collision_test_step(l_collision);
+
+    {
+        Slice<TriggerEvent> l_events = l_collision.get_collision_events(l_detector);
+        uimax l_enter_count = 0;
+        for (loop(i, 0, l_events.Size))
+        {
+            if (l_events.get(i).state == Trigger::State::TRIGGER_ENTER)
+            {
+                assert_true(tk_eq(l_events.get(i).other, l_row_colliders[63]));
+                l_enter_count += 1;
+            }
+        }
+        assert_true(l_enter_count == 1);
+    }
+
+    for (loop(i, l_row_count / 2, l_row_count))
+    {
+        l_collision.free_collider(l_row_colliders[i]);
+    }
+    l_collision.free_collider(l_detector_collider);
+
+    l_collision.free();
+};
+
+/*
+    Randomly moved BoxColliders, half of them with a ColliderDetector, are simulated by two Collision2.
+    One is stepped by the single threaded step, the other by the parallel step.
+        -> TriggerEvents of all ColliderDetectors are identical after every step
+*/
+inline void collision_test_08()
+{
+    JobSystem* l_job_system = g_collision_test_job_system;
+    Collision2 l_collisions[2] = {Collision2::allocate(), Collision2::allocate()};
+
+    aabb l_unit_aabb = aabb{v3f{0.0f, 0.0f, 0.0f}, v3f{0.5f, 0.5f, 0.5f}};
+    const uimax l_collider_count = 256;
+    Token(BoxCollider) l_colliders[2][l_collider_count];
+    Token(ColliderDetector) l_detectors[2][l_collider_count];
+
+    for (loop(l_collision_index, 0, 2))
+    {
+        for (loop(i, 0, l_collider_count))
+        {
+            l_colliders[l_collision_index][i] = l_collisions[l_collision_index].allocate_boxcollider(l_unit_aabb);
+            l_detectors[l_collision_index][i] = tk_b(ColliderDetector, -1);
+            if (i % 2 == 0)
+            {
+                l_detectors[l_collision_index][i] = l_collisions[l_collision_index].allocate_colliderdetector(l_colliders[l_collision_index][i]);
+            }
+        }
+    }
+
+    uint32 l_seed = 12345;
+    for (loop(l_step, 0, 20))
+    {
+        // Same movements are applied to both Collision2
+        uint32 l_step_seed = l_seed;
+        for (loop(l_collision_index, 0, 2))
+        {
+            l_seed = l_step_seed;
+            for (loop(i, 0, l_collider_count))
+            {
+                test_random_next(&l_seed);
+                if ((l_seed >> 16) % 3 == 0 || l_step == 0)
+                {
+                    test_random_next(&l_seed);
+                    float32 l_x = (float32)((l_seed >> 16) % 64) * 0.25f;
+                    test_random_next(&l_seed);
+                    float32 l_z = (float32)((l_seed >> 16) % 64) * 0.25f;
+                    l_collisions[l_collision_index].on_collider_moved(l_colliders[l_collision_index][i],
+                                                                      transform_pa{v3f{l_x, 0.0f, l_z}, quat_const::IDENTITY.to_axis()});
+                }
+            }
+        }
+
+        l_collisions[0].step();
+        l_collisions[1].step_parallel(*l_job_system);
+
+        for (loop(i, 0, l_collider_count))
+        {
+            if (tk_neq(l_detectors[0][i], tk_b(ColliderDetector, -1)))
+            {
+                Slice<TriggerEvent> l_events_0 = l_collisions[0].get_collision_events(l_detectors[0][i]);
+                Slice<TriggerEvent> l_events_1 = l_collisions[1].get_collision_events(l_detectors[1][i]);
+                assert_true(l_events_0.Size == l_events_1.Size);
+                for (loop(j, 0, l_events_0.Size))
+                {
+                    assert_true(tk_v(l_events_0.get(j).other) == tk_v(l_events_1.get(j).other));
+                    assert_true(l_events_0.get(j).state == l_events_1.get(j).state);
+                }
+            }
+        }
+    }
+
+    for (loop(l_collision_index, 0, 2))
+    {
+        for (loop(i, 0, l_collider_count))
+        {
+            l_collisions[l_collision_index].free_collider(l_colliders[l_collision_index][i]);
+        }
+        l_collisions[l_collision_index].free();
+    }
+};
+
+// A BoxCollider that has never been moved is still indexed by the broad phase at it's allocation position
+inline void collision_test_09()
+{
+    Collision2 l_collision = Collision2::allocate();
+
+    aabb l_unit_aabb = aabb{v3f{0.0f, 0.0f, 0.0f}, v3f{0.5f, 0.5f, 0.5f}};
+    Token(BoxCollider) l_static_collider = l_collision.allocate_boxcollider(l_unit_aabb);
+
+    Token(BoxCollider) l_detector_collider = l_collision.allocate_boxcollider(l_unit_aabb);
+    Token(ColliderDetector) l_detector = l_collision.allocate_colliderdetector(l_detector_collider);
+    l_collision.on_collider_moved(l_detector_collider, transform_pa{v3f{100.0f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()});
+
+    collision_test_step(l_collision);
+
+    {
+        Slice<TriggerEvent> l_events = l_collision.get_collision_events(l_detector);
+        assert_true(l_events.Size == 0);
+    }
+
+    l_collision.on_collider_moved(l_detector_collider, transform_pa{v3f{0.25f, 0.0f, 0.0f}, quat_const::IDENTITY.to_axis()});
+    collision_test_step(l_collision);
+
+    {
+        Slice<TriggerEvent> l_events = l_collision.get_collision_events(l_detector);
+        assert_true(l_events.Size == 1);
+        assert_true(tk_eq(l_events.get(0).other, l_static_collider));
+        assert_true(l_events.get(0).state == Trigger::State::TRIGGER_ENTER);
+    }
+
+    l_collision.free_collider(l_static_collider);
+    l_collision.free_collider(l_detector_collider);
+
+    l_collision.free();
+};
+
 int main()
 {
     collision_test_01();
@@ -614,6 +840,24 @@ int main()
     collision_test_04();
     collision_test_05();
     collision_test_06();
+    collision_test_07();
+    collision_test_09();
+
+    JobSystem l_job_system = JobSystem::allocate(4);
+    g_collision_test_job_system = &l_job_system;
+
+    collision_test_01();
+    collision_test_02();
+    collision_test_03();
+    collision_test_04();
+    collision_test_05();
+    collision_test_06();
+    collision_test_07();
+    collision_test_08();
+    collision_test_09();
+
+    g_collision_test_job_system = NULL;
+    l_job_system.free();
 
     memleak_ckeck();
 };
\ No newline at end of file
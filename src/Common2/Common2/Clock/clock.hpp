@@ -40,7 +40,7 @@ inline time_t clock_currenttime_mics()
 {
     struct timespec spec;
     clock_gettime(CLOCK_REALTIME, &spec);
-    return round(spec.tv_nsec / 1000);
+    return ((time_t)spec.tv_sec * 1000000) + (time_t)(spec.tv_nsec / 1000);
 };
 
 #endif
\ No newline at end of file
@@ -1,29 +1,95 @@
 #pragma once
 
-#define Hashmap_HashFn_Hash(p_key, p_modulo) hash(p_key, p_modulo)
-
 template <class KeyType_t> struct HashMap_HashFn
 {
-    inline static hash_t Hashmap_HashFn_Hash(const KeyType_t& p_key, const uimax p_modulo)
+    inline static hash_t hash(const KeyType_t& p_key)
     {
-        return HashSlice(Slice<KeyType_t>::build_memory_elementnb((KeyType_t*)&p_key, 1)) % p_modulo;
+        return HashSlice(Slice<KeyType_t>::build_memory_elementnb((KeyType_t*)&p_key, 1));
     };
 };
 
-// We specialize hash only for hash_t because it's formula is simpler
+// We specialize hash only for hash_t because it is already a hash
 template <> struct HashMap_HashFn<hash_t>
 {
-    inline static hash_t Hashmap_HashFn_Hash(const hash_t p_key, const uimax p_modulo)
+    inline static hash_t hash(const hash_t p_key)
+    {
+        return p_key;
+    };
+};
+
+/*
+    A group of 8 control bytes of the HashMap matched at once by bit manipulation on a uint64.
+    Control bytes are either EMPTY (0), DELETED (1) or FULL (0x80 | 7 bits of the key hash).
+*/
+struct HashMapControlGroup
+{
+    static constexpr uimax Width = 8;
+    static constexpr uint64 lsbs = 0x0101010101010101;
+    static constexpr uint64 msbs = 0x8080808080808080;
+
+    static constexpr int8 Empty = 0;
+    static constexpr int8 Deleted = 1;
+
+    uint64 controls;
+
+    inline static HashMapControlGroup load(const int8* p_controls)
+    {
+        HashMapControlGroup l_group;
+        memory_cpy((int8*)&l_group.controls, p_controls, sizeof(uint64));
+        return l_group;
+    };
+
+    inline static int8 full_control(const hash_t p_h2)
+    {
+        return (int8)(0x80 | p_h2);
+    };
+
+    /*
+        Mask of control bytes that are equal to the FULL control of p_h2.
+        It may contain false positives (only when a byte next to them is a real match) so keys must be compared afterwards.
+    */
+    inline uint64 match(const hash_t p_h2) const
     {
-        return p_key % p_modulo;
+        uint64 l_xored = this->controls ^ (lsbs * (uint8)full_control(p_h2));
+        return (l_xored - lsbs) & ~l_xored & msbs;
+    };
+
+    inline uint64 match_empty() const
+    {
+        return ~(this->controls | (this->controls << 7)) & msbs;
+    };
+
+    inline uint64 match_empty_or_deleted() const
+    {
+        return ~this->controls & msbs;
+    };
+
+    // Index in the group of the first matched control byte. p_mask must not be 0.
+    inline static uimax lowest_index(const uint64 p_mask)
+    {
+        uint64 l_lowest = p_mask & (~p_mask + 1);
+        return (uimax)(((((l_lowest >> 7) - 1) & lsbs) * lsbs) >> 56);
+    };
+
+    inline static uint64 remove_lowest(const uint64 p_mask)
+    {
+        return p_mask & (p_mask - 1);
     };
 };
 
+/*
+    Open addressing hash map.
+    Slots are probed by groups of HashMapControlGroup::Width with a triangular sequence over the groups.
+    Erased slots leave a tombstone when their group is full, so that probe sequences passing through it are not broken.
+    The table grows when it's load factor reaches 7/8 (tombstones included). If tombstones are the cause of the growth, the table is rehashed with the same capacity.
+*/
 template <class KeyType, class ElementType> struct HashMap
 {
     Span<ElementType> Memory;
-    Span<KeyType> StoredKeys; // for rehash
-    Span<int8> Slots;
+    Span<KeyType> Keys;
+    Span<int8> Controls;
+    uimax Size;
+    uimax GrowthLeft;
 
     inline static HashMap<KeyType, ElementType> allocate(const uimax p_initial_size)
     {
@@ -33,7 +99,13 @@ template <class KeyType, class ElementType> struct HashMap
             abort(); // minimal allocation size is 2
         }
 #endif
-        return HashMap<KeyType, ElementType>{Span<ElementType>::allocate(p_initial_size), Span<KeyType>::allocate(p_initial_size), Span<int8>::callocate(p_initial_size)};
+        uimax l_capacity = HashMapControlGroup::Width;
+        while (l_capacity < p_initial_size)
+        {
+            l_capacity *= 2;
+        }
+
+        return HashMap<KeyType, ElementType>{Span<ElementType>::allocate(l_capacity), Span<KeyType>::allocate(l_capacity), Span<int8>::callocate(l_capacity), 0, max_load(l_capacity)};
     };
 
     inline static HashMap<KeyType, ElementType> allocate_default()
@@ -41,180 +113,243 @@ template <class KeyType, class ElementType> struct HashMap
         return allocate(8);
     };
 
-    inline void resize(const uimax p_new_size)
-    {
-        this->Memory.resize(p_new_size);
-        this->StoredKeys.resize(p_new_size);
-        this->Slots.resize(p_new_size);
-    };
-
     inline void zero()
     {
-        this->Slots.slice.zero();
+        this->Controls.slice.zero();
+        this->Size = 0;
+        this->GrowthLeft = max_load(this->get_capacity());
     };
 
     inline void free()
     {
         this->Memory.free();
-        this->StoredKeys.free();
-        this->Slots.free();
+        this->Keys.free();
+        this->Controls.free();
+        this->Size = 0;
+        this->GrowthLeft = 0;
     };
 
     inline uimax get_capacity()
     {
-        return this->Memory.Capacity;
+        return this->Controls.Capacity;
+    };
+
+    inline uimax get_size()
+    {
+        return this->Size;
     };
 
     inline int8 empty()
     {
-        for (loop(i, 0, this->Slots.Capacity))
+        return this->Size == 0;
+    };
+
+    // Calls p_foreach(key, value) for every element, in slot order
+    template <class ForeachSlot_t> inline void foreach (const ForeachSlot_t& p_foreach)
+    {
+        for (loop(i, 0, this->get_capacity()))
         {
-            if (this->Slots.get(i))
+            if (this->Controls.get(i) & 0x80)
             {
-                return 0;
+                p_foreach(this->Keys.get(i), this->Memory.get(i));
             }
         }
-
-        return 1;
     };
 
-    inline int8 has_key(const hash_t p_hash)
+    inline int8 has_key_nothashed(const KeyType& p_key)
     {
-        return this->Slots.get(p_hash);
+        uimax l_slot;
+        return this->find_slot(p_key, this->hash_key(p_key), &l_slot);
     };
 
-    inline int8 has_key_nothashed(const KeyType& p_key)
+    inline ElementType* get_value_nothashed(const KeyType& p_key)
     {
-#if CONTAINER_BOUND_TEST
-        hash_t l_hash = this->hash_key(p_key);
-        if (this->has_key(l_hash))
+        uimax l_slot;
+        if (this->find_slot(p_key, this->hash_key(p_key), &l_slot))
         {
-            assert_true(this->check_key_equality(p_key, l_hash));
-            return 1;
+            return &this->Memory.get(l_slot);
         }
-        return 0;
-#else
-        return this->has_key(this->hash_key(p_key));
+
+        return NULL;
+    };
+
+    inline void put_value_nothashed(const KeyType& p_key, const ElementType& p_value)
+    {
+        uimax l_slot;
+#if CONTAINER_BOUND_TEST
+        assert_true( // use has_key before
+#endif
+            this->find_slot(p_key, this->hash_key(p_key), &l_slot)
+#if CONTAINER_BOUND_TEST
+        )
 #endif
+            ;
+        this->Memory.get(l_slot) = p_value;
     };
 
-    inline ElementType* get_value(const hash_t p_hash)
+    inline void push_key_value_nothashed(const KeyType& p_key, const ElementType& p_value)
     {
-        if (this->has_key(p_hash))
+        hash_t l_hash = this->hash_key(p_key);
+#if CONTAINER_BOUND_TEST
+        uimax l_existing_slot;
+        assert_true(!this->find_slot(p_key, l_hash, &l_existing_slot)); // use has_key before
+#endif
+
+        uimax l_slot = this->find_insert_slot(l_hash);
+        if (this->GrowthLeft == 0 && this->Controls.get(l_slot) == HashMapControlGroup::Empty)
         {
-            return &this->Memory.get(p_hash);
+            this->rehash_for_insert();
+            l_slot = this->find_insert_slot(l_hash);
         }
 
-        return NULL;
+        if (this->Controls.get(l_slot) == HashMapControlGroup::Empty)
+        {
+            this->GrowthLeft -= 1;
+        }
+
+        this->Controls.get(l_slot) = HashMapControlGroup::full_control(h2(l_hash));
+        this->Keys.get(l_slot) = p_key;
+        this->Memory.get(l_slot) = p_value;
+        this->Size += 1;
     };
 
-    inline ElementType* get_value_nothashed(const KeyType& p_key)
+    inline void erase_key_nothashed(const KeyType& p_key)
     {
-        hash_t l_hash = this->hash_key(p_key);
-        if (this->has_key(l_hash))
-        {
+        uimax l_slot;
+#if CONTAINER_BOUND_TEST
+        assert_true(
+#endif
+            this->find_slot(p_key, this->hash_key(p_key), &l_slot)
 #if CONTAINER_BOUND_TEST
-            assert_true(this->check_key_equality(p_key, l_hash));
+        )
 #endif
-            return this->get_value(l_hash);
+            ;
+
+        /*
+            A group that still has an EMPTY slot has never been full since the last rehash, so no probe sequence went through it.
+        */
+        uimax l_group_begin = l_slot - (l_slot % HashMapControlGroup::Width);
+        if (HashMapControlGroup::load(this->Controls.Memory + l_group_begin).match_empty())
+        {
+            this->Controls.get(l_slot) = HashMapControlGroup::Empty;
+            this->GrowthLeft += 1;
+        }
+        else
+        {
+            this->Controls.get(l_slot) = HashMapControlGroup::Deleted;
         }
 
-        return NULL;
+        this->Size -= 1;
     };
 
-    inline void put_key_value(const hash_t p_hash, const KeyType& p_key, const ElementType& p_value)
+  private:
+    inline static uimax max_load(const uimax p_capacity)
     {
-#if CONTAINER_BOUND_TEST
-        assert_true(!this->has_key(p_hash)); // use has_key before
-#endif
+        return p_capacity - (p_capacity / 8);
+    };
 
-        this->Memory.get(p_hash) = p_value;
-        this->StoredKeys.get(p_hash) = p_key;
-        this->Slots.get(p_hash) = 1;
+    inline static hash_t hash_key(const KeyType& p_key)
+    {
+        // Finalizer of murmur3, keys that are already hashes may only vary on a few bits
+        uint64 l_hash = (uint64)HashMap_HashFn<KeyType>::hash(p_key);
+        l_hash ^= l_hash >> 33;
+        l_hash *= 0xff51afd7ed558ccd;
+        l_hash ^= l_hash >> 33;
+        return (hash_t)l_hash;
     };
 
-    inline void put_value(const hash_t p_hash, const ElementType& p_value)
+    inline static hash_t h1(const hash_t p_hash)
     {
-#if CONTAINER_BOUND_TEST
-        assert_true(this->has_key(p_hash)); // use has_key before
-#endif
+        return p_hash >> 7;
+    };
 
-        this->Memory.get(p_hash) = p_value;
+    inline static hash_t h2(const hash_t p_hash)
+    {
+        return p_hash & 0x7F;
     };
 
-    inline void put_value_nothashed(const KeyType& p_key, const ElementType& p_value)
+    inline uimax group_mask()
     {
-        hash_t l_hash = this->hash_key(p_key);
-#if CONTAINER_BOUND_TEST
-        assert_true(this->has_key(l_hash) && this->check_key_equality(p_key, l_hash)); // use has_key before
-#endif
-        this->Memory.get(l_hash) = p_value;
+        return (this->get_capacity() / HashMapControlGroup::Width) - 1;
     };
 
-    inline void push_key_value_nothashed(const KeyType& p_key, const ElementType& p_value)
+    inline int8 find_slot(const KeyType& p_key, const hash_t p_hash, uimax* out_slot)
     {
-        hash_t l_hash = this->hash_key(p_key);
-        if (this->has_key(l_hash))
+        uimax l_group_mask = this->group_mask();
+        uimax l_group = h1(p_hash) & l_group_mask;
+        for (loop(l_probe, 1, l_group_mask + 2))
         {
-            HashMap<KeyType, ElementType> l_new_map = HashMap<KeyType, ElementType>::allocate(this->Memory.Capacity * 2);
-            this->rehash_to(&l_new_map);
-            l_hash = l_new_map.hash_key(p_key);
-            while (l_new_map.has_key(l_hash))
+            uimax l_group_begin = l_group * HashMapControlGroup::Width;
+            HashMapControlGroup l_controls = HashMapControlGroup::load(this->Controls.Memory + l_group_begin);
+            for (uint64 l_match = l_controls.match(h2(p_hash)); l_match; l_match = HashMapControlGroup::remove_lowest(l_match))
+            {
+                uimax l_slot = l_group_begin + HashMapControlGroup::lowest_index(l_match);
+                if (memory_compare((int8*)&this->Keys.get(l_slot), (int8*)&p_key, sizeof(KeyType)))
+                {
+                    *out_slot = l_slot;
+                    return 1;
+                }
+            }
+
+            if (l_controls.match_empty())
             {
-                l_new_map.resize(l_new_map.Memory.Capacity * 2);
-                l_new_map.zero();
-                this->rehash_to(&l_new_map);
-                l_hash = l_new_map.hash_key(p_key);
+                return 0;
             }
 
-            this->free();
-            *this = l_new_map;
+            l_group = (l_group + l_probe) & l_group_mask;
         }
 
-        this->put_key_value(l_hash, p_key, p_value);
+        return 0;
     };
 
-    inline void erase_key(const hash_t p_hash)
+    // The table always has at least one EMPTY slot because of the load factor.
+    inline uimax find_insert_slot(const hash_t p_hash)
     {
-        this->Slots.get(p_hash) = 0;
-    };
+        uimax l_group_mask = this->group_mask();
+        uimax l_group = h1(p_hash) & l_group_mask;
+        for (loop(l_probe, 1, l_group_mask + 2))
+        {
+            uimax l_group_begin = l_group * HashMapControlGroup::Width;
+            uint64 l_match = HashMapControlGroup::load(this->Controls.Memory + l_group_begin).match_empty_or_deleted();
+            if (l_match)
+            {
+                return l_group_begin + HashMapControlGroup::lowest_index(l_match);
+            }
+
+            l_group = (l_group + l_probe) & l_group_mask;
+        }
 
-    inline void erase_key_nothashed(const KeyType& p_key)
-    {
-        hash_t l_hash = this->hash_key(p_key);
 #if CONTAINER_BOUND_TEST
-        assert_true(this->check_key_equality(p_key, l_hash));
+        abort();
 #endif
-        this->Slots.get(l_hash) = 0;
+        return 0;
     };
 
-  private:
-    inline void rehash_to(HashMap<KeyType, ElementType>* in_out_new_map)
+    inline void rehash_for_insert()
     {
-        for (loop(i, 0, this->Slots.Capacity))
+        uimax l_capacity = this->get_capacity();
+        if (this->Size >= (max_load(l_capacity) / 2))
         {
-            if (this->Slots.get(i))
+            l_capacity *= 2;
+        }
+
+        HashMap<KeyType, ElementType> l_new_map = HashMap<KeyType, ElementType>::allocate(l_capacity);
+        for (loop(i, 0, this->get_capacity()))
+        {
+            if (this->Controls.get(i) & 0x80)
             {
-                KeyType& l_key = this->StoredKeys.get(i);
-                in_out_new_map->put_key_value(in_out_new_map->hash_key(l_key), l_key, this->Memory.get(i));
+                KeyType& l_key = this->Keys.get(i);
+                hash_t l_hash = hash_key(l_key);
+                uimax l_slot = l_new_map.find_insert_slot(l_hash);
+                l_new_map.Controls.get(l_slot) = HashMapControlGroup::full_control(h2(l_hash));
+                l_new_map.Keys.get(l_slot) = l_key;
+                l_new_map.Memory.get(l_slot) = this->Memory.get(i);
             }
         }
-    };
-
-    inline hash_t hash_key(const KeyType& p_key)
-    {
-        return HashMap_HashFn<KeyType>::Hashmap_HashFn_Hash(p_key, this->Memory.Capacity);
-    };
+        l_new_map.Size = this->Size;
+        l_new_map.GrowthLeft = max_load(l_capacity) - this->Size;
 
-    inline hash_t mod_key(const hash_t p_hash)
-    {
-        return p_hash % this->Memory.Capacity;
-    };
-
-    inline int8 check_key_equality(const KeyType& p_key, const hash_t p_hash)
-    {
-        return memory_compare((int8*)&this->StoredKeys.get(p_hash), (int8*)&p_key, sizeof(KeyType));
+        this->free();
+        *this = l_new_map;
     };
 };
-
-#undef Hashmap_HashFn_Hash
\ No newline at end of file
@@ -4,13 +4,11 @@
 
 #define sh_func_get_size() get_size()
 #define sh_func_resize(p_newsize) resize(p_newsize)
-#define sh_func_get_freechunks() get_freechunks()
-#define sh_func_get_allocated_chunks() get_allocated_chunks()
+#define sh_func_get_chunks() get_chunks()
 
 #define sh_c_get_size(p_shadow_heap) (p_shadow_heap)->get_size()
 #define sh_c_resize(p_shadow_heap, p_newsize) (p_shadow_heap)->resize(p_newsize)
-#define sh_c_get_freechunks(p_shadow_heap) (p_shadow_heap)->get_freechunks()
-#define sh_c_get_allocated_chunks(p_shadow_heap) (p_shadow_heap)->get_allocated_chunks()
+#define sh_c_get_chunks(p_shadow_heap) (p_shadow_heap)->get_chunks()
 
 struct HeapA
 {
@@ -41,35 +39,399 @@ struct HeapA
 
     template <class ShadowHeap_t(s)>
     static AllocationState allocate_element_norealloc_with_modulo_offset(ShadowHeap_t(s) & p_heap, const uimax p_size, const uimax p_alignement_modulo, HeapA::AllocatedElementReturn* out_chunk);
+};
+
+namespace HeapTLSF_Const
+{
+// Every power of two size range is split in 2^SL_LOG2 free lists
+static const uimax SL_LOG2 = 4;
+static const uimax SL_COUNT = 1 << SL_LOG2;
+// Sizes below SL_COUNT are all stored in the first level 0, one free list per size
+static const uimax FL_COUNT = (sizeof(uimax) * 8) - SL_LOG2 + 1;
+// When no size class guarantees a fit, at most this number of smaller free blocks are checked before giving up
+static const uimax MAX_SCANNED_FREE_BLOCKS = 32;
+}; // namespace HeapTLSF_Const
+
+/*
+    Chunks of a Heap, stored as a two level segregated fit (TLSF) allocator.
+    Every chunk is a block linked to its physical neighbours. Free blocks are also linked in the free list of their size class.
+    A bitmap of non empty free lists allows to find a free block that is large enough in constant time, whatever the number of free chunks.
+    Freed blocks are immediately merged with their free physical neighbours.
+    The HeapTLSF doesn't know the heap size, it only allocates in the free chunks that have been pushed.
+*/
+struct HeapTLSF
+{
+    struct Block
+    {
+        SliceIndex chunk;
+        Token(Block) previous_physical;
+        Token(Block) next_physical;
+        Token(Block) previous_free;
+        Token(Block) next_free;
+        int8 is_free;
+    };
+
+    Pool<Block> blocks;
+    // Head of the free list of every (first level, second level) size class
+    Span<Token(Block)> free_lists;
+    uimax fl_bitmap;
+    SliceN<uint32, HeapTLSF_Const::FL_COUNT> sl_bitmaps;
+    // Block that ends at the highest address, it is extended when free chunks are pushed after it
+    Token(Block) last_block;
+    uimax free_size;
+
+    inline static HeapTLSF allocate(const uimax p_size)
+    {
+        HeapTLSF l_tlsf;
+        l_tlsf.blocks = Pool<Block>::allocate(0);
+        l_tlsf.free_lists = Span<Token(Block)>::allocate(HeapTLSF_Const::FL_COUNT * HeapTLSF_Const::SL_COUNT);
+        for (loop(i, 0, l_tlsf.free_lists.Capacity))
+        {
+            l_tlsf.free_lists.get(i) = tk_bd(Block);
+        }
+        l_tlsf.fl_bitmap = 0;
+        for (loop(i, 0, HeapTLSF_Const::FL_COUNT))
+        {
+            l_tlsf.sl_bitmaps.get(i) = 0;
+        }
+        l_tlsf.last_block = tk_bd(Block);
+        l_tlsf.free_size = 0;
+        if (p_size != 0)
+        {
+            l_tlsf.push_free_chunk(SliceIndex::build(0, p_size));
+        }
+        return l_tlsf;
+    };
+
+    inline void free()
+    {
+        this->blocks.free();
+        this->free_lists.free();
+    };
+
+    /*
+        Pushes a free chunk that starts where the last block ends.
+        It is merged with the last block if it is free.
+    */
+    inline void push_free_chunk(const SliceIndex& p_chunk)
+    {
+        if (tk_neq(this->last_block, tk_bd(Block)))
+        {
+            Block& l_last_block = this->blocks.get(this->last_block);
+#if CONTAINER_BOUND_TEST
+            assert_true((l_last_block.chunk.Begin + l_last_block.chunk.Size) == p_chunk.Begin);
+#endif
+            if (l_last_block.is_free)
+            {
+                this->remove_free_block(this->last_block);
+                l_last_block.chunk.Size += p_chunk.Size;
+                this->insert_free_block(this->last_block);
+                return;
+            }
+        }
+
+        Token(Block) l_block = this->blocks.alloc_element(Block{p_chunk, this->last_block, tk_bd(Block), tk_bd(Block), tk_bd(Block), 0});
+        if (tk_neq(this->last_block, tk_bd(Block)))
+        {
+            this->blocks.get(this->last_block).next_physical = l_block;
+        }
+        this->last_block = l_block;
+        this->insert_free_block(l_block);
+    };
+
+    /*
+        Allocates a chunk of p_size whose begin is a multiple of p_modulo_offset (0 and 1 mean no alignment).
+        The free block is found in constant time in the first size class that is guaranteed to fit the padded size.
+        If there is none, a bounded number of free blocks between p_size and the padded size are checked, so that the heap rarely grows while a free chunk can hold the chunk.
+        Returns 0 if no free chunk can hold the chunk.
+    */
+    inline int8 allocate_chunk(const uimax p_size, const uimax p_modulo_offset, HeapA::AllocatedElementReturn* out_chunk)
+    {
+#if CONTAINER_BOUND_TEST
+        assert_true(p_size != 0);
+#endif
+        uimax l_modulo = p_modulo_offset == 0 ? 1 : p_modulo_offset;
+        uimax l_padded_size = p_size + l_modulo - 1;
+
+        uimax l_offset;
+        Token(Block) l_block = this->find_guaranteed_free_block(l_padded_size);
+        if (tk_neq(l_block, tk_bd(Block)))
+        {
+            l_offset = align_offset(this->blocks.get(l_block).chunk.Begin, l_modulo);
+        }
+        else
+        {
+            l_block = this->find_fitting_free_block(p_size, l_padded_size, l_modulo, &l_offset);
+            if (tk_eq(l_block, tk_bd(Block)))
+            {
+                return 0;
+            }
+        }
+
+        this->remove_free_block(l_block);
+
+        Block& l_allocated_block = this->blocks.get(l_block);
+        uimax l_padding = l_offset - l_allocated_block.chunk.Begin;
+        if (l_padding != 0)
+        {
+            // The padding before the aligned begin can't be merged with the previous block if it is free, because it has been found in the free lists
+            Token(Block) l_padding_block =
+                this->blocks.alloc_element(Block{SliceIndex::build(l_allocated_block.chunk.Begin, l_padding), l_allocated_block.previous_physical, l_block, tk_bd(Block), tk_bd(Block), 0});
+            Block& l_block_after_alloc = this->blocks.get(l_block);
+            if (tk_neq(l_block_after_alloc.previous_physical, tk_bd(Block)))
+            {
+                this->blocks.get(l_block_after_alloc.previous_physical).next_physical = l_padding_block;
+            }
+            l_block_after_alloc.previous_physical = l_padding_block;
+            l_block_after_alloc.chunk.Begin += l_padding;
+            l_block_after_alloc.chunk.Size -= l_padding;
+            this->insert_free_block(l_padding_block);
+        }
+
+        Block& l_split_block = this->blocks.get(l_block);
+        if (l_split_block.chunk.Size > p_size)
+        {
+            Token(Block) l_remaining_block = this->blocks.alloc_element(
+                Block{SliceIndex::build(l_offset + p_size, l_split_block.chunk.Size - p_size), l_block, this->blocks.get(l_block).next_physical, tk_bd(Block), tk_bd(Block), 0});
+            Block& l_block_after_alloc = this->blocks.get(l_block);
+            if (tk_neq(l_block_after_alloc.next_physical, tk_bd(Block)))
+            {
+                this->blocks.get(l_block_after_alloc.next_physical).previous_physical = l_remaining_block;
+            }
+            else
+            {
+                this->last_block = l_remaining_block;
+            }
+            l_block_after_alloc.next_physical = l_remaining_block;
+            l_block_after_alloc.chunk.Size = p_size;
+            this->insert_free_block(l_remaining_block);
+        }
+
+        *out_chunk = HeapA::AllocatedElementReturn::build(tk_bf(SliceIndex, l_block), l_offset);
+        return 1;
+    };
+
+    inline SliceIndex& get_chunk(const Token(SliceIndex) p_chunk)
+    {
+#if CONTAINER_BOUND_TEST
+        assert_true(!this->blocks.get(tk_bf(Block, p_chunk)).is_free);
+#endif
+        return this->blocks.get(tk_bf(Block, p_chunk)).chunk;
+    };
+
+    inline void release_chunk(const Token(SliceIndex) p_chunk)
+    {
+        Token(Block) l_block = tk_bf(Block, p_chunk);
+#if CONTAINER_BOUND_TEST
+        assert_true(!this->blocks.get(l_block).is_free);
+#endif
+        Token(Block) l_previous_block = this->blocks.get(l_block).previous_physical;
+        if (tk_neq(l_previous_block, tk_bd(Block)) && this->blocks.get(l_previous_block).is_free)
+        {
+            this->remove_free_block(l_previous_block);
+            this->merge_with_next_physical(l_previous_block);
+            l_block = l_previous_block;
+        }
+
+        Token(Block) l_next_block = this->blocks.get(l_block).next_physical;
+        if (tk_neq(l_next_block, tk_bd(Block)) && this->blocks.get(l_next_block).is_free)
+        {
+            this->remove_free_block(l_next_block);
+            this->merge_with_next_physical(l_block);
+        }
+
+        this->insert_free_block(l_block);
+    };
 
   private:
-    template <class ShadowHeap_t(s)> static int8 _allocate_element(ShadowHeap_t(s) & p_heap, const uimax p_size, HeapA::AllocatedElementReturn* out_return);
+    inline static uimax align_offset(const uimax p_begin, const uimax p_modulo)
+    {
+        uimax l_offset_modulo = p_begin % p_modulo;
+        return l_offset_modulo == 0 ? p_begin : (p_begin + (p_modulo - l_offset_modulo));
+    };
 
-    template <class ShadowHeap_t(s)>
-    static int8 _allocate_element_with_modulo_offset(ShadowHeap_t(s) & p_heap, const uimax p_size, const uimax p_modulo_offset, HeapA::AllocatedElementReturn* out_chunk);
+    // Size class of the free list that contains p_size
+    inline static void size_class(const uimax p_size, uimax* out_fl, uimax* out_sl)
+    {
+        if (p_size < HeapTLSF_Const::SL_COUNT)
+        {
+            *out_fl = 0;
+            *out_sl = p_size;
+        }
+        else
+        {
+            uimax l_msb = bit_msb(p_size);
+            *out_fl = l_msb - HeapTLSF_Const::SL_LOG2 + 1;
+            *out_sl = (p_size >> (l_msb - HeapTLSF_Const::SL_LOG2)) - HeapTLSF_Const::SL_COUNT;
+        }
+    };
+
+    inline Token(Block) & free_list(const uimax p_fl, const uimax p_sl)
+    {
+        return this->free_lists.get((p_fl * HeapTLSF_Const::SL_COUNT) + p_sl);
+    };
+
+    // First free block of the smallest size class whose blocks are all at least p_size
+    inline Token(Block) find_guaranteed_free_block(const uimax p_size)
+    {
+        uimax l_size = p_size;
+        if (l_size >= HeapTLSF_Const::SL_COUNT)
+        {
+            uimax l_round = ((uimax)1 << (bit_msb(l_size) - HeapTLSF_Const::SL_LOG2)) - 1;
+            if (l_size > (l_size + l_round))
+            {
+                return tk_bd(Block);
+            }
+            l_size += l_round;
+        }
+
+        uimax l_fl, l_sl;
+        size_class(l_size, &l_fl, &l_sl);
+        uimax l_sl_bitmap = this->sl_bitmaps.get(l_fl) & ((~(uimax)0) << l_sl);
+        if (l_sl_bitmap == 0)
+        {
+            uimax l_fl_bitmap = (l_fl + 1) < HeapTLSF_Const::FL_COUNT ? (this->fl_bitmap & ((~(uimax)0) << (l_fl + 1))) : 0;
+            if (l_fl_bitmap == 0)
+            {
+                return tk_bd(Block);
+            }
+            l_fl = bit_lsb(l_fl_bitmap);
+            l_sl_bitmap = this->sl_bitmaps.get(l_fl);
+        }
+        return this->free_list(l_fl, bit_lsb(l_sl_bitmap));
+    };
+
+    /*
+        Scans the size classes that may hold blocks between p_size and p_padded_size, for a block that fits once aligned.
+        Classes are scanned from the largest, their blocks are more likely to fit. The number of scanned blocks is bounded so that the allocation stays in constant time.
+    */
+    inline Token(Block) find_fitting_free_block(const uimax p_size, const uimax p_padded_size, const uimax p_modulo, uimax* out_offset)
+    {
+        uimax l_begin_fl, l_begin_sl, l_end_fl, l_end_sl;
+        size_class(p_size, &l_begin_fl, &l_begin_sl);
+        size_class(p_padded_size, &l_end_fl, &l_end_sl);
+        uimax l_scanned_block_count = 0;
+        for (loop_reverse(l_class, (l_begin_fl * HeapTLSF_Const::SL_COUNT) + l_begin_sl, (l_end_fl * HeapTLSF_Const::SL_COUNT) + l_end_sl + 1))
+        {
+            if (!(this->sl_bitmaps.get(l_class / HeapTLSF_Const::SL_COUNT) & ((uint32)1 << (l_class % HeapTLSF_Const::SL_COUNT))))
+            {
+                continue;
+            }
+
+            Token(Block) l_block = this->free_lists.get(l_class);
+            while (tk_neq(l_block, tk_bd(Block)))
+            {
+                if (l_scanned_block_count == HeapTLSF_Const::MAX_SCANNED_FREE_BLOCKS)
+                {
+                    return tk_bd(Block);
+                }
+                l_scanned_block_count += 1;
+
+                Block& l_free_block = this->blocks.get(l_block);
+                uimax l_offset = align_offset(l_free_block.chunk.Begin, p_modulo);
+                if ((l_offset + p_size) <= (l_free_block.chunk.Begin + l_free_block.chunk.Size))
+                {
+                    *out_offset = l_offset;
+                    return l_block;
+                }
+                l_block = l_free_block.next_free;
+            }
+        }
+        return tk_bd(Block);
+    };
+
+    inline void insert_free_block(const Token(Block) p_block)
+    {
+        Block& l_block = this->blocks.get(p_block);
+        uimax l_fl, l_sl;
+        size_class(l_block.chunk.Size, &l_fl, &l_sl);
+        Token(Block)& l_head = this->free_list(l_fl, l_sl);
+
+        l_block.is_free = 1;
+        l_block.previous_free = tk_bd(Block);
+        l_block.next_free = l_head;
+        if (tk_neq(l_head, tk_bd(Block)))
+        {
+            this->blocks.get(l_head).previous_free = p_block;
+        }
+        l_head = p_block;
+
+        this->fl_bitmap |= ((uimax)1 << l_fl);
+        this->sl_bitmaps.get(l_fl) |= ((uint32)1 << l_sl);
+        this->free_size += l_block.chunk.Size;
+    };
+
+    inline void remove_free_block(const Token(Block) p_block)
+    {
+        Block& l_block = this->blocks.get(p_block);
+#if CONTAINER_BOUND_TEST
+        assert_true(l_block.is_free);
+#endif
+        uimax l_fl, l_sl;
+        size_class(l_block.chunk.Size, &l_fl, &l_sl);
 
-    template <class ShadowHeap_t(s)> static AllocatedElementReturn _push_chunk(ShadowHeap_t(s) & p_heap, SliceIndex* p_chunk);
+        if (tk_neq(l_block.previous_free, tk_bd(Block)))
+        {
+            this->blocks.get(l_block.previous_free).next_free = l_block.next_free;
+        }
+        else
+        {
+            this->free_list(l_fl, l_sl) = l_block.next_free;
+            if (tk_eq(l_block.next_free, tk_bd(Block)))
+            {
+                this->sl_bitmaps.get(l_fl) &= ~((uint32)1 << l_sl);
+                if (this->sl_bitmaps.get(l_fl) == 0)
+                {
+                    this->fl_bitmap &= ~((uimax)1 << l_fl);
+                }
+            }
+        }
+        if (tk_neq(l_block.next_free, tk_bd(Block)))
+        {
+            this->blocks.get(l_block.next_free).previous_free = l_block.previous_free;
+        }
+
+        l_block.is_free = 0;
+        this->free_size -= l_block.chunk.Size;
+    };
 
-    template <class ShadowHeap_t(s)> static void _defragment(ShadowHeap_t(s) & p_heap);
+    // The next physical block is absorbed by p_block, neither of them are in the free lists
+    inline void merge_with_next_physical(const Token(Block) p_block)
+    {
+        Block& l_block = this->blocks.get(p_block);
+        Token(Block) l_next_block_token = l_block.next_physical;
+        Block& l_next_block = this->blocks.get(l_next_block_token);
+
+        l_block.chunk.Size += l_next_block.chunk.Size;
+        l_block.next_physical = l_next_block.next_physical;
+        if (tk_neq(l_next_block.next_physical, tk_bd(Block)))
+        {
+            this->blocks.get(l_next_block.next_physical).previous_physical = p_block;
+        }
+        else
+        {
+            this->last_block = p_block;
+        }
+        this->blocks.release_element(l_next_block_token);
+    };
 };
 
 /*
     A Heap is a function object that calculates : "what is the offset of the chunk of data you want to allocate ?".
     The Heap object doesn't actually allocate any memory. It is up to the consumer to choose how memory is allocated.
     The heap has been implemented like that to allow flexibility between allocating memory on the CPU or GPU. (or any other logic)
+    Chunks are allocated by a HeapTLSF, when no free chunk can hold the chunk, the heap is resized and the new memory is pushed as a free chunk.
 */
 struct Heap
 {
-    Pool<SliceIndex> AllocatedChunks;
-    Vector<SliceIndex> FreeChunks;
+    HeapTLSF Chunks;
     uimax Size;
 
     static Heap allocate(const uimax p_heap_size);
     void free();
     void sh_func_resize(const uimax p_newsize);
     uimax sh_func_get_size();
-    Vector<SliceIndex>& sh_func_get_freechunks();
-    Pool<SliceIndex>& sh_func_get_allocated_chunks();
+    HeapTLSF& sh_func_get_chunks();
     HeapA::AllocationState allocate_element(const uimax p_size, HeapA::AllocatedElementReturn* out_chunk);
     HeapA::AllocationState allocate_element_with_modulo_offset(const uimax p_size, const uimax p_modulo_offset, HeapA::AllocatedElementReturn* out_chunk);
     HeapA::AllocationState allocate_element_norealloc_with_modulo_offset(const uimax p_size, const uimax p_modulo_offset, HeapA::AllocatedElementReturn* out_chunk);
@@ -111,8 +473,8 @@ struct HeapPaged
         };
     };
 
-    Pool<SliceIndex> AllocatedChunks;
-    VectorOfVector<SliceIndex> FreeChunks;
+    // Chunks of every page, chunk tokens are local to their page
+    Vector<HeapTLSF> Pages;
     uimax PageSize;
 
     /*
@@ -122,7 +484,6 @@ struct HeapPaged
     {
         HeapPaged* heapPaged;
         uimax index;
-        VectorOfVector<SliceIndex>::Element_ShadowVector tmp_shadow_vec;
 
         inline static SingleShadowHeap build(HeapPaged* p_heap_paged, const uimax p_index)
         {
@@ -132,15 +493,14 @@ struct HeapPaged
             return l_shadow_heap;
         };
 
-        inline VectorOfVector<SliceIndex>::Element_ShadowVector& sh_func_get_freechunks()
+        inline uimax sh_func_get_size()
         {
-            this->tmp_shadow_vec = this->heapPaged->FreeChunks.element_as_shadow_vector(this->index);
-            return tmp_shadow_vec;
+            return this->heapPaged->PageSize;
         };
 
-        inline Pool<SliceIndex>& sh_func_get_allocated_chunks()
+        inline HeapTLSF& sh_func_get_chunks()
         {
-            return this->heapPaged->AllocatedChunks;
+            return this->heapPaged->Pages.get(this->index);
         };
     };
 
@@ -157,53 +517,29 @@ struct HeapPaged
 
 template <class ShadowHeap_t(s)> inline HeapA::AllocationState HeapA::allocate_element(ShadowHeap_t(s) & p_heap, const uimax p_size, HeapA::AllocatedElementReturn* out_chunk)
 {
-    if (!_allocate_element(p_heap, p_size, out_chunk))
-    {
-        _defragment(p_heap);
-        if (!_allocate_element(p_heap, p_size, out_chunk))
-        {
-            uimax l_heap_size = sh_c_get_size(&p_heap);
-            sh_c_resize(&p_heap, l_heap_size == 0 ? p_size : ((l_heap_size * 2) + p_size));
-
-#if CONTAINER_MEMORY_TEST
-            assert_true(
-#endif
-                _allocate_element(p_heap, p_size, out_chunk)
-#if CONTAINER_MEMORY_TEST
-            )
-#endif
-                ;
-
-            return HeapA::AllocationState::ALLOCATED_AND_HEAP_RESIZED;
-        }
-        return HeapA::AllocationState::ALLOCATED;
-    }
-    return HeapA::AllocationState::ALLOCATED;
+    return allocate_element_with_modulo_offset(p_heap, p_size, 1, out_chunk);
 }
 
 template <class ShadowHeap_t(s)>
 inline HeapA::AllocationState HeapA::allocate_element_with_modulo_offset(ShadowHeap_t(s) & p_heap, const uimax p_size, const uimax p_modulo_offset, HeapA::AllocatedElementReturn* out_chunk)
 {
-    if (!_allocate_element_with_modulo_offset(p_heap, p_size, p_modulo_offset, out_chunk))
+    if (!sh_c_get_chunks(&p_heap).allocate_chunk(p_size, p_modulo_offset, out_chunk))
     {
-        _defragment(p_heap);
-        if (!_allocate_element_with_modulo_offset(p_heap, p_size, p_modulo_offset, out_chunk))
-        {
-            uimax l_heap_size = sh_c_get_size(&p_heap);
-            sh_c_resize(&p_heap, l_heap_size == 0 ? (p_modulo_offset > p_size ? p_modulo_offset : p_size) : ((l_heap_size * 2) + (p_modulo_offset > p_size ? p_modulo_offset : p_size)));
+        // The pushed free chunk is large enough to hold the chunk whatever the alignment padding is
+        uimax l_padded_size = p_size + (p_modulo_offset == 0 ? 0 : (p_modulo_offset - 1));
+        uimax l_heap_size = sh_c_get_size(&p_heap);
+        sh_c_resize(&p_heap, l_heap_size == 0 ? l_padded_size : ((l_heap_size * 2) + l_padded_size));
 
 #if CONTAINER_MEMORY_TEST
-            assert_true(
+        assert_true(
 #endif
-                _allocate_element_with_modulo_offset(p_heap, p_size, p_modulo_offset, out_chunk)
+            sh_c_get_chunks(&p_heap).allocate_chunk(p_size, p_modulo_offset, out_chunk)
 #if CONTAINER_MEMORY_TEST
-            )
+        )
 #endif
-                ;
+            ;
 
-            return HeapA::AllocationState::ALLOCATED_AND_HEAP_RESIZED;
-        }
-        return HeapA::AllocationState::ALLOCATED;
+        return HeapA::AllocationState::ALLOCATED_AND_HEAP_RESIZED;
     }
     return HeapA::AllocationState::ALLOCATED;
 }
@@ -212,171 +548,28 @@ template <class ShadowHeap_t(s)>
 inline HeapA::AllocationState HeapA::allocate_element_norealloc_with_modulo_offset(ShadowHeap_t(s) & p_heap, const uimax p_size, const uimax p_alignement_modulo,
                                                                                    HeapA::AllocatedElementReturn* out_chunk)
 {
-    if (!_allocate_element_with_modulo_offset(p_heap, p_size, p_alignement_modulo, out_chunk))
+    if (!sh_c_get_chunks(&p_heap).allocate_chunk(p_size, p_alignement_modulo, out_chunk))
     {
-        _defragment(p_heap);
-        if (!_allocate_element_with_modulo_offset(p_heap, p_size, p_alignement_modulo, out_chunk))
-        {
-            return AllocationState::NOT_ALLOCATED;
-        }
-        return AllocationState::ALLOCATED;
+        return AllocationState::NOT_ALLOCATED;
     }
     return AllocationState::ALLOCATED;
 }
 
-template <class ShadowHeap_t(s)> inline int8 HeapA::_allocate_element(ShadowHeap_t(s) & p_heap, const uimax p_size, HeapA::AllocatedElementReturn* out_return)
-{
-#if CONTAINER_BOUND_TEST
-    assert_true(p_size != 0);
-#endif
-
-    using ShadowVector(free_chunks) = decltype(sh_c_get_freechunks(&p_heap));
-    ShadowVector(free_chunks)& l_free_chunks = sh_c_get_freechunks(&p_heap);
-    for (uimax i = 0; i < sv_c_get_size(&l_free_chunks); i++)
-    {
-        SliceIndex& l_free_chunk = sv_c_get(&l_free_chunks, i);
-        if (l_free_chunk.Size > p_size)
-        {
-            SliceIndex l_new_allocated_chunk;
-            l_free_chunk.slice_two(l_free_chunk.Begin + p_size, &l_new_allocated_chunk, &l_free_chunk);
-            *out_return = _push_chunk(p_heap, &l_new_allocated_chunk);
-            return 1;
-        }
-        else if (l_free_chunk.Size == p_size)
-        {
-            *out_return = _push_chunk(p_heap, &l_free_chunk);
-            sv_c_erase_element_at_always(&l_free_chunks, i);
-            return 1;
-        }
-    }
-
-    return 0;
-}
-
-template <class ShadowHeap_t(s)>
-inline int8 HeapA::_allocate_element_with_modulo_offset(ShadowHeap_t(s) & p_heap, const uimax p_size, const uimax p_modulo_offset, HeapA::AllocatedElementReturn* out_chunk)
-{
-#if CONTAINER_BOUND_TEST
-    assert_true(p_size != 0);
-#endif
-
-    using ShadowVector(free_chunks) = decltype(sh_c_get_freechunks(&p_heap));
-    ShadowVector(free_chunks)& l_free_chunks = sh_c_get_freechunks(&p_heap);
-    for (uimax i = 0; i < sv_c_get_size(&l_free_chunks); i++)
-    {
-        SliceIndex& l_free_chunk = sv_c_get(&l_free_chunks, i);
-
-        if (l_free_chunk.Size > p_size)
-        {
-            uimax l_offset_modulo = (l_free_chunk.Begin % p_modulo_offset);
-            if (l_offset_modulo == 0)
-            {
-                // create one free chunk (after)
-                SliceIndex l_new_allocated_chunk;
-                l_free_chunk.slice_two(l_free_chunk.Begin + p_size, &l_new_allocated_chunk, &l_free_chunk);
-                *out_chunk = _push_chunk(p_heap, &l_new_allocated_chunk);
-                return 1;
-            }
-            else
-            {
-                uimax l_chunk_offset_delta = p_modulo_offset - l_offset_modulo;
-                // Does the offsetted new memory is able to be allocated in the chunk ?
-                if (l_free_chunk.Size > (p_size + l_chunk_offset_delta)) // offsetted chunk is in the middle of the free chunk
-                {
-                    // create two free chunk (before and after)
-
-                    SliceIndex l_new_allocated_chunk, l_new_free_chunk, l_tmp_chunk;
-                    l_free_chunk.slice_two(l_free_chunk.Begin + l_chunk_offset_delta, &l_free_chunk, &l_tmp_chunk);
-                    l_tmp_chunk.slice_two(l_tmp_chunk.Begin + p_size, &l_new_allocated_chunk, &l_new_free_chunk);
-                    *out_chunk = _push_chunk(p_heap, &l_new_allocated_chunk);
-
-                    sv_c_push_back_element(&l_free_chunks, l_new_free_chunk);
-
-                    return 1;
-                }
-                else if (l_free_chunk.Size == (p_size + l_chunk_offset_delta)) // offsetted chunk end matches perfectly the end of the free chunk
-                {
-                    SliceIndex l_new_allocated_chunk;
-                    l_free_chunk.slice_two(l_free_chunk.Begin + l_chunk_offset_delta, &l_free_chunk, &l_new_allocated_chunk);
-                    *out_chunk = _push_chunk(p_heap, &l_new_allocated_chunk);
-
-                    return 1;
-                }
-            }
-        }
-        else if (l_free_chunk.Size == p_size)
-        {
-            uimax l_offset_modulo = (l_free_chunk.Size % p_modulo_offset);
-            if (l_offset_modulo == 0)
-            {
-                *out_chunk = _push_chunk(p_heap, &l_free_chunk);
-                sv_c_erase_element_at(&l_free_chunks, i);
-
-                return 1;
-            }
-        }
-    }
-
-    return 0;
-}
-
-template <class ShadowHeap_t(s)> inline HeapA::AllocatedElementReturn HeapA::_push_chunk(ShadowHeap_t(s) & p_heap, SliceIndex* p_chunk)
-{
-    return HeapA::AllocatedElementReturn::build(sh_c_get_allocated_chunks(&p_heap).alloc_element(*p_chunk), p_chunk->Begin);
-}
-
-template <class ShadowHeap_t(s)> inline void HeapA::_defragment(ShadowHeap_t(s) & p_heap)
-{
-    using ShadowVector(free_chunks) = decltype(sh_c_get_freechunks(&p_heap));
-    ShadowVector(free_chunks)& l_free_chunks = sh_c_get_freechunks(&p_heap);
-    if (sv_c_get_size(&l_free_chunks) > 0)
-    {
-        struct FreeChunkSortByAddress
-        {
-            inline int8 operator()(const SliceIndex& p_left, const SliceIndex& p_right) const
-            {
-                return p_left.Begin > p_right.Begin;
-            };
-        };
-        Slice<SliceIndex> l_freechunks_slice = sv_c_to_slice(&l_free_chunks);
-        Sort::Linear3(l_freechunks_slice, 0, FreeChunkSortByAddress{});
-
-        SliceIndex& l_compared_chunk = sv_c_get(&l_free_chunks, 0);
-        for (loop(i, 1, sv_c_get_size(&l_free_chunks)))
-        {
-            SliceIndex& l_chunk = sv_c_get(&l_free_chunks, i);
-            if ((l_compared_chunk.Begin + l_compared_chunk.Size) == l_chunk.Begin)
-            {
-                l_compared_chunk.Size += l_chunk.Size;
-                sv_c_erase_element_at_always(&l_free_chunks, i);
-                i -= 1;
-            }
-            else
-            {
-                l_compared_chunk = l_chunk;
-            }
-        }
-    }
-}
-
 inline Heap Heap::allocate(const uimax p_heap_size)
 {
-    Heap l_heap = Heap{Pool<SliceIndex>::allocate(0), Vector<SliceIndex>::allocate(1), p_heap_size};
-    l_heap.FreeChunks.push_back_element(SliceIndex::build(0, p_heap_size));
-    return l_heap;
+    return Heap{HeapTLSF::allocate(p_heap_size), p_heap_size};
 }
 
 inline void Heap::free()
 {
-    this->AllocatedChunks.free();
-    this->FreeChunks.free();
+    this->Chunks.free();
     this->Size = 0;
 }
 
 inline void Heap::sh_func_resize(const uimax p_newsize)
 {
     uimax l_old_size = this->Size;
-    this->FreeChunks.push_back_element(SliceIndex::build(l_old_size, p_newsize - l_old_size));
+    this->Chunks.push_free_chunk(SliceIndex::build(l_old_size, p_newsize - l_old_size));
     this->Size = p_newsize;
 }
 
@@ -385,14 +578,9 @@ inline uimax Heap::sh_func_get_size()
     return this->Size;
 }
 
-inline Vector<SliceIndex>& Heap::sh_func_get_freechunks()
+inline HeapTLSF& Heap::sh_func_get_chunks()
 {
-    return this->FreeChunks;
-}
-
-inline Pool<SliceIndex>& Heap::sh_func_get_allocated_chunks()
-{
-    return this->AllocatedChunks;
+    return this->Chunks;
 }
 
 inline HeapA::AllocationState Heap::allocate_element(const uimax p_size, HeapA::AllocatedElementReturn* out_chunk)
@@ -412,13 +600,12 @@ inline HeapA::AllocationState Heap::allocate_element_norealloc_with_modulo_offse
 
 inline SliceIndex* Heap::get(const Token(SliceIndex) p_chunk)
 {
-    return &this->AllocatedChunks.get(p_chunk);
+    return &this->Chunks.get_chunk(p_chunk);
 }
 
 inline void Heap::release_element(const Token(SliceIndex) p_chunk)
 {
-    this->FreeChunks.push_back_element(this->AllocatedChunks.get(p_chunk));
-    this->AllocatedChunks.release_element(p_chunk);
+    this->Chunks.release_chunk(p_chunk);
 }
 
 inline HeapA::AllocationState Heap::reallocate_element(const Token(SliceIndex) p_chunk, const uimax p_new_size, HeapA::AllocatedElementReturn* out_chunk)
@@ -433,25 +620,28 @@ inline HeapA::AllocationState Heap::reallocate_element(const Token(SliceIndex) p
 
 inline HeapPaged HeapPaged::allocate_default(const uimax p_page_size)
 {
-    return HeapPaged{Pool<SliceIndex>::allocate(0), VectorOfVector<SliceIndex>::allocate_default(), p_page_size};
+    return HeapPaged{Vector<HeapTLSF>::allocate(0), p_page_size};
 }
 
 inline void HeapPaged::free()
 {
-    this->AllocatedChunks.free();
-    this->FreeChunks.free();
+    for (loop(i, 0, this->Pages.Size))
+    {
+        this->Pages.get(i).free();
+    }
+    this->Pages.free();
 }
 
 inline uimax HeapPaged::get_page_count()
 {
-    return this->FreeChunks.varying_vector.get_size();
+    return this->Pages.Size;
 }
 
 inline HeapPaged::AllocationState HeapPaged::allocate_element_norealloc_with_modulo_offset(const uimax p_size, const uimax p_modulo_offset, AllocatedElementReturn* out_chunk)
 {
     HeapA::AllocatedElementReturn l_heap_allocated_element_return;
 
-    for (loop(i, 0, this->FreeChunks.varying_vector.get_size()))
+    for (loop(i, 0, this->Pages.Size))
     {
         SingleShadowHeap l_single_shadow_heap = SingleShadowHeap::build(this, i);
         if ((HeapA::AllocationState_t)HeapA::allocate_element_norealloc_with_modulo_offset(l_single_shadow_heap, p_size, p_modulo_offset, &l_heap_allocated_element_return) &
@@ -464,11 +654,11 @@ inline HeapPaged::AllocationState HeapPaged::allocate_element_norealloc_with_mod
 
     this->create_new_page();
 
-    SingleShadowHeap l_single_shadow_heap = SingleShadowHeap::build(this, this->FreeChunks.varying_vector.get_size() - 1);
+    SingleShadowHeap l_single_shadow_heap = SingleShadowHeap::build(this, this->Pages.Size - 1);
     if ((HeapA::AllocationState_t)HeapA::allocate_element_norealloc_with_modulo_offset(l_single_shadow_heap, p_size, p_modulo_offset, &l_heap_allocated_element_return) &
         (HeapA::AllocationState_t)HeapA::AllocationState::ALLOCATED)
     {
-        *out_chunk = AllocatedElementReturn::buid_from_HeapAllocatedElementReturn(this->FreeChunks.varying_vector.get_size() - 1, l_heap_allocated_element_return);
+        *out_chunk = AllocatedElementReturn::buid_from_HeapAllocatedElementReturn(this->Pages.Size - 1, l_heap_allocated_element_return);
         return (AllocationState)((AllocationState_t)AllocationState::ALLOCATED | (AllocationState_t)AllocationState::PAGE_CREATED);
     };
 
@@ -477,17 +667,15 @@ inline HeapPaged::AllocationState HeapPaged::allocate_element_norealloc_with_mod
 
 inline void HeapPaged::release_element(const HeapPagedToken& p_token)
 {
-    this->FreeChunks.element_push_back_element(p_token.PageIndex, this->AllocatedChunks.get(p_token.token));
-    this->AllocatedChunks.release_element(p_token.token);
+    this->Pages.get(p_token.PageIndex).release_chunk(p_token.token);
 }
 
 inline SliceIndex* HeapPaged::get_sliceindex_only(const HeapPagedToken& p_token)
 {
-    return &this->AllocatedChunks.get(p_token.token);
+    return &this->Pages.get(p_token.PageIndex).get_chunk(p_token.token);
 }
 
 inline void HeapPaged::create_new_page()
 {
-    SliceIndex l_chunk_slice = SliceIndex::build(0, this->PageSize);
-    this->FreeChunks.push_back_element(Slice<SliceIndex>::build_memory_elementnb(&l_chunk_slice, 1));
+    this->Pages.push_back_element(HeapTLSF::allocate(this->PageSize));
 }
@@ -1,30 +1,58 @@
 #pragma once
 
+namespace Pool_Const
+{
+// Tokens of generation checked Pools hold the index of the slot in their low bits and the generation of the slot in their high bits
+static const uimax TOKEN_INDEX_BITS = 40;
+static const token_t TOKEN_INDEX_MASK = ((token_t)1 << TOKEN_INDEX_BITS) - 1;
+static const uint32 GENERATION_MASK = (uint32)(((uimax)1 << ((sizeof(token_t) * 8) - TOKEN_INDEX_BITS)) - 1);
+}; // namespace Pool_Const
+
 /*
     A Pool is a non continous Vector where elements are acessed via Tokens.
     Generated Tokens are unique from it's source Pool.
     Even if pool memory is reallocate, generated Tokens are still valid.
     /!\ It is very unsafe to store raw pointer of an element. Because is Pool memory is reallocated, then the pointer is no longer valid.
+    Free slots are flagged in a bitset, checking that an element is free is O(1) and allocated elements are iterated by scanning the bitset (foreach).
+    When GenerationChecked is set, every slot has a generation that is incremented when it's element is released. The generation is encoded in the Tokens,
+    so that a Token of a released element is detected even after it's slot has been reused. These Tokens are not indices, get_index returns the index of the slot.
 */
-template <class ElementType> struct Pool
+template <class ElementType, int8 GenerationChecked = 0> struct Pool
 {
     Vector<ElementType> memory;
     Vector<Token(ElementType)> free_blocks;
+    // One bit per slot, set when the slot is free. Bits after the last slot are set.
+    Vector<uint64> free_mask;
+    // Generation of every slot, only allocated if GenerationChecked
+    Vector<uint32> generations;
 
-    inline static Pool<ElementType> build(const Vector<ElementType>& p_memory, const Vector<Token(ElementType)>& p_free_blocks)
+    inline static Pool<ElementType, GenerationChecked> build(const Vector<ElementType>& p_memory, const Vector<Token(ElementType)>& p_free_blocks)
     {
-        return Pool<ElementType>{p_memory, p_free_blocks};
+        Pool<ElementType, GenerationChecked> l_pool = Pool<ElementType, GenerationChecked>{p_memory, p_free_blocks, Vector<uint64>::build_zero_size(cast(uint64*, NULL), 0),
+                                                                                           Vector<uint32>::build_zero_size(cast(uint32*, NULL), 0)};
+        for (loop(i, 0, l_pool.memory.Size))
+        {
+            l_pool.push_slot(i);
+        }
+        for (loop(i, 0, l_pool.free_blocks.Size))
+        {
+            l_pool.set_slot_free(tk_v(l_pool.free_blocks.get(i)));
+        }
+        return l_pool;
     };
 
-    inline static Pool<ElementType> allocate(const uimax p_memory_capacity)
+    inline static Pool<ElementType, GenerationChecked> allocate(const uimax p_memory_capacity)
     {
-        return Pool<ElementType>{Vector<ElementType>::allocate(p_memory_capacity), Vector<Token(ElementType)>::build_zero_size(cast(Token(ElementType)*, NULL), 0)};
+        return Pool<ElementType, GenerationChecked>{Vector<ElementType>::allocate(p_memory_capacity), Vector<Token(ElementType)>::build_zero_size(cast(Token(ElementType)*, NULL), 0),
+                                                    Vector<uint64>::build_zero_size(cast(uint64*, NULL), 0), Vector<uint32>::build_zero_size(cast(uint32*, NULL), 0)};
     };
 
     inline void free()
     {
         this->memory.free();
         this->free_blocks.free();
+        this->free_mask.free();
+        this->generations.free();
     };
 
     inline uimax get_size()
@@ -52,17 +80,34 @@ template <class ElementType> struct Pool
         return this->memory.Size != this->free_blocks.Size;
     };
 
-    inline int8 is_element_free(const Token(ElementType) p_token)
+    inline static uimax get_index(const Token(ElementType) p_token)
     {
-        for (vector_loop(&this->free_blocks, i))
+        if (GenerationChecked)
         {
-            if (tk_v(this->free_blocks.get(i)) == tk_v(p_token))
-            {
-                return 1;
-            };
-        };
+            return (uimax)(tk_v(p_token) & Pool_Const::TOKEN_INDEX_MASK);
+        }
+        return (uimax)tk_v(p_token);
+    };
 
-        return 0;
+    inline int8 is_element_free(const Token(ElementType) p_token)
+    {
+        uimax l_index = get_index(p_token);
+        return (this->free_mask.get(l_index >> 6) >> (l_index & 63)) & 1;
+    };
+
+    // The Token points to an allocated element, and for generation checked Pools, it's element has not been released since the Token has been generated
+    inline int8 is_token_valid(const Token(ElementType) p_token)
+    {
+        uimax l_index = get_index(p_token);
+        if (l_index >= this->memory.Size || this->is_element_free(p_token))
+        {
+            return 0;
+        }
+        if (GenerationChecked)
+        {
+            return (uint32)(tk_v(p_token) >> Pool_Const::TOKEN_INDEX_BITS) == this->generations.get(l_index);
+        }
+        return 1;
     };
 
     inline ElementType& get(const Token(ElementType) p_token)
@@ -71,21 +116,23 @@ template <class ElementType> struct Pool
         this->element_free_check(p_token);
 #endif
 
-        return this->memory.get(tk_v(p_token));
+        return this->memory.get(get_index(p_token));
     };
 
     inline Token(ElementType) alloc_element_empty()
     {
         if (!this->free_blocks.empty())
         {
-            Token(ElementType) l_availble_token = this->free_blocks.get(this->free_blocks.Size - 1);
+            uimax l_index = tk_v(this->free_blocks.get(this->free_blocks.Size - 1));
             this->free_blocks.pop_back();
-            return l_availble_token;
+            this->set_slot_allocated(l_index);
+            return this->build_token(l_index);
         }
         else
         {
             this->memory.push_back_element_empty();
-            return Token(ElementType){this->memory.Size - 1};
+            this->push_slot(this->memory.Size - 1);
+            return this->build_token(this->memory.Size - 1);
         }
     }
 
@@ -93,15 +140,17 @@ template <class ElementType> struct Pool
     {
         if (!this->free_blocks.empty())
         {
-            Token(ElementType) l_availble_token = this->free_blocks.get(this->free_blocks.Size - 1);
+            uimax l_index = tk_v(this->free_blocks.get(this->free_blocks.Size - 1));
             this->free_blocks.pop_back();
-            this->memory.get(tk_v(l_availble_token)) = p_element;
-            return l_availble_token;
+            this->set_slot_allocated(l_index);
+            this->memory.get(l_index) = p_element;
+            return this->build_token(l_index);
         }
         else
         {
             this->memory.push_back_element(p_element);
-            return Token(ElementType){this->memory.Size - 1};
+            this->push_slot(this->memory.Size - 1);
+            return this->build_token(this->memory.Size - 1);
         }
     };
 
@@ -111,14 +160,74 @@ template <class ElementType> struct Pool
         this->element_not_free_check(p_token);
 #endif
 
-        this->free_blocks.push_back_element(p_token);
+        uimax l_index = get_index(p_token);
+        this->set_slot_free(l_index);
+        if (GenerationChecked)
+        {
+            uint32& l_generation = this->generations.get(l_index);
+            l_generation = (l_generation + 1) & Pool_Const::GENERATION_MASK;
+        }
+        this->free_blocks.push_back_element(tk_b(ElementType, l_index));
+    };
+
+    /*
+        Calls the ForeachFunc for every allocated element, in slot order. Free slots are skipped 64 at a time.
+        Elements can be released by the ForeachFunc.
+
+        # void ForeachFunc(const Token(ElementType) p_token, ElementType& p_element);
+    */
+    template <class ForeachFunc> inline void foreach(const ForeachFunc& p_foreach_func)
+    {
+        for (loop(i, 0, this->free_mask.Size))
+        {
+            uint64 l_allocated_mask = ~this->free_mask.get(i);
+            while (l_allocated_mask != 0)
+            {
+                uimax l_index = (i << 6) + bit_lsb(l_allocated_mask);
+                l_allocated_mask &= (l_allocated_mask - 1);
+                p_foreach_func(this->build_token(l_index), this->memory.get(l_index));
+            }
+        }
     };
 
   private:
+    inline Token(ElementType) build_token(const uimax p_index)
+    {
+        if (GenerationChecked)
+        {
+            return tk_b(ElementType, ((token_t)this->generations.get(p_index) << Pool_Const::TOKEN_INDEX_BITS) | (token_t)p_index);
+        }
+        return tk_b(ElementType, p_index);
+    };
+
+    // The slot is pushed allocated
+    inline void push_slot(const uimax p_index)
+    {
+        if ((p_index & 63) == 0)
+        {
+            this->free_mask.push_back_element(~(uint64)0);
+        }
+        this->set_slot_allocated(p_index);
+        if (GenerationChecked)
+        {
+            this->generations.push_back_element(0);
+        }
+    };
+
+    inline void set_slot_free(const uimax p_index)
+    {
+        this->free_mask.get(p_index >> 6) |= ((uint64)1 << (p_index & 63));
+    };
+
+    inline void set_slot_allocated(const uimax p_index)
+    {
+        this->free_mask.get(p_index >> 6) &= ~((uint64)1 << (p_index & 63));
+    };
+
     inline void element_free_check(const Token(ElementType) p_token)
     {
 #if CONTAINER_BOUND_TEST
-        if (this->is_element_free(p_token))
+        if (!this->is_token_valid(p_token))
         {
             abort();
         }
@@ -128,10 +237,10 @@ template <class ElementType> struct Pool
     inline void element_not_free_check(const Token(ElementType) p_token)
     {
 #if CONTAINER_BOUND_TEST
-        if (this->is_element_free(p_token))
+        if (!this->is_token_valid(p_token))
         {
             abort();
         }
 #endif
     };
-};
\ No newline at end of file
+};
@@ -143,14 +143,14 @@ template <class ElementType> struct NTree
         };
     };
 
-    inline void get_nodes(const Token(NTreeNode) p_start_node_included, Vector<Resolve>* in_out_nodes)
+    template <class AllocatorType> inline void get_nodes(const Token(NTreeNode) p_start_node_included, Vector<Resolve, AllocatorType>* in_out_nodes)
     {
         this->traverse3(p_start_node_included, [in_out_nodes](const Resolve& p_node) { in_out_nodes->push_back_element(p_node); });
     };
 
     inline void remove_node_recursively(const Token(NTreeNode) p_node)
     {
-        Vector<Resolve> l_involved_nodes = Vector<Resolve>::allocate(0);
+        Vector<Resolve, ScratchAllocator> l_involved_nodes = Vector<Resolve, ScratchAllocator>::allocate(0);
         this->get_nodes(p_node, &l_involved_nodes);
 
         Slice<Resolve> l_involved_nodes_slice = l_involved_nodes.to_slice();
@@ -7,31 +7,31 @@
     Any memory access outside of this imaginary boundary will be in error.
     The Vector expose some safe way to insert/erase data (array or single element).
 */
-template <class ElementType> struct Vector
+template <class ElementType, class AllocatorType = HeapAllocator> struct Vector
 {
     uimax Size;
-    Span<ElementType> Memory;
+    Span<ElementType, AllocatorType> Memory;
 
-    inline static Vector<ElementType> build_zero_size(ElementType* p_memory, const uimax p_initial_capacity)
+    inline static Vector<ElementType, AllocatorType> build_zero_size(ElementType* p_memory, const uimax p_initial_capacity)
     {
-        return Vector<ElementType>{0, Span<ElementType>::build(p_memory, p_initial_capacity)};
+        return Vector<ElementType, AllocatorType>{0, Span<ElementType, AllocatorType>::build(p_memory, p_initial_capacity)};
     };
 
-    inline static Vector<ElementType> allocate(const uimax p_initial_capacity)
+    inline static Vector<ElementType, AllocatorType> allocate(const uimax p_initial_capacity)
     {
-        return Vector<ElementType>{0, Span<ElementType>::allocate(p_initial_capacity)};
+        return Vector<ElementType, AllocatorType>{0, Span<ElementType, AllocatorType>::allocate(p_initial_capacity)};
     };
 
-    inline static Vector<ElementType> allocate_elements(const Slice<ElementType>& p_initial_elements)
+    inline static Vector<ElementType, AllocatorType> allocate_elements(const Slice<ElementType>& p_initial_elements)
     {
-        Vector<ElementType> l_vector = Vector<ElementType>::allocate(p_initial_elements.Size);
+        Vector<ElementType, AllocatorType> l_vector = Vector<ElementType, AllocatorType>::allocate(p_initial_elements.Size);
         l_vector.push_back_array(p_initial_elements);
         return l_vector;
     };
 
-    inline static Vector<ElementType> allocate_capacity_elements(const uimax p_inital_capacity, const Slice<ElementType>& p_initial_elements)
+    inline static Vector<ElementType, AllocatorType> allocate_capacity_elements(const uimax p_inital_capacity, const Slice<ElementType>& p_initial_elements)
     {
-        Vector<ElementType> l_vector = Vector<ElementType>::allocate(p_inital_capacity);
+        Vector<ElementType, AllocatorType> l_vector = Vector<ElementType, AllocatorType>::allocate(p_inital_capacity);
         l_vector.push_back_array(p_initial_elements);
         return l_vector;
     };
@@ -44,7 +44,7 @@ template <class ElementType> struct Vector
     inline void free()
     {
         this->Memory.free();
-        *this = Vector<ElementType>::build_zero_size(NULL, 0);
+        *this = Vector<ElementType, AllocatorType>::build_zero_size(NULL, 0);
     };
 
     inline ElementType* get_memory()
@@ -78,7 +78,7 @@ template <class ElementType> struct Vector
 
     inline const ElementType& get(const uimax p_index) const
     {
-        return ((Vector<ElementType>*)this)->get(p_index);
+        return ((Vector<ElementType, AllocatorType>*)this)->get(p_index);
     };
 
     inline void clear()
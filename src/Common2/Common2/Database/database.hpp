@@ -44,21 +44,60 @@ inline static int32 handleStepError(int32 p_step_return, sqlite3** p_connection)
 
 }; // namespace DatabaseConnection_Utils
 
+enum class DatabaseSynchronous : int8
+{
+    DEFAULT = 0,
+    OFF = 1,
+    NORMAL = 2,
+    FULL = 3
+};
+
+/*
+    Options applied with PRAGMAs when a DatabaseConnection is opened. Options left to 0 keep the SQLite default.
+    The WAL journal mode is stored in the database file, it allows readers and a writer to access the database at the same time.
+    A query_only connection is still opened in read write mode, so that it can create the WAL index of the database if it doesn't exist.
+*/
+struct DatabaseConnectionProfile
+{
+    int8 query_only;
+    int8 wal;
+    int8 exclusive_locking;
+    DatabaseSynchronous synchronous;
+    uimax cache_size_kib;
+    uimax mmap_size;
+    int32 busy_timeout_ms;
+
+    inline static DatabaseConnectionProfile build_default()
+    {
+        return DatabaseConnectionProfile{0, 0, 0, DatabaseSynchronous::DEFAULT, 0, 0, 0};
+    };
+};
+
 struct DatabaseConnection
 {
     sqlite3* connection;
 
     inline static DatabaseConnection allocate(const Slice<int8>& p_databasepath)
+    {
+        return allocate_with_profile(p_databasepath, DatabaseConnectionProfile::build_default());
+    }
+
+    /*
+        A connection must only be used by one thread at a time.
+    */
+    inline static DatabaseConnection allocate_with_profile(const Slice<int8>& p_databasepath, const DatabaseConnectionProfile& p_profile)
     {
         DatabaseConnection l_connection;
         File l_database_file = File::create_or_open(p_databasepath);
         l_database_file.free();
-        DatabaseConnection_Utils::handleSQLiteError(sqlite3_open(p_databasepath.Begin, &l_connection.connection), &l_connection.connection);
+        DatabaseConnection_Utils::handleSQLiteError(
+            sqlite3_open_v2(p_databasepath.Begin, &l_connection.connection, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, NULL), &l_connection.connection);
 
 #if MEM_LEAK_DETECTION
         push_ptr_to_tracked((int8*)l_connection.connection);
 #endif
 
+        l_connection.apply_profile(p_profile);
         return l_connection;
     }
 
@@ -69,6 +108,77 @@ struct DatabaseConnection
 #endif
         DatabaseConnection_Utils::handleSQLiteError(sqlite3_close(this->connection), &this->connection);
     }
+
+  private:
+    inline void apply_profile(const DatabaseConnectionProfile& p_profile)
+    {
+        if (p_profile.busy_timeout_ms != 0)
+        {
+            DatabaseConnection_Utils::handleSQLiteError(sqlite3_busy_timeout(this->connection, p_profile.busy_timeout_ms), &this->connection);
+        }
+        if (p_profile.exclusive_locking)
+        {
+            this->execute_pragma(slice_int8_build_rawstr("PRAGMA locking_mode = EXCLUSIVE;"));
+        }
+        if (p_profile.wal)
+        {
+            this->execute_pragma(slice_int8_build_rawstr("PRAGMA journal_mode = WAL;"));
+        }
+        switch (p_profile.synchronous)
+        {
+        case DatabaseSynchronous::DEFAULT:
+            break;
+        case DatabaseSynchronous::OFF:
+            this->execute_pragma(slice_int8_build_rawstr("PRAGMA synchronous = OFF;"));
+            break;
+        case DatabaseSynchronous::NORMAL:
+            this->execute_pragma(slice_int8_build_rawstr("PRAGMA synchronous = NORMAL;"));
+            break;
+        case DatabaseSynchronous::FULL:
+            this->execute_pragma(slice_int8_build_rawstr("PRAGMA synchronous = FULL;"));
+            break;
+        default:
+            abort();
+        }
+        if (p_profile.cache_size_kib != 0)
+        {
+            // A negative cache_size is a size in KiB instead of a number of pages
+            String l_pragma = String::allocate_elements(slice_int8_build_rawstr("PRAGMA cache_size = -"));
+            ToString::auimax_append(p_profile.cache_size_kib, l_pragma);
+            l_pragma.append(slice_int8_build_rawstr(";"));
+            this->execute_pragma(l_pragma.to_slice());
+            l_pragma.free();
+        }
+        if (p_profile.mmap_size != 0)
+        {
+            String l_pragma = String::allocate_elements(slice_int8_build_rawstr("PRAGMA mmap_size = "));
+            ToString::auimax_append(p_profile.mmap_size, l_pragma);
+            l_pragma.append(slice_int8_build_rawstr(";"));
+            this->execute_pragma(l_pragma.to_slice());
+            l_pragma.free();
+        }
+        // Must be the last one, PRAGMAs that write to the database (like the journal mode) fail once it is set
+        if (p_profile.query_only)
+        {
+            this->execute_pragma(slice_int8_build_rawstr("PRAGMA query_only = 1;"));
+        }
+    };
+
+    inline void execute_pragma(const Slice<int8>& p_pragma)
+    {
+        sqlite3_stmt* l_statement;
+        DatabaseConnection_Utils::handleSQLiteError(sqlite3_prepare_v2(this->connection, p_pragma.Begin, (int32)p_pragma.Size, &l_statement, NULL), &this->connection);
+        int32 l_step_status = SQLITE_BUSY;
+        while (l_step_status == SQLITE_BUSY)
+        {
+            l_step_status = DatabaseConnection_Utils::handleStepError(sqlite3_step(l_statement), &this->connection);
+        }
+        while (l_step_status == SQLITE_ROW)
+        {
+            l_step_status = DatabaseConnection_Utils::handleStepError(sqlite3_step(l_statement), &this->connection);
+        }
+        DatabaseConnection_Utils::handleSQLiteError(sqlite3_finalize(l_statement), &this->connection);
+    };
 };
 
 enum class SQLiteQueryPrimitiveTypes
@@ -275,6 +385,17 @@ struct SQLiteResultSet
         uimax l_size = sqlite3_column_bytes(this->binded_statement, p_index);
         return Span<int8>::allocate_slice(Slice<int8>::build_memory_elementnb((int8*)sqlite3_column_blob(this->binded_statement, p_index), l_size));
     };
+
+    // The returned memory is owned by the statement, it is valid until the next step
+    inline Slice<int8> get_blob_slice(const int8 p_index)
+    {
+#if DATABASE_BOUND_TEST
+        assert_true(this->binded_return_layout != NULL);
+        assert_true(this->binded_return_layout->types_slice.get(p_index) == SQLiteQueryPrimitiveTypes::BLOB);
+#endif
+        uimax l_size = sqlite3_column_bytes(this->binded_statement, p_index);
+        return Slice<int8>::build_memory_elementnb((int8*)sqlite3_column_blob(this->binded_statement, p_index), l_size);
+    };
 };
 
 struct SQliteQueryExecution
@@ -2,6 +2,7 @@
 
 #if _WIN32
 using FileHandle = HANDLE;
+using FileMappingHandle = HANDLE;
 #endif
 
 struct FileNative
@@ -43,6 +44,11 @@ struct FileNative
     };
 
     static int8 handle_is_valid(const FileHandle& p_file_handle);
+
+    // Maps the p_size first bytes of the file as read only memory
+    static FileMappingHandle map_file_readonly(const FileHandle& p_file_handle, const uimax p_size, int8** out_memory);
+
+    static void unmap_file(const FileMappingHandle& p_file_mapping_handle, int8* p_memory, const uimax p_size);
 };
 
 #if _WIN32
@@ -92,12 +98,14 @@ inline void FileNative::close_file(const FileHandle& p_file_handle)
 
 inline void FileNative::set_file_pointer(const FileHandle& p_file_handle, uimax p_pointer)
 {
+    LARGE_INTEGER l_distance;
+    l_distance.QuadPart = (LONGLONG)p_pointer;
 #if CONTAINER_BOUND_TEST
     assert_true(
 #endif
-        SetFilePointer(p_file_handle, (LONG)p_pointer, 0, FILE_BEGIN)
+        SetFilePointerEx(p_file_handle, l_distance, NULL, FILE_BEGIN)
 #if CONTAINER_BOUND_TEST
-        != INVALID_SET_FILE_POINTER)
+    )
 #endif
         ;
 };
@@ -129,6 +137,38 @@ inline int8 FileNative::handle_is_valid(const FileHandle& p_file_handle)
     return p_file_handle != INVALID_HANDLE_VALUE;
 };
 
+inline FileMappingHandle FileNative::map_file_readonly(const FileHandle& p_file_handle, const uimax p_size, int8** out_memory)
+{
+    FileMappingHandle l_mapping = CreateFileMapping(p_file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+#if CONTAINER_BOUND_TEST
+    assert_true(l_mapping != NULL);
+#endif
+#if MEM_LEAK_DETECTION
+    push_ptr_to_tracked((int8*)l_mapping);
+#endif
+    *out_memory = (int8*)MapViewOfFile(l_mapping, FILE_MAP_READ, 0, 0, (SIZE_T)p_size);
+#if CONTAINER_BOUND_TEST
+    assert_true(*out_memory != NULL);
+#endif
+    return l_mapping;
+};
+
+inline void FileNative::unmap_file(const FileMappingHandle& p_file_mapping_handle, int8* p_memory, const uimax p_size)
+{
+#if MEM_LEAK_DETECTION
+    remove_ptr_to_tracked((int8*)p_file_mapping_handle);
+#endif
+#if CONTAINER_BOUND_TEST
+    assert_true(
+#endif
+        UnmapViewOfFile(p_memory)
+#if CONTAINER_BOUND_TEST
+    )
+#endif
+        ;
+    CloseHandle(p_file_mapping_handle);
+};
+
 #endif
 
 struct File
@@ -183,7 +223,7 @@ struct File
         FileNative::delete_file(this->path_slice);
     };
 
-    inline uimax get_size()
+    inline uimax get_size() const
     {
         return FileNative::get_file_size(this->native_handle);
     };
@@ -199,6 +239,27 @@ struct File
         FileNative::read_buffer(this->native_handle, in_out_buffer);
     };
 
+    /*
+        Reads at most in_out_buffer->Size bytes starting from p_offset.
+        in_out_buffer->Size is set to the number of bytes read, it is 0 if p_offset is at the end of the file.
+    */
+    inline void read_file_chunk(const uimax p_offset, Slice<int8>* in_out_buffer) const
+    {
+        uimax l_file_size = FileNative::get_file_size(this->native_handle);
+        if (p_offset >= l_file_size)
+        {
+            in_out_buffer->Size = 0;
+            return;
+        }
+
+        if ((l_file_size - p_offset) < in_out_buffer->Size)
+        {
+            in_out_buffer->Size = l_file_size - p_offset;
+        }
+        FileNative::set_file_pointer(this->native_handle, p_offset);
+        FileNative::read_buffer(this->native_handle, in_out_buffer);
+    };
+
     inline Span<int8> read_file_allocate() const
     {
         uimax l_file_size = FileNative::get_file_size(this->native_handle);
@@ -213,6 +274,13 @@ struct File
         FileNative::write_buffer(this->native_handle, 0, p_buffer);
     };
 
+    // Writing after the end of the file extends it
+    inline void write_file_chunk(const uimax p_offset, const Slice<int8>& p_buffer)
+    {
+        FileNative::set_file_pointer(this->native_handle, p_offset);
+        FileNative::write_buffer(this->native_handle, p_offset, p_buffer);
+    };
+
     inline int8 is_valid()
     {
         return FileNative::handle_is_valid(this->native_handle);
@@ -235,3 +303,28 @@ struct File
         return l_file;
     };
 };
+
+/*
+    Read only view of the content of a file.
+    Pages of the file are loaded by the OS the first time they are accessed, nothing is copied to the heap.
+    The file must not be written while it is mapped.
+*/
+struct FileMapping
+{
+    FileMappingHandle native_handle;
+    Slice<int8> memory;
+
+    inline static FileMapping allocate(const File& p_file)
+    {
+        FileMapping l_file_mapping;
+        l_file_mapping.memory.Size = p_file.get_size();
+        l_file_mapping.native_handle = FileNative::map_file_readonly(p_file.native_handle, l_file_mapping.memory.Size, &l_file_mapping.memory.Begin);
+        return l_file_mapping;
+    };
+
+    inline void free()
+    {
+        FileNative::unmap_file(this->native_handle, this->memory.Begin, this->memory.Size);
+        this->memory = Slice<int8>::build_default();
+    };
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+// Index of the most significant bit, p_value must not be 0
+inline uimax bit_msb(const uimax p_value)
+{
+#ifdef _MSC_VER
+    unsigned long l_index;
+    _BitScanReverse64(&l_index, (unsigned long long)p_value);
+    return l_index;
+#else
+    return ((sizeof(unsigned long long) * 8) - 1) - __builtin_clzll((unsigned long long)p_value);
+#endif
+};
+
+// Index of the least significant bit, p_value must not be 0
+inline uimax bit_lsb(const uimax p_value)
+{
+#ifdef _MSC_VER
+    unsigned long l_index;
+    _BitScanForward64(&l_index, (unsigned long long)p_value);
+    return l_index;
+#else
+    return __builtin_ctzll((unsigned long long)p_value);
+#endif
+};
@@ -1,24 +1,352 @@
 #pragma once
 
+namespace Sort_Const
+{
+// Ranges smaller than this are sorted with an insertion sort
+static const uimax INSERTION_SORT_SIZE = 16;
+// Below this size, the radix sort histograms cost more than an insertion sort
+static const uimax RADIX_INSERTION_SORT_SIZE = 64;
+static const uimax RADIX_DIGIT_BITS = 8;
+static const uimax RADIX_DIGIT_COUNT = 1 << RADIX_DIGIT_BITS;
+}; // namespace Sort_Const
+
+/*
+    In place sorting of slices.
+    Comparison sorts take a p_compare_slot(left, right) that returns true when left must be placed after right.
+    Sorts that need extra memory can be given a scratch slice of at least the size of the sorted slice, otherwise it is allocated and freed by the sort.
+*/
 struct Sort
 {
-    // TODO ->Implement Quick sort
-    template<class ElementType, class CompareSlot>
-    inline static void Linear3(Slice<ElementType>& p_slice, const uimax p_start_index, const CompareSlot& p_compare_slot)
+    /*
+        Introsort : a quick sort with median of three pivots, that switches to a heap sort when the recursion gets too deep.
+        Complexity is always O(n log(n)) but the order of equal elements is not preserved.
+    */
+    template <class ElementType, class CompareSlot> inline static void Intro(Slice<ElementType>& p_slice, const CompareSlot& p_compare_slot)
+    {
+        if (p_slice.Size < 2)
+        {
+            return;
+        }
+
+        uimax l_depth_limit = 0;
+        for (uimax l_size = p_slice.Size; l_size > 1; l_size >>= 1)
+        {
+            l_depth_limit += 2;
+        }
+        intro_sort_range(p_slice.Begin, 0, p_slice.Size, l_depth_limit, p_compare_slot);
+    };
+
+    /*
+        In place heap sort. Complexity is always O(n log(n)) but the order of equal elements is not preserved.
+    */
+    template <class ElementType, class CompareSlot> inline static void Heap(Slice<ElementType>& p_slice, const CompareSlot& p_compare_slot)
+    {
+        if (p_slice.Size < 2)
+        {
+            return;
+        }
+
+        for (uimax i = p_slice.Size / 2; i > 0; i--)
+        {
+            heap_sift_down(p_slice, i - 1, p_slice.Size, p_compare_slot);
+        }
+
+        for (uimax l_end = p_slice.Size - 1; l_end > 0; l_end--)
+        {
+            ElementType l_tmp = p_slice.get(0);
+            p_slice.get(0) = p_slice.get(l_end);
+            p_slice.get(l_end) = l_tmp;
+            heap_sift_down(p_slice, 0, l_end, p_compare_slot);
+        }
+    };
+
+    /*
+        Stable bottom-up merge sort. Runs of INSERTION_SORT_SIZE elements are insertion sorted, then merged back and forth between the slice and the scratch.
+    */
+    template <class ElementType, class CompareSlot> inline static void Merge(Slice<ElementType>& p_slice, const CompareSlot& p_compare_slot)
+    {
+        if (p_slice.Size < 2)
+        {
+            return;
+        }
+
+        Span<ElementType> l_scratch = Span<ElementType>::allocate(p_slice.Size);
+        Merge(p_slice, l_scratch.slice, p_compare_slot);
+        l_scratch.free();
+    };
+
+    template <class ElementType, class CompareSlot> inline static void Merge(Slice<ElementType>& p_slice, const Slice<ElementType>& p_scratch, const CompareSlot& p_compare_slot)
+    {
+        uimax l_size = p_slice.Size;
+        if (l_size < 2)
+        {
+            return;
+        }
+#if CONTAINER_BOUND_TEST
+        assert_true(p_scratch.Size >= l_size);
+#endif
+
+        for (uimax l_begin = 0; l_begin < l_size; l_begin += Sort_Const::INSERTION_SORT_SIZE)
+        {
+            uimax l_end = l_begin + Sort_Const::INSERTION_SORT_SIZE;
+            insertion_sort_range(p_slice.Begin, l_begin, l_end < l_size ? l_end : l_size, p_compare_slot);
+        }
+
+        ElementType* l_source = p_slice.Begin;
+        ElementType* l_target = p_scratch.Begin;
+        for (uimax l_width = Sort_Const::INSERTION_SORT_SIZE; l_width < l_size; l_width *= 2)
+        {
+            for (uimax l_begin = 0; l_begin < l_size; l_begin += (l_width * 2))
+            {
+                uimax l_middle = (l_begin + l_width) < l_size ? (l_begin + l_width) : l_size;
+                uimax l_end = (l_begin + (l_width * 2)) < l_size ? (l_begin + (l_width * 2)) : l_size;
+                merge_ranges(l_source, l_target, l_begin, l_middle, l_end, p_compare_slot);
+            }
+
+            ElementType* l_tmp = l_source;
+            l_source = l_target;
+            l_target = l_tmp;
+        }
+
+        if (l_source != p_slice.Begin)
+        {
+            memory_cpy((int8*)p_slice.Begin, (int8*)l_source, l_size * sizeof(ElementType));
+        }
+    };
+
+    /*
+        Stable LSD radix sort in ascending order of the unsigned integer key returned by p_key_slot(element) (hash_t, uimax, token values...).
+        Every byte of the key is a counting sort pass, passes where all elements have the same byte are skipped.
+    */
+    template <class ElementType, class KeySlot> inline static void Radix(Slice<ElementType>& p_slice, const KeySlot& p_key_slot)
+    {
+        if (p_slice.Size < 2)
+        {
+            return;
+        }
+
+        Span<ElementType> l_scratch = Span<ElementType>::allocate(p_slice.Size);
+        Radix(p_slice, l_scratch.slice, p_key_slot);
+        l_scratch.free();
+    };
+
+    template <class ElementType, class KeySlot> inline static void Radix(Slice<ElementType>& p_slice, const Slice<ElementType>& p_scratch, const KeySlot& p_key_slot)
+    {
+        constexpr uimax l_pass_count = sizeof(decltype(p_key_slot(*p_slice.Begin)));
+        uimax l_size = p_slice.Size;
+        if (l_size < 2)
+        {
+            return;
+        }
+
+        if (l_size <= Sort_Const::RADIX_INSERTION_SORT_SIZE)
+        {
+            insertion_sort_range(p_slice.Begin, 0, l_size, [&](const ElementType& p_left, const ElementType& p_right) {
+                return (uint64)p_key_slot(p_left) > (uint64)p_key_slot(p_right);
+            });
+            return;
+        }
+#if CONTAINER_BOUND_TEST
+        assert_true(p_scratch.Size >= l_size);
+#endif
+
+        // The histograms of all passes are built at once
+        uimax l_histograms[l_pass_count][Sort_Const::RADIX_DIGIT_COUNT];
+        memory_zero((int8*)l_histograms, sizeof(l_histograms));
+        for (loop(i, 0, l_size))
+        {
+            uint64 l_key = (uint64)p_key_slot(p_slice.Begin[i]);
+            for (loop(l_pass, 0, l_pass_count))
+            {
+                l_histograms[l_pass][(l_key >> (l_pass * Sort_Const::RADIX_DIGIT_BITS)) & (Sort_Const::RADIX_DIGIT_COUNT - 1)] += 1;
+            }
+        }
+
+        ElementType* l_source = p_slice.Begin;
+        ElementType* l_target = p_scratch.Begin;
+        for (loop(l_pass, 0, l_pass_count))
+        {
+            uimax l_shift = l_pass * Sort_Const::RADIX_DIGIT_BITS;
+            uimax* l_histogram = l_histograms[l_pass];
+            if (l_histogram[((uint64)p_key_slot(l_source[0]) >> l_shift) & (Sort_Const::RADIX_DIGIT_COUNT - 1)] == l_size)
+            {
+                continue;
+            }
+
+            uimax l_offset = 0;
+            for (loop(l_digit, 0, Sort_Const::RADIX_DIGIT_COUNT))
+            {
+                uimax l_count = l_histogram[l_digit];
+                l_histogram[l_digit] = l_offset;
+                l_offset += l_count;
+            }
+
+            for (loop(i, 0, l_size))
+            {
+                uimax& l_digit_offset = l_histogram[((uint64)p_key_slot(l_source[i]) >> l_shift) & (Sort_Const::RADIX_DIGIT_COUNT - 1)];
+                l_target[l_digit_offset] = l_source[i];
+                l_digit_offset += 1;
+            }
+
+            ElementType* l_tmp = l_source;
+            l_source = l_target;
+            l_target = l_tmp;
+        }
+
+        if (l_source != p_slice.Begin)
+        {
+            memory_cpy((int8*)p_slice.Begin, (int8*)l_source, l_size * sizeof(ElementType));
+        }
+    };
+
+    /*
+        Radix sort of unsigned integers by their value.
+    */
+    template <class ElementType> inline static void Radix(Slice<ElementType>& p_slice)
+    {
+        Radix(p_slice, [](const ElementType& p_element) { return p_element; });
+    };
+
+  private:
+    template <class ElementType, class CompareSlot>
+    inline static void intro_sort_range(ElementType* p_elements, uimax p_begin, uimax p_end, uimax p_depth_limit, const CompareSlot& p_compare_slot)
     {
-        for (loop(i, p_start_index, p_slice.Size))
+        while ((p_end - p_begin) > Sort_Const::INSERTION_SORT_SIZE)
         {
-            ElementType& l_left = p_slice.get(i);
-            for (loop(j, i, p_slice.Size))
+            if (p_depth_limit == 0)
             {
-                ElementType& l_right = p_slice.get(j);
-                if (p_compare_slot(l_left, l_right))
+                Slice<ElementType> l_range = Slice<ElementType>::build_memory_elementnb(p_elements + p_begin, p_end - p_begin);
+                Heap(l_range, p_compare_slot);
+                return;
+            }
+            p_depth_limit -= 1;
+
+            // The first, middle and last elements are ordered, the middle one is the pivot
+            uimax l_middle = p_begin + ((p_end - p_begin) / 2);
+            uimax l_last = p_end - 1;
+            if (p_compare_slot(p_elements[p_begin], p_elements[l_middle]))
+            {
+                swap(p_elements, p_begin, l_middle);
+            }
+            if (p_compare_slot(p_elements[l_middle], p_elements[l_last]))
+            {
+                swap(p_elements, l_middle, l_last);
+                if (p_compare_slot(p_elements[p_begin], p_elements[l_middle]))
+                {
+                    swap(p_elements, p_begin, l_middle);
+                }
+            }
+            ElementType l_pivot = p_elements[l_middle];
+
+            // Hoare partition, elements equal to the pivot are spread on both sides
+            uimax l_left = p_begin;
+            uimax l_right = l_last;
+            while (1)
+            {
+                while (p_compare_slot(l_pivot, p_elements[l_left]))
                 {
-                    ElementType l_left_tmp = l_left;
-                    l_left = l_right;
-                    l_right = l_left_tmp;
+                    l_left += 1;
                 }
+                while (p_compare_slot(p_elements[l_right], l_pivot))
+                {
+                    l_right -= 1;
+                }
+                if (l_left >= l_right)
+                {
+                    break;
+                }
+                swap(p_elements, l_left, l_right);
+                l_left += 1;
+                l_right -= 1;
+            }
+
+            // The smallest side is sorted recursively so that the stack depth stays in O(log(n))
+            uimax l_split = l_right + 1;
+            if ((l_split - p_begin) < (p_end - l_split))
+            {
+                intro_sort_range(p_elements, p_begin, l_split, p_depth_limit, p_compare_slot);
+                p_begin = l_split;
+            }
+            else
+            {
+                intro_sort_range(p_elements, l_split, p_end, p_depth_limit, p_compare_slot);
+                p_end = l_split;
+            }
+        }
+
+        insertion_sort_range(p_elements, p_begin, p_end, p_compare_slot);
+    };
+
+    // Stable, elements are only moved after the elements they must be placed after
+    template <class ElementType, class CompareSlot> inline static void insertion_sort_range(ElementType* p_elements, const uimax p_begin, const uimax p_end, const CompareSlot& p_compare_slot)
+    {
+        for (loop(i, p_begin + 1, p_end))
+        {
+            ElementType l_element = p_elements[i];
+            uimax j = i;
+            while (j > p_begin && p_compare_slot(p_elements[j - 1], l_element))
+            {
+                p_elements[j] = p_elements[j - 1];
+                j -= 1;
             }
+            p_elements[j] = l_element;
+        }
+    };
+
+    // Merges the sorted ranges [p_begin, p_middle[ and [p_middle, p_end[ of p_source in p_target. Left elements are taken first when equal.
+    template <class ElementType, class CompareSlot>
+    inline static void merge_ranges(const ElementType* p_source, ElementType* p_target, const uimax p_begin, const uimax p_middle, const uimax p_end, const CompareSlot& p_compare_slot)
+    {
+        uimax l_left = p_begin;
+        uimax l_right = p_middle;
+        uimax l_target = p_begin;
+        while (l_left < p_middle && l_right < p_end)
+        {
+            if (p_compare_slot(p_source[l_left], p_source[l_right]))
+            {
+                p_target[l_target] = p_source[l_right];
+                l_right += 1;
+            }
+            else
+            {
+                p_target[l_target] = p_source[l_left];
+                l_left += 1;
+            }
+            l_target += 1;
+        }
+
+        memory_cpy((int8*)(p_target + l_target), (const int8*)(p_source + l_left), (p_middle - l_left) * sizeof(ElementType));
+        l_target += (p_middle - l_left);
+        memory_cpy((int8*)(p_target + l_target), (const int8*)(p_source + l_right), (p_end - l_right) * sizeof(ElementType));
+    };
+
+    template <class ElementType> inline static void swap(ElementType* p_elements, const uimax p_left, const uimax p_right)
+    {
+        ElementType l_tmp = p_elements[p_left];
+        p_elements[p_left] = p_elements[p_right];
+        p_elements[p_right] = l_tmp;
+    };
+
+    // The heap root is the element that must be placed last
+    template <class ElementType, class CompareSlot> inline static void heap_sift_down(Slice<ElementType>& p_slice, uimax p_root, const uimax p_end, const CompareSlot& p_compare_slot)
+    {
+        while ((p_root * 2) + 1 < p_end)
+        {
+            uimax l_child = (p_root * 2) + 1;
+            if (l_child + 1 < p_end && p_compare_slot(p_slice.get(l_child + 1), p_slice.get(l_child)))
+            {
+                l_child += 1;
+            }
+
+            if (!p_compare_slot(p_slice.get(l_child), p_slice.get(p_root)))
+            {
+                return;
+            }
+
+            ElementType l_tmp = p_slice.get(p_root);
+            p_slice.get(p_root) = p_slice.get(l_child);
+            p_slice.get(l_child) = l_tmp;
+            p_root = l_child;
         }
     };
 };
@@ -27,5 +27,7 @@ inline uint64 FILETIME_to_mics(FILETIME& p_filetime)
 #include <time.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
 
 #endif
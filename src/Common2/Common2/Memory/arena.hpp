@@ -0,0 +1,321 @@
+#pragma once
+
+namespace MemoryArena_Const
+{
+// Every allocation is aligned so that any primitive type can be stored in it
+static const uimax ALIGNMENT = 16;
+static const uimax SCRATCH_BLOCK_SIZE = 256 * 1024;
+static const uimax FRAME_BLOCK_SIZE = 1024 * 1024;
+}; // namespace MemoryArena_Const
+
+/*
+    A MemoryArena is a bump pointer allocator over a chain of heap blocks.
+    Allocating is moving the cursor of the current block. When the current block is full, a new one is chained.
+    Memory is not released individually : the arena is rewinded to a previously taken Mark or reset as a whole.
+    Reallocating or freeing the last allocation is done in place, so that a growing Vector allocated on top of the arena doesn't leave copies behind.
+    When every allocation has been freed, the arena is reset.
+*/
+struct MemoryArena
+{
+    // Header stored at the beginning of every block, allocated memory starts right after it
+    struct Block
+    {
+        Block* previous;
+        uimax capacity;
+        uimax padding[2];
+    };
+
+    struct Mark
+    {
+        Block* block;
+        uimax cursor;
+        uimax allocation_count;
+    };
+
+    Block* current_block;
+    uimax cursor;
+    uimax block_size;
+    uimax allocation_count;
+
+    // No memory is allocated until the first allocation
+    inline static MemoryArena allocate(const uimax p_block_size)
+    {
+        return MemoryArena{NULL, 0, p_block_size, 0};
+    };
+
+    inline void free()
+    {
+        this->free_blocks_until(NULL);
+        this->cursor = 0;
+        this->allocation_count = 0;
+    };
+
+    inline int8* allocate_memory(const uimax p_size)
+    {
+        uimax l_begin = MemoryArena::align(this->cursor);
+        if (this->current_block == NULL || (l_begin + p_size) > this->current_block->capacity)
+        {
+            this->push_block(p_size);
+            l_begin = 0;
+        }
+
+        this->cursor = l_begin + p_size;
+        this->allocation_count += 1;
+        return MemoryArena::get_block_memory(this->current_block) + l_begin;
+    };
+
+    inline int8* callocate_memory(const uimax p_size)
+    {
+        int8* l_memory = this->allocate_memory(p_size);
+        memory_zero(l_memory, p_size);
+        return l_memory;
+    };
+
+    inline int8* reallocate_memory(int8* p_memory, const uimax p_old_size, const uimax p_new_size)
+    {
+        if (p_memory == NULL)
+        {
+            return this->allocate_memory(p_new_size);
+        }
+
+        if (this->is_last_allocation(p_memory, p_old_size))
+        {
+            uimax l_begin = (uimax)(p_memory - MemoryArena::get_block_memory(this->current_block));
+            if ((l_begin + p_new_size) <= this->current_block->capacity)
+            {
+                this->cursor = l_begin + p_new_size;
+                return p_memory;
+            }
+        }
+
+        int8* l_new_memory = this->allocate_memory(p_new_size);
+        memory_cpy(l_new_memory, p_memory, p_old_size < p_new_size ? p_old_size : p_new_size);
+        this->allocation_count -= 1;
+        return l_new_memory;
+    };
+
+    inline void free_memory(int8* p_memory, const uimax p_size)
+    {
+        if (p_memory == NULL)
+        {
+            return;
+        }
+
+#if CONTAINER_MEMORY_TEST
+        assert_true(this->allocation_count != 0);
+#endif
+
+        this->allocation_count -= 1;
+        if (this->allocation_count == 0)
+        {
+            this->reset();
+        }
+        else if (this->is_last_allocation(p_memory, p_size))
+        {
+            this->cursor = (uimax)(p_memory - MemoryArena::get_block_memory(this->current_block));
+        }
+    };
+
+    inline Mark get_mark() const
+    {
+        return Mark{this->current_block, this->cursor, this->allocation_count};
+    };
+
+    // Every allocation done after the Mark has been taken is released, blocks chained after the Mark are freed
+    inline void rewind(const Mark& p_mark)
+    {
+        // The arena was empty, it may have been reset since then and the Mark block may not exist anymore
+        if (p_mark.allocation_count == 0)
+        {
+            this->reset();
+            return;
+        }
+
+        this->free_blocks_until(p_mark.block);
+        this->cursor = p_mark.cursor;
+        this->allocation_count = p_mark.allocation_count;
+    };
+
+    /*
+        Releases every allocation.
+        If the arena has grown beyond one block, blocks are merged into a single one big enough to hold all of them,
+        so that an arena reset every frame stops chaining blocks once it has reached the frame peak usage.
+    */
+    inline void reset()
+    {
+        if (this->current_block != NULL && this->current_block->previous != NULL)
+        {
+            uimax l_total_capacity = 0;
+            for (Block* l_block = this->current_block; l_block != NULL; l_block = l_block->previous)
+            {
+                l_total_capacity += l_block->capacity;
+            }
+            this->free_blocks_until(NULL);
+            this->push_block(l_total_capacity);
+        }
+        this->cursor = 0;
+        this->allocation_count = 0;
+    };
+
+    inline uimax get_block_count() const
+    {
+        uimax l_block_count = 0;
+        for (Block* l_block = this->current_block; l_block != NULL; l_block = l_block->previous)
+        {
+            l_block_count += 1;
+        }
+        return l_block_count;
+    };
+
+  private:
+    inline static uimax align(const uimax p_offset)
+    {
+        return (p_offset + (MemoryArena_Const::ALIGNMENT - 1)) & ~(MemoryArena_Const::ALIGNMENT - 1);
+    };
+
+    inline static int8* get_block_memory(Block* p_block)
+    {
+        return (int8*)(p_block + 1);
+    };
+
+    inline int8 is_last_allocation(const int8* p_memory, const uimax p_size) const
+    {
+        return this->current_block != NULL && (p_memory + p_size) == (MemoryArena::get_block_memory(this->current_block) + this->cursor);
+    };
+
+    inline void push_block(const uimax p_min_capacity)
+    {
+        uimax l_capacity = MemoryArena::align(p_min_capacity > this->block_size ? p_min_capacity : this->block_size);
+        Block* l_block = (Block*)heap_malloc(sizeof(Block) + l_capacity);
+        l_block->previous = this->current_block;
+        l_block->capacity = l_capacity;
+        this->current_block = l_block;
+        this->cursor = 0;
+    };
+
+    inline void free_blocks_until(Block* p_block)
+    {
+        while (this->current_block != p_block)
+        {
+#if CONTAINER_MEMORY_TEST
+            assert_true(this->current_block != NULL);
+#endif
+            Block* l_previous = this->current_block->previous;
+            heap_free((int8*)this->current_block);
+            this->current_block = l_previous;
+        }
+    };
+};
+
+/*
+    Arenas owned by the calling thread.
+    The scratch arena holds temporaries that don't outlive the function that allocates them. Functions take a Mark before allocating and rewind to it before returning.
+    The frame arena holds temporaries that live until the end of the frame, it is reset once per frame by the owner of the frame loop.
+    Memory allocated from these arenas must be freed by the thread that allocated it.
+*/
+struct ThreadArenas
+{
+    inline static MemoryArena& scratch()
+    {
+        static thread_local MemoryArena l_scratch = MemoryArena::allocate(MemoryArena_Const::SCRATCH_BLOCK_SIZE);
+        return l_scratch;
+    };
+
+    inline static MemoryArena& frame()
+    {
+        static thread_local MemoryArena l_frame = MemoryArena::allocate(MemoryArena_Const::FRAME_BLOCK_SIZE);
+        return l_frame;
+    };
+
+    /*
+        Must be called before the thread exits, every allocation must have been freed.
+        The main thread arenas are freed by memleak_ckeck, spawned threads call it at the end of their main.
+    */
+    inline static void free()
+    {
+#if CONTAINER_MEMORY_TEST
+        assert_true(ThreadArenas::scratch().allocation_count == 0);
+        assert_true(ThreadArenas::frame().allocation_count == 0);
+#endif
+        ThreadArenas::scratch().free();
+        ThreadArenas::frame().free();
+    };
+};
+
+inline void thread_arenas_free()
+{
+    ThreadArenas::free();
+};
+
+/*
+    Allocators used by Span and Vector.
+    The allocated size is passed back on reallocation and free so that arena allocators can grow and release the last allocation in place.
+*/
+struct HeapAllocator
+{
+    inline static int8* allocate_memory(const uimax p_size)
+    {
+        return heap_malloc(p_size);
+    };
+
+    inline static int8* callocate_memory(const uimax p_size)
+    {
+        return heap_calloc(p_size);
+    };
+
+    inline static int8* reallocate_memory(int8* p_memory, const uimax p_old_size, const uimax p_new_size)
+    {
+        return heap_realloc(p_memory, p_new_size);
+    };
+
+    inline static void free_memory(int8* p_memory, const uimax p_size)
+    {
+        heap_free(p_memory);
+    };
+};
+
+struct ScratchAllocator
+{
+    inline static int8* allocate_memory(const uimax p_size)
+    {
+        return ThreadArenas::scratch().allocate_memory(p_size);
+    };
+
+    inline static int8* callocate_memory(const uimax p_size)
+    {
+        return ThreadArenas::scratch().callocate_memory(p_size);
+    };
+
+    inline static int8* reallocate_memory(int8* p_memory, const uimax p_old_size, const uimax p_new_size)
+    {
+        return ThreadArenas::scratch().reallocate_memory(p_memory, p_old_size, p_new_size);
+    };
+
+    inline static void free_memory(int8* p_memory, const uimax p_size)
+    {
+        ThreadArenas::scratch().free_memory(p_memory, p_size);
+    };
+};
+
+struct FrameAllocator
+{
+    inline static int8* allocate_memory(const uimax p_size)
+    {
+        return ThreadArenas::frame().allocate_memory(p_size);
+    };
+
+    inline static int8* callocate_memory(const uimax p_size)
+    {
+        return ThreadArenas::frame().callocate_memory(p_size);
+    };
+
+    inline static int8* reallocate_memory(int8* p_memory, const uimax p_old_size, const uimax p_new_size)
+    {
+        return ThreadArenas::frame().reallocate_memory(p_memory, p_old_size, p_new_size);
+    };
+
+    inline static void free_memory(int8* p_memory, const uimax p_size)
+    {
+        ThreadArenas::frame().free_memory(p_memory, p_size);
+    };
+};
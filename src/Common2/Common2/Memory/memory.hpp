@@ -1,103 +1,412 @@
 #pragma once
 
-#if MEM_LEAK_DETECTION
+/*
+    Subsystems that heap allocations are charged to.
+    Every thread has a current tag, set by the subsystem entry points, that is given to the allocations of the thread. Jobs are executed with the tag of the thread that built them.
+*/
+enum class MemoryTag : int8
+{
+    DEFAULT = 0,
+    COLLISION = 1,
+    SCENE = 2,
+    RENDER = 3,
+    ASSET = 4,
+    GPU_STAGING = 5,
+    COUNT = 6
+};
+
+inline MemoryTag& memory_tag_current()
+{
+    static thread_local MemoryTag l_tag = MemoryTag::DEFAULT;
+    return l_tag;
+};
+
+inline MemoryTag memory_tag_get()
+{
+    return memory_tag_current();
+};
 
-#define MEM_LEAK_MAX_POINTER_COUNTER 10000
-#define MEM_LEAK_MAX_BACKTRACE 64
+// Returns the previous tag, so that it can be restored when the subsystem returns
+inline MemoryTag memory_tag_set(const MemoryTag p_tag)
+{
+    MemoryTag l_previous_tag = memory_tag_current();
+    memory_tag_current() = p_tag;
+    return l_previous_tag;
+};
 
-int8* ptr_counter[MEM_LEAK_MAX_POINTER_COUNTER] = {};
+struct MemoryTagStatistics
+{
+    uimax live_size;
+    uimax peak_size;
+    uimax live_count;
+    // Reset by memory_statistics_end_frame
+    uimax frame_peak_size;
+    uimax frame_allocation_count;
+    uimax frame_allocated_size;
+};
 
-typedef LPVOID backtrace_t[MEM_LEAK_MAX_BACKTRACE];
+/*
+    Allocation tracking.
+    MEM_LEAK_DETECTION : allocations are tracked with their backtrace, memleak_ckeck aborts if some of them are still alive.
+    MEM_STATISTICS : live size, peak size and allocation counts are recorded per MemoryTag.
+    Both are backed by an open addressing hash table of the live allocations, keyed by pointer, that is protected by a spin lock.
+*/
+#define MEM_TRACKING (MEM_LEAK_DETECTION || MEM_STATISTICS)
 
-backtrace_t backtraces[MEM_LEAK_MAX_POINTER_COUNTER] = {};
+#if MEM_TRACKING
 
+#if MEM_LEAK_DETECTION
+#ifdef _WIN32
 #include "dbghelp.h"
+#elif __linux__
+#include <execinfo.h>
+#endif
+#endif
 
-inline void capture_backtrace(const uimax p_ptr_index)
+namespace MemoryTracking_Const
 {
-    CaptureStackBackTrace(0, MEM_LEAK_MAX_BACKTRACE, backtraces[p_ptr_index], NULL);
-};
+static const uimax INITIAL_CAPACITY = 4096;
+static const uimax BACKTRACE_SIZE = 32;
+}; // namespace MemoryTracking_Const
 
-inline int8* push_ptr_to_tracked(int8* p_ptr)
+struct MemoryTracking
 {
-    for (uimax i = 0; i < MEM_LEAK_MAX_POINTER_COUNTER; i++)
+    struct Allocation
     {
-        if (ptr_counter[i] == NULL)
+        int8* ptr;
+        uimax size;
+        MemoryTag tag;
+#if MEM_LEAK_DETECTION
+        uimax backtrace_size;
+        void* backtrace[MemoryTracking_Const::BACKTRACE_SIZE];
+#endif
+    };
+
+    volatile int64 lock;
+    Allocation* allocations;
+    uimax capacity;
+    uimax count;
+    MemoryTagStatistics statistics[(uimax)MemoryTag::COUNT];
+    MemoryTagStatistics frame_statistics[(uimax)MemoryTag::COUNT];
+
+    inline static MemoryTracking& get()
+    {
+        static MemoryTracking l_tracking = {};
+        return l_tracking;
+    };
+
+    inline void push(int8* p_ptr, const uimax p_size, const MemoryTag p_tag)
+    {
+        if (p_ptr == NULL)
         {
-            ptr_counter[i] = p_ptr;
-            capture_backtrace(i);
-            return p_ptr;
+            return;
         }
-    }
 
-    abort();
-};
+        Allocation l_allocation;
+        l_allocation.ptr = p_ptr;
+        l_allocation.size = p_size;
+        l_allocation.tag = p_tag;
+#if MEM_LEAK_DETECTION
+        MemoryTracking::capture_backtrace(&l_allocation);
+#endif
 
-inline void remove_ptr_to_tracked(int8* p_ptr)
-{
-    for (uimax i = 0; i < MEM_LEAK_MAX_POINTER_COUNTER; i++)
+        this->lock_acquire();
+        if (((this->count + 1) * 2) > this->capacity)
+        {
+            this->grow();
+        }
+        uimax l_slot = this->home_slot(p_ptr);
+        while (this->allocations[l_slot].ptr != NULL)
+        {
+            l_slot = (l_slot + 1) & (this->capacity - 1);
+        }
+        this->allocations[l_slot] = l_allocation;
+        this->count += 1;
+        this->on_allocated(p_tag, p_size);
+        this->lock_release();
+    };
+
+    // Returns the tag of the removed allocation
+    inline MemoryTag remove(int8* p_ptr)
     {
-        if (ptr_counter[i] == p_ptr)
+        MemoryTag l_tag = memory_tag_get();
+        if (p_ptr == NULL)
         {
-            ptr_counter[i] = NULL;
-            return;
+            return l_tag;
         }
-    }
 
-    abort();
+        this->lock_acquire();
+        uimax l_slot;
+        if (this->find(p_ptr, &l_slot))
+        {
+            l_tag = this->allocations[l_slot].tag;
+            this->on_freed(l_tag, this->allocations[l_slot].size);
+            this->remove_slot(l_slot);
+        }
+#if MEM_LEAK_DETECTION
+        else
+        {
+            // Freeing memory that has not been allocated by heap_malloc, or freeing it twice
+            abort();
+        }
+#endif
+        this->lock_release();
+        return l_tag;
+    };
+
+    inline void on_allocated(const MemoryTag p_tag, const uimax p_size)
+    {
+        MemoryTagStatistics& l_statistics = this->statistics[(uimax)p_tag];
+        l_statistics.live_size += p_size;
+        l_statistics.live_count += 1;
+        l_statistics.frame_allocation_count += 1;
+        l_statistics.frame_allocated_size += p_size;
+        if (l_statistics.live_size > l_statistics.peak_size)
+        {
+            l_statistics.peak_size = l_statistics.live_size;
+        }
+        if (l_statistics.live_size > l_statistics.frame_peak_size)
+        {
+            l_statistics.frame_peak_size = l_statistics.live_size;
+        }
+    };
+
+    inline void on_freed(const MemoryTag p_tag, const uimax p_size)
+    {
+        MemoryTagStatistics& l_statistics = this->statistics[(uimax)p_tag];
+        l_statistics.live_size -= p_size;
+        l_statistics.live_count -= 1;
+    };
+
+    inline void lock_acquire()
+    {
+        while (!atomic_compare_exchange(&this->lock, 0, 1))
+        {
+        }
+    };
+
+    inline void lock_release()
+    {
+        atomic_store(&this->lock, 0);
+    };
+
+  private:
+    inline uimax home_slot(const int8* p_ptr)
+    {
+        // Allocations are at least 16 bytes aligned, the low bits are always the same
+        return (uimax)((((uint64)p_ptr >> 4) * 11400714819323198485ULL) >> 24) & (this->capacity - 1);
+    };
+
+    inline int8 find(const int8* p_ptr, uimax* out_slot)
+    {
+        if (this->capacity == 0)
+        {
+            return 0;
+        }
+        uimax l_slot = this->home_slot(p_ptr);
+        while (this->allocations[l_slot].ptr != NULL)
+        {
+            if (this->allocations[l_slot].ptr == p_ptr)
+            {
+                *out_slot = l_slot;
+                return 1;
+            }
+            l_slot = (l_slot + 1) & (this->capacity - 1);
+        }
+        return 0;
+    };
+
+    // Following allocations of the probe sequence are shifted back, so that lookups never stop on an empty slot before finding their allocation
+    inline void remove_slot(uimax p_slot)
+    {
+        uimax l_mask = this->capacity - 1;
+        uimax l_next = (p_slot + 1) & l_mask;
+        while (this->allocations[l_next].ptr != NULL)
+        {
+            uimax l_home = this->home_slot(this->allocations[l_next].ptr);
+            if (((l_next - l_home) & l_mask) >= ((l_next - p_slot) & l_mask))
+            {
+                this->allocations[p_slot] = this->allocations[l_next];
+                p_slot = l_next;
+            }
+            l_next = (l_next + 1) & l_mask;
+        }
+        this->allocations[p_slot].ptr = NULL;
+        this->count -= 1;
+    };
+
+    // The table is allocated with the system allocator, it is not tracked itself
+    inline void grow()
+    {
+        Allocation* l_old_allocations = this->allocations;
+        uimax l_old_capacity = this->capacity;
+
+        this->capacity = l_old_capacity == 0 ? MemoryTracking_Const::INITIAL_CAPACITY : (l_old_capacity * 2);
+        this->allocations = (Allocation*)::calloc(this->capacity, sizeof(Allocation));
+        for (uimax i = 0; i < l_old_capacity; i++)
+        {
+            if (l_old_allocations[i].ptr != NULL)
+            {
+                uimax l_slot = this->home_slot(l_old_allocations[i].ptr);
+                while (this->allocations[l_slot].ptr != NULL)
+                {
+                    l_slot = (l_slot + 1) & (this->capacity - 1);
+                }
+                this->allocations[l_slot] = l_old_allocations[i];
+            }
+        }
+        ::free(l_old_allocations);
+    };
+
+#if MEM_LEAK_DETECTION
+    inline static void capture_backtrace(Allocation* in_out_allocation)
+    {
+#ifdef _WIN32
+        in_out_allocation->backtrace_size = CaptureStackBackTrace(0, MemoryTracking_Const::BACKTRACE_SIZE, in_out_allocation->backtrace, NULL);
+#elif __linux__
+        in_out_allocation->backtrace_size = (uimax)backtrace(in_out_allocation->backtrace, (int)MemoryTracking_Const::BACKTRACE_SIZE);
+#endif
+    };
+#endif
 };
 
 #endif
 
+#if MEM_LEAK_DETECTION
+
+// Tracks memory that is not allocated by heap_malloc, like handles and memory returned by libraries
+inline int8* push_ptr_to_tracked(int8* p_ptr)
+{
+    MemoryTracking::get().push(p_ptr, 0, memory_tag_get());
+    return p_ptr;
+};
+
+inline void remove_ptr_to_tracked(int8* p_ptr)
+{
+    MemoryTracking::get().remove(p_ptr);
+};
+
+#endif
+
+// Defined with the ThreadArenas
+inline void thread_arenas_free();
+
+// The arenas of the calling thread are freed before checking leaks, it must be the last thread alive
 inline void memleak_ckeck()
 {
+    thread_arenas_free();
 #if MEM_LEAK_DETECTION
-    for (uimax i = 0; i < MEM_LEAK_MAX_POINTER_COUNTER; i++)
+    MemoryTracking& l_tracking = MemoryTracking::get();
+    if (l_tracking.count != 0)
     {
-        if (ptr_counter[i] != NULL)
+        for (uimax i = 0; i < l_tracking.capacity; i++)
         {
-            /*
-            for (loop(j, 0, MEM_LEAK_MAX_BACKTRACE))
+            MemoryTracking::Allocation& l_allocation = l_tracking.allocations[i];
+            if (l_allocation.ptr != NULL)
             {
-                LPVOID l_func_pointer = backtraces[i][j];
-                if (l_func_pointer)
-                {
-                    SYMBOL_INFO l_symbol;
-                    assert_true(SymFromAddr(GetCurrentProcess(), (DWORD64)l_func_pointer, 0, &l_symbol));
-                    printf(l_symbol.Name);
-                    printf("\n");
-                }
+                printf("Leaked allocation of %lld bytes, tag %d\n", (long long)l_allocation.size, (int)l_allocation.tag);
+#ifdef __linux__
+                backtrace_symbols_fd(l_allocation.backtrace, (int)l_allocation.backtrace_size, 2);
+#endif
             }
-            */
-            abort();
         }
+        abort();
     }
 #endif
 };
 
-inline int8* heap_malloc(const uimax p_size)
+// Memory that is not allocated on the heap, like GPU staging buffers, is recorded in the statistics with it's size
+inline void memory_statistics_push_external(const MemoryTag p_tag, const uimax p_size)
 {
-#if MEM_LEAK_DETECTION
-    return push_ptr_to_tracked((int8*)::malloc(p_size));
+#if MEM_TRACKING
+    MemoryTracking& l_tracking = MemoryTracking::get();
+    l_tracking.lock_acquire();
+    l_tracking.on_allocated(p_tag, p_size);
+    l_tracking.lock_release();
+#endif
+};
+
+inline void memory_statistics_remove_external(const MemoryTag p_tag, const uimax p_size)
+{
+#if MEM_TRACKING
+    MemoryTracking& l_tracking = MemoryTracking::get();
+    l_tracking.lock_acquire();
+    l_tracking.on_freed(p_tag, p_size);
+    l_tracking.lock_release();
+#endif
+};
+
+// Statistics of the last frame ended by memory_statistics_end_frame
+inline MemoryTagStatistics memory_statistics_get_frame(const MemoryTag p_tag)
+{
+#if MEM_TRACKING
+    MemoryTracking& l_tracking = MemoryTracking::get();
+    l_tracking.lock_acquire();
+    MemoryTagStatistics l_statistics = l_tracking.frame_statistics[(uimax)p_tag];
+    l_tracking.lock_release();
+    return l_statistics;
 #else
-    return (int8*)::malloc(p_size);
+    return MemoryTagStatistics{};
+#endif
+};
+
+inline void memory_statistics_end_frame()
+{
+#if MEM_TRACKING
+    MemoryTracking& l_tracking = MemoryTracking::get();
+    l_tracking.lock_acquire();
+    for (uimax i = 0; i < (uimax)MemoryTag::COUNT; i++)
+    {
+        MemoryTagStatistics& l_statistics = l_tracking.statistics[i];
+        l_tracking.frame_statistics[i] = l_statistics;
+        l_statistics.frame_peak_size = l_statistics.live_size;
+        l_statistics.frame_allocation_count = 0;
+        l_statistics.frame_allocated_size = 0;
+    }
+    l_tracking.lock_release();
 #endif
 };
 
+inline void memory_statistics_print()
+{
+#if MEM_TRACKING
+    const char* l_tag_names[(uimax)MemoryTag::COUNT] = {"default", "collision", "scene", "render", "asset", "gpu staging"};
+    for (uimax i = 0; i < (uimax)MemoryTag::COUNT; i++)
+    {
+        MemoryTagStatistics l_statistics = memory_statistics_get_frame((MemoryTag)i);
+        printf("%-12s live: %10lld bytes %7lld allocations | peak: %10lld bytes | frame peak: %10lld bytes | frame: %7lld allocations %10lld bytes\n", l_tag_names[i],
+               (long long)l_statistics.live_size, (long long)l_statistics.live_count, (long long)l_statistics.peak_size, (long long)l_statistics.frame_peak_size,
+               (long long)l_statistics.frame_allocation_count, (long long)l_statistics.frame_allocated_size);
+    }
+#endif
+};
+
+inline int8* heap_malloc(const uimax p_size)
+{
+    int8* l_memory = (int8*)::malloc(p_size);
+#if MEM_TRACKING
+    MemoryTracking::get().push(l_memory, p_size, memory_tag_get());
+#endif
+    return l_memory;
+};
+
 inline int8* heap_calloc(const uimax p_size)
 {
-#if MEM_LEAK_DETECTION
-    return push_ptr_to_tracked((int8*)::calloc(1, p_size));
-#else
-    return (int8*)::calloc(1, p_size);
+    int8* l_memory = (int8*)::calloc(1, p_size);
+#if MEM_TRACKING
+    MemoryTracking::get().push(l_memory, p_size, memory_tag_get());
 #endif
+    return l_memory;
 };
 
 inline int8* heap_realloc(int8* p_memory, const uimax p_new_size)
 {
-#if MEM_LEAK_DETECTION
-    remove_ptr_to_tracked(p_memory);
-    return push_ptr_to_tracked((int8*)::realloc(p_memory, p_new_size));
+#if MEM_TRACKING
+    // The old allocation is removed before it is released, another thread may get the same address right after. The reallocated memory keeps it's tag.
+    MemoryTag l_tag = MemoryTracking::get().remove(p_memory);
+    int8* l_memory = (int8*)::realloc(p_memory, p_new_size);
+    MemoryTracking::get().push(l_memory, p_new_size, l_tag);
+    return l_memory;
 #else
     return (int8*)::realloc(p_memory, p_new_size);
 #endif
@@ -105,8 +414,8 @@ inline int8* heap_realloc(int8* p_memory, const uimax p_new_size)
 
 inline void heap_free(int8* p_memory)
 {
-#if MEM_LEAK_DETECTION
-    remove_ptr_to_tracked(p_memory);
+#if MEM_TRACKING
+    MemoryTracking::get().remove(p_memory);
 #endif
     ::free(p_memory);
 };
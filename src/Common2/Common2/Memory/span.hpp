@@ -3,8 +3,9 @@
 /*
     A Span is a heap allocated chunk of memory.
     Span can allocate memory, be resized and freed.
+    Memory is allocated by the AllocatorType, short lived Spans can be allocated from the scratch or frame arenas of the thread (ScratchAllocator, FrameAllocator).
 */
-template <class ElementType> struct Span
+template <class ElementType, class AllocatorType = HeapAllocator> struct Span
 {
     union
     {
@@ -16,48 +17,48 @@ template <class ElementType> struct Span
         Slice<ElementType> slice;
     };
 
-    inline static Span<ElementType> build_default()
+    inline static Span<ElementType, AllocatorType> build_default()
     {
-        Span<ElementType> l_return;
+        Span<ElementType, AllocatorType> l_return;
         l_return.slice = Slice<ElementType>::build_default();
         return l_return;
     };
 
-    inline static Span<ElementType> build(ElementType* p_memory, const uimax p_capacity)
+    inline static Span<ElementType, AllocatorType> build(ElementType* p_memory, const uimax p_capacity)
     {
-        return Span<ElementType>{p_capacity, p_memory};
+        return Span<ElementType, AllocatorType>{p_capacity, p_memory};
     };
 
-    inline static Span<ElementType> allocate(const uimax p_capacity)
+    inline static Span<ElementType, AllocatorType> allocate(const uimax p_capacity)
     {
-        return Span<ElementType>{p_capacity, cast(ElementType*, heap_malloc(p_capacity * sizeof(ElementType)))};
+        return Span<ElementType, AllocatorType>{p_capacity, cast(ElementType*, AllocatorType::allocate_memory(p_capacity * sizeof(ElementType)))};
     };
 
-    inline static Span<ElementType> allocate_slice(const Slice<ElementType>& p_elements)
+    inline static Span<ElementType, AllocatorType> allocate_slice(const Slice<ElementType>& p_elements)
     {
-        Span<ElementType> l_span = Span<ElementType>::allocate(p_elements.Size);
+        Span<ElementType, AllocatorType> l_span = Span<ElementType, AllocatorType>::allocate(p_elements.Size);
         l_span.slice.copy_memory(Slice<ElementType>::build_memory_elementnb((ElementType*)p_elements.Begin, p_elements.Size));
         return l_span;
     };
 
-    inline static Span<ElementType> allocate_slice_2(const Slice<ElementType>& p_elements_1, const Slice<ElementType>& p_elements_2)
+    inline static Span<ElementType, AllocatorType> allocate_slice_2(const Slice<ElementType>& p_elements_1, const Slice<ElementType>& p_elements_2)
     {
-        Span<ElementType> l_span = Span<ElementType>::allocate(p_elements_1.Size + p_elements_2.Size);
+        Span<ElementType, AllocatorType> l_span = Span<ElementType, AllocatorType>::allocate(p_elements_1.Size + p_elements_2.Size);
         l_span.slice.copy_memory_at_index_2(0, p_elements_1, p_elements_2);
         return l_span;
     };
 
 
-    inline static Span<ElementType> allocate_slice_3(const Slice<ElementType>& p_elements_1, const Slice<ElementType>& p_elements_2, const Slice<ElementType>& p_elements_3)
+    inline static Span<ElementType, AllocatorType> allocate_slice_3(const Slice<ElementType>& p_elements_1, const Slice<ElementType>& p_elements_2, const Slice<ElementType>& p_elements_3)
     {
-        Span<ElementType> l_span = Span<ElementType>::allocate(p_elements_1.Size + p_elements_2.Size + p_elements_3.Size);
+        Span<ElementType, AllocatorType> l_span = Span<ElementType, AllocatorType>::allocate(p_elements_1.Size + p_elements_2.Size + p_elements_3.Size);
         l_span.slice.copy_memory_at_index_3(0, p_elements_1, p_elements_2, p_elements_3);
         return l_span;
     };
 
-    inline static Span<ElementType> callocate(const uimax p_capacity)
+    inline static Span<ElementType, AllocatorType> callocate(const uimax p_capacity)
     {
-        return Span<ElementType>{p_capacity, cast(ElementType*, heap_calloc(p_capacity * sizeof(ElementType)))};
+        return Span<ElementType, AllocatorType>{p_capacity, cast(ElementType*, AllocatorType::callocate_memory(p_capacity * sizeof(ElementType)))};
     };
 
     inline ElementType& get(const uimax p_index)
@@ -72,10 +73,10 @@ template <class ElementType> struct Span
     {
         if (p_new_capacity > this->Capacity)
         {
-            ElementType* l_newMemory = (ElementType*)heap_realloc(cast(int8*, this->Memory), p_new_capacity * sizeof(ElementType));
+            ElementType* l_newMemory = (ElementType*)AllocatorType::reallocate_memory(cast(int8*, this->Memory), this->Capacity * sizeof(ElementType), p_new_capacity * sizeof(ElementType));
             if (l_newMemory != NULL)
             {
-                *this = Span<ElementType>::build(l_newMemory, p_new_capacity);
+                *this = Span<ElementType, AllocatorType>::build(l_newMemory, p_new_capacity);
                 return 1;
             }
             return 0;
@@ -85,13 +86,13 @@ template <class ElementType> struct Span
 
     inline const ElementType& get(const uimax p_index) const
     {
-        return ((Span<ElementType>*)(this))->get(p_index);
+        return ((Span<ElementType, AllocatorType>*)(this))->get(p_index);
     };
 
-    inline Span<ElementType> move_to_value()
+    inline Span<ElementType, AllocatorType> move_to_value()
     {
-        Span<ElementType> l_return = *this;
-        *this = Span<ElementType>::build(NULL, 0);
+        Span<ElementType, AllocatorType> l_return = *this;
+        *this = Span<ElementType, AllocatorType>::build(NULL, 0);
         return l_return;
     };
 
@@ -119,7 +120,7 @@ template <class ElementType> struct Span
 
     inline void free()
     {
-        heap_free(cast(int8*, this->Memory));
-        *this = Span<ElementType>::build(NULL, 0);
+        AllocatorType::free_memory(cast(int8*, this->Memory), this->Capacity * sizeof(ElementType));
+        *this = Span<ElementType, AllocatorType>::build(NULL, 0);
     };
 };
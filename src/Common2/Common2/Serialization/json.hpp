@@ -30,17 +30,18 @@ struct JSONDeserializer
     Slice<int8> source;
 
     Slice<int8> parent_cursor;
-    Vector<FieldNode> stack_fields;
+    // Deserializers are short lived, the stack is allocated from the scratch arena of the deserializing thread
+    Vector<FieldNode, ScratchAllocator> stack_fields;
     uimax current_field;
 
     inline static JSONDeserializer allocate_default()
     {
-        return JSONDeserializer{Slice<int8>::build_default(), Slice<int8>::build_default(), Vector<FieldNode>::allocate(0), (uimax)-1};
+        return JSONDeserializer{Slice<int8>::build_default(), Slice<int8>::build_default(), Vector<FieldNode, ScratchAllocator>::allocate(0), (uimax)-1};
     };
 
     inline static JSONDeserializer allocate(const Slice<int8>& p_source, const Slice<int8>& p_parent_cursor)
     {
-        return JSONDeserializer{p_source, p_parent_cursor, Vector<FieldNode>::allocate(0), (uimax)-1};
+        return JSONDeserializer{p_source, p_parent_cursor, Vector<FieldNode, ScratchAllocator>::allocate(0), (uimax)-1};
     };
 
     inline static JSONDeserializer start(Vector<int8>& p_source)
@@ -54,7 +55,7 @@ struct JSONDeserializer
 
     inline JSONDeserializer clone()
     {
-        return JSONDeserializer{this->source, this->parent_cursor, Vector<FieldNode>::allocate_elements(this->stack_fields.to_slice()), this->current_field};
+        return JSONDeserializer{this->source, this->parent_cursor, Vector<FieldNode, ScratchAllocator>::allocate_elements(this->stack_fields.to_slice()), this->current_field};
     };
 
     inline void free()
@@ -69,14 +70,11 @@ struct JSONDeserializer
         Slice<int8> l_next_field_whole_value;
         if (this->find_next_field_whole_value(&l_next_field_whole_value))
         {
-            String l_field_name_json = String::allocate(strlen(p_field_name) + 2);
-            l_field_name_json.append(slice_int8_build_rawstr("\""));
-            l_field_name_json.append(slice_int8_build_rawstr(p_field_name));
-            l_field_name_json.append(slice_int8_build_rawstr("\":"));
+            Span<int8, ScratchAllocator> l_field_name_json = JSONDeserializer::allocate_field_name_json(p_field_name);
 
-            if (l_next_field_whole_value.compare(l_field_name_json.to_slice()))
+            if (l_next_field_whole_value.compare(l_field_name_json.slice))
             {
-                Slice<int8> l_next_field_value_with_quotes = l_next_field_whole_value.slide_rv(l_field_name_json.get_length());
+                Slice<int8> l_next_field_value_with_quotes = l_next_field_whole_value.slide_rv(l_field_name_json.Capacity);
 
                 FieldNode l_field_node;
                 uimax l_field_value_delta;
@@ -107,13 +105,10 @@ struct JSONDeserializer
 
         Slice<int8> l_compared_slice = this->get_current_slice_cursor();
 
-        String l_field_name_json = String::allocate(strlen(p_field_name) + 2);
-        l_field_name_json.append(slice_int8_build_rawstr("\""));
-        l_field_name_json.append(slice_int8_build_rawstr(p_field_name));
-        l_field_name_json.append(slice_int8_build_rawstr("\":"));
+        Span<int8, ScratchAllocator> l_field_name_json = JSONDeserializer::allocate_field_name_json(p_field_name);
 
         FieldNode l_field_node;
-        if (find_next_json_field(l_compared_slice, l_field_name_json.to_slice(), '{', '}', &l_field_node.whole_field, &l_field_node.value))
+        if (find_next_json_field(l_compared_slice, l_field_name_json.slice, '{', '}', &l_field_node.whole_field, &l_field_node.value))
         {
             l_field_node.value.slide(1); //for '{'
             *out_object_iterator = JSONDeserializer::allocate(this->source, l_field_node.value);
@@ -136,13 +131,10 @@ struct JSONDeserializer
 
         Slice<int8> l_compared_slice = this->get_current_slice_cursor();
 
-        String l_field_name_json = String::allocate(strlen(p_field_name) + 2);
-        l_field_name_json.append(slice_int8_build_rawstr("\""));
-        l_field_name_json.append(slice_int8_build_rawstr(p_field_name));
-        l_field_name_json.append(slice_int8_build_rawstr("\":"));
+        Span<int8, ScratchAllocator> l_field_name_json = JSONDeserializer::allocate_field_name_json(p_field_name);
 
         FieldNode l_field_node;
-        if (find_next_json_field(l_compared_slice, l_field_name_json.to_slice(), '[', ']', &l_field_node.whole_field, &l_field_node.value))
+        if (find_next_json_field(l_compared_slice, l_field_name_json.slice, '[', ']', &l_field_node.whole_field, &l_field_node.value))
         {
             // To skip the first "["
             l_field_node.whole_field.Begin += 1;
@@ -195,6 +187,15 @@ struct JSONDeserializer
     };
 
   private:
+    // "p_field_name": is the pattern that begins a field
+    inline static Span<int8, ScratchAllocator> allocate_field_name_json(const int8* p_field_name)
+    {
+        Slice<int8> l_field_name = slice_int8_build_rawstr(p_field_name);
+        Span<int8, ScratchAllocator> l_field_name_json = Span<int8, ScratchAllocator>::allocate(l_field_name.Size + 3);
+        l_field_name_json.slice.copy_memory_at_index_3(0, slice_int8_build_rawstr("\""), l_field_name, slice_int8_build_rawstr("\":"));
+        return l_field_name_json;
+    };
+
     inline FieldNode* get_current_field()
     {
         if (this->current_field != (uimax)-1)
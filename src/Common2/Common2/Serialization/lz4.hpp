@@ -0,0 +1,230 @@
+#pragma once
+
+namespace LZ4_Const
+{
+static const uimax MIN_MATCH = 4;
+// The last sequence always ends with at least LAST_LITERALS literals
+static const uimax LAST_LITERALS = 5;
+// A match can't start in the last MATCH_FIND_LIMIT bytes of the source
+static const uimax MATCH_FIND_LIMIT = 12;
+static const uimax MAX_OFFSET = 65535;
+static const uimax HASH_LOG = 12;
+// After every 2^SKIP_TRIGGER consecutive misses, the compressor moves one more byte forward between two match searches
+static const uimax SKIP_TRIGGER = 6;
+}; // namespace LZ4_Const
+
+/*
+    Compression and decompression of the LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md).
+    Compressed memory is a sequence of literals followed by a back reference (offset, length) in the already decompressed memory.
+    The compressor only uses a single hash table of previous positions, decompression speed is what matters.
+*/
+struct LZ4
+{
+    inline static uimax get_max_compressed_size(const uimax p_size)
+    {
+        return p_size + (p_size / 255) + 16;
+    };
+
+    // out_compressed must be at least get_max_compressed_size(p_source.Size) bytes. Returns the compressed size.
+    inline static uimax compress(const Slice<int8>& p_source, const Slice<int8>& out_compressed)
+    {
+#if CONTAINER_BOUND_TEST
+        assert_true(out_compressed.Size >= get_max_compressed_size(p_source.Size));
+#endif
+        const uint8* l_source = (const uint8*)p_source.Begin;
+        uint8* l_compressed = (uint8*)out_compressed.Begin;
+        uimax l_anchor = 0;
+
+        if (p_source.Size > LZ4_Const::MATCH_FIND_LIMIT)
+        {
+            uint32 l_hash_table[1 << LZ4_Const::HASH_LOG];
+            memory_zero((int8*)l_hash_table, sizeof(l_hash_table));
+
+            uimax l_match_find_end = p_source.Size - LZ4_Const::MATCH_FIND_LIMIT;
+            uimax l_match_end_limit = p_source.Size - LZ4_Const::LAST_LITERALS;
+            uimax l_position = 0;
+            uimax l_miss_count = 0;
+            while (l_position <= l_match_find_end)
+            {
+                uint32 l_sequence = read_uint32(l_source + l_position);
+                uint32& l_hash_entry = l_hash_table[hash(l_sequence)];
+                uimax l_candidate = l_hash_entry;
+                l_hash_entry = (uint32)l_position;
+
+                if (l_candidate >= l_position || (l_position - l_candidate) > LZ4_Const::MAX_OFFSET || read_uint32(l_source + l_candidate) != l_sequence)
+                {
+                    l_position += (l_miss_count >> LZ4_Const::SKIP_TRIGGER) + 1;
+                    l_miss_count += 1;
+                    continue;
+                }
+
+                uimax l_match_length = LZ4_Const::MIN_MATCH;
+                while ((l_position + l_match_length) < l_match_end_limit && l_source[l_candidate + l_match_length] == l_source[l_position + l_match_length])
+                {
+                    l_match_length += 1;
+                }
+                while (l_position > l_anchor && l_candidate > 0 && l_source[l_position - 1] == l_source[l_candidate - 1])
+                {
+                    l_position -= 1;
+                    l_candidate -= 1;
+                    l_match_length += 1;
+                }
+
+                l_compressed = write_sequence(l_compressed, l_source + l_anchor, l_position - l_anchor, l_position - l_candidate, l_match_length);
+                l_position += l_match_length;
+                l_anchor = l_position;
+                l_miss_count = 0;
+            }
+        }
+
+        // The last sequence only has literals
+        l_compressed = write_sequence(l_compressed, l_source + l_anchor, p_source.Size - l_anchor, 0, LZ4_Const::MIN_MATCH);
+        return (uimax)(l_compressed - (uint8*)out_compressed.Begin);
+    };
+
+    /*
+        Decompresses p_compressed into out_decompressed, that must be exactly the size of the source memory.
+        Returns 0 if p_compressed is not a valid block of this size. Nothing is read or written outside of the slices.
+    */
+    inline static int8 decompress(const Slice<int8>& p_compressed, const Slice<int8>& out_decompressed)
+    {
+        const uint8* l_compressed = (const uint8*)p_compressed.Begin;
+        const uint8* l_compressed_end = l_compressed + p_compressed.Size;
+        uint8* l_decompressed_begin = (uint8*)out_decompressed.Begin;
+        uint8* l_decompressed = l_decompressed_begin;
+        uint8* l_decompressed_end = l_decompressed_begin + out_decompressed.Size;
+
+        while (l_compressed < l_compressed_end)
+        {
+            uint8 l_token = *l_compressed;
+            l_compressed += 1;
+
+            uimax l_literal_length = l_token >> 4;
+            if (l_literal_length == 15 && !read_length(&l_compressed, l_compressed_end, &l_literal_length))
+            {
+                return 0;
+            }
+            if ((uimax)(l_compressed_end - l_compressed) < l_literal_length || (uimax)(l_decompressed_end - l_decompressed) < l_literal_length)
+            {
+                return 0;
+            }
+            memory_cpy((int8*)l_decompressed, (const int8*)l_compressed, l_literal_length);
+            l_compressed += l_literal_length;
+            l_decompressed += l_literal_length;
+
+            if (l_compressed == l_compressed_end)
+            {
+                break;
+            }
+
+            if ((l_compressed_end - l_compressed) < 2)
+            {
+                return 0;
+            }
+            uimax l_offset = (uimax)l_compressed[0] | ((uimax)l_compressed[1] << 8);
+            l_compressed += 2;
+            if (l_offset == 0 || l_offset > (uimax)(l_decompressed - l_decompressed_begin))
+            {
+                return 0;
+            }
+
+            uimax l_match_length = l_token & 15;
+            if (l_match_length == 15 && !read_length(&l_compressed, l_compressed_end, &l_match_length))
+            {
+                return 0;
+            }
+            l_match_length += LZ4_Const::MIN_MATCH;
+            if ((uimax)(l_decompressed_end - l_decompressed) < l_match_length)
+            {
+                return 0;
+            }
+
+            const uint8* l_match = l_decompressed - l_offset;
+            if (l_offset >= l_match_length)
+            {
+                memory_cpy((int8*)l_decompressed, (const int8*)l_match, l_match_length);
+            }
+            else
+            {
+                // The match overlaps the bytes it is writing, they are copied one by one to repeat the pattern
+                for (loop(i, 0, l_match_length))
+                {
+                    l_decompressed[i] = l_match[i];
+                }
+            }
+            l_decompressed += l_match_length;
+        }
+
+        return l_decompressed == l_decompressed_end;
+    };
+
+  private:
+    inline static uint32 read_uint32(const uint8* p_memory)
+    {
+        uint32 l_value;
+        memory_cpy((int8*)&l_value, (const int8*)p_memory, sizeof(uint32));
+        return l_value;
+    };
+
+    inline static uint32 hash(const uint32 p_sequence)
+    {
+        return (p_sequence * 2654435761U) >> (32 - LZ4_Const::HASH_LOG);
+    };
+
+    inline static uint8* write_length(uint8* p_compressed, uimax p_length)
+    {
+        p_length -= 15;
+        while (p_length >= 255)
+        {
+            *p_compressed = 255;
+            p_compressed += 1;
+            p_length -= 255;
+        }
+        *p_compressed = (uint8)p_length;
+        return p_compressed + 1;
+    };
+
+    // A p_offset of 0 writes the last sequence, that has no match
+    inline static uint8* write_sequence(uint8* p_compressed, const uint8* p_literals, const uimax p_literal_length, const uimax p_offset, const uimax p_match_length)
+    {
+        uimax l_match_length = p_match_length - LZ4_Const::MIN_MATCH;
+        uint8* l_token = p_compressed;
+        *l_token = (uint8)(((p_literal_length >= 15 ? 15 : p_literal_length) << 4) | (l_match_length >= 15 ? 15 : l_match_length));
+        p_compressed += 1;
+
+        if (p_literal_length >= 15)
+        {
+            p_compressed = write_length(p_compressed, p_literal_length);
+        }
+        memory_cpy((int8*)p_compressed, (const int8*)p_literals, p_literal_length);
+        p_compressed += p_literal_length;
+
+        if (p_offset != 0)
+        {
+            p_compressed[0] = (uint8)(p_offset & 0xFF);
+            p_compressed[1] = (uint8)(p_offset >> 8);
+            p_compressed += 2;
+            if (l_match_length >= 15)
+            {
+                p_compressed = write_length(p_compressed, l_match_length);
+            }
+        }
+        return p_compressed;
+    };
+
+    inline static int8 read_length(const uint8** in_out_compressed, const uint8* p_compressed_end, uimax* in_out_length)
+    {
+        uint8 l_byte;
+        do
+        {
+            if (*in_out_compressed >= p_compressed_end)
+            {
+                return 0;
+            }
+            l_byte = **in_out_compressed;
+            *in_out_compressed += 1;
+            *in_out_length += l_byte;
+        } while (l_byte == 255);
+        return 1;
+    };
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+    Sequentially consistent atomic operations.
+    They are the only way memory shared by multiple threads is read and written without a lock.
+*/
+
+#ifdef _WIN32
+
+inline int64 atomic_load(volatile int64* p_value)
+{
+    // On x64, aligned loads are not reordered with other loads, and stores are done with a locked instruction.
+    int64 l_value = *p_value;
+    _ReadWriteBarrier();
+    return l_value;
+};
+
+inline void atomic_store(volatile int64* p_value, const int64 p_new_value)
+{
+    InterlockedExchange64(p_value, p_new_value);
+};
+
+// Returns the value before the addition
+inline int64 atomic_fetch_add(volatile int64* p_value, const int64 p_added)
+{
+    return InterlockedExchangeAdd64(p_value, p_added);
+};
+
+inline int8 atomic_compare_exchange(volatile int64* p_value, const int64 p_expected, const int64 p_new_value)
+{
+    return InterlockedCompareExchange64(p_value, p_new_value, p_expected) == p_expected;
+};
+
+inline int8 atomic_compare_exchange_pointer(void* volatile* p_value, void* p_expected, void* p_new_value)
+{
+    return InterlockedCompareExchangePointer(p_value, p_new_value, p_expected) == p_expected;
+};
+
+#elif __linux__
+
+inline int64 atomic_load(volatile int64* p_value)
+{
+    return __atomic_load_n(p_value, __ATOMIC_SEQ_CST);
+};
+
+inline void atomic_store(volatile int64* p_value, const int64 p_new_value)
+{
+    __atomic_store_n(p_value, p_new_value, __ATOMIC_SEQ_CST);
+};
+
+// Returns the value before the addition
+inline int64 atomic_fetch_add(volatile int64* p_value, const int64 p_added)
+{
+    return __atomic_fetch_add(p_value, p_added, __ATOMIC_SEQ_CST);
+};
+
+inline int8 atomic_compare_exchange(volatile int64* p_value, const int64 p_expected, const int64 p_new_value)
+{
+    int64 l_expected = p_expected;
+    return __atomic_compare_exchange_n(p_value, &l_expected, p_new_value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+};
+
+inline int8 atomic_compare_exchange_pointer(void* volatile* p_value, void* p_expected, void* p_new_value)
+{
+    void* l_expected = p_expected;
+    return __atomic_compare_exchange_n(p_value, &l_expected, p_new_value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+};
+
+#endif
@@ -0,0 +1,421 @@
+#pragma once
+
+namespace JobSystem_const
+{
+constexpr uimax DEQUE_CAPACITY = 4096;
+// Number of times an idle worker looks for jobs before going to sleep
+constexpr uimax IDLE_SPIN_COUNT = 64;
+}; // namespace JobSystem_const
+
+/*
+    Number of jobs that have been scheduled with the counter and have not been executed yet.
+    Waiting for a counter is how a job depends on other jobs.
+*/
+struct JobCounter
+{
+    volatile int64 count;
+
+    inline static JobCounter build_default()
+    {
+        return JobCounter{0};
+    };
+
+    inline int8 is_done()
+    {
+        return atomic_load(&this->count) == 0;
+    };
+};
+
+/*
+    A job calls it's function with the [begin, end[ range it has been built with.
+    The counter is decremented once the function has returned.
+    Allocations of the job are charged to the MemoryTag of the thread that has built it.
+*/
+struct Job
+{
+    typedef void (*function_t)(void* p_data, const uimax p_begin, const uimax p_end);
+
+    function_t function;
+    void* data;
+    uimax begin;
+    uimax end;
+    JobCounter* counter;
+    MemoryTag memory_tag;
+
+    inline static Job build(const function_t p_function, void* p_data, JobCounter* p_counter)
+    {
+        return Job{p_function, p_data, 0, 0, p_counter, memory_tag_get()};
+    };
+
+    inline static Job build_range(const function_t p_function, void* p_data, const uimax p_begin, const uimax p_end, JobCounter* p_counter)
+    {
+        return Job{p_function, p_data, p_begin, p_end, p_counter, memory_tag_get()};
+    };
+
+    inline void execute()
+    {
+        MemoryTag l_previous_tag = memory_tag_set(this->memory_tag);
+        this->function(this->data, this->begin, this->end);
+        memory_tag_set(l_previous_tag);
+        atomic_fetch_add(&this->counter->count, -1);
+    };
+};
+
+/*
+    Work stealing deque (Chase-Lev) with a fixed capacity.
+    The worker that owns the deque pushes and pops jobs at the bottom, other workers steal them from the top.
+*/
+struct JobDeque
+{
+    Span<Job> jobs;
+    volatile int64 top;
+    volatile int64 bottom;
+
+    inline static JobDeque allocate(const uimax p_capacity)
+    {
+#if CONTAINER_BOUND_TEST
+        assert_true(p_capacity != 0 && (p_capacity & (p_capacity - 1)) == 0); // capacity must be a power of two
+#endif
+        return JobDeque{Span<Job>::allocate(p_capacity), 0, 0};
+    };
+
+    inline void free()
+    {
+        this->jobs.free();
+    };
+
+    inline int8 empty()
+    {
+        return atomic_load(&this->bottom) <= atomic_load(&this->top);
+    };
+
+    // Returns 0 if the deque is full
+    inline int8 push(const Job& p_job)
+    {
+        int64 l_bottom = atomic_load(&this->bottom);
+        int64 l_top = atomic_load(&this->top);
+        if ((uimax)(l_bottom - l_top) >= this->jobs.Capacity)
+        {
+            return 0;
+        }
+
+        this->jobs.get(l_bottom & (this->jobs.Capacity - 1)) = p_job;
+        atomic_store(&this->bottom, l_bottom + 1);
+        return 1;
+    };
+
+    inline int8 pop(Job* out_job)
+    {
+        int64 l_bottom = atomic_load(&this->bottom) - 1;
+        atomic_store(&this->bottom, l_bottom);
+        int64 l_top = atomic_load(&this->top);
+
+        if (l_top > l_bottom)
+        {
+            atomic_store(&this->bottom, l_bottom + 1);
+            return 0;
+        }
+
+        *out_job = this->jobs.get(l_bottom & (this->jobs.Capacity - 1));
+        if (l_top == l_bottom)
+        {
+            // Last job of the deque, a thief may be taking it at the same time
+            int8 l_won = atomic_compare_exchange(&this->top, l_top, l_top + 1);
+            atomic_store(&this->bottom, l_bottom + 1);
+            return l_won;
+        }
+
+        return 1;
+    };
+
+    inline int8 steal(Job* out_job)
+    {
+        int64 l_top = atomic_load(&this->top);
+        int64 l_bottom = atomic_load(&this->bottom);
+        if (l_top >= l_bottom)
+        {
+            return 0;
+        }
+
+        *out_job = this->jobs.get(l_top & (this->jobs.Capacity - 1));
+        return atomic_compare_exchange(&this->top, l_top, l_top + 1);
+    };
+};
+
+struct JobWorkerSync
+{
+    volatile int64 running;
+    volatile int64 sleeping_worker_count;
+    ThreadSemaphore wake;
+};
+
+/*
+    A thread of the JobSystem with it's own JobDeque.
+    When it's deque is empty, it steals jobs from the other workers. When no worker has jobs, it goes to sleep until a job is scheduled.
+*/
+struct JobWorker
+{
+    uimax index;
+    thread_t thread;
+    JobDeque deque;
+    uimax steal_seed;
+    Slice<JobWorker> workers;
+    JobWorkerSync* sync;
+
+    // Worker of the calling thread, NULL if the thread doesn't belong to a JobSystem
+    inline static JobWorker*& current()
+    {
+        static thread_local JobWorker* l_current_worker = NULL;
+        return l_current_worker;
+    };
+
+    inline int8 find_job(Job* out_job)
+    {
+        if (this->deque.pop(out_job))
+        {
+            return 1;
+        }
+
+        // Victims are visited from a different worker every time so that thieves don't all fight for the same deque
+        this->steal_seed = (this->steal_seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        uimax l_first_victim = (uimax)(this->steal_seed >> 33);
+        for (loop(i, 0, this->workers.Size))
+        {
+            JobWorker& l_victim = this->workers.get((l_first_victim + i) % this->workers.Size);
+            if (l_victim.index != this->index && l_victim.deque.steal(out_job))
+            {
+                return 1;
+            }
+        }
+
+        return 0;
+    };
+
+    inline void sleep()
+    {
+        atomic_fetch_add(&this->sync->sleeping_worker_count, 1);
+        // Jobs pushed before the sleeping count was visible have not notified the semaphore
+        if (atomic_load(&this->sync->running) && !this->has_jobs_to_steal())
+        {
+            this->sync->wake.wait();
+        }
+        atomic_fetch_add(&this->sync->sleeping_worker_count, -1);
+    };
+
+    inline static thread_return_t THREAD_CALL main(void* p_worker)
+    {
+        JobWorker* l_worker = (JobWorker*)p_worker;
+        JobWorker::current() = l_worker;
+
+        uimax l_idle_count = 0;
+        while (atomic_load(&l_worker->sync->running))
+        {
+            Job l_job;
+            if (l_worker->find_job(&l_job))
+            {
+                l_job.execute();
+                l_idle_count = 0;
+            }
+            else if (l_idle_count < JobSystem_const::IDLE_SPIN_COUNT)
+            {
+                l_idle_count += 1;
+                Thread::yield();
+            }
+            else
+            {
+                l_worker->sleep();
+                l_idle_count = 0;
+            }
+        }
+
+        JobWorker::current() = NULL;
+        ThreadArenas::free();
+        return 0;
+    };
+
+  private:
+    inline int8 has_jobs_to_steal()
+    {
+        for (loop(i, 0, this->workers.Size))
+        {
+            if (!this->workers.get(i).deque.empty())
+            {
+                return 1;
+            }
+        }
+        return 0;
+    };
+};
+
+/*
+    Fixed pool of worker threads executing scheduled jobs.
+    The thread that allocates the JobSystem is the worker 0, it doesn't have a thread of it's own and executes jobs only while it waits for a JobCounter.
+    Jobs can only be scheduled by threads of the JobSystem, that is the allocating thread or jobs.
+    Because waiting threads execute jobs instead of blocking, a job can schedule other jobs and wait for them.
+*/
+struct JobSystem
+{
+    Span<JobWorker> workers;
+    JobWorkerSync* sync;
+
+    // p_thread_count includes the calling thread
+    inline static JobSystem allocate(const uimax p_thread_count)
+    {
+#if CONTAINER_BOUND_TEST
+        assert_true(p_thread_count != 0);
+        assert_true(JobWorker::current() == NULL); // a thread can only belong to a single JobSystem
+#endif
+        JobSystem l_job_system;
+        l_job_system.workers = Span<JobWorker>::allocate(p_thread_count);
+        l_job_system.sync = (JobWorkerSync*)heap_malloc(sizeof(JobWorkerSync));
+        l_job_system.sync->running = 1;
+        l_job_system.sync->sleeping_worker_count = 0;
+        l_job_system.sync->wake = ThreadSemaphore::allocate();
+
+        for (loop(i, 0, p_thread_count))
+        {
+            JobWorker& l_worker = l_job_system.workers.get(i);
+            l_worker.index = i;
+            l_worker.deque = JobDeque::allocate(JobSystem_const::DEQUE_CAPACITY);
+            l_worker.steal_seed = i;
+            l_worker.workers = l_job_system.workers.slice;
+            l_worker.sync = l_job_system.sync;
+        }
+
+        l_job_system.workers.get(0).thread = Thread::get_current_thread();
+        JobWorker::current() = &l_job_system.workers.get(0);
+        for (loop(i, 1, p_thread_count))
+        {
+            JobWorker& l_worker = l_job_system.workers.get(i);
+            l_worker.thread = Thread::spawn(JobWorker::main, &l_worker);
+        }
+
+        return l_job_system;
+    };
+
+    inline static JobSystem allocate_default()
+    {
+        uimax l_processor_count = Thread::get_processor_count();
+        return allocate(l_processor_count == 0 ? 1 : l_processor_count);
+    };
+
+    inline void free()
+    {
+        atomic_store(&this->sync->running, 0);
+        this->sync->wake.notify(this->workers.Capacity);
+        for (loop(i, 1, this->workers.Capacity))
+        {
+            Thread::join(this->workers.get(i).thread);
+        }
+
+        for (loop(i, 0, this->workers.Capacity))
+        {
+#if CONTAINER_BOUND_TEST
+            assert_true(this->workers.get(i).deque.empty());
+#endif
+            this->workers.get(i).deque.free();
+        }
+        this->sync->wake.free();
+        heap_free((int8*)this->sync);
+        this->workers.free();
+        JobWorker::current() = NULL;
+    };
+
+    inline uimax get_thread_count()
+    {
+        return this->workers.Capacity;
+    };
+
+    // Index of the calling thread in [0, get_thread_count()[, it can be used to access per thread memory from jobs.
+    inline uimax get_current_thread_index()
+    {
+        return this->get_current_worker().index;
+    };
+
+    /*
+        The counter of the job is incremented before the job is pushed.
+        If the deque of the calling thread is full, the job is executed immediately.
+    */
+    inline void schedule(const Job& p_job)
+    {
+        JobWorker& l_worker = this->get_current_worker();
+        atomic_fetch_add(&p_job.counter->count, 1);
+        if (!l_worker.deque.push(p_job))
+        {
+            Job l_job = p_job;
+            l_job.execute();
+            return;
+        }
+
+        if (atomic_load(&this->sync->sleeping_worker_count) > 0)
+        {
+            this->sync->wake.notify(1);
+        }
+    };
+
+    // The calling thread executes jobs until the counter reaches 0
+    inline void wait(JobCounter& p_counter)
+    {
+        JobWorker& l_worker = this->get_current_worker();
+        while (!p_counter.is_done())
+        {
+            Job l_job;
+            if (l_worker.find_job(&l_job))
+            {
+                l_job.execute();
+            }
+            else
+            {
+                Thread::yield();
+            }
+        }
+    };
+
+    /*
+        Calls p_function(index, element) for every element of p_slice and returns once they have all been processed.
+        Elements are split in jobs of p_chunk_size elements, the calling thread processes chunks while it waits.
+    */
+    template <class ElementType, class Function> inline void parallel_for(const Slice<ElementType>& p_slice, const uimax p_chunk_size, const Function& p_function)
+    {
+#if CONTAINER_BOUND_TEST
+        assert_true(p_chunk_size != 0);
+#endif
+        struct ParallelFor
+        {
+            ElementType* elements;
+            const Function* function;
+
+            inline static void execute(void* p_data, const uimax p_begin, const uimax p_end)
+            {
+                ParallelFor* thiz = (ParallelFor*)p_data;
+                for (loop(i, p_begin, p_end))
+                {
+                    (*thiz->function)(i, thiz->elements[i]);
+                }
+            };
+        };
+
+        ParallelFor l_parallel_for = ParallelFor{p_slice.Begin, &p_function};
+        JobCounter l_counter = JobCounter::build_default();
+        for (uimax l_begin = 0; l_begin < p_slice.Size; l_begin += p_chunk_size)
+        {
+            uimax l_end = l_begin + p_chunk_size;
+            if (l_end > p_slice.Size)
+            {
+                l_end = p_slice.Size;
+            }
+            this->schedule(Job::build_range(ParallelFor::execute, &l_parallel_for, l_begin, l_end, &l_counter));
+        }
+        this->wait(l_counter);
+    };
+
+  private:
+    inline JobWorker& get_current_worker()
+    {
+        JobWorker* l_worker = JobWorker::current();
+#if CONTAINER_BOUND_TEST
+        assert_true(l_worker != NULL && l_worker->sync == this->sync); // the calling thread doesn't belong to the JobSystem
+#endif
+        return *l_worker;
+    };
+};
@@ -8,10 +8,68 @@ using thread_t
 #endif // _WIN32
     ;
 
+using thread_return_t
+#ifdef _WIN32
+    = DWORD
+#elif __linux__
+    = void*
+#endif // _WIN32
+    ;
+
+#ifdef _WIN32
+#define THREAD_CALL WINAPI
+#elif __linux__
+#define THREAD_CALL
+#endif
+
+typedef thread_return_t(THREAD_CALL* thread_main_t)(void* p_parameter);
+
 struct Thread
 {
     static thread_t get_current_thread();
     static void wait(const uimax p_time_in_ms);
+    static void yield();
+    static uimax get_processor_count();
+
+    // p_parameter must outlive the thread
+    static thread_t spawn(const thread_main_t p_main, void* p_parameter);
+    static void join(const thread_t p_thread);
+};
+
+/*
+    Counting semaphore used to put threads to sleep until they are notified.
+*/
+struct ThreadSemaphore
+{
+#ifdef _WIN32
+    HANDLE handle;
+#elif __linux__
+    sem_t* handle;
+#endif
+
+    static ThreadSemaphore allocate();
+    void free();
+
+    void notify(const uimax p_count);
+    void wait();
+};
+
+/*
+    Mutual exclusion lock protecting data that is read and written by multiple threads.
+*/
+struct ThreadMutex
+{
+#ifdef _WIN32
+    CRITICAL_SECTION* handle;
+#elif __linux__
+    pthread_mutex_t* handle;
+#endif
+
+    static ThreadMutex allocate();
+    void free();
+
+    void lock();
+    void unlock();
 };
 
 #ifdef _WIN32
@@ -26,11 +84,161 @@ inline void Thread::wait(const uimax p_time_in_ms)
     WaitForSingleObject(get_current_thread(), (DWORD)p_time_in_ms);
 };
 
+inline void Thread::yield()
+{
+    SwitchToThread();
+};
+
+inline uimax Thread::get_processor_count()
+{
+    SYSTEM_INFO l_system_info;
+    GetSystemInfo(&l_system_info);
+    return (uimax)l_system_info.dwNumberOfProcessors;
+};
+
+inline thread_t Thread::spawn(const thread_main_t p_main, void* p_parameter)
+{
+    return CreateThread(NULL, 0, p_main, p_parameter, 0, NULL);
+};
+
+inline void Thread::join(const thread_t p_thread)
+{
+    WaitForSingleObject(p_thread, INFINITE);
+    CloseHandle(p_thread);
+};
+
+inline ThreadSemaphore ThreadSemaphore::allocate()
+{
+    return ThreadSemaphore{CreateSemaphore(NULL, 0, LONG_MAX, NULL)};
+};
+
+inline void ThreadSemaphore::free()
+{
+    CloseHandle(this->handle);
+};
+
+inline void ThreadSemaphore::notify(const uimax p_count)
+{
+    ReleaseSemaphore(this->handle, (LONG)p_count, NULL);
+};
+
+inline void ThreadSemaphore::wait()
+{
+    WaitForSingleObject(this->handle, INFINITE);
+};
+
+inline ThreadMutex ThreadMutex::allocate()
+{
+    // The critical section is not stored inline because it must not be moved once initialized
+    ThreadMutex l_mutex;
+    l_mutex.handle = (CRITICAL_SECTION*)::malloc(sizeof(CRITICAL_SECTION));
+    InitializeCriticalSection(l_mutex.handle);
+    return l_mutex;
+};
+
+inline void ThreadMutex::free()
+{
+    DeleteCriticalSection(this->handle);
+    ::free(this->handle);
+};
+
+inline void ThreadMutex::lock()
+{
+    EnterCriticalSection(this->handle);
+};
+
+inline void ThreadMutex::unlock()
+{
+    LeaveCriticalSection(this->handle);
+};
+
 #elif __linux__
 
+inline thread_t Thread::get_current_thread()
+{
+    return pthread_self();
+};
+
 inline void Thread::wait(const uimax p_time_in_ms)
 {
     usleep(p_time_in_ms * 1000);
 };
 
-#endif
\ No newline at end of file
+inline void Thread::yield()
+{
+    sched_yield();
+};
+
+inline uimax Thread::get_processor_count()
+{
+    return (uimax)sysconf(_SC_NPROCESSORS_ONLN);
+};
+
+inline thread_t Thread::spawn(const thread_main_t p_main, void* p_parameter)
+{
+    pthread_t l_thread;
+    pthread_create(&l_thread, NULL, p_main, p_parameter);
+    return l_thread;
+};
+
+inline void Thread::join(const thread_t p_thread)
+{
+    pthread_join(p_thread, NULL);
+};
+
+inline ThreadSemaphore ThreadSemaphore::allocate()
+{
+    // The semaphore is not stored inline because sem_t must not be moved once initialized
+    ThreadSemaphore l_semaphore;
+    l_semaphore.handle = (sem_t*)::malloc(sizeof(sem_t));
+    sem_init(l_semaphore.handle, 0, 0);
+    return l_semaphore;
+};
+
+inline void ThreadSemaphore::free()
+{
+    sem_destroy(this->handle);
+    ::free(this->handle);
+};
+
+inline void ThreadSemaphore::notify(const uimax p_count)
+{
+    for (loop(i, 0, p_count))
+    {
+        sem_post(this->handle);
+    }
+};
+
+inline void ThreadSemaphore::wait()
+{
+    while (sem_wait(this->handle) != 0)
+    {
+    }
+};
+
+inline ThreadMutex ThreadMutex::allocate()
+{
+    // The mutex is not stored inline because pthread_mutex_t must not be moved once initialized
+    ThreadMutex l_mutex;
+    l_mutex.handle = (pthread_mutex_t*)::malloc(sizeof(pthread_mutex_t));
+    pthread_mutex_init(l_mutex.handle, NULL);
+    return l_mutex;
+};
+
+inline void ThreadMutex::free()
+{
+    pthread_mutex_destroy(this->handle);
+    ::free(this->handle);
+};
+
+inline void ThreadMutex::lock()
+{
+    pthread_mutex_lock(this->handle);
+};
+
+inline void ThreadMutex::unlock()
+{
+    pthread_mutex_unlock(this->handle);
+};
+
+#endif
@@ -16,15 +16,18 @@
 
 #include "./Clock/clock.hpp"
 #include "./Thread/thread.hpp"
+#include "./Thread/atomic.hpp"
 
 #include "./Functional/assert.hpp"
 
 #include "./Memory/token.hpp"
 #include "./Memory/memory.hpp"
+#include "./Memory/arena.hpp"
 #include "./Memory/slice.hpp"
 #include "./Memory/span.hpp"
 
 #include "./Functional/hash.hpp"
+#include "./Functional/bit.hpp"
 
 #include "./Functional/sort.hpp"
 
@@ -45,12 +48,15 @@
 
 #include "./Container/Specialization/heap_memory.hpp"
 
+#include "./Thread/job.hpp"
+
 #include "./Functional/string_functions.hpp"
 
 #include "./File/file.hpp"
 
 #include "./Serialization/json.hpp"
 #include "./Serialization/binary.hpp"
+#include "./Serialization/lz4.hpp"
 #include "./Serialization/types.hpp"
 
 #include "./Database/database.hpp"
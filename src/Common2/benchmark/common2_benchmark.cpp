@@ -0,0 +1,214 @@
+#include "Common2/common2.hpp"
+#include "test_random.hpp"
+
+/*
+    Heap allocation throughput and fragmentation.
+    The heap is filled with a number of live chunks, then chunks are randomly released and allocated again.
+    The time per allocation/release pair must not depend on the number of live chunks.
+    Fragmentation is measured as the ratio of heap size to live bytes and the share of free memory held by the largest free chunk.
+*/
+
+const uimax common2_benchmark_churn_count = 200000;
+
+inline uimax common2_benchmark_random(uint32* in_out_seed)
+{
+    return (test_random_next(in_out_seed) >> 8) & 0xFFFFFF;
+};
+
+// Sizes are mostly small with a few large chunks, like the buffers of a scene
+inline uimax common2_benchmark_random_size(uint32* in_out_seed)
+{
+    uimax l_random = common2_benchmark_random(in_out_seed);
+    if ((l_random % 16) == 0)
+    {
+        return ((l_random >> 4) % 65536) + 4096;
+    }
+    return ((l_random >> 4) % 4096) + 16;
+};
+
+inline uimax common2_benchmark_largest_free_chunk(HeapTLSF& p_chunks)
+{
+    uimax l_largest_free_chunk = 0;
+    for (loop(i, 0, p_chunks.blocks.get_size()))
+    {
+        if (!p_chunks.blocks.is_element_free(tk_b(HeapTLSF::Block, i)))
+        {
+            HeapTLSF::Block& l_block = p_chunks.blocks.get(tk_b(HeapTLSF::Block, i));
+            if (l_block.is_free && l_block.chunk.Size > l_largest_free_chunk)
+            {
+                l_largest_free_chunk = l_block.chunk.Size;
+            }
+        }
+    }
+    return l_largest_free_chunk;
+};
+
+inline void common2_benchmark_heap(const uimax p_live_count, const uimax p_modulo_offset)
+{
+    Heap l_heap = Heap::allocate(0);
+    Vector<Token(SliceIndex)> l_chunks = Vector<Token(SliceIndex)>::allocate(p_live_count);
+    uint32 l_seed = 4242;
+    uimax l_live_size = 0;
+
+    for (loop(i, 0, p_live_count))
+    {
+        HeapA::AllocatedElementReturn l_chunk;
+        uimax l_size = common2_benchmark_random_size(&l_seed);
+        l_heap.allocate_element_with_modulo_offset(l_size, p_modulo_offset, &l_chunk);
+        l_chunks.push_back_element(l_chunk.token);
+        l_live_size += l_size;
+    }
+
+    time_t l_begin = clock_currenttime_mics();
+    for (loop(i, 0, common2_benchmark_churn_count))
+    {
+        uimax l_index = common2_benchmark_random(&l_seed) % p_live_count;
+        l_live_size -= l_heap.get(l_chunks.get(l_index))->Size;
+        l_heap.release_element(l_chunks.get(l_index));
+
+        HeapA::AllocatedElementReturn l_chunk;
+        uimax l_size = common2_benchmark_random_size(&l_seed);
+        l_heap.allocate_element_with_modulo_offset(l_size, p_modulo_offset, &l_chunk);
+        l_chunks.get(l_index) = l_chunk.token;
+        l_live_size += l_size;
+    }
+    float64 l_time = (float64)(clock_currenttime_mics() - l_begin);
+
+    uimax l_free_size = l_heap.Chunks.free_size;
+    printf("heap live chunks: %6lld, modulo: %4lld | %7.1f ns per allocate/release | heap size / live size: %.3f | largest free chunk / free size: %.3f\n", (long long)p_live_count,
+           (long long)p_modulo_offset, (l_time * 1000.0) / (float64)common2_benchmark_churn_count, (float64)l_heap.Size / (float64)l_live_size,
+           l_free_size == 0 ? 1.0 : (float64)common2_benchmark_largest_free_chunk(l_heap.Chunks) / (float64)l_free_size);
+
+    l_chunks.free();
+    l_heap.free();
+};
+
+// Same as the GPU memory allocator : 16MB pages and chunks aligned to 256 bytes
+inline void common2_benchmark_heap_paged(const uimax p_live_count)
+{
+    const uimax l_page_size = 16000000;
+    const uimax l_modulo_offset = 256;
+    HeapPaged l_heap_paged = HeapPaged::allocate_default(l_page_size);
+    Vector<HeapPagedToken> l_chunks = Vector<HeapPagedToken>::allocate(p_live_count);
+    uint32 l_seed = 2424;
+
+    for (loop(i, 0, p_live_count))
+    {
+        HeapPaged::AllocatedElementReturn l_chunk;
+        l_heap_paged.allocate_element_norealloc_with_modulo_offset(common2_benchmark_random_size(&l_seed), l_modulo_offset, &l_chunk);
+        l_chunks.push_back_element(l_chunk.token);
+    }
+
+    time_t l_begin = clock_currenttime_mics();
+    for (loop(i, 0, common2_benchmark_churn_count))
+    {
+        uimax l_index = common2_benchmark_random(&l_seed) % p_live_count;
+        l_heap_paged.release_element(l_chunks.get(l_index));
+
+        HeapPaged::AllocatedElementReturn l_chunk;
+        l_heap_paged.allocate_element_norealloc_with_modulo_offset(common2_benchmark_random_size(&l_seed), l_modulo_offset, &l_chunk);
+        l_chunks.get(l_index) = l_chunk.token;
+    }
+    float64 l_time = (float64)(clock_currenttime_mics() - l_begin);
+
+    printf("heap paged live chunks: %6lld | %7.1f ns per allocate/release | page count: %lld\n", (long long)p_live_count, (l_time * 1000.0) / (float64)common2_benchmark_churn_count,
+           (long long)l_heap_paged.get_page_count());
+
+    l_chunks.free();
+    l_heap_paged.free();
+};
+
+/*
+    Sort time of 1M elements slices, with random 64 bits keys and with keys that have a lot of duplicates.
+*/
+
+const uimax common2_benchmark_sort_element_count = 1000000;
+
+struct Common2BenchmarkSortElement
+{
+    hash_t key;
+    uimax value;
+};
+
+struct Common2BenchmarkSortElementByKey
+{
+    inline int8 operator()(const Common2BenchmarkSortElement& p_left, const Common2BenchmarkSortElement& p_right) const
+    {
+        return p_left.key > p_right.key;
+    };
+};
+
+inline hash_t common2_benchmark_sort_element_key(const Common2BenchmarkSortElement& p_element)
+{
+    return p_element.key;
+};
+
+inline void common2_benchmark_sort_print(const int8* p_name, const time_t p_begin, const Slice<Common2BenchmarkSortElement>& p_elements)
+{
+    float64 l_time = (float64)(clock_currenttime_mics() - p_begin) / 1000.0;
+    int8 l_sorted = 1;
+    for (loop(i, 1, p_elements.Size))
+    {
+        l_sorted &= p_elements.get(i - 1).key <= p_elements.get(i).key;
+    }
+    printf("    %-6s: %8.2f ms%s\n", p_name, l_time, l_sorted ? "" : " NOT SORTED");
+};
+
+inline void common2_benchmark_sort(const int8* p_name, const uimax p_key_modulo)
+{
+    Span<Common2BenchmarkSortElement> l_source = Span<Common2BenchmarkSortElement>::allocate(common2_benchmark_sort_element_count);
+    Span<Common2BenchmarkSortElement> l_elements = Span<Common2BenchmarkSortElement>::allocate(common2_benchmark_sort_element_count);
+    Span<Common2BenchmarkSortElement> l_scratch = Span<Common2BenchmarkSortElement>::allocate(common2_benchmark_sort_element_count);
+    uint32 l_seed = 1337;
+    for (loop(i, 0, l_source.Capacity))
+    {
+        hash_t l_key = ((hash_t)common2_benchmark_random(&l_seed) << 40) ^ ((hash_t)common2_benchmark_random(&l_seed) << 20) ^ (hash_t)common2_benchmark_random(&l_seed);
+        l_source.get(i) = Common2BenchmarkSortElement{l_key % p_key_modulo, i};
+    }
+
+    printf("sort %lld elements, %s keys\n", (long long)common2_benchmark_sort_element_count, p_name);
+
+    l_elements.slice.copy_memory(l_source.slice);
+    time_t l_begin = clock_currenttime_mics();
+    Sort::Heap(l_elements.slice, Common2BenchmarkSortElementByKey{});
+    common2_benchmark_sort_print("heap", l_begin, l_elements.slice);
+
+    l_elements.slice.copy_memory(l_source.slice);
+    l_begin = clock_currenttime_mics();
+    Sort::Intro(l_elements.slice, Common2BenchmarkSortElementByKey{});
+    common2_benchmark_sort_print("intro", l_begin, l_elements.slice);
+
+    l_elements.slice.copy_memory(l_source.slice);
+    l_begin = clock_currenttime_mics();
+    Sort::Merge(l_elements.slice, l_scratch.slice, Common2BenchmarkSortElementByKey{});
+    common2_benchmark_sort_print("merge", l_begin, l_elements.slice);
+
+    l_elements.slice.copy_memory(l_source.slice);
+    l_begin = clock_currenttime_mics();
+    Sort::Radix(l_elements.slice, l_scratch.slice, common2_benchmark_sort_element_key);
+    common2_benchmark_sort_print("radix", l_begin, l_elements.slice);
+
+    l_scratch.free();
+    l_elements.free();
+    l_source.free();
+};
+
+int main()
+{
+    uimax l_live_counts[3] = {1000, 10000, 50000};
+    for (loop(i, 0, 3))
+    {
+        common2_benchmark_heap(l_live_counts[i], 1);
+        common2_benchmark_heap(l_live_counts[i], 256);
+    }
+    for (loop(i, 0, 3))
+    {
+        common2_benchmark_heap_paged(l_live_counts[i]);
+    }
+
+    common2_benchmark_sort("random", (hash_t)-1);
+    common2_benchmark_sort("1000 distinct", 1000);
+
+    memleak_ckeck();
+    return 0;
+};
@@ -1,5 +1,6 @@
 
 #include "Common2/common2.hpp"
+#include "test_random.hpp"
 
 template <class ElementType> inline void assert_span_unitialized(Span<ElementType>* p_span)
 {
@@ -228,13 +229,15 @@ HashMap<Key, uimax> l_map = HashMap<Key, uimax>::allocate(2);
 l_map.push_key_value_nothashed(Key{0, 0, 0}, 0);
 l_map.push_key_value_nothashed(Key{0, 0, 1}, 1);
 
-assert_true(l_map.get_capacity() == 2);
+assert_true(l_map.get_capacity() == 8);
+assert_true(l_map.get_size() == 2);
 assert_true(*l_map.get_value_nothashed(Key{0, 0, 0}) == 0);
 assert_true(*l_map.get_value_nothashed(Key{0, 0, 1}) == 1);
 
 l_map.push_key_value_nothashed(Key{0, 1, 1}, 2);
 
-assert_true(l_map.get_capacity() == 4);
+assert_true(l_map.get_capacity() == 8);
+assert_true(l_map.get_size() == 3);
 assert_true(*l_map.get_value_nothashed(Key{0, 0, 0}) == 0);
 assert_true(*l_map.get_value_nothashed(Key{0, 0, 1}) == 1);
 assert_true(*l_map.get_value_nothashed(Key{0, 1, 1}) == 2);
@@ -257,12 +260,13 @@ l_map.free();
     l_map.push_key_value_nothashed(1, 0);
     l_map.push_key_value_nothashed(0, 1);
 
-    assert_true(l_map.get_capacity() == 2);
+    assert_true(l_map.get_capacity() == 8);
     assert_true(*l_map.get_value_nothashed(1) == 0);
     assert_true(*l_map.get_value_nothashed(0) == 1);
 
     l_map.push_key_value_nothashed(12, 2);
 
+    // keys colliding on the same slot modulo don't grow the map
     assert_true(l_map.get_capacity() == 8);
 
     assert_true(*l_map.get_value_nothashed(1) == 0);
@@ -280,6 +284,85 @@ l_map.free();
 
     l_map.free();
 }
+
+// growth and tombstones
+{
+    HashMap<hash_t, uimax> l_map = HashMap<hash_t, uimax>::allocate_default();
+
+    const uimax l_key_count = 1000;
+    for (loop(i, 0, l_key_count))
+    {
+        l_map.push_key_value_nothashed(i * 8, i);
+    }
+
+    assert_true(l_map.get_size() == l_key_count);
+    assert_true(l_map.get_capacity() == 2048);
+    for (loop(i, 0, l_key_count))
+    {
+        assert_true(*l_map.get_value_nothashed(i * 8) == i);
+    }
+
+    for (loop(i, 0, l_key_count))
+    {
+        if (i % 2 == 0)
+        {
+            l_map.erase_key_nothashed(i * 8);
+        }
+    }
+
+    assert_true(l_map.get_size() == l_key_count / 2);
+    for (loop(i, 0, l_key_count))
+    {
+        assert_true(l_map.has_key_nothashed(i * 8) == (i % 2 != 0));
+    }
+
+    // erasing and pushing keys repeatedly reuses tombstones instead of growing
+    for (loop(j, 0, 10))
+    {
+        for (loop(i, 0, l_key_count))
+        {
+            if (i % 2 == 0)
+            {
+                l_map.push_key_value_nothashed(i * 8, i + j);
+            }
+        }
+        for (loop(i, 0, l_key_count))
+        {
+            if (i % 2 == 0)
+            {
+                assert_true(*l_map.get_value_nothashed(i * 8) == i + j);
+                l_map.erase_key_nothashed(i * 8);
+            }
+        }
+    }
+
+    assert_true(l_map.get_capacity() == 2048);
+    assert_true(l_map.get_size() == l_key_count / 2);
+
+    // foreach only visits the remaining keys
+    {
+        uimax l_visited_count = 0;
+        l_map.foreach ([&](const uimax p_key, uimax& p_value) {
+            assert_true(p_key == p_value * 8);
+            assert_true(p_value % 2 != 0);
+            l_visited_count += 1;
+        });
+        assert_true(l_visited_count == l_key_count / 2);
+    }
+
+    for (loop(i, 0, l_key_count))
+    {
+        if (i % 2 != 0)
+        {
+            assert_true(*l_map.get_value_nothashed(i * 8) == i);
+            l_map.erase_key_nothashed(i * 8);
+        }
+    }
+
+    assert_true(l_map.empty());
+
+    l_map.free();
+}
 }
 ;
 
@@ -337,6 +420,100 @@ inline void pool_test()
         assert_true(l_pool_sizet.get_capacity() == 0);
         assert_true(l_pool_sizet.get_memory() == 0);
     }
+
+    // foreach skips free slots, elements can be released while iterating
+    {
+        Pool<uimax> l_pool = Pool<uimax>::allocate(0);
+        for (loop(i, 0, 200))
+        {
+            l_pool.alloc_element(i);
+        }
+        uimax l_allocated_count = 0;
+        for (loop(i, 0, 200))
+        {
+            if ((i % 3) == 0 || (i >= 64 && i < 128))
+            {
+                l_pool.release_element(tk_b(uimax, i));
+            }
+            else
+            {
+                l_allocated_count += 1;
+            }
+        }
+
+        uimax l_count = 0;
+        uimax l_released_count = 0;
+        l_pool.foreach([&](const Token(uimax) p_token, uimax& p_element) {
+            assert_true(tk_v(p_token) == p_element);
+            assert_true(!l_pool.is_element_free(p_token));
+            l_count += 1;
+            if ((p_element % 3) == 1)
+            {
+                l_pool.release_element(p_token);
+                l_released_count += 1;
+            }
+        });
+        assert_true(l_count == l_allocated_count);
+
+        l_count = 0;
+        l_pool.foreach([&](const Token(uimax) p_token, uimax& p_element) {
+            assert_true((p_element % 3) == 2);
+            l_count += 1;
+        });
+        assert_true(l_count == (l_allocated_count - l_released_count));
+        l_pool.free();
+    }
+
+    // Bound checked access stays O(1) with a lot of free slots
+    {
+        Pool<uimax> l_pool = Pool<uimax>::allocate(0);
+        for (loop(i, 0, 100000))
+        {
+            l_pool.alloc_element(i);
+        }
+        for (loop(i, 0, 100000))
+        {
+            if ((i % 2) == 0)
+            {
+                l_pool.release_element(tk_b(uimax, i));
+            }
+        }
+        for (loop(i, 0, 100000))
+        {
+            if ((i % 2) == 1)
+            {
+                assert_true(l_pool.get(tk_b(uimax, i)) == i);
+            }
+        }
+        l_pool.free();
+    }
+
+    // Tokens of generation checked pools are invalidated when their element is released, even if the slot is reused
+    {
+        Pool<uimax, 1> l_pool = Pool<uimax, 1>::allocate(0);
+        Token(uimax) l_first = l_pool.alloc_element(1);
+        assert_true(Pool<uimax, 1>::get_index(l_first) == 0);
+        assert_true(l_pool.is_token_valid(l_first));
+
+        l_pool.release_element(l_first);
+        assert_true(!l_pool.is_token_valid(l_first));
+
+        Token(uimax) l_second = l_pool.alloc_element(2);
+        assert_true(Pool<uimax, 1>::get_index(l_second) == 0);
+        assert_true(tk_neq(l_first, l_second));
+        assert_true(l_pool.is_token_valid(l_second));
+        assert_true(!l_pool.is_token_valid(l_first));
+        assert_true(l_pool.get(l_second) == 2);
+
+        uimax l_count = 0;
+        l_pool.foreach([&](const Token(uimax) p_token, uimax& p_element) {
+            assert_true(tk_eq(p_token, l_second));
+            l_count += 1;
+        });
+        assert_true(l_count == 1);
+
+        l_pool.free();
+    }
 };
 
 inline void varyingslice_test()
@@ -969,46 +1146,242 @@ inline void ntree_test()
     l_uimax_tree.free();
 };
 
-inline void assert_heap_integrity(Heap* p_heap)
+inline void memory_arena_test()
 {
-    uimax l_calculated_size = 0;
-    for (loop(i, 0, p_heap->AllocatedChunks.get_size()))
+    // Allocations are aligned and the last allocation is reallocated in place
     {
-        // Token(SliceIndex)* l_chunk = ;
-        if (!p_heap->AllocatedChunks.is_element_free(Token(SliceIndex){i}))
+        MemoryArena l_arena = MemoryArena::allocate(1000);
+        int8* l_first = l_arena.allocate_memory(3);
+        int8* l_second = l_arena.allocate_memory(10);
+        assert_true(l_second == (l_first + MemoryArena_Const::ALIGNMENT));
+        assert_true(((uimax)l_second % MemoryArena_Const::ALIGNMENT) == 0);
+
+        l_second[0] = 5;
+        assert_true(l_arena.reallocate_memory(l_second, 10, 500) == l_second);
+        int8* l_first_reallocated = l_arena.reallocate_memory(l_first, 3, 20);
+        assert_true(l_first_reallocated != l_first);
+        assert_true(l_arena.allocation_count == 2);
+
+        // Freeing the last allocation gives it's memory back
+        l_arena.free_memory(l_first_reallocated, 20);
+        assert_true(l_arena.allocate_memory(20) == l_first_reallocated);
+
+        // When the block is full, a new one is chained and the reallocated memory is copied
+        int8* l_moved = l_arena.reallocate_memory(l_second, 500, 2000);
+        assert_true(l_moved != l_second);
+        assert_true(l_moved[0] == 5);
+        assert_true(l_arena.get_block_count() == 2);
+
+        l_arena.free();
+        assert_true(l_arena.get_block_count() == 0);
+    }
+
+    // Rewinding to a Mark releases the allocations done after it, blocks are merged on reset
+    {
+        MemoryArena l_arena = MemoryArena::allocate(100);
+        int8* l_kept = l_arena.allocate_memory(50);
+        MemoryArena::Mark l_mark = l_arena.get_mark();
+        for (loop(i, 0, 10))
         {
-            l_calculated_size += p_heap->AllocatedChunks.get(Token(SliceIndex){i}).Size;
-        };
+            l_arena.allocate_memory(60);
+        }
+        assert_true(l_arena.get_block_count() == 11);
+        l_arena.rewind(l_mark);
+        assert_true(l_arena.get_block_count() == 1);
+        assert_true(l_arena.allocation_count == 1);
+        assert_true(l_arena.allocate_memory(30) == (l_kept + 64));
+
+        for (loop(i, 0, 10))
+        {
+            l_arena.allocate_memory(60);
+        }
+        l_arena.reset();
+        assert_true(l_arena.get_block_count() == 1);
+        assert_true(l_arena.current_block->capacity >= 1000);
+        for (loop(i, 0, 10))
+        {
+            l_arena.allocate_memory(60);
+        }
+        assert_true(l_arena.get_block_count() == 1);
+
+        l_arena.free();
+    }
+
+    // Freeing every allocation resets the arena
+    {
+        MemoryArena l_arena = MemoryArena::allocate(100);
+        int8* l_first = l_arena.allocate_memory(10);
+        int8* l_second = l_arena.allocate_memory(10);
+        l_arena.free_memory(l_first, 10);
+        assert_true(l_arena.cursor != 0);
+        l_arena.free_memory(l_second, 10);
+        assert_true(l_arena.cursor == 0);
+        assert_true(l_arena.allocation_count == 0);
+        l_arena.free();
+    }
+
+    // Vector and Span allocated from the scratch arena
+    {
+        MemoryArena::Mark l_mark = ThreadArenas::scratch().get_mark();
+
+        Vector<uimax, ScratchAllocator> l_vector = Vector<uimax, ScratchAllocator>::allocate(0);
+        for (loop(i, 0, 1000))
+        {
+            l_vector.push_back_element(i);
+        }
+        Span<uimax, ScratchAllocator> l_span = Span<uimax, ScratchAllocator>::allocate_slice(l_vector.to_slice());
+        assert_true(l_span.slice.compare(l_vector.to_slice()));
+
+        // The vector has always been the last allocation, it has grown in place
+        assert_true(ThreadArenas::scratch().allocation_count == (l_mark.allocation_count + 2));
+        assert_true(ThreadArenas::scratch().get_block_count() == 1);
+
+        l_span.free();
+        l_vector.free();
+        assert_true(ThreadArenas::scratch().allocation_count == l_mark.allocation_count);
+
+        Span<uimax, ScratchAllocator>::allocate(10);
+        ThreadArenas::scratch().rewind(l_mark);
+        assert_true(ThreadArenas::scratch().allocation_count == l_mark.allocation_count);
     }
 
-    for (loop(i, 0, p_heap->FreeChunks.Size))
+    // Vectors filled every frame from the frame arena, the arena stops growing once it has reached the frame peak usage
     {
-        l_calculated_size += p_heap->FreeChunks.get(i).Size;
+        for (loop(l_frame, 0, 4))
+        {
+            Vector<uimax, FrameAllocator> l_events = Vector<uimax, FrameAllocator>::build_zero_size(NULL, 0);
+            Vector<uimax, FrameAllocator> l_other_events = Vector<uimax, FrameAllocator>::build_zero_size(NULL, 0);
+            for (loop(i, 0, 100000))
+            {
+                l_events.push_back_element(i);
+                l_other_events.push_back_element(i);
+            }
+            assert_true(l_events.get(99999) == 99999);
+            if (l_frame > 0)
+            {
+                assert_true(ThreadArenas::frame().get_block_count() == 1);
+            }
+            l_other_events.free();
+            l_events.free();
+            ThreadArenas::frame().reset();
+        }
+        assert_true(ThreadArenas::frame().allocation_count == 0);
     }
+};
 
-    assert_true(l_calculated_size == p_heap->Size);
+inline void memory_statistics_test()
+{
+#if MEM_TRACKING
+    memory_statistics_end_frame();
+    MemoryTagStatistics l_scene_before = memory_statistics_get_frame(MemoryTag::SCENE);
+    MemoryTagStatistics l_collision_before = memory_statistics_get_frame(MemoryTag::COLLISION);
+
+    // Allocations are charged to the tag of the thread, reallocated memory keeps it's tag
+    MemoryTag l_previous_tag = memory_tag_set(MemoryTag::SCENE);
+    int8* l_scene_memory = heap_malloc(100);
+    int8* l_freed_memory = heap_malloc(1000);
+    memory_tag_set(MemoryTag::COLLISION);
+    l_scene_memory = heap_realloc(l_scene_memory, 200);
+    int8* l_collision_memory = heap_calloc(50);
+    heap_free(l_freed_memory);
+    memory_tag_set(l_previous_tag);
+    assert_true(memory_tag_get() == l_previous_tag);
+
+    memory_statistics_end_frame();
+    MemoryTagStatistics l_scene = memory_statistics_get_frame(MemoryTag::SCENE);
+    MemoryTagStatistics l_collision = memory_statistics_get_frame(MemoryTag::COLLISION);
+    assert_true(l_scene.live_size == (l_scene_before.live_size + 200));
+    assert_true(l_scene.live_count == (l_scene_before.live_count + 1));
+    assert_true(l_scene.frame_allocation_count == 3);
+    assert_true(l_scene.frame_allocated_size == 1300);
+    assert_true(l_scene.frame_peak_size >= (l_scene_before.live_size + 1100));
+    assert_true(l_collision.live_size == (l_collision_before.live_size + 50));
+    assert_true(l_collision.frame_allocation_count == 1);
+
+    // Frame counters are reset at the end of the frame
+    heap_free(l_scene_memory);
+    heap_free(l_collision_memory);
+    memory_statistics_end_frame();
+    l_scene = memory_statistics_get_frame(MemoryTag::SCENE);
+    assert_true(l_scene.live_size == l_scene_before.live_size);
+    assert_true(l_scene.frame_allocation_count == 0);
+    assert_true(l_scene.peak_size >= (l_scene_before.live_size + 1100));
+
+    // Memory that is not on the heap
+    memory_statistics_push_external(MemoryTag::GPU_STAGING, 4096);
+    memory_statistics_end_frame();
+    assert_true(memory_statistics_get_frame(MemoryTag::GPU_STAGING).live_size == 4096);
+    memory_statistics_remove_external(MemoryTag::GPU_STAGING, 4096);
+    memory_statistics_end_frame();
+    assert_true(memory_statistics_get_frame(MemoryTag::GPU_STAGING).live_size == 0);
+
+    // Jobs are executed with the tag of the thread that has built them
+    {
+        struct JobTag
+        {
+            inline static void execute(void* p_tag, const uimax p_begin, const uimax p_end)
+            {
+                *(MemoryTag*)p_tag = memory_tag_get();
+            };
+        };
+        MemoryTag l_job_tag = MemoryTag::DEFAULT;
+        JobCounter l_counter = JobCounter{1};
+        l_previous_tag = memory_tag_set(MemoryTag::RENDER);
+        Job l_job = Job::build(JobTag::execute, &l_job_tag, &l_counter);
+        memory_tag_set(MemoryTag::ASSET);
+        l_job.execute();
+        assert_true(l_job_tag == MemoryTag::RENDER);
+        assert_true(memory_tag_get() == MemoryTag::ASSET);
+        memory_tag_set(l_previous_tag);
+    }
+#endif
 };
 
-inline void asset_heappaged_integrity(HeapPaged* p_heap_paged)
+inline void assert_heaptlsf_integrity(HeapTLSF* p_chunks, const uimax p_heap_size)
 {
     uimax l_calculated_size = 0;
-    for (loop(i, 0, p_heap_paged->AllocatedChunks.get_size()))
+    uimax l_calculated_free_size = 0;
+    for (loop(i, 0, p_chunks->blocks.get_size()))
     {
-        if (!p_heap_paged->AllocatedChunks.is_element_free(Token(SliceIndex){i}))
+        if (!p_chunks->blocks.is_element_free(tk_b(HeapTLSF::Block, i)))
         {
-            l_calculated_size += p_heap_paged->AllocatedChunks.get(Token(SliceIndex){i}).Size;
+            HeapTLSF::Block& l_block = p_chunks->blocks.get(tk_b(HeapTLSF::Block, i));
+            l_calculated_size += l_block.chunk.Size;
+            if (l_block.is_free)
+            {
+                l_calculated_free_size += l_block.chunk.Size;
+            }
+
+            if (tk_neq(l_block.next_physical, tk_bd(HeapTLSF::Block)))
+            {
+                HeapTLSF::Block& l_next_block = p_chunks->blocks.get(l_block.next_physical);
+                assert_true(l_next_block.chunk.Begin == (l_block.chunk.Begin + l_block.chunk.Size));
+                assert_true(tk_v(l_next_block.previous_physical) == i);
+                // Free blocks are always merged with their free neighbours
+                assert_true(!(l_block.is_free && l_next_block.is_free));
+            }
+            else
+            {
+                assert_true(tk_v(p_chunks->last_block) == i);
+            }
         };
     }
 
-    for (loop(i, 0, p_heap_paged->FreeChunks.varying_vector.get_size()))
+    assert_true(l_calculated_size == p_heap_size);
+    assert_true(l_calculated_free_size == p_chunks->free_size);
+};
+
+inline void assert_heap_integrity(Heap* p_heap)
+{
+    assert_heaptlsf_integrity(&p_heap->Chunks, p_heap->Size);
+};
+
+inline void asset_heappaged_integrity(HeapPaged* p_heap_paged)
+{
+    for (loop(i, 0, p_heap_paged->get_page_count()))
     {
-        for (loop(j, 0, p_heap_paged->FreeChunks.get(i).Size))
-        {
-            l_calculated_size += p_heap_paged->FreeChunks.get(i).get(j).Size;
-        }
+        assert_heaptlsf_integrity(&p_heap_paged->Pages.get(i), p_heap_paged->PageSize);
     }
-
-    assert_true(l_calculated_size == (p_heap_paged->PageSize * p_heap_paged->get_page_count()));
 };
 
 inline void sort_test(){{uimax l_sizet_array[10] = {10, 9, 8, 2, 7, 4, 10, 35, 9, 4};
@@ -1022,13 +1395,139 @@ struct TestSorter
         return p_left < p_right;
     };
 };
-Sort::Linear3(l_slice, 0, TestSorter{});
+Sort::Intro(l_slice, TestSorter{});
+
+assert_true(memcmp(l_sizet_array, l_sorted_sizet_array, sizeof(uimax) * 10) == 0);
+}
+{
+uimax l_sizet_array[10] = {10, 9, 8, 2, 7, 4, 10, 35, 9, 4};
+uimax l_sorted_sizet_array[10] = {35, 10, 10, 9, 9, 8, 7, 4, 4, 2};
+Slice<uimax> l_slice = Slice<uimax>::build_memory_elementnb(l_sizet_array, 10);
+
+struct TestSorter
+{
+    inline int8 operator()(const uimax& p_left, const uimax& p_right) const
+    {
+        return p_left < p_right;
+    };
+};
+Sort::Heap(l_slice, TestSorter{});
 
 assert_true(memcmp(l_sizet_array, l_sorted_sizet_array, sizeof(uimax) * 10) == 0);
 }
 }
 ;
 
+struct SortTestElement
+{
+    uint32 key;
+    uint32 order;
+};
+
+inline void assert_sorttestelements_sorted(const Slice<SortTestElement>& p_elements, const int8 p_stable)
+{
+    for (loop(i, 1, p_elements.Size))
+    {
+        assert_true(p_elements.get(i - 1).key <= p_elements.get(i).key);
+        if (p_stable && p_elements.get(i - 1).key == p_elements.get(i).key)
+        {
+            assert_true(p_elements.get(i - 1).order < p_elements.get(i).order);
+        }
+    }
+};
+
+inline void sort_algorithms_test()
+{
+    struct SortTestElementByKey
+    {
+        inline int8 operator()(const SortTestElement& p_left, const SortTestElement& p_right) const
+        {
+            return p_left.key > p_right.key;
+        };
+    };
+    auto l_key = [](const SortTestElement& p_element) { return p_element.key; };
+
+    const uimax l_element_count = 5000;
+    Span<SortTestElement> l_source = Span<SortTestElement>::allocate(l_element_count);
+    Span<SortTestElement> l_elements = Span<SortTestElement>::allocate(l_element_count);
+    Span<SortTestElement> l_scratch = Span<SortTestElement>::allocate(l_element_count);
+
+    // Random keys with a lot of duplicates, then already sorted, reversed and equal keys
+    for (loop(l_case, 0, 4))
+    {
+        uint32 l_seed = 42;
+        for (loop(i, 0, l_element_count))
+        {
+            test_random_next(&l_seed);
+            uint32 l_key;
+            switch (l_case)
+            {
+            case 0:
+                l_key = (l_seed >> 8) % 100;
+                break;
+            case 1:
+                l_key = (uint32)i;
+                break;
+            case 2:
+                l_key = (uint32)(l_element_count - i);
+                break;
+            default:
+                l_key = 7;
+                break;
+            }
+            l_source.get(i) = SortTestElement{l_key, (uint32)i};
+        }
+
+        l_elements.slice.copy_memory(l_source.slice);
+        Sort::Intro(l_elements.slice, SortTestElementByKey{});
+        assert_sorttestelements_sorted(l_elements.slice, 0);
+
+        l_elements.slice.copy_memory(l_source.slice);
+        Sort::Merge(l_elements.slice, SortTestElementByKey{});
+        assert_sorttestelements_sorted(l_elements.slice, 1);
+
+        l_elements.slice.copy_memory(l_source.slice);
+        Sort::Merge(l_elements.slice, l_scratch.slice, SortTestElementByKey{});
+        assert_sorttestelements_sorted(l_elements.slice, 1);
+
+        l_elements.slice.copy_memory(l_source.slice);
+        Sort::Radix(l_elements.slice, l_key);
+        assert_sorttestelements_sorted(l_elements.slice, 1);
+
+        l_elements.slice.copy_memory(l_source.slice);
+        Sort::Radix(l_elements.slice, l_scratch.slice, l_key);
+        assert_sorttestelements_sorted(l_elements.slice, 1);
+
+        // Small slices are insertion sorted
+        Slice<SortTestElement> l_small_elements = Slice<SortTestElement>::build_memory_elementnb(l_elements.Memory, 40);
+        l_small_elements.copy_memory(l_source.slice.slide_rv(l_element_count - 40));
+        Sort::Radix(l_small_elements, l_key);
+        assert_sorttestelements_sorted(l_small_elements, 1);
+        l_small_elements.copy_memory(l_source.slice.slide_rv(l_element_count - 40));
+        Sort::Intro(l_small_elements, SortTestElementByKey{});
+        assert_sorttestelements_sorted(l_small_elements, 0);
+    }
+
+    l_scratch.free();
+    l_elements.free();
+    l_source.free();
+
+    // Every byte of 64 bits keys is sorted
+    {
+        Span<hash_t> l_hashes = Span<hash_t>::allocate(1000);
+        for (loop(i, 0, l_hashes.Capacity))
+        {
+            l_hashes.get(i) = (hash_t)((uint64)(i + 1) * 0x9E3779B97F4A7C15ULL);
+        }
+        Sort::Radix(l_hashes.slice);
+        for (loop(i, 1, l_hashes.Capacity))
+        {
+            assert_true(l_hashes.get(i - 1) <= l_hashes.get(i));
+        }
+        l_hashes.free();
+    }
+};
+
 inline void heap_test()
 {
     uimax l_initial_heap_size = 20;
@@ -1097,14 +1596,144 @@ inline void heap_test()
     {
         HeapA::AllocatedElementReturn l_allocated_chunk;
 
-        assert_true(l_heap.AllocatedChunks.get_size() == 0);
+        assert_true(l_heap.Chunks.free_size == l_initial_heap_size);
         assert_true(l_heap.allocate_element_norealloc_with_modulo_offset(l_initial_heap_size + 10, 0, &l_allocated_chunk) == HeapA::AllocationState::NOT_ALLOCATED);
-        assert_true(l_heap.AllocatedChunks.get_size() == 0);
+        assert_true(l_heap.Chunks.free_size == l_initial_heap_size);
     }
 
     l_heap.free();
 };
 
+inline void heap_tlsf_test()
+{
+    // Released chunks are merged with their free neighbours
+    {
+        Heap l_heap = Heap::allocate(100);
+        HeapA::AllocatedElementReturn l_chunks[4];
+        for (loop(i, 0, 4))
+        {
+            assert_true(l_heap.allocate_element(10, &l_chunks[i]) == HeapA::AllocationState::ALLOCATED);
+            assert_true(l_chunks[i].Offset == (i * 10));
+        }
+
+        l_heap.release_element(l_chunks[0].token);
+        l_heap.release_element(l_chunks[2].token);
+        assert_heap_integrity(&l_heap);
+        l_heap.release_element(l_chunks[1].token);
+        assert_heap_integrity(&l_heap);
+
+        HeapA::AllocatedElementReturn l_merged_chunk;
+        assert_true(l_heap.allocate_element_norealloc_with_modulo_offset(30, 0, &l_merged_chunk) == HeapA::AllocationState::ALLOCATED);
+        assert_true(l_merged_chunk.Offset == 0);
+        assert_heap_integrity(&l_heap);
+
+        l_heap.release_element(l_merged_chunk.token);
+        l_heap.release_element(l_chunks[3].token);
+        assert_heap_integrity(&l_heap);
+        assert_true(l_heap.Chunks.free_size == 100);
+        assert_true(l_heap.allocate_element_norealloc_with_modulo_offset(100, 0, &l_merged_chunk) == HeapA::AllocationState::ALLOCATED);
+        assert_true(l_merged_chunk.Offset == 0);
+
+        l_heap.free();
+    }
+
+    // Allocated chunks begin on a multiple of the modulo offset, even when the heap is resized
+    {
+        Heap l_heap = Heap::allocate(0);
+        uimax l_modulos[6] = {1, 3, 16, 64, 256, 7};
+        for (loop(i, 0, 60))
+        {
+            uimax l_modulo = l_modulos[i % 6];
+            uimax l_size = ((i * 37) % 50) + 1;
+            HeapA::AllocatedElementReturn l_chunk;
+            assert_true((HeapA::AllocationState_t)l_heap.allocate_element_with_modulo_offset(l_size, l_modulo, &l_chunk) & (HeapA::AllocationState_t)HeapA::AllocationState::ALLOCATED);
+            assert_true((l_chunk.Offset % l_modulo) == 0);
+            assert_true(l_heap.get(l_chunk.token)->Begin == l_chunk.Offset);
+            assert_true(l_heap.get(l_chunk.token)->Size == l_size);
+            assert_true((l_chunk.Offset + l_size) <= l_heap.Size);
+            assert_heap_integrity(&l_heap);
+            if ((i % 3) == 0)
+            {
+                l_heap.release_element(l_chunk.token);
+                assert_heap_integrity(&l_heap);
+            }
+        }
+        l_heap.free();
+    }
+
+    // Random allocations and releases are compared to a byte occupancy map.
+    // An allocation can only fail if no free range of the occupancy map is large enough to be in the guaranteed fit size class.
+    {
+        const uimax l_heap_size = 4096;
+        Heap l_heap = Heap::allocate(l_heap_size);
+        Span<int8> l_occupancy = Span<int8>::callocate(l_heap_size);
+        Vector<Token(SliceIndex)> l_allocated_chunks = Vector<Token(SliceIndex)>::allocate(0);
+        uint32 l_seed = 1234;
+        uimax l_modulos[3] = {1, 4, 16};
+
+        for (loop(l_iteration, 0, 3000))
+        {
+            test_random_next(&l_seed);
+            uimax l_random = l_seed >> 8;
+            if ((l_random % 5) < 3 || l_allocated_chunks.Size == 0)
+            {
+                uimax l_size = ((l_random >> 4) % 96) + 1;
+                uimax l_modulo = l_modulos[(l_random >> 12) % 3];
+                HeapA::AllocatedElementReturn l_chunk;
+                if (l_heap.allocate_element_norealloc_with_modulo_offset(l_size, l_modulo, &l_chunk) == HeapA::AllocationState::ALLOCATED)
+                {
+                    assert_true((l_chunk.Offset % l_modulo) == 0);
+                    for (loop(i, l_chunk.Offset, l_chunk.Offset + l_size))
+                    {
+                        assert_true(l_occupancy.get(i) == 0);
+                        l_occupancy.get(i) = 1;
+                    }
+                    l_allocated_chunks.push_back_element(l_chunk.token);
+                }
+                else
+                {
+                    // Free blocks of the size class that is guaranteed to fit the padded size are found in constant time.
+                    // Smaller blocks are only partially scanned (HeapTLSF_Const::MAX_SCANNED_FREE_BLOCKS), so the allocation may fail while one of them can hold the chunk.
+                    uimax l_guaranteed_size = l_size + l_modulo - 1;
+                    if (l_guaranteed_size >= HeapTLSF_Const::SL_COUNT)
+                    {
+                        uimax l_round = ((uimax)1 << (bit_msb(l_guaranteed_size) - HeapTLSF_Const::SL_LOG2)) - 1;
+                        l_guaranteed_size = (l_guaranteed_size + l_round) & ~l_round;
+                    }
+
+                    uimax l_free_range_size = 0;
+                    for (loop(i, 0, l_heap_size))
+                    {
+                        l_free_range_size = l_occupancy.get(i) ? 0 : (l_free_range_size + 1);
+                        assert_true(l_free_range_size < l_guaranteed_size);
+                    }
+                }
+            }
+            else
+            {
+                uimax l_released_index = (l_random >> 4) % l_allocated_chunks.Size;
+                SliceIndex* l_released_chunk = l_heap.get(l_allocated_chunks.get(l_released_index));
+                for (loop(i, l_released_chunk->Begin, l_released_chunk->Begin + l_released_chunk->Size))
+                {
+                    l_occupancy.get(i) = 0;
+                }
+                l_heap.release_element(l_allocated_chunks.get(l_released_index));
+                l_allocated_chunks.erase_element_at_always(l_released_index);
+            }
+
+            if ((l_iteration % 100) == 0)
+            {
+                assert_heap_integrity(&l_heap);
+            }
+        }
+        assert_heap_integrity(&l_heap);
+
+        l_allocated_chunks.free();
+        l_occupancy.free();
+        l_heap.free();
+    }
+};
+
 // The HeapPaged uses the same allocation functions as the Heap.
 // We just test the fact that new pages are created.
 inline void heappaged_test()
@@ -1525,6 +2154,69 @@ inline void serialize_deserialize_binary_test()
     l_binary_data.free();
 };
 
+inline void lz4_test()
+{
+    // Block built by hand : 3 literals followed by a match of 15 bytes that overlaps it's source, then 5 last literals
+    {
+        SliceN<int8, 12> l_compressed = {0x3B, 'a', 'b', 'c', 3, 0, 0x50, 'x', 'y', 'z', 'w', 'v'};
+        Slice<int8> l_awaited = slice_int8_build_rawstr("abcabcabcabcabcabcxyzwv");
+        Span<int8> l_decompressed = Span<int8>::allocate(l_awaited.Size);
+        assert_true(LZ4::decompress(l_compressed.to_slice(), l_decompressed.slice));
+        assert_true(l_decompressed.slice.compare(l_awaited));
+        l_decompressed.free();
+    }
+
+    // Repeating patterns, long runs, random bytes and sources too small to have a match
+    const uimax l_source_size = 20000;
+    Span<int8> l_source = Span<int8>::allocate(l_source_size);
+    uint32 l_seed = 12345;
+    for (loop(i, 0, l_source_size))
+    {
+        test_random_next(&l_seed);
+        if (i < 5000)
+        {
+            l_source.get(i) = (int8)(i % 7);
+        }
+        else if (i < 10000)
+        {
+            l_source.get(i) = 42;
+        }
+        else
+        {
+            l_source.get(i) = (int8)(l_seed >> 16);
+        }
+    }
+
+    SliceN<uimax, 6> l_sizes = {0, 1, 12, 13, 10000, l_source_size};
+    for (loop(i, 0, l_sizes.Size()))
+    {
+        Slice<int8> l_tested_source = Slice<int8>::build_memory_elementnb(l_source.Memory, l_sizes.get(i));
+        Span<int8> l_compressed = Span<int8>::allocate(LZ4::get_max_compressed_size(l_tested_source.Size));
+        uimax l_compressed_size = LZ4::compress(l_tested_source, l_compressed.slice);
+        assert_true(l_compressed_size <= l_compressed.Capacity);
+        if (l_tested_source.Size == 10000)
+        {
+            assert_true(l_compressed_size < (l_tested_source.Size / 10));
+        }
+
+        Slice<int8> l_compressed_slice = Slice<int8>::build_memory_elementnb(l_compressed.Memory, l_compressed_size);
+        Span<int8> l_decompressed = Span<int8>::allocate(l_tested_source.Size);
+        assert_true(LZ4::decompress(l_compressed_slice, l_decompressed.slice));
+        assert_true(l_decompressed.slice.compare(l_tested_source));
+
+        // A truncated block is rejected
+        if (l_compressed_size > 1)
+        {
+            assert_true(!LZ4::decompress(Slice<int8>::build_memory_elementnb(l_compressed.Memory, l_compressed_size - 1), l_decompressed.slice));
+        }
+
+        l_decompressed.free();
+        l_compressed.free();
+    }
+
+    l_source.free();
+};
+
 inline void file_test()
 {
     String l_file_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
@@ -1644,9 +2336,144 @@ inline void database_test()
         l_connection.free();
     }
 
+    // connection profile
+    {
+        DatabaseConnectionProfile l_profile = DatabaseConnectionProfile::build_default();
+        l_profile.wal = 1;
+        l_profile.synchronous = DatabaseSynchronous::NORMAL;
+        l_profile.cache_size_kib = 1024;
+        l_profile.mmap_size = 1024 * 1024;
+        l_profile.busy_timeout_ms = 100;
+        DatabaseConnection l_connection = DatabaseConnection::allocate_with_profile(l_database_path.to_slice(), l_profile);
+
+        l_profile.query_only = 1;
+        DatabaseConnection l_query_only_connection = DatabaseConnection::allocate_with_profile(l_database_path.to_slice(), l_profile);
+
+        SliceN<SQLiteQueryPrimitiveTypes, 1> l_text_return_types = {SQLiteQueryPrimitiveTypes::TEXT};
+        SQLitePreparedQuery l_journal_mode_query = SQLitePreparedQuery::allocate(l_connection, slice_int8_build_rawstr("PRAGMA journal_mode;"), SQLiteQueryLayout::build_default(),
+                                                                                 SQLiteQueryLayout::build_slice(l_text_return_types.to_slice()));
+        Span<int8> l_journal_mode = Span<int8>::build_default();
+        SQLiteResultSet l_journal_mode_rs = SQLiteResultSet::build_from_prepared_query(l_journal_mode_query);
+        SQliteQueryExecution::execute_sync(l_connection, l_journal_mode_query.statement, [&]() { l_journal_mode = l_journal_mode_rs.get_text(0); });
+        assert_true(l_journal_mode.slice.compare(slice_int8_build_rawstr("wal")));
+        l_journal_mode.free();
+        l_journal_mode_query.free(l_connection);
+
+        SliceN<SQLiteQueryPrimitiveTypes, 1> l_int_return_types = {SQLiteQueryPrimitiveTypes::INT64};
+        SQLitePreparedQuery l_query_only_query = SQLitePreparedQuery::allocate(l_query_only_connection, slice_int8_build_rawstr("PRAGMA query_only;"), SQLiteQueryLayout::build_default(),
+                                                                               SQLiteQueryLayout::build_slice(l_int_return_types.to_slice()));
+        int64 l_query_only = 0;
+        SQLiteResultSet l_query_only_rs = SQLiteResultSet::build_from_prepared_query(l_query_only_query);
+        SQliteQueryExecution::execute_sync(l_query_only_connection, l_query_only_query.statement, [&]() { l_query_only = l_query_only_rs.get_int64(0); });
+        assert_true(l_query_only == 1);
+        l_query_only_query.free(l_query_only_connection);
+
+        l_query_only_connection.free();
+        l_connection.free();
+    }
+
     l_database_path.free();
 };
 
+inline void job_test()
+{
+    JobSystem l_job_system = JobSystem::allocate(4);
+    assert_true(l_job_system.get_thread_count() == 4);
+    assert_true(l_job_system.get_current_thread_index() == 0);
+
+    // parallel_for
+    {
+        Span<uimax> l_elements = Span<uimax>::callocate(10000);
+        l_job_system.parallel_for(l_elements.slice, 64, [](const uimax p_index, uimax& p_element) {
+            p_element = p_index * 2;
+        });
+        for (loop(i, 0, l_elements.Capacity))
+        {
+            assert_true(l_elements.get(i) == i * 2);
+        }
+        l_elements.free();
+    }
+
+    // the calling thread executes jobs inline when it's deque is full
+    {
+        volatile int64 l_executed = 0;
+        JobCounter l_counter = JobCounter::build_default();
+        for (loop(i, 0, JobSystem_const::DEQUE_CAPACITY * 2))
+        {
+            l_job_system.schedule(Job::build(
+                [](void* p_data, const uimax, const uimax) {
+                    atomic_fetch_add((volatile int64*)p_data, 1);
+                },
+                (void*)&l_executed, &l_counter));
+        }
+        l_job_system.wait(l_counter);
+        assert_true(l_counter.is_done());
+        assert_true(l_executed == JobSystem_const::DEQUE_CAPACITY * 2);
+    }
+
+    // a job waits for the jobs it has scheduled before reading their results
+    {
+        struct Dependency
+        {
+            JobSystem* job_system;
+            Span<uimax> partial_sums;
+            uimax sum;
+
+            inline static void sum_range(void* p_data, const uimax p_begin, const uimax p_end)
+            {
+                Dependency* thiz = (Dependency*)p_data;
+                uimax l_sum = 0;
+                for (loop(i, p_begin, p_end))
+                {
+                    l_sum += i;
+                }
+                thiz->partial_sums.get(p_begin / 100) = l_sum;
+            };
+
+            inline static void sum_all(void* p_data, const uimax, const uimax)
+            {
+                Dependency* thiz = (Dependency*)p_data;
+                JobCounter l_partial_counter = JobCounter::build_default();
+                for (loop(i, 0, thiz->partial_sums.Capacity))
+                {
+                    thiz->job_system->schedule(Job::build_range(Dependency::sum_range, thiz, i * 100, (i + 1) * 100, &l_partial_counter));
+                }
+                thiz->job_system->wait(l_partial_counter);
+
+                thiz->sum = 0;
+                for (loop(i, 0, thiz->partial_sums.Capacity))
+                {
+                    thiz->sum += thiz->partial_sums.get(i);
+                }
+            };
+        };
+
+        Dependency l_dependency = Dependency{&l_job_system, Span<uimax>::allocate(100), 0};
+        JobCounter l_counter = JobCounter::build_default();
+        l_job_system.schedule(Job::build(Dependency::sum_all, &l_dependency, &l_counter));
+        l_job_system.wait(l_counter);
+        assert_true(l_dependency.sum == (10000 * 9999) / 2);
+        l_dependency.partial_sums.free();
+    }
+
+    l_job_system.free();
+
+    // without worker threads, jobs are executed by the waiting thread
+    {
+        JobSystem l_single_thread = JobSystem::allocate(1);
+        Span<uimax> l_elements = Span<uimax>::callocate(100);
+        l_single_thread.parallel_for(l_elements.slice, 7, [](const uimax p_index, uimax& p_element) {
+            p_element = p_index + 1;
+        });
+        for (loop(i, 0, l_elements.Capacity))
+        {
+            assert_true(l_elements.get(i) == i + 1);
+        }
+        l_elements.free();
+        l_single_thread.free();
+    }
+};
+
 inline void native_window()
 {
     Token(Window) l_window = WindowAllocator::allocate(300, 300, slice_int8_build_rawstr("TEST"));
@@ -1706,16 +2533,22 @@ int main(int argc, int8** argv)
     pool_hashed_counted_test();
     ntree_test();
     sort_test();
+    sort_algorithms_test();
     heap_test();
+    heap_tlsf_test();
     heappaged_test();
     heap_memory_test();
+    memory_arena_test();
+    memory_statistics_test();
     string_test();
     fromstring_test();
     deserialize_json_test();
     serialize_json_test();
     serialize_deserialize_binary_test();
+    lz4_test();
     file_test();
     database_test();
+    job_test();
     native_window();
 
     memleak_ckeck();
@@ -1,5 +1,11 @@
 #pragma once
 
+namespace GPUFrame_const
+{
+// Number of frames that the CPU can record while the previous ones are still executed by the GPU.
+constexpr uimax FRAMES_IN_FLIGHT = 2;
+}; // namespace GPUFrame_const
+
 struct Semafore
 {
     VkSemaphore semaphore;
@@ -8,6 +14,17 @@ struct Semafore
     void free(const gc_t p_device);
 };
 
+struct Fence
+{
+    VkFence fence;
+
+    static Fence allocate(const gc_t p_device, const int8 p_signaled);
+    void free(const gc_t p_device);
+
+    void wait(const gc_t p_device);
+    void reset(const gc_t p_device);
+};
+
 struct CommandBuffer
 {
     VkCommandBuffer command_buffer;
@@ -23,10 +40,13 @@ struct CommandBuffer
     void submit_and_notity(const Semafore p_notify);
     void submit_after(const Semafore p_wait_for, const VkPipelineStageFlags p_wait_stage);
     void submit_after_and_notify(const Semafore p_wait_for, const VkPipelineStageFlags p_wait_stage, const Semafore p_notify);
+    void submit_after_and_notify_with_fence(const Slice<Semafore>& p_wait_for, const Slice<VkPipelineStageFlags>& p_wait_stages, const Slice<Semafore>& p_notify, const Fence p_fence);
     void wait_for_completion();
     void flush();
 
     void force_sync_execution();
+
+    void cmd_wait_for_previous_submits();
 };
 
 struct CommandPool
@@ -55,6 +75,34 @@ inline void Semafore::free(const gc_t p_device)
     vkDestroySemaphore(p_device, this->semaphore, NULL);
 };
 
+inline Fence Fence::allocate(const gc_t p_device, const int8 p_signaled)
+{
+    Fence l_fence;
+    VkFenceCreateInfo l_fence_create_info{};
+    l_fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (p_signaled)
+    {
+        l_fence_create_info.flags = VkFenceCreateFlagBits::VK_FENCE_CREATE_SIGNALED_BIT;
+    }
+    vk_handle_result(vkCreateFence(p_device, &l_fence_create_info, NULL, &l_fence.fence));
+    return l_fence;
+};
+
+inline void Fence::free(const gc_t p_device)
+{
+    vkDestroyFence(p_device, this->fence, NULL);
+};
+
+inline void Fence::wait(const gc_t p_device)
+{
+    vk_handle_result(vkWaitForFences(p_device, 1, &this->fence, VK_TRUE, UINT64_MAX));
+};
+
+inline void Fence::reset(const gc_t p_device)
+{
+    vk_handle_result(vkResetFences(p_device, 1, &this->fence));
+};
+
 inline CommandBuffer CommandBuffer::build_default()
 {
     return CommandBuffer{NULL, NULL, 0};
@@ -135,6 +183,25 @@ inline void CommandBuffer::submit_after_and_notify(const Semafore p_wait_for, co
     vk_handle_result(vkQueueSubmit(this->queue, 1, &l_wait_for_end_submit, NULL));
 };
 
+inline void CommandBuffer::submit_after_and_notify_with_fence(const Slice<Semafore>& p_wait_for, const Slice<VkPipelineStageFlags>& p_wait_stages, const Slice<Semafore>& p_notify,
+                                                              const Fence p_fence)
+{
+#if GPU_BOUND_TEST
+    assert_true(p_wait_for.Size == p_wait_stages.Size);
+#endif
+    this->end();
+    VkSubmitInfo l_wait_for_end_submit{};
+    l_wait_for_end_submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    l_wait_for_end_submit.commandBufferCount = 1;
+    l_wait_for_end_submit.pCommandBuffers = &this->command_buffer;
+    l_wait_for_end_submit.waitSemaphoreCount = (uint32)p_wait_for.Size;
+    l_wait_for_end_submit.pWaitSemaphores = (VkSemaphore*)p_wait_for.Begin;
+    l_wait_for_end_submit.pWaitDstStageMask = p_wait_stages.Begin;
+    l_wait_for_end_submit.signalSemaphoreCount = (uint32)p_notify.Size;
+    l_wait_for_end_submit.pSignalSemaphores = (VkSemaphore*)p_notify.Begin;
+    vk_handle_result(vkQueueSubmit(this->queue, 1, &l_wait_for_end_submit, p_fence.fence));
+};
+
 inline void CommandBuffer::wait_for_completion()
 {
     vk_handle_result(vkQueueWaitIdle(this->queue));
@@ -152,6 +219,20 @@ inline void CommandBuffer::force_sync_execution()
     this->wait_for_completion();
 };
 
+/*
+    Commands of the previous frames may still be executed by the GPU when the next frame is recorded.
+    The barrier orders the following commands after every command previously submitted to the same queue.
+*/
+inline void CommandBuffer::cmd_wait_for_previous_submits()
+{
+    VkMemoryBarrier l_memory_barrier{};
+    l_memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    l_memory_barrier.srcAccessMask = VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT;
+    l_memory_barrier.dstAccessMask = VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT | VkAccessFlagBits::VK_ACCESS_MEMORY_WRITE_BIT;
+    vkCmdPipelineBarrier(this->command_buffer, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &l_memory_barrier,
+                         0, NULL, 0, NULL);
+};
+
 inline CommandPool CommandPool::allocate(const gc_t p_device, const uint32 p_queue_family)
 {
     CommandPool l_pool;
@@ -83,6 +83,28 @@ inline static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSe
 #include "./graphics_binder.hpp"
 #include "./present.hpp"
 
+/*
+    Resources of a frame that is recorded by the CPU while the previous ones may still be executed by the GPU.
+    The end_fence is signaled when the graphics commands of the frame are executed, it is awaited before the frame resources are recorded again.
+    Host buffers used as staging memory by the transfer commands of the frame are released only once the end_fence is signaled.
+*/
+struct GPUFrame
+{
+    CommandBuffer transfer_command_buffer;
+    CommandBuffer graphics_command_buffer;
+    Semafore buffer_end_semaphore;
+    Semafore graphics_end_semaphore;
+    Fence end_fence;
+    Vector<Token(BufferHost)> garbage_host_buffers;
+};
+
+/*
+    The GPUContext records one frame at a time, among GPUFrame_const::FRAMES_IN_FLIGHT frames.
+    Command buffers and semaphores of the current frame are the ones binded to the TransferDevice, the GraphicsDevice and the buffer_end_semaphore/graphics_end_semaphore.
+    begin_frame switches to the next frame once the GPU has finished executing it. If begin_frame is never called, the first frame is always used and the caller must wait_for_completion
+    before recording again.
+    Transfer and graphics queues are the same queue, so consecutive frames are ordered on the GPU by cmd_wait_for_previous_submits.
+*/
 struct GPUContext
 {
     GPUInstance instance;
@@ -92,14 +114,40 @@ struct GPUContext
     Semafore buffer_end_semaphore;
     Semafore graphics_end_semaphore;
 
+    SliceN<GPUFrame, GPUFrame_const::FRAMES_IN_FLIGHT> frames;
+    uimax frame_index;
+
     inline static GPUContext allocate(const Slice<GPUExtension>& p_gpu_extensions)
     {
         GPUContext l_context;
         l_context.instance = GPUInstance::allocate(p_gpu_extensions);
         l_context.buffer_memory = BufferMemory::allocate(l_context.instance);
         l_context.graphics_allocator = GraphicsAllocator2::allocate_default(l_context.instance);
-        l_context.buffer_end_semaphore = Semafore::allocate(l_context.instance.logical_device);
-        l_context.graphics_end_semaphore = Semafore::allocate(l_context.instance.logical_device);
+
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            GPUFrame& l_frame = l_context.frames.get(i);
+            if (i == 0)
+            {
+                l_frame.transfer_command_buffer = l_context.buffer_memory.allocator.device.command_buffer;
+                l_frame.graphics_command_buffer = l_context.graphics_allocator.graphics_device.command_buffer;
+            }
+            else
+            {
+                l_frame.transfer_command_buffer =
+                    l_context.buffer_memory.allocator.device.command_pool.allocate_command_buffer(l_context.instance.logical_device, l_context.buffer_memory.allocator.device.transfer_queue);
+                l_frame.graphics_command_buffer =
+                    l_context.graphics_allocator.graphics_device.command_pool.allocate_command_buffer(l_context.instance.logical_device, l_context.graphics_allocator.graphics_device.graphics_queue);
+            }
+            l_frame.buffer_end_semaphore = Semafore::allocate(l_context.instance.logical_device);
+            l_frame.graphics_end_semaphore = Semafore::allocate(l_context.instance.logical_device);
+            l_frame.end_fence = Fence::allocate(l_context.instance.logical_device, 1);
+            l_frame.garbage_host_buffers = Vector<Token(BufferHost)>::allocate(0);
+        }
+
+        l_context.frame_index = 0;
+        l_context.buffer_end_semaphore = l_context.frames.get(0).buffer_end_semaphore;
+        l_context.graphics_end_semaphore = l_context.frames.get(0).graphics_end_semaphore;
         return l_context;
     };
 
@@ -107,17 +155,55 @@ struct GPUContext
 
     inline void free()
     {
-        this->buffer_end_semaphore.free(this->instance.logical_device);
-        this->graphics_end_semaphore.free(this->instance.logical_device);
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            GPUFrame& l_frame = this->frames.get(i);
+            l_frame.end_fence.wait(this->instance.logical_device);
+            this->free_frame_garbage_buffers(l_frame);
+            l_frame.garbage_host_buffers.free();
+            l_frame.end_fence.free(this->instance.logical_device);
+            l_frame.buffer_end_semaphore.free(this->instance.logical_device);
+            l_frame.graphics_end_semaphore.free(this->instance.logical_device);
+        }
         this->graphics_allocator.free();
         this->buffer_memory.free();
         this->instance.free();
     };
 
+    /*
+        Waits for the GPU to finish the next frame and binds it's command buffers.
+        Must be called before anything is recorded or written to per frame host memory for the new frame.
+    */
+    inline void begin_frame()
+    {
+        GPUFrame& l_previous_frame = this->frames.get(this->frame_index);
+        l_previous_frame.transfer_command_buffer = this->buffer_memory.allocator.device.command_buffer;
+        l_previous_frame.graphics_command_buffer = this->graphics_allocator.graphics_device.command_buffer;
+
+        this->frame_index = (this->frame_index + 1) % GPUFrame_const::FRAMES_IN_FLIGHT;
+
+        GPUFrame& l_frame = this->frames.get(this->frame_index);
+        l_frame.end_fence.wait(this->instance.logical_device);
+        this->free_frame_garbage_buffers(l_frame);
+
+        this->buffer_memory.allocator.device.command_buffer = l_frame.transfer_command_buffer;
+        this->graphics_allocator.graphics_device.command_buffer = l_frame.graphics_command_buffer;
+        this->graphics_allocator.graphics_device.frame_index = this->frame_index;
+        this->buffer_end_semaphore = l_frame.buffer_end_semaphore;
+        this->graphics_end_semaphore = l_frame.graphics_end_semaphore;
+    };
+
     inline void buffer_step_and_submit()
     {
+        this->buffer_memory.allocator.device.command_buffer.begin();
+        this->buffer_memory.allocator.device.command_buffer.cmd_wait_for_previous_submits();
         BufferStep::step(this->buffer_memory.allocator, this->buffer_memory.events);
         this->buffer_memory.allocator.device.command_buffer.submit_and_notity(this->buffer_end_semaphore);
+
+        // Staging buffers are read by the submitted commands, they are released when the frame is over
+        GPUFrame& l_frame = this->frames.get(this->frame_index);
+        l_frame.garbage_host_buffers.push_back_array(this->buffer_memory.events.garbage_host_buffers.to_slice());
+        this->buffer_memory.events.garbage_host_buffers.clear();
     };
 
     inline void buffer_step_and_wait_for_completion()
@@ -131,24 +217,49 @@ struct GPUContext
     {
         GraphicsBinder l_binder = GraphicsBinder::build(this->buffer_memory.allocator, this->graphics_allocator);
         l_binder.start();
+        this->graphics_allocator.graphics_device.command_buffer.cmd_wait_for_previous_submits();
         return l_binder;
     };
 
     inline void submit_graphics_binder(GraphicsBinder& p_binder)
     {
         p_binder.end();
-        p_binder.submit_after(this->buffer_end_semaphore, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT);
+        GPUFrame& l_frame = this->frames.get(this->frame_index);
+        l_frame.end_fence.reset(this->instance.logical_device);
+        p_binder.submit_after_and_notify_with_fence(SliceN<Semafore, 1>{this->buffer_end_semaphore}.to_slice(),
+                                                    SliceN<VkPipelineStageFlags, 1>{VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT}.to_slice(), Slice<Semafore>::build_default(),
+                                                    l_frame.end_fence);
     };
 
     inline void submit_graphics_binder_and_notity_end(GraphicsBinder& p_binder)
     {
         p_binder.end();
-        p_binder.submit_after_and_notify(this->buffer_end_semaphore, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, this->graphics_end_semaphore);
+        GPUFrame& l_frame = this->frames.get(this->frame_index);
+        l_frame.end_fence.reset(this->instance.logical_device);
+        p_binder.submit_after_and_notify_with_fence(SliceN<Semafore, 1>{this->buffer_end_semaphore}.to_slice(),
+                                                    SliceN<VkPipelineStageFlags, 1>{VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT}.to_slice(),
+                                                    SliceN<Semafore, 1>{this->graphics_end_semaphore}.to_slice(), l_frame.end_fence);
     };
 
     inline void wait_for_completion()
     {
         this->graphics_allocator.graphics_device.command_buffer.wait_for_completion();
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            this->free_frame_garbage_buffers(this->frames.get(i));
+        }
+    };
+
+  private:
+    inline void free_frame_garbage_buffers(GPUFrame& p_frame)
+    {
+        for (loop(i, 0, p_frame.garbage_host_buffers.Size))
+        {
+            Token(BufferHost) l_staging_buffer = p_frame.garbage_host_buffers.get(i);
+            memory_statistics_remove_external(MemoryTag::GPU_STAGING, this->buffer_memory.allocator.host_buffers.get(l_staging_buffer).size);
+            this->buffer_memory.allocator.free_bufferhost(l_staging_buffer);
+        }
+        p_frame.garbage_host_buffers.clear();
     };
 };
 
@@ -6,6 +6,8 @@ enum class ShaderLayoutParameterType
     UNIFORM_BUFFER_VERTEX = 1,
     UNIFORM_BUFFER_VERTEX_FRAGMENT = 2,
     TEXTURE_FRAGMENT = 3,
+    // The offset of the uniform buffer is provided when the parameter is binded.
+    UNIFORM_BUFFER_DYNAMIC_VERTEX = 4
 };
 
 /*
@@ -19,6 +21,7 @@ struct ShaderLayoutParameters
         VkDescriptorSetLayout uniformbuffer_vertex_layout;
         VkDescriptorSetLayout uniformbuffer_fragment_vertex_layout;
         VkDescriptorSetLayout texture_fragment_layout;
+        VkDescriptorSetLayout uniformbuffer_dynamic_vertex_layout;
     };
 
     Binding0 parameter_set;
@@ -67,6 +70,8 @@ struct GraphicsDevice
 
     CommandPool command_pool;
     CommandBuffer command_buffer;
+    // Index of the frame in flight that is recorded with the command_buffer
+    uimax frame_index;
 
     ShaderParameterPool shaderparameter_pool;
     ShaderLayoutParameters shaderlayout_parameters;
@@ -166,9 +171,21 @@ struct ShaderLayout
     Span<VertexInputParameter> vertex_input_layout;
     uimax vertex_element_size;
 
+    /*
+        Optional per instance inputs. They are read from the vertex binding 1 and their locations follow the vertex inputs ones.
+    */
+    Span<VertexInputParameter> instance_input_layout;
+    uimax instance_element_size;
+
     static ShaderLayout allocate(const GraphicsDevice& p_device, const Span<ShaderLayoutParameterType>& in_shaderlayout_parameter_types, const Span<VertexInputParameter>& in_vertex_input_layout,
                                  const uimax in_vertex_element_size);
 
+    static ShaderLayout allocate_instanced(const GraphicsDevice& p_device, const Span<ShaderLayoutParameterType>& in_shaderlayout_parameter_types,
+                                           const Span<VertexInputParameter>& in_vertex_input_layout, const uimax in_vertex_element_size, const Span<VertexInputParameter>& in_instance_input_layout,
+                                           const uimax in_instance_element_size);
+
+    int8 is_instanced() const;
+
     void free(const GraphicsDevice& p_device);
 };
 
@@ -249,7 +266,8 @@ namespace ShadowShaderUniformBufferParameter
 {
 template <class ShadowShaderUniformBufferParameter_t(_), class ShadowBuffer_t(_)>
 static ShadowShaderUniformBufferParameter_t(_) allocate(const GraphicsDevice& p_graphics_device, const VkDescriptorSetLayout p_descriptor_set_layout,
-                                                        const Token(ShadowBuffer_t(_)) p_buffer_memory_token, const ShadowBuffer_t(_) & p_buffer_memory);
+                                                        const Token(ShadowBuffer_t(_)) p_buffer_memory_token, const ShadowBuffer_t(_) & p_buffer_memory, const VkDescriptorType p_descriptor_type,
+                                                        const uimax p_range);
 };
 
 struct ShaderUniformBufferHostParameter
@@ -260,9 +278,37 @@ struct ShaderUniformBufferHostParameter
     static ShaderUniformBufferHostParameter allocate(const GraphicsDevice& p_graphics_device, const VkDescriptorSetLayout p_descriptor_set_layout, const Token(BufferHost) p_buffer_memory_token,
                                                      const BufferHost& p_buffer_memory);
 
+    /*
+        The descriptor covers p_range bytes of the buffer, starting from the dynamic offset given when the parameter is binded.
+    */
+    static ShaderUniformBufferHostParameter allocate_dynamic(const GraphicsDevice& p_graphics_device, const VkDescriptorSetLayout p_descriptor_set_layout,
+                                                             const Token(BufferHost) p_buffer_memory_token, const BufferHost& p_buffer_memory, const uimax p_range);
+
     void ShadowShaderUniformBufferParameter_func_method_free(const GraphicsDevice& p_graphics_device);
 };
 
+/*
+    Host uniform buffer parameter of a Material. The buffer and it's descriptor set are duplicated for every frame in flight.
+    The copy of the recorded frame is the one that is written and binded, so that the CPU never writes memory that the GPU reads for a previous frame.
+    Once a copy has been written, the other ones are outdated. They are refreshed from the written copy when their frame binds the parameter.
+*/
+struct ShaderUniformBufferHostFramesParameter
+{
+    SliceN<Token(ShaderUniformBufferHostParameter), GPUFrame_const::FRAMES_IN_FLIGHT> frames;
+    SliceN<int8, GPUFrame_const::FRAMES_IN_FLIGHT> frames_outdated;
+    uimax written_frame;
+
+    inline Token(ShaderUniformBufferHostParameter) write_frame(const uimax p_frame_index)
+    {
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            this->frames_outdated.get(i) = (i != p_frame_index);
+        }
+        this->written_frame = p_frame_index;
+        return this->frames.get(p_frame_index);
+    };
+};
+
 struct ShaderUniformBufferGPUParameter
 {
     VkDescriptorSet descriptor_set;
@@ -297,7 +343,7 @@ struct ShaderParameter
 
     union
     {
-        Token(ShaderUniformBufferHostParameter) uniform_host;
+        Token(ShaderUniformBufferHostFramesParameter) uniform_host;
         Token(ShaderUniformBufferGPUParameter) uniform_gpu;
         Token(ShaderTextureGPUParameter) texture_gpu;
     };
@@ -313,6 +359,7 @@ struct GraphicsHeap2
     Pool<Shader> shaders;
 
     Pool<ShaderUniformBufferHostParameter> shader_uniform_buffer_host_parameters;
+    Pool<ShaderUniformBufferHostFramesParameter> shader_uniform_buffer_host_frames_parameters;
     Pool<ShaderUniformBufferGPUParameter> shader_uniform_buffer_gpu_parameters;
     Pool<ShaderTextureGPUParameter> shader_texture_gpu_parameters;
 
@@ -327,6 +374,7 @@ struct GraphicsHeap2
                              Pool<ShaderModule>::allocate(0),
                              Pool<Shader>::allocate(0),
                              Pool<ShaderUniformBufferHostParameter>::allocate(0),
+                             Pool<ShaderUniformBufferHostFramesParameter>::allocate(0),
                              Pool<ShaderUniformBufferGPUParameter>::allocate(0),
                              Pool<ShaderTextureGPUParameter>::allocate(0),
                              PoolOfVector<ShaderParameter>::allocate_default()};
@@ -342,6 +390,7 @@ struct GraphicsHeap2
         assert_true(!this->shader_modules.has_allocated_elements());
         assert_true(!this->shaders.has_allocated_elements());
         assert_true(!this->shader_uniform_buffer_host_parameters.has_allocated_elements());
+        assert_true(!this->shader_uniform_buffer_host_frames_parameters.has_allocated_elements());
         assert_true(!this->shader_uniform_buffer_gpu_parameters.has_allocated_elements());
         assert_true(!this->shader_texture_gpu_parameters.has_allocated_elements());
         assert_true(!this->material_parameters.has_allocated_elements());
@@ -354,6 +403,7 @@ struct GraphicsHeap2
         this->shader_modules.free();
         this->shaders.free();
         this->shader_uniform_buffer_host_parameters.free();
+        this->shader_uniform_buffer_host_frames_parameters.free();
         this->shader_uniform_buffer_gpu_parameters.free();
         this->shader_texture_gpu_parameters.free();
         this->material_parameters.free();
@@ -365,7 +415,8 @@ inline ShaderLayoutParameters ShaderLayoutParameters::allocate(gc_t const p_devi
     ShaderLayoutParameters l_shader_layout_parameters;
     l_shader_layout_parameters.parameter_set = Binding0{l_shader_layout_parameters.create_layout(p_device, ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX, (uint32)0),
                                                         l_shader_layout_parameters.create_layout(p_device, ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX_FRAGMENT, (uint32)0),
-                                                        l_shader_layout_parameters.create_layout(p_device, ShaderLayoutParameterType::TEXTURE_FRAGMENT, (uint32)0)};
+                                                        l_shader_layout_parameters.create_layout(p_device, ShaderLayoutParameterType::TEXTURE_FRAGMENT, (uint32)0),
+                                                        l_shader_layout_parameters.create_layout(p_device, ShaderLayoutParameterType::UNIFORM_BUFFER_DYNAMIC_VERTEX, (uint32)0)};
     return l_shader_layout_parameters;
 };
 
@@ -374,6 +425,7 @@ inline void ShaderLayoutParameters::free(gc_t const p_device)
     vkDestroyDescriptorSetLayout(p_device, this->parameter_set.uniformbuffer_vertex_layout, NULL);
     vkDestroyDescriptorSetLayout(p_device, this->parameter_set.uniformbuffer_fragment_vertex_layout, NULL);
     vkDestroyDescriptorSetLayout(p_device, this->parameter_set.texture_fragment_layout, NULL);
+    vkDestroyDescriptorSetLayout(p_device, this->parameter_set.uniformbuffer_dynamic_vertex_layout, NULL);
 };
 
 inline VkDescriptorSetLayout ShaderLayoutParameters::get_descriptorset_layout(const ShaderLayoutParameterType p_shader_layout_parameter_type) const
@@ -386,6 +438,8 @@ inline VkDescriptorSetLayout ShaderLayoutParameters::get_descriptorset_layout(co
         return this->parameter_set.uniformbuffer_fragment_vertex_layout;
     case ShaderLayoutParameterType::TEXTURE_FRAGMENT:
         return this->parameter_set.texture_fragment_layout;
+    case ShaderLayoutParameterType::UNIFORM_BUFFER_DYNAMIC_VERTEX:
+        return this->parameter_set.uniformbuffer_dynamic_vertex_layout;
     default:
         abort();
     }
@@ -409,6 +463,10 @@ inline VkDescriptorSetLayout ShaderLayoutParameters::create_layout(gc_t const p_
         l_descriptor_type = VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         l_shader_stage = VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT;
         break;
+    case ShaderLayoutParameterType::UNIFORM_BUFFER_DYNAMIC_VERTEX:
+        l_descriptor_type = VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        l_shader_stage = VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT;
+        break;
     default:
         abort();
     }
@@ -438,13 +496,15 @@ inline VkDescriptorSetLayoutBinding ShaderLayoutParameters::create_binding(const
 
 inline ShaderParameterPool ShaderParameterPool::allocate(const gc_t p_device, const uimax p_max_sets)
 {
-    VkDescriptorPoolSize l_types{};
-    l_types.descriptorCount = 4;
+    VkDescriptorPoolSize l_types[2]{};
+    l_types[0].descriptorCount = 4;
+    l_types[1].type = VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    l_types[1].descriptorCount = 4;
 
     VkDescriptorPoolCreateInfo l_descriptor_pool_create_info{};
     l_descriptor_pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    l_descriptor_pool_create_info.poolSizeCount = 1;
-    l_descriptor_pool_create_info.pPoolSizes = &l_types;
+    l_descriptor_pool_create_info.poolSizeCount = 2;
+    l_descriptor_pool_create_info.pPoolSizes = l_types;
     l_descriptor_pool_create_info.flags = VkDescriptorPoolCreateFlagBits::VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
     l_descriptor_pool_create_info.maxSets = (uint32_t)p_max_sets;
 
@@ -475,7 +535,7 @@ inline TextureSamplers TextureSamplers::allocate(const gc_t p_device)
     l_sampler_create_info.compareOp = VkCompareOp::VK_COMPARE_OP_ALWAYS;
     l_sampler_create_info.mipmapMode = VkSamplerMipmapMode::VK_SAMPLER_MIPMAP_MODE_LINEAR;
     l_sampler_create_info.mipLodBias = 0.0f;
-    l_sampler_create_info.maxLod = 0.0f;
+    l_sampler_create_info.maxLod = VK_LOD_CLAMP_NONE;
     l_sampler_create_info.minLod = 0.0f;
 
     vk_handle_result(vkCreateSampler(p_device, &l_sampler_create_info, NULL, &l_samplers.Default));
@@ -497,6 +557,7 @@ inline GraphicsDevice GraphicsDevice::allocate(GPUInstance& p_instance)
 
     l_graphics_device.command_pool = CommandPool::allocate(l_graphics_device.device, p_instance.graphics_card.graphics_queue_family);
     l_graphics_device.command_buffer = l_graphics_device.command_pool.allocate_command_buffer(l_graphics_device.device, l_graphics_device.graphics_queue);
+    l_graphics_device.frame_index = 0;
 
     l_graphics_device.shaderparameter_pool = ShaderParameterPool::allocate(l_graphics_device.device, 10000);
     l_graphics_device.shaderlayout_parameters = ShaderLayoutParameters::allocate(l_graphics_device.device);
@@ -691,6 +752,13 @@ inline void GraphicsPass::free(const GraphicsDevice& p_graphics_device)
 
 inline ShaderLayout ShaderLayout::allocate(const GraphicsDevice& p_device, const Span<ShaderLayoutParameterType>& in_shaderlayout_parameter_types,
                                            const Span<VertexInputParameter>& in_vertex_input_layout, const uimax in_vertex_element_size)
+{
+    return allocate_instanced(p_device, in_shaderlayout_parameter_types, in_vertex_input_layout, in_vertex_element_size, Span<VertexInputParameter>::build(NULL, 0), 0);
+};
+
+inline ShaderLayout ShaderLayout::allocate_instanced(const GraphicsDevice& p_device, const Span<ShaderLayoutParameterType>& in_shaderlayout_parameter_types,
+                                                     const Span<VertexInputParameter>& in_vertex_input_layout, const uimax in_vertex_element_size,
+                                                     const Span<VertexInputParameter>& in_instance_input_layout, const uimax in_instance_element_size)
 {
     VkPipelineLayoutCreateInfo l_pipeline_create_info{};
     l_pipeline_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -709,6 +777,8 @@ inline ShaderLayout ShaderLayout::allocate(const GraphicsDevice& p_device, const
     l_shader_layout.shader_layout_parameter_types = in_shaderlayout_parameter_types;
     l_shader_layout.vertex_input_layout = in_vertex_input_layout;
     l_shader_layout.vertex_element_size = in_vertex_element_size;
+    l_shader_layout.instance_input_layout = in_instance_input_layout;
+    l_shader_layout.instance_element_size = in_instance_element_size;
     vk_handle_result(vkCreatePipelineLayout(p_device.device, &l_pipeline_create_info, NULL, &l_shader_layout.layout));
 
     l_descriptor_set_layouts.free();
@@ -721,6 +791,12 @@ inline void ShaderLayout::free(const GraphicsDevice& p_device)
     vkDestroyPipelineLayout(p_device.device, this->layout, NULL);
     this->shader_layout_parameter_types.free();
     this->vertex_input_layout.free();
+    this->instance_input_layout.free();
+};
+
+inline int8 ShaderLayout::is_instanced() const
+{
+    return this->instance_input_layout.Capacity != 0;
 };
 
 inline ShaderModule ShaderModule::allocate(const GraphicsDevice& p_graphics_device, const Slice<int8>& p_shader_compiled_str)
@@ -750,7 +826,9 @@ inline Shader Shader::allocate(const GraphicsDevice& p_device, const ShaderAlloc
     Shader l_shader;
     l_shader.layout = p_shader_allocate_info.shader_layout;
 
-    Span<VkVertexInputAttributeDescription> l_vertex_input_attributes = Span<VkVertexInputAttributeDescription>::allocate(p_shader_allocate_info.shader_layout.vertex_input_layout.Capacity);
+    const ShaderLayout& l_shader_layout = p_shader_allocate_info.shader_layout;
+    Span<VkVertexInputAttributeDescription> l_vertex_input_attributes =
+        Span<VkVertexInputAttributeDescription>::allocate(l_shader_layout.vertex_input_layout.Capacity + l_shader_layout.instance_input_layout.Capacity);
 
     VkGraphicsPipelineCreateInfo l_pipeline_graphics_create_info{};
     l_pipeline_graphics_create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -815,18 +893,28 @@ inline Shader Shader::allocate(const GraphicsDevice& p_device, const ShaderAlloc
     l_multisample_state.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
     l_multisample_state.rasterizationSamples = VkSampleCountFlagBits::VK_SAMPLE_COUNT_1_BIT;
 
-    for (loop(i, 0, l_vertex_input_attributes.Capacity))
+    for (loop(i, 0, l_shader_layout.vertex_input_layout.Capacity))
     {
-        const ShaderLayout::VertexInputParameter& l_vertex_input_parameter = p_shader_allocate_info.shader_layout.vertex_input_layout.get(i);
+        const ShaderLayout::VertexInputParameter& l_vertex_input_parameter = l_shader_layout.vertex_input_layout.get(i);
         l_vertex_input_attributes.get(i) = VkVertexInputAttributeDescription{(uint32_t)i, 0, get_primitivetype_format(l_vertex_input_parameter.type), (uint32_t)l_vertex_input_parameter.offset};
     }
 
-    VkVertexInputBindingDescription l_vertex_input_binding{0, (uint32_t)p_shader_allocate_info.shader_layout.vertex_element_size, VkVertexInputRate::VK_VERTEX_INPUT_RATE_VERTEX};
+    for (loop(i, 0, l_shader_layout.instance_input_layout.Capacity))
+    {
+        const ShaderLayout::VertexInputParameter& l_instance_input_parameter = l_shader_layout.instance_input_layout.get(i);
+        uimax l_location = l_shader_layout.vertex_input_layout.Capacity + i;
+        l_vertex_input_attributes.get(l_location) =
+            VkVertexInputAttributeDescription{(uint32_t)l_location, 1, get_primitivetype_format(l_instance_input_parameter.type), (uint32_t)l_instance_input_parameter.offset};
+    }
+
+    VkVertexInputBindingDescription l_vertex_input_bindings[2];
+    l_vertex_input_bindings[0] = VkVertexInputBindingDescription{0, (uint32_t)l_shader_layout.vertex_element_size, VkVertexInputRate::VK_VERTEX_INPUT_RATE_VERTEX};
+    l_vertex_input_bindings[1] = VkVertexInputBindingDescription{1, (uint32_t)l_shader_layout.instance_element_size, VkVertexInputRate::VK_VERTEX_INPUT_RATE_INSTANCE};
 
     VkPipelineVertexInputStateCreateInfo l_vertex_input_create{};
     l_vertex_input_create.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    l_vertex_input_create.vertexBindingDescriptionCount = 1;
-    l_vertex_input_create.pVertexBindingDescriptions = &l_vertex_input_binding;
+    l_vertex_input_create.vertexBindingDescriptionCount = l_shader_layout.is_instanced() ? 2 : 1;
+    l_vertex_input_create.pVertexBindingDescriptions = l_vertex_input_bindings;
     l_vertex_input_create.pVertexAttributeDescriptions = l_vertex_input_attributes.Memory;
     l_vertex_input_create.vertexAttributeDescriptionCount = (uint32_t)l_vertex_input_attributes.Capacity;
 
@@ -900,7 +988,8 @@ inline VkFormat Shader::get_primitivetype_format(const PrimitiveSerializedTypes:
 
 template <class ShadowShaderUniformBufferParameter_t(_), class ShadowBuffer_t(_)>
 inline ShadowShaderUniformBufferParameter_t(_) ShadowShaderUniformBufferParameter::allocate(const GraphicsDevice& p_graphics_device, const VkDescriptorSetLayout p_descriptor_set_layout,
-                                                                                            const Token(ShadowBuffer_t(_)) p_buffer_memory_token, const ShadowBuffer_t(_) & p_buffer_memory)
+                                                                                            const Token(ShadowBuffer_t(_)) p_buffer_memory_token, const ShadowBuffer_t(_) & p_buffer_memory,
+                                                                                            const VkDescriptorType p_descriptor_type, const uimax p_range)
 {
     ShadowShaderUniformBufferParameter_t(_) l_shader_unifor_buffer_parameter;
     VkDescriptorSetAllocateInfo l_allocate_info{};
@@ -915,13 +1004,13 @@ inline ShadowShaderUniformBufferParameter_t(_) ShadowShaderUniformBufferParamete
     VkDescriptorBufferInfo l_descriptor_buffer_info;
     l_descriptor_buffer_info.buffer = ShadowBuffer_c_get_buffer(&p_buffer_memory);
     l_descriptor_buffer_info.offset = 0;
-    l_descriptor_buffer_info.range = ShadowBuffer_c_get_size(&p_buffer_memory);
+    l_descriptor_buffer_info.range = p_range;
 
     VkWriteDescriptorSet l_write_descriptor_set{};
     l_write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     l_write_descriptor_set.dstSet = ShadowShaderUniformBufferParameter_c_get_descriptor_set(&l_shader_unifor_buffer_parameter);
     l_write_descriptor_set.descriptorCount = 1;
-    l_write_descriptor_set.descriptorType = VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    l_write_descriptor_set.descriptorType = p_descriptor_type;
     l_write_descriptor_set.pBufferInfo = &l_descriptor_buffer_info;
 
     vkUpdateDescriptorSets(p_graphics_device.device, 1, &l_write_descriptor_set, 0, NULL);
@@ -932,7 +1021,15 @@ inline ShadowShaderUniformBufferParameter_t(_) ShadowShaderUniformBufferParamete
 inline ShaderUniformBufferHostParameter ShaderUniformBufferHostParameter::allocate(const GraphicsDevice& p_graphics_device, const VkDescriptorSetLayout p_descriptor_set_layout,
                                                                                    const Token(BufferHost) p_buffer_memory_token, const BufferHost& p_buffer_memory)
 {
-    return ShadowShaderUniformBufferParameter::allocate<ShaderUniformBufferHostParameter>(p_graphics_device, p_descriptor_set_layout, p_buffer_memory_token, p_buffer_memory);
+    return ShadowShaderUniformBufferParameter::allocate<ShaderUniformBufferHostParameter>(p_graphics_device, p_descriptor_set_layout, p_buffer_memory_token, p_buffer_memory,
+                                                                                          VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, p_buffer_memory.size);
+};
+
+inline ShaderUniformBufferHostParameter ShaderUniformBufferHostParameter::allocate_dynamic(const GraphicsDevice& p_graphics_device, const VkDescriptorSetLayout p_descriptor_set_layout,
+                                                                                           const Token(BufferHost) p_buffer_memory_token, const BufferHost& p_buffer_memory, const uimax p_range)
+{
+    return ShadowShaderUniformBufferParameter::allocate<ShaderUniformBufferHostParameter>(p_graphics_device, p_descriptor_set_layout, p_buffer_memory_token, p_buffer_memory,
+                                                                                          VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, p_range);
 };
 
 inline void ShaderUniformBufferHostParameter::free(const GraphicsDevice& p_graphics_device)
@@ -943,7 +1040,8 @@ inline void ShaderUniformBufferHostParameter::free(const GraphicsDevice& p_graph
 inline ShaderUniformBufferGPUParameter ShaderUniformBufferGPUParameter::allocate(const GraphicsDevice& p_graphics_device, const VkDescriptorSetLayout p_descriptor_set_layout,
                                                                                  const Token(BufferGPU) p_buffer_memory_token, const BufferGPU& p_buffer_memory)
 {
-    return ShadowShaderUniformBufferParameter::allocate<ShaderUniformBufferGPUParameter>(p_graphics_device, p_descriptor_set_layout, p_buffer_memory_token, p_buffer_memory);
+    return ShadowShaderUniformBufferParameter::allocate<ShaderUniformBufferGPUParameter>(p_graphics_device, p_descriptor_set_layout, p_buffer_memory_token, p_buffer_memory,
+                                                                                         VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, p_buffer_memory.size);
 };
 
 inline void ShaderUniformBufferGPUParameter::free(const GraphicsDevice& p_graphics_device)
@@ -1064,6 +1162,14 @@ struct GraphicsAllocator2
             ShaderLayout::allocate(this->graphics_device, in_shaderlayout_parameter_types.move_to_value(), in_vertex_input_layout.move_to_value(), in_vertex_element_size));
     };
 
+    inline Token(ShaderLayout) allocate_shader_layout_instanced(Span<ShaderLayoutParameterType>& in_shaderlayout_parameter_types, Span<ShaderLayout::VertexInputParameter>& in_vertex_input_layout,
+                                                                const uimax in_vertex_element_size, Span<ShaderLayout::VertexInputParameter>& in_instance_input_layout,
+                                                                const uimax in_instance_element_size)
+    {
+        return this->heap.shader_layouts.alloc_element(ShaderLayout::allocate_instanced(this->graphics_device, in_shaderlayout_parameter_types.move_to_value(), in_vertex_input_layout.move_to_value(),
+                                                                                        in_vertex_element_size, in_instance_input_layout.move_to_value(), in_instance_element_size));
+    };
+
     inline void free_shader_layout(const Token(ShaderLayout) p_shader_layout)
     {
         ShaderLayout& l_shader_layout = this->heap.shader_layouts.get(p_shader_layout);
@@ -1104,6 +1210,15 @@ struct GraphicsAllocator2
         return this->heap.shader_uniform_buffer_host_parameters.alloc_element(l_shader_uniform_buffer_parameter);
     };
 
+    inline Token(ShaderUniformBufferHostParameter) allocate_shaderuniformbufferhost_dynamic_parameter(const Token(BufferHost) p_memory_token, const BufferHost& p_memory, const uimax p_range)
+    {
+        ShaderUniformBufferHostParameter l_shader_uniform_buffer_parameter = ShaderUniformBufferHostParameter::allocate_dynamic(
+            this->graphics_device, this->graphics_device.shaderlayout_parameters.get_descriptorset_layout(ShaderLayoutParameterType::UNIFORM_BUFFER_DYNAMIC_VERTEX), p_memory_token, p_memory,
+            p_range);
+
+        return this->heap.shader_uniform_buffer_host_parameters.alloc_element(l_shader_uniform_buffer_parameter);
+    };
+
     inline void free_shaderuniformbufferhost_parameter(const Token(ShaderUniformBufferHostParameter) p_parameter)
     {
         ShaderUniformBufferHostParameter& l_parameter = this->heap.shader_uniform_buffer_host_parameters.get(p_parameter);
@@ -1111,6 +1226,30 @@ struct GraphicsAllocator2
         this->heap.shader_uniform_buffer_host_parameters.release_element(p_parameter);
     };
 
+    inline Token(ShaderUniformBufferHostFramesParameter) allocate_shaderuniformbufferhost_frames_parameter(const ShaderLayoutParameterType p_shaderlayout_parameter_type, BufferAllocator& p_buffer_allocator,
+                                                                                                           const SliceN<Token(BufferHost), GPUFrame_const::FRAMES_IN_FLIGHT>& p_memory_tokens)
+    {
+        ShaderUniformBufferHostFramesParameter l_parameter;
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            l_parameter.frames.get(i) =
+                this->allocate_shaderuniformbufferhost_parameter(p_shaderlayout_parameter_type, p_memory_tokens.get(i), p_buffer_allocator.host_buffers.get(p_memory_tokens.get(i)));
+            l_parameter.frames_outdated.get(i) = 0;
+        }
+        l_parameter.written_frame = 0;
+        return this->heap.shader_uniform_buffer_host_frames_parameters.alloc_element(l_parameter);
+    };
+
+    inline void free_shaderuniformbufferhost_frames_parameter(const Token(ShaderUniformBufferHostFramesParameter) p_parameter)
+    {
+        ShaderUniformBufferHostFramesParameter& l_parameter = this->heap.shader_uniform_buffer_host_frames_parameters.get(p_parameter);
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            this->free_shaderuniformbufferhost_parameter(l_parameter.frames.get(i));
+        }
+        this->heap.shader_uniform_buffer_host_frames_parameters.release_element(p_parameter);
+    };
+
     inline Token(ShaderUniformBufferGPUParameter)
         allocate_shaderuniformbuffergpu_parameter(const ShaderLayoutParameterType p_shaderlayout_parameter_type, const Token(BufferGPU) p_memory_token, const BufferGPU& p_memory)
     {
@@ -1,5 +1,17 @@
 #pragma once
 
+/*
+    Layout of an indexed draw read from an indirect buffer by the GPU. It matches VkDrawIndexedIndirectCommand.
+*/
+struct DrawIndexedIndirectCommand
+{
+    uint32 indices_count;
+    uint32 instance_count;
+    uint32 first_index;
+    int32 vertex_offset;
+    uint32 first_instance;
+};
+
 /*
 A  GraphicsBinder is a convenient way to properly setup the graphics command buffer.
 */
@@ -37,6 +49,11 @@ struct GraphicsBinder
         this->graphics_allocator.graphics_device.command_buffer.submit_after_and_notify(p_wait_for, p_wait_stage, p_notify);
     };
 
+    inline void submit_after_and_notify_with_fence(const Slice<Semafore>& p_wait_for, const Slice<VkPipelineStageFlags>& p_wait_stages, const Slice<Semafore>& p_notify, const Fence p_fence)
+    {
+        this->graphics_allocator.graphics_device.command_buffer.submit_after_and_notify_with_fence(p_wait_for, p_wait_stages, p_notify, p_fence);
+    };
+
     inline void begin_render_pass(GraphicsPass& p_graphics_pass, const Slice<v4f>& p_clear_values)
     {
 #if GPU_DEBUG
@@ -101,6 +118,16 @@ struct GraphicsBinder
         this->material_set_count += 1;
     };
 
+    inline void bind_shaderbufferhost_dynamic_parameter(const ShaderUniformBufferHostParameter& p_parameter, const uint32 p_dynamic_offset)
+    {
+#if GPU_DEBUG
+        assert_true(this->binded_shader_layout->shader_layout_parameter_types.get(this->material_set_count) == ShaderLayoutParameterType::UNIFORM_BUFFER_DYNAMIC_VERTEX);
+#endif
+        vkCmdBindDescriptorSets(this->graphics_allocator.graphics_device.command_buffer.command_buffer, VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS, this->binded_shader_layout->layout,
+                                this->material_set_count, 1, &p_parameter.descriptor_set, 1, &p_dynamic_offset);
+        this->material_set_count += 1;
+    };
+
     inline void pop_shaderbufferhost_parameter()
     {
         this->material_set_count -= 1;
@@ -141,6 +168,18 @@ struct GraphicsBinder
         vkCmdBindVertexBuffers(this->graphics_allocator.graphics_device.command_buffer.command_buffer, 0, 1, &p_vertex_buffer_host.buffer, &l_offset);
     };
 
+    /*
+        The instance buffer is bound at the vertex binding 1. p_offset is in bytes.
+    */
+    inline void bind_instance_buffer_host(const BufferHost& p_instance_buffer_host, const uimax p_offset)
+    {
+#if GPU_DEBUG
+        assert_true(this->binded_shader_layout->is_instanced());
+#endif
+        VkDeviceSize l_offset = p_offset;
+        vkCmdBindVertexBuffers(this->graphics_allocator.graphics_device.command_buffer.command_buffer, 1, 1, &p_instance_buffer_host.buffer, &l_offset);
+    };
+
     inline void draw(const uimax p_vertex_count)
     {
         vkCmdDraw(this->graphics_allocator.graphics_device.command_buffer.command_buffer, (uint32_t)p_vertex_count, 1, 0, 1);
@@ -151,6 +190,14 @@ struct GraphicsBinder
         vkCmdDrawIndexed(this->graphics_allocator.graphics_device.command_buffer.command_buffer, (uint32_t)p_indices_count, 1, 0, 0, 0);
     };
 
+    /*
+        Draws the DrawIndexedIndirectCommand located at p_offset (in bytes) of the indirect buffer.
+    */
+    inline void draw_indexed_indirect(const BufferHost& p_indirect_buffer_host, const uimax p_offset)
+    {
+        vkCmdDrawIndexedIndirect(this->graphics_allocator.graphics_device.command_buffer.command_buffer, p_indirect_buffer_host.buffer, (VkDeviceSize)p_offset, 1, sizeof(DrawIndexedIndirectCommand));
+    };
+
     inline void draw_offsetted(const uimax p_vertex_count, const uimax p_offset)
     {
         vkCmdDraw(this->graphics_allocator.graphics_device.command_buffer.command_buffer, (uint32_t)p_vertex_count, 1, (uint32)p_offset, 1);
@@ -201,7 +248,19 @@ struct GraphicsBinder
         {
         case ShaderParameter::Type::UNIFORM_HOST:
         {
-            _cmd_bind_uniform_buffer_parameter(p_shader_layout, this->graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(p_shader_parameter.uniform_host).descriptor_set, p_set_number);
+            ShaderUniformBufferHostFramesParameter& l_parameter = this->graphics_allocator.heap.shader_uniform_buffer_host_frames_parameters.get(p_shader_parameter.uniform_host);
+            uimax l_frame_index = this->graphics_allocator.graphics_device.frame_index;
+            // The frame has been waited for before recording, it's copy is no longer read by the GPU
+            if (l_parameter.frames_outdated.get(l_frame_index))
+            {
+                this->buffer_allocator.host_buffers.get(this->graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_parameter.frames.get(l_frame_index)).memory)
+                    .get_mapped_effective_memory()
+                    .copy_memory(this->buffer_allocator.host_buffers.get(this->graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_parameter.frames.get(l_parameter.written_frame)).memory)
+                                     .get_mapped_effective_memory());
+                l_parameter.frames_outdated.get(l_frame_index) = 0;
+            }
+            _cmd_bind_uniform_buffer_parameter(p_shader_layout, this->graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_parameter.frames.get(l_frame_index)).descriptor_set,
+                                               p_set_number);
         }
         break;
         case ShaderParameter::Type::UNIFORM_GPU:
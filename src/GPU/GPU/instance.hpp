@@ -10,6 +10,9 @@ struct GraphicsCard
     VkPhysicalDeviceMemoryProperties device_memory_properties;
     uint32 transfer_queue_family;
     uint32 graphics_queue_family;
+    uimax min_uniform_buffer_offset_alignment;
+    // BC compressed textures can be sampled, otherwise texture ressources decode them when they are allocated
+    int8 texture_compression_bc;
 
     uint32 get_memory_type_index(const VkMemoryRequirements& p_memory_requirements, const VkMemoryPropertyFlags p_properties) const;
 };
@@ -244,7 +247,11 @@ inline GPUInstance GPUInstance::allocate(const Slice<GPUExtension>& p_required_i
             l_queueFamilies.free();
 
             l_gpu.graphics_card.device = l_physical_device;
+            l_gpu.graphics_card.min_uniform_buffer_offset_alignment = (uimax)l_physical_device_properties.limits.minUniformBufferOffsetAlignment;
             vkGetPhysicalDeviceMemoryProperties(l_gpu.graphics_card.device, &l_gpu.graphics_card.device_memory_properties);
+            VkPhysicalDeviceFeatures l_physical_device_features;
+            vkGetPhysicalDeviceFeatures(l_gpu.graphics_card.device, &l_physical_device_features);
+            l_gpu.graphics_card.texture_compression_bc = (int8)l_physical_device_features.textureCompressionBC;
             break;
         }
     }
@@ -262,6 +269,10 @@ inline GPUInstance GPUInstance::allocate(const Slice<GPUExtension>& p_required_i
     l_device_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     l_device_create_info.pQueueCreateInfos = &l_devicequeue_create_info;
     l_device_create_info.queueCreateInfoCount = 1;
+
+    VkPhysicalDeviceFeatures l_enabled_features{};
+    l_enabled_features.textureCompressionBC = (VkBool32)l_gpu.graphics_card.texture_compression_bc;
+    l_device_create_info.pEnabledFeatures = &l_enabled_features;
     
 
 #if GPU_DEBUG
@@ -36,9 +36,7 @@ struct Material
             {
             case ShaderParameter::Type::UNIFORM_HOST:
             {
-                auto& l_shader_parameter = p_graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_shader_paramter.uniform_host);
-                BufferAllocatorComposition::free_buffer_host_and_remove_event_references(p_buffer_memory.allocator, p_buffer_memory.events, l_shader_parameter.memory);
-                p_graphics_allocator.free_shaderuniformbufferhost_parameter(l_shader_paramter.uniform_host);
+                free_buffer_host_parameter(p_graphics_allocator, p_buffer_memory, l_shader_paramter.uniform_host);
             }
             break;
             case ShaderParameter::Type::UNIFORM_GPU:
@@ -73,9 +71,7 @@ struct Material
             {
             case ShaderParameter::Type::UNIFORM_HOST:
             {
-                auto& l_shader_parameter = p_graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_shader_paramter.uniform_host);
-                BufferAllocatorComposition::free_buffer_host_and_remove_event_references(p_buffer_memory.allocator, p_buffer_memory.events, l_shader_parameter.memory);
-                p_graphics_allocator.free_shaderuniformbufferhost_parameter(l_shader_paramter.uniform_host);
+                free_buffer_host_parameter(p_graphics_allocator, p_buffer_memory, l_shader_paramter.uniform_host);
             }
             break;
             case ShaderParameter::Type::UNIFORM_GPU:
@@ -102,7 +98,9 @@ struct Material
         p_graphics_allocator.free_material_parameters(this->parameters);
     };
 
-    inline void add_buffer_host_parameter(GraphicsAllocator2& p_graphics_allocator, const ShaderLayout& p_shader_layout, const Token(BufferHost) p_buffer_token, const BufferHost& p_buffer)
+    // The parameter is allocated with one buffer per frame in flight
+    inline void add_buffer_host_parameter(GraphicsAllocator2& p_graphics_allocator, BufferAllocator& p_buffer_allocator, const ShaderLayout& p_shader_layout,
+                                          const SliceN<Token(BufferHost), GPUFrame_const::FRAMES_IN_FLIGHT>& p_buffer_tokens)
     {
         uimax l_inserted_index = this->set_index_offset + p_graphics_allocator.heap.material_parameters.get_vector(this->parameters).Size;
 
@@ -112,16 +110,20 @@ struct Material
                     p_shader_layout.shader_layout_parameter_types.get(l_inserted_index) == ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX_FRAGMENT);
 #endif
 
-        Token(ShaderUniformBufferHostParameter) l_parameter =
-            p_graphics_allocator.allocate_shaderuniformbufferhost_parameter(p_shader_layout.shader_layout_parameter_types.get(l_inserted_index), p_buffer_token, p_buffer);
+        Token(ShaderUniformBufferHostFramesParameter) l_parameter =
+            p_graphics_allocator.allocate_shaderuniformbufferhost_frames_parameter(p_shader_layout.shader_layout_parameter_types.get(l_inserted_index), p_buffer_allocator, p_buffer_tokens);
 
         p_graphics_allocator.heap.material_parameters.element_push_back_element(this->parameters, ShaderParameter{ShaderParameter::Type::UNIFORM_HOST, tk_v(l_parameter)});
     };
 
     inline void add_and_allocate_buffer_host_parameter(GraphicsAllocator2& p_graphics_allocator, BufferAllocator& p_buffer_allocator, const ShaderLayout& p_shader_layout, const Slice<int8>& p_memory)
     {
-        Token(BufferHost) l_buffer = p_buffer_allocator.allocate_bufferhost(p_memory, BufferUsageFlag::UNIFORM);
-        this->add_buffer_host_parameter(p_graphics_allocator, p_shader_layout, l_buffer, p_buffer_allocator.host_buffers.get(l_buffer));
+        SliceN<Token(BufferHost), GPUFrame_const::FRAMES_IN_FLIGHT> l_buffers;
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            l_buffers.get(i) = p_buffer_allocator.allocate_bufferhost(p_memory, BufferUsageFlag::UNIFORM);
+        }
+        this->add_buffer_host_parameter(p_graphics_allocator, p_buffer_allocator, p_shader_layout, l_buffers);
     };
 
     template <class ElementType>
@@ -131,6 +133,10 @@ struct Material
         this->add_and_allocate_buffer_host_parameter(p_graphics_allocator, p_buffer_allocator, p_shader_layout, Slice<ElementType>::build_asint8_memory_singleelement(&p_memory));
     };
 
+    /*
+        Returns the buffer of the frame that is being recorded, it is the one that the caller writes to.
+        Buffers of the other frames may still be read by the GPU, they are refreshed from this one when their frame binds the Material.
+    */
     inline Token(BufferHost) get_buffer_host_parameter(GraphicsAllocator2& p_graphics_allocator, const uimax p_index)
     {
         ShaderParameter& l_shader_parameter = p_graphics_allocator.heap.material_parameters.get_vector(this->parameters).get(this->set_index_offset + p_index);
@@ -139,7 +145,9 @@ struct Material
         assert_true(l_shader_parameter.type == ShaderParameter::Type::UNIFORM_HOST);
 #endif
 
-        return p_graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_shader_parameter.uniform_host).memory;
+        Token(ShaderUniformBufferHostParameter) l_frame_parameter =
+            p_graphics_allocator.heap.shader_uniform_buffer_host_frames_parameters.get(l_shader_parameter.uniform_host).write_frame(p_graphics_allocator.graphics_device.frame_index);
+        return p_graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_frame_parameter).memory;
     };
 
     inline void add_buffer_gpu_parameter(GraphicsAllocator2& p_graphics_allocator, const ShaderLayout& p_shader_layout, const Token(BufferGPU) p_buffer_gpu_token, const BufferGPU& p_buffer_gpu)
@@ -218,4 +226,16 @@ struct Material
 
         return p_graphics_allocator.heap.shader_texture_gpu_parameters.get(l_shader_parameter.texture_gpu).texture;
     };
+
+  private:
+    inline static void free_buffer_host_parameter(GraphicsAllocator2& p_graphics_allocator, BufferMemory& p_buffer_memory, const Token(ShaderUniformBufferHostFramesParameter) p_parameter)
+    {
+        ShaderUniformBufferHostFramesParameter& l_parameter = p_graphics_allocator.heap.shader_uniform_buffer_host_frames_parameters.get(p_parameter);
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            BufferAllocatorComposition::free_buffer_host_and_remove_event_references(
+                p_buffer_memory.allocator, p_buffer_memory.events, p_graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_parameter.frames.get(i)).memory);
+        }
+        p_graphics_allocator.free_shaderuniformbufferhost_frames_parameter(p_parameter);
+    };
 };
\ No newline at end of file
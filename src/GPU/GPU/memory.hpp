@@ -80,7 +80,8 @@ enum class BufferUsageFlag
     TRANSFER_WRITE = VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_DST_BIT,
     UNIFORM = VkBufferUsageFlagBits::VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
     VERTEX = VkBufferUsageFlagBits::VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-    INDEX = VkBufferUsageFlagBits::VK_BUFFER_USAGE_INDEX_BUFFER_BIT
+    INDEX = VkBufferUsageFlagBits::VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+    INDIRECT = VkBufferUsageFlagBits::VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
 };
 
 enum class BufferIndexType
@@ -185,7 +186,17 @@ struct ImageFormat
 
     static ImageFormat build_color_2d(const v3ui& p_extend, const ImageUsageFlag p_usage);
 
+    static ImageFormat build_color_2d_with_format(const v3ui& p_extend, const VkFormat p_format, const uint32 p_mip_levels, const ImageUsageFlag p_usage);
+
     static ImageFormat build_depth_2d(const v3ui& p_extend, const ImageUsageFlag p_usage);
+
+    v3ui get_mip_level_extent(const uint32 p_mip_level) const;
+
+    // Size of the mip level when it's texel blocks are tightly packed
+    uimax get_mip_level_memory_size(const uint32 p_mip_level) const;
+
+    // Block compressed formats have texel blocks of 4x4 texels, other formats have blocks of a single texel
+    static void get_texel_block(const VkFormat p_format, uint32* out_block_extent, uimax* out_block_size);
 };
 
 #define ShadowImage_t(Prefix) ShadowImage_##Prefix
@@ -753,6 +764,14 @@ inline ImageFormat ImageFormat::build_color_2d(const v3ui& p_extend, const Image
     return l_color_imageformat;
 };
 
+inline ImageFormat ImageFormat::build_color_2d_with_format(const v3ui& p_extend, const VkFormat p_format, const uint32 p_mip_levels, const ImageUsageFlag p_usage)
+{
+    ImageFormat l_color_imageformat = ImageFormat::build_color_2d(p_extend, p_usage);
+    l_color_imageformat.format = p_format;
+    l_color_imageformat.mipLevels = p_mip_levels;
+    return l_color_imageformat;
+};
+
 inline ImageFormat ImageFormat::build_depth_2d(const v3ui& p_extend, const ImageUsageFlag p_usage)
 {
     ImageFormat l_depth_imageformat;
@@ -767,6 +786,56 @@ inline ImageFormat ImageFormat::build_depth_2d(const v3ui& p_extend, const Image
     return l_depth_imageformat;
 };
 
+inline v3ui ImageFormat::get_mip_level_extent(const uint32 p_mip_level) const
+{
+    v3ui l_extent = v3ui{this->extent.x >> p_mip_level, this->extent.y >> p_mip_level, this->extent.z >> p_mip_level};
+    return v3ui{l_extent.x == 0 ? 1 : l_extent.x, l_extent.y == 0 ? 1 : l_extent.y, l_extent.z == 0 ? 1 : l_extent.z};
+};
+
+inline uimax ImageFormat::get_mip_level_memory_size(const uint32 p_mip_level) const
+{
+    uint32 l_block_extent;
+    uimax l_block_size;
+    ImageFormat::get_texel_block(this->format, &l_block_extent, &l_block_size);
+    v3ui l_mip_extent = this->get_mip_level_extent(p_mip_level);
+    return (uimax)((l_mip_extent.x + l_block_extent - 1) / l_block_extent) * (uimax)((l_mip_extent.y + l_block_extent - 1) / l_block_extent) * (uimax)l_mip_extent.z * l_block_size *
+           (uimax)this->arrayLayers;
+};
+
+inline void ImageFormat::get_texel_block(const VkFormat p_format, uint32* out_block_extent, uimax* out_block_size)
+{
+    switch (p_format)
+    {
+    case VkFormat::VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VkFormat::VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VkFormat::VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VkFormat::VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        *out_block_extent = 4;
+        *out_block_size = 8;
+        break;
+    case VkFormat::VK_FORMAT_BC3_UNORM_BLOCK:
+    case VkFormat::VK_FORMAT_BC3_SRGB_BLOCK:
+    case VkFormat::VK_FORMAT_BC7_UNORM_BLOCK:
+    case VkFormat::VK_FORMAT_BC7_SRGB_BLOCK:
+        *out_block_extent = 4;
+        *out_block_size = 16;
+        break;
+    case VkFormat::VK_FORMAT_D16_UNORM:
+        *out_block_extent = 1;
+        *out_block_size = 2;
+        break;
+    case VkFormat::VK_FORMAT_R8G8B8A8_UNORM:
+    case VkFormat::VK_FORMAT_R8G8B8A8_SRGB:
+    case VkFormat::VK_FORMAT_B8G8R8A8_UNORM:
+    case VkFormat::VK_FORMAT_B8G8R8A8_SRGB:
+        *out_block_extent = 1;
+        *out_block_size = 4;
+        break;
+    default:
+        abort();
+    }
+};
+
 inline ImageHost ImageHost::allocate(TransferDevice& p_transfer_device, const ImageFormat& p_image_format, const VkImageLayout p_initial_layout)
 {
     ImageHost l_image_host;
@@ -1348,7 +1417,9 @@ inline void BufferStep::clean_garbage_buffers(BufferAllocator& p_buffer_allocato
 {
     for (loop(i, 0, p_buffer_events.garbage_host_buffers.Size))
     {
-        p_buffer_allocator.free_bufferhost(p_buffer_events.garbage_host_buffers.get(i));
+        Token(BufferHost) l_staging_buffer = p_buffer_events.garbage_host_buffers.get(i);
+        memory_statistics_remove_external(MemoryTag::GPU_STAGING, p_buffer_allocator.host_buffers.get(l_staging_buffer).size);
+        p_buffer_allocator.free_bufferhost(l_staging_buffer);
     }
 
     p_buffer_events.garbage_host_buffers.clear();
@@ -1403,6 +1474,7 @@ inline void BufferAllocatorComposition::free_image_gpu_and_remove_event_referenc
 inline void BufferReadWrite::write_to_buffergpu(BufferAllocator& p_buffer_allocator, BufferEvents& p_buffer_events, const Token(BufferGPU) p_buffer_gpu, const Slice<int8>& p_value)
 {
     Token(BufferHost) l_staging_buffer = p_buffer_allocator.allocate_bufferhost(p_value, BufferUsageFlag::TRANSFER_READ);
+    memory_statistics_push_external(MemoryTag::GPU_STAGING, p_value.Size);
     p_buffer_events.write_buffer_host_to_buffer_gpu_events.push_back_element(BufferEvents::WriteBufferHostToBufferGPU{l_staging_buffer, 1, p_buffer_gpu});
 };
 
@@ -1418,6 +1490,7 @@ inline void BufferReadWrite::write_to_imagegpu(BufferAllocator& p_buffer_allocat
                                                const Slice<int8>& p_value)
 {
     Token(BufferHost) l_stagin_buffer = p_buffer_allocator.allocate_bufferhost(p_value, BufferUsageFlag::TRANSFER_READ);
+    memory_statistics_push_external(MemoryTag::GPU_STAGING, p_value.Size);
     p_buffer_events.write_buffer_host_to_image_gpu_events.push_back_element(BufferEvents::WriteBufferHostToImageGPU{l_stagin_buffer, 1, p_image_gpu_token});
 };
 
@@ -1476,11 +1549,27 @@ inline void BufferCommandUtils::cmd_copy_buffer_host_to_image_gpu(const CommandB
 
     BufferCommandUtils::cmd_image_layout_transition_v2(p_command_buffer, p_barriers, p_gpu, p_gpu.format.imageUsage, ImageUsageFlag::TRANSFER_WRITE);
 
-    VkBufferImageCopy l_buffer_image_copy{};
-    l_buffer_image_copy.imageSubresource = VkImageSubresourceLayers{p_gpu.format.imageAspect, 0, 0, (uint32_t)p_gpu.format.arrayLayers};
-    l_buffer_image_copy.imageExtent = VkExtent3D{(uint32_t)p_gpu.format.extent.x, (uint32_t)p_gpu.format.extent.y, (uint32_t)p_gpu.format.extent.z};
+    // The buffer contains all mip levels one after the other, from the mip 0 to the last mip
+    Span<VkBufferImageCopy> l_buffer_image_copies = Span<VkBufferImageCopy>::allocate(p_gpu.format.mipLevels);
+    uimax l_buffer_offset = 0;
+    for (loop(i, 0, p_gpu.format.mipLevels))
+    {
+        v3ui l_mip_extent = p_gpu.format.get_mip_level_extent((uint32)i);
+        VkBufferImageCopy& l_buffer_image_copy = l_buffer_image_copies.get(i);
+        l_buffer_image_copy = VkBufferImageCopy{};
+        l_buffer_image_copy.bufferOffset = l_buffer_offset;
+        l_buffer_image_copy.imageSubresource = VkImageSubresourceLayers{p_gpu.format.imageAspect, (uint32_t)i, 0, (uint32_t)p_gpu.format.arrayLayers};
+        l_buffer_image_copy.imageExtent = VkExtent3D{(uint32_t)l_mip_extent.x, (uint32_t)l_mip_extent.y, (uint32_t)l_mip_extent.z};
+        l_buffer_offset += p_gpu.format.get_mip_level_memory_size((uint32)i);
+    }
+
+#if CONTAINER_MEMORY_TEST
+    assert_true(l_buffer_offset <= p_host.size);
+#endif
 
-    vkCmdCopyBufferToImage(p_command_buffer.command_buffer, p_host.buffer, p_gpu.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &l_buffer_image_copy);
+    vkCmdCopyBufferToImage(p_command_buffer.command_buffer, p_host.buffer, p_gpu.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)l_buffer_image_copies.Capacity,
+                           l_buffer_image_copies.Memory);
+    l_buffer_image_copies.free();
 
     BufferCommandUtils::cmd_image_layout_transition_v2(p_command_buffer, p_barriers, p_gpu, ImageUsageFlag::TRANSFER_WRITE, p_gpu.format.imageUsage);
 };
@@ -1516,7 +1605,7 @@ inline void BufferCommandUtils::cmd_image_layout_transition_v2(const CommandBuff
     l_image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     l_image_memory_barrier.image = ShadowImage_c_get_image(&p_image);
 
-    l_image_memory_barrier.subresourceRange = VkImageSubresourceRange{ShadowImage_c_get_format(&p_image).imageAspect, 0, (uint32_t)ShadowImage_c_get_format(&p_image).arrayLayers, 0,
+    l_image_memory_barrier.subresourceRange = VkImageSubresourceRange{ShadowImage_c_get_format(&p_image).imageAspect, 0, (uint32_t)ShadowImage_c_get_format(&p_image).mipLevels, 0,
                                                                       (uint32_t)ShadowImage_c_get_format(&p_image).arrayLayers};
 
     ImageLayoutTransitionBarrierConfiguration l_layout_barrier = p_barriers.get_barrier(p_source_image_usage, p_target_image_usage);
@@ -135,7 +135,9 @@ struct GPUPresent_2DQuad
 struct GPUPresent_SwapChain
 {
     VkSwapchainKHR swap_chain;
-    Semafore swap_chain_next_image_semaphore;
+    // One acquire semaphore per frame in flight, the previous one may still be awaited by the presentation of the previous frame.
+    SliceN<Semafore, GPUFrame_const::FRAMES_IN_FLIGHT> swap_chain_next_image_semaphores;
+    uimax swap_chain_next_image_semaphore_index;
 
     v3ui swap_chain_dimensions;
     Span<Token(ImageGPU)> swap_chain_images;
@@ -173,7 +175,11 @@ struct GPUPresent_SwapChain
     inline static void allocate_swap_chain_texture_independant(GPUPresent_SwapChain& p_swap_chain, GPUPresentDevice& p_present_device, GraphicsAllocator2& p_graphics_allocator,
                                                                const Token(TextureGPU) p_presented_texture, const Slice<int8>& p_compiled_vertex_shader, const Slice<int8>& p_compiled_fragment_shader)
     {
-        p_swap_chain.swap_chain_next_image_semaphore = Semafore::allocate(p_present_device.device);
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            p_swap_chain.swap_chain_next_image_semaphores.get(i) = Semafore::allocate(p_present_device.device);
+        }
+        p_swap_chain.swap_chain_next_image_semaphore_index = 0;
 
         Span<ShaderLayoutParameterType> l_shader_parameter_layout =
             Span<ShaderLayoutParameterType>::allocate_slice(SliceN<ShaderLayoutParameterType, 1>{ShaderLayoutParameterType::TEXTURE_FRAGMENT}.to_slice());
@@ -193,7 +199,10 @@ struct GPUPresent_SwapChain
     inline static void free_swap_chain_texture_independant(GPUPresent_SwapChain& p_swap_chain, GPUPresentDevice& p_present_device, BufferMemory& p_buffer_memory,
                                                            GraphicsAllocator2& p_graphics_allocator)
     {
-        p_swap_chain.swap_chain_next_image_semaphore.free(p_present_device.device);
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            p_swap_chain.swap_chain_next_image_semaphores.get(i).free(p_present_device.device);
+        }
 
         p_graphics_allocator.free_shadertexturegpu_parameter(p_buffer_memory.allocator.device, p_swap_chain.shader_parameter_texture,
                                                              p_graphics_allocator.heap.shader_texture_gpu_parameters.get(p_swap_chain.shader_parameter_texture));
@@ -320,7 +329,9 @@ struct GPUPresent
         BufferCommandUtils::cmd_image_layout_transition_v2(p_graphics_binder.graphics_allocator.graphics_device.command_buffer, p_graphics_binder.buffer_allocator.image_layout_barriers,
                                                            l_presented_image, l_presented_image.format.imageUsage, ImageUsageFlag::SHADER_TEXTURE_PARAMETER);
 
-        vk_handle_result(vkAcquireNextImageKHR(this->device.device, this->swap_chain.swap_chain, 0, this->swap_chain.swap_chain_next_image_semaphore.semaphore, VK_NULL_HANDLE,
+        this->swap_chain.swap_chain_next_image_semaphore_index = (this->swap_chain.swap_chain_next_image_semaphore_index + 1) % GPUFrame_const::FRAMES_IN_FLIGHT;
+        vk_handle_result(vkAcquireNextImageKHR(this->device.device, this->swap_chain.swap_chain, 0,
+                                               this->swap_chain.swap_chain_next_image_semaphores.get(this->swap_chain.swap_chain_next_image_semaphore_index).semaphore, VK_NULL_HANDLE,
                                                &this->current_swapchain_image_index));
 
         p_graphics_binder.begin_render_pass(p_graphics_binder.graphics_allocator.heap.graphics_pass.get(this->swap_chain.rendertarget_copy_pass.get(this->current_swapchain_image_index)),
@@ -337,7 +348,8 @@ struct GPUPresent
 
     inline void present(const Semafore& p_awaited_semaphore)
     {
-        Slice<Semafore> l_awaited_semaphores = SliceN<Semafore, 2>{this->swap_chain.swap_chain_next_image_semaphore, p_awaited_semaphore}.to_slice();
+        Slice<Semafore> l_awaited_semaphores =
+            SliceN<Semafore, 2>{this->swap_chain.swap_chain_next_image_semaphores.get(this->swap_chain.swap_chain_next_image_semaphore_index), p_awaited_semaphore}.to_slice();
 
         VkPresentInfoKHR l_present_info{};
         l_present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -2,6 +2,7 @@
 
 struct obb;
 struct aabb;
+struct obb_batch;
 
 struct aabb
 {
@@ -23,6 +24,30 @@ struct obb
     inline int8 overlap(const obb& p_other) const;
     inline int8 overlap1(const obb& p_other) const;
     inline int8 overlap2(const obb& p_other) const;
+
+    /*
+        Tests this obb against all obbs of the batch at once.
+        Bit i of the returned mask is set if this obb overlaps the obb of the lane i. Results are the same as overlap2.
+    */
+    inline uint32 overlap2_batch(const obb_batch& p_others) const;
+};
+
+/*
+    Up to simd_f32::Width obbs stored as structure of arrays, one obb per lane.
+    Radii are stored oriented by the obb axis, as they are used by the SAT tests.
+*/
+struct obb_batch
+{
+    float32 center[3][simd_f32::Width];
+    float32 axis[3][3][simd_f32::Width];
+    float32 radii_oriented[3][3][simd_f32::Width];
+    uimax count;
+
+    inline static obb_batch build_empty();
+    inline void push_back(const obb& p_obb);
+    inline int8 is_full() const;
+    // Lanes are not zeroed, they are excluded from overlap results by the count
+    inline void clear();
 };
 
 struct SAT
@@ -52,6 +77,21 @@ struct SAT
     */
     inline static int8 L_origin_oriented_R_oriented_symetricalshapes(const m33f& p_left_radii_oriented, const v3f& p_right_center_relative_to_left, const m33f& p_right_radii_oriented,
                                                                      const v3f& p_tested_axis);
+
+    /*
+        L_origin_oriented_R_oriented_symetricalshapes done for every lane, vectors are stored by component.
+        p_greater_eq_tolerance is the float32 equivalent of the Math::greater_eq tolerance.
+        Bit i of the returned mask is set if the shapes of the lane i doesn't intersect along the tested axis.
+    */
+    inline static uint32 L_origin_oriented_R_oriented_symetricalshapes_batch(const simd_f32 p_left_radii_oriented[3][3], const simd_f32 p_right_center_relative_to_left[3],
+                                                                             const simd_f32 p_right_radii_oriented[3][3], const simd_f32 p_tested_axis[3],
+                                                                             const simd_f32& p_greater_eq_tolerance);
+
+    /*
+        Math::greater_eq compares the float32 difference with a float64 tolerance.
+        This is the smallest float32 that passes the same comparison.
+    */
+    inline static float32 greater_eq_tolerance_f32();
 };
 
 struct GeometryUtil
@@ -196,6 +236,96 @@ inline int8 obb::overlap2(const obb& p_other) const
     return 1;
 };
 
+inline uint32 obb::overlap2_batch(const obb_batch& p_others) const
+{
+    simd_f32 l_this_box_radii_oriented[3][3];
+    simd_f32 l_this_axis[3][3];
+    simd_f32 l_other_radii_oriented[3][3];
+    simd_f32 l_other_axis[3][3];
+    for (int8 i = 0; i < 3; i++)
+    {
+        v3f l_this_radii_oriented = (this->axis.Points2D[i] * this->box.radiuses);
+        for (int8 j = 0; j < 3; j++)
+        {
+            l_this_box_radii_oriented[i][j] = simd_f32::build_broadcast(l_this_radii_oriented.Points[j]);
+            l_this_axis[i][j] = simd_f32::build_broadcast(this->axis.Points2D[i].Points[j]);
+            l_other_radii_oriented[i][j] = simd_f32::build_load(p_others.radii_oriented[i][j]);
+            l_other_axis[i][j] = simd_f32::build_load(p_others.axis[i][j]);
+        }
+    }
+
+    simd_f32 l_other_center_relative_to_this[3];
+    for (int8 j = 0; j < 3; j++)
+    {
+        l_other_center_relative_to_this[j] = simd_f32::build_load(p_others.center[j]) - simd_f32::build_broadcast(this->box.center.Points[j]);
+    }
+
+    simd_f32 l_tolerance = simd_f32::build_broadcast(SAT::greater_eq_tolerance_f32());
+
+    // Axis are tested in the same order as overlap2
+    uint32 l_not_overlapping = 0;
+    for (int8 i = 0; i < 3; i++)
+    {
+        l_not_overlapping |=
+            SAT::L_origin_oriented_R_oriented_symetricalshapes_batch(l_this_box_radii_oriented, l_other_center_relative_to_this, l_other_radii_oriented, l_this_axis[i], l_tolerance);
+    }
+    for (int8 i = 0; i < 3; i++)
+    {
+        l_not_overlapping |=
+            SAT::L_origin_oriented_R_oriented_symetricalshapes_batch(l_this_box_radii_oriented, l_other_center_relative_to_this, l_other_radii_oriented, l_other_axis[i], l_tolerance);
+    }
+    for (int8 i = 0; i < 3; i++)
+    {
+        const simd_f32* l_left = l_this_axis[i];
+        for (int8 j = 0; j < 3; j++)
+        {
+            const simd_f32* l_right = l_other_axis[j];
+            simd_f32 l_cross[3] = {(l_left[1] * l_right[2]) - (l_left[2] * l_right[1]), (l_left[2] * l_right[0]) - (l_left[0] * l_right[2]),
+                                   (l_left[0] * l_right[1]) - (l_left[1] * l_right[0])};
+            l_not_overlapping |=
+                SAT::L_origin_oriented_R_oriented_symetricalshapes_batch(l_this_box_radii_oriented, l_other_center_relative_to_this, l_other_radii_oriented, l_cross, l_tolerance);
+        }
+    }
+
+    return (~l_not_overlapping) & simd_f32::lanes_mask(p_others.count);
+};
+
+inline obb_batch obb_batch::build_empty()
+{
+    obb_batch l_batch;
+    // Unused lanes are zeroed so that they never hold invalid floats
+    memory_zero((int8*)&l_batch, sizeof(l_batch));
+    return l_batch;
+};
+
+inline void obb_batch::push_back(const obb& p_obb)
+{
+#if CONTAINER_BOUND_TEST
+    assert_true(!this->is_full());
+#endif
+    for (int8 i = 0; i < 3; i++)
+    {
+        v3f l_radii_oriented = (p_obb.axis.Points2D[i] * p_obb.box.radiuses);
+        this->center[i][this->count] = p_obb.box.center.Points[i];
+        for (int8 j = 0; j < 3; j++)
+        {
+            this->axis[i][j][this->count] = p_obb.axis.Points2D[i].Points[j];
+            this->radii_oriented[i][j][this->count] = l_radii_oriented.Points[j];
+        }
+    }
+    this->count += 1;
+};
+
+inline int8 obb_batch::is_full() const
+{
+    return this->count == simd_f32::Width;
+};
+
+inline void obb_batch::clear()
+{
+    this->count = 0;
+};
+
 // see Christer_Ericson-Real-Time_Collision_Detection-EN
 #if 0
 inline int8 obb::overlap2(const obb& p_other) const
@@ -327,6 +457,40 @@ inline int8 SAT::L_oriented_R_oriented_symetricalshapes(const v3f& p_left_center
     return Math::greater_eq(l_tl, l_left_radii_projected + l_right_radii_projected);
 };
 
+inline uint32 SAT::L_origin_oriented_R_oriented_symetricalshapes_batch(const simd_f32 p_left_radii_oriented[3][3], const simd_f32 p_right_center_relative_to_left[3],
+                                                                      const simd_f32 p_right_radii_oriented[3][3], const simd_f32 p_tested_axis[3],
+                                                                      const simd_f32& p_greater_eq_tolerance)
+{
+    // Operations are done in the same order as v3f::dot so that results are identical to the scalar version
+    simd_f32 l_left_radii_projected[3];
+    simd_f32 l_right_radii_projected[3];
+    for (int8 j = 0; j < 3; j++)
+    {
+        l_left_radii_projected[j] = ((p_left_radii_oriented[j][0] * p_tested_axis[0]) + (p_left_radii_oriented[j][1] * p_tested_axis[1]) + (p_left_radii_oriented[j][2] * p_tested_axis[2])).abs();
+        l_right_radii_projected[j] =
+            ((p_right_radii_oriented[j][0] * p_tested_axis[0]) + (p_right_radii_oriented[j][1] * p_tested_axis[1]) + (p_right_radii_oriented[j][2] * p_tested_axis[2])).abs();
+    }
+
+    simd_f32 l_left_radii_sum = (l_left_radii_projected[0] + l_left_radii_projected[1]) + l_left_radii_projected[2];
+    simd_f32 l_right_radii_sum = (l_right_radii_projected[0] + l_right_radii_projected[1]) + l_right_radii_projected[2];
+
+    simd_f32 l_tl = ((p_right_center_relative_to_left[0] * p_tested_axis[0]) + (p_right_center_relative_to_left[1] * p_tested_axis[1]) +
+                     (p_right_center_relative_to_left[2] * p_tested_axis[2]))
+                        .abs();
+
+    return (l_tl - (l_left_radii_sum + l_right_radii_sum)).greater_eq_mask(p_greater_eq_tolerance);
+};
+
+inline float32 SAT::greater_eq_tolerance_f32()
+{
+    float32 l_tolerance = (float32)Limits::tol_f;
+    if ((float64)l_tolerance < Limits::tol_f)
+    {
+        l_tolerance = nextafterf(l_tolerance, FLT_MAX);
+    }
+    return l_tolerance;
+};
+
 inline int8 SAT::L_origin_oriented_R_oriented_symetricalshapes(const m33f& p_left_radii_oriented, const v3f& p_right_center_relative_to_left, const m33f& p_right_radii_oriented,
                                                                const v3f& p_tested_axis)
 {
@@ -7,6 +7,7 @@
 
 #include "./definitions.hpp"
 #include "./kernel.hpp"
+#include "./simd.hpp"
 #include "./geometry.hpp"
 
 #include "./serialization.hpp"
\ No newline at end of file
@@ -0,0 +1,213 @@
+#pragma once
+
+/*
+    The SIMD instruction set is chosen at compile time from the target architecture.
+    MATH_SIMD_FORCE_SCALAR can be set to 1 to use the scalar fallback on any architecture.
+*/
+#ifndef MATH_SIMD_FORCE_SCALAR
+#define MATH_SIMD_FORCE_SCALAR 0
+#endif
+
+#if !MATH_SIMD_FORCE_SCALAR && defined(__AVX2__)
+#define MATH_SIMD_AVX2 1
+#define MATH_SIMD_SSE 0
+#elif !MATH_SIMD_FORCE_SCALAR && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATH_SIMD_AVX2 0
+#define MATH_SIMD_SSE 1
+#else
+#define MATH_SIMD_AVX2 0
+#define MATH_SIMD_SSE 0
+#endif
+
+#if MATH_SIMD_AVX2 || MATH_SIMD_SSE
+#include <immintrin.h>
+#endif
+
+/*
+    A register of simd_f32::Width float32 lanes.
+    Operations are done independently on every lane, with the same rounding as the equivalent float32 scalar operation.
+*/
+struct simd_f32
+{
+#if MATH_SIMD_AVX2
+    static constexpr uimax Width = 8;
+    __m256 value;
+#elif MATH_SIMD_SSE
+    static constexpr uimax Width = 4;
+    __m128 value;
+#else
+    static constexpr uimax Width = 4;
+    float32 value[Width];
+#endif
+
+    inline static simd_f32 build_broadcast(const float32 p_value);
+
+    // p_values must point to Width float32
+    inline static simd_f32 build_load(const float32* p_values);
+
+    inline simd_f32 operator+(const simd_f32& p_other) const;
+    inline simd_f32 operator-(const simd_f32& p_other) const;
+    inline simd_f32 operator*(const simd_f32& p_other) const;
+    inline simd_f32 abs() const;
+
+    // Bit i of the returned mask is set if lane i of this is greater or equal to the lane i of p_other
+    inline uint32 greater_eq_mask(const simd_f32& p_other) const;
+
+    inline static uint32 lanes_mask(const uimax p_lane_count);
+};
+
+#if MATH_SIMD_AVX2
+
+inline simd_f32 simd_f32::build_broadcast(const float32 p_value)
+{
+    return simd_f32{_mm256_set1_ps(p_value)};
+};
+
+inline simd_f32 simd_f32::build_load(const float32* p_values)
+{
+    return simd_f32{_mm256_loadu_ps(p_values)};
+};
+
+inline simd_f32 simd_f32::operator+(const simd_f32& p_other) const
+{
+    return simd_f32{_mm256_add_ps(this->value, p_other.value)};
+};
+
+inline simd_f32 simd_f32::operator-(const simd_f32& p_other) const
+{
+    return simd_f32{_mm256_sub_ps(this->value, p_other.value)};
+};
+
+inline simd_f32 simd_f32::operator*(const simd_f32& p_other) const
+{
+    return simd_f32{_mm256_mul_ps(this->value, p_other.value)};
+};
+
+inline simd_f32 simd_f32::abs() const
+{
+    return simd_f32{_mm256_andnot_ps(_mm256_set1_ps(-0.0f), this->value)};
+};
+
+inline uint32 simd_f32::greater_eq_mask(const simd_f32& p_other) const
+{
+    return (uint32)_mm256_movemask_ps(_mm256_cmp_ps(this->value, p_other.value, _CMP_GE_OQ));
+};
+
+#elif MATH_SIMD_SSE
+
+inline simd_f32 simd_f32::build_broadcast(const float32 p_value)
+{
+    return simd_f32{_mm_set1_ps(p_value)};
+};
+
+inline simd_f32 simd_f32::build_load(const float32* p_values)
+{
+    return simd_f32{_mm_loadu_ps(p_values)};
+};
+
+inline simd_f32 simd_f32::operator+(const simd_f32& p_other) const
+{
+    return simd_f32{_mm_add_ps(this->value, p_other.value)};
+};
+
+inline simd_f32 simd_f32::operator-(const simd_f32& p_other) const
+{
+    return simd_f32{_mm_sub_ps(this->value, p_other.value)};
+};
+
+inline simd_f32 simd_f32::operator*(const simd_f32& p_other) const
+{
+    return simd_f32{_mm_mul_ps(this->value, p_other.value)};
+};
+
+inline simd_f32 simd_f32::abs() const
+{
+    return simd_f32{_mm_andnot_ps(_mm_set1_ps(-0.0f), this->value)};
+};
+
+inline uint32 simd_f32::greater_eq_mask(const simd_f32& p_other) const
+{
+    return (uint32)_mm_movemask_ps(_mm_cmpge_ps(this->value, p_other.value));
+};
+
+#else
+
+inline simd_f32 simd_f32::build_broadcast(const float32 p_value)
+{
+    simd_f32 l_return;
+    for (loop(i, 0, Width))
+    {
+        l_return.value[i] = p_value;
+    }
+    return l_return;
+};
+
+inline simd_f32 simd_f32::build_load(const float32* p_values)
+{
+    simd_f32 l_return;
+    for (loop(i, 0, Width))
+    {
+        l_return.value[i] = p_values[i];
+    }
+    return l_return;
+};
+
+inline simd_f32 simd_f32::operator+(const simd_f32& p_other) const
+{
+    simd_f32 l_return;
+    for (loop(i, 0, Width))
+    {
+        l_return.value[i] = this->value[i] + p_other.value[i];
+    }
+    return l_return;
+};
+
+inline simd_f32 simd_f32::operator-(const simd_f32& p_other) const
+{
+    simd_f32 l_return;
+    for (loop(i, 0, Width))
+    {
+        l_return.value[i] = this->value[i] - p_other.value[i];
+    }
+    return l_return;
+};
+
+inline simd_f32 simd_f32::operator*(const simd_f32& p_other) const
+{
+    simd_f32 l_return;
+    for (loop(i, 0, Width))
+    {
+        l_return.value[i] = this->value[i] * p_other.value[i];
+    }
+    return l_return;
+};
+
+inline simd_f32 simd_f32::abs() const
+{
+    simd_f32 l_return;
+    for (loop(i, 0, Width))
+    {
+        l_return.value[i] = fabsf(this->value[i]);
+    }
+    return l_return;
+};
+
+inline uint32 simd_f32::greater_eq_mask(const simd_f32& p_other) const
+{
+    uint32 l_mask = 0;
+    for (loop(i, 0, Width))
+    {
+        if (this->value[i] >= p_other.value[i])
+        {
+            l_mask |= (1 << i);
+        }
+    }
+    return l_mask;
+};
+
+#endif
+
+inline uint32 simd_f32::lanes_mask(const uimax p_lane_count)
+{
+    return (uint32)((1 << p_lane_count) - 1);
+};
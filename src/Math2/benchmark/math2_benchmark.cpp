@@ -0,0 +1,79 @@
+#include "Math2/math.hpp"
+#include "test_random_geometry.hpp"
+
+/*
+    OBB vs OBB SAT throughput of obb::overlap2 compared to obb::overlap2_batch.
+    Every left obb is tested against all right obbs, the number of overlapping pairs is printed to check that both tests agree.
+*/
+
+const uimax math2_benchmark_left_count = 1024;
+const uimax math2_benchmark_right_count = 1024;
+const uimax math2_benchmark_iteration_count = 8;
+
+int main()
+{
+    Span<obb> l_lefts = Span<obb>::allocate(math2_benchmark_left_count);
+    Span<obb> l_rights = Span<obb>::allocate(math2_benchmark_right_count);
+    uimax l_batch_count = (math2_benchmark_right_count + simd_f32::Width - 1) / simd_f32::Width;
+    Span<obb_batch> l_right_batches = Span<obb_batch>::allocate(l_batch_count);
+
+    uint32 l_seed = 4242;
+    for (loop(i, 0, l_lefts.Capacity))
+    {
+        l_lefts.get(i) = test_random_obb(&l_seed, 8.0f);
+    }
+    for (loop(i, 0, l_batch_count))
+    {
+        l_right_batches.get(i) = obb_batch::build_empty();
+    }
+    for (loop(i, 0, l_rights.Capacity))
+    {
+        l_rights.get(i) = test_random_obb(&l_seed, 8.0f);
+        l_right_batches.get(i / simd_f32::Width).push_back(l_rights.get(i));
+    }
+
+    uimax l_pair_count = math2_benchmark_left_count * math2_benchmark_right_count * math2_benchmark_iteration_count;
+
+    uimax l_scalar_overlap_count = 0;
+    time_t l_begin = clock_currenttime_mics();
+    for (loop(l_iteration, 0, math2_benchmark_iteration_count))
+    {
+        for (loop(i, 0, l_lefts.Capacity))
+        {
+            for (loop(j, 0, l_rights.Capacity))
+            {
+                l_scalar_overlap_count += l_lefts.get(i).overlap2(l_rights.get(j));
+            }
+        }
+    }
+    float64 l_scalar_time = (float64)(clock_currenttime_mics() - l_begin) / 1000000.0;
+
+    uimax l_batch_overlap_count = 0;
+    l_begin = clock_currenttime_mics();
+    for (loop(l_iteration, 0, math2_benchmark_iteration_count))
+    {
+        for (loop(i, 0, l_lefts.Capacity))
+        {
+            for (loop(j, 0, l_batch_count))
+            {
+                uint32 l_overlaps = l_lefts.get(i).overlap2_batch(l_right_batches.get(j));
+                for (loop(l_lane, 0, simd_f32::Width))
+                {
+                    l_batch_overlap_count += (l_overlaps >> l_lane) & 1;
+                }
+            }
+        }
+    }
+    float64 l_batch_time = (float64)(clock_currenttime_mics() - l_begin) / 1000000.0;
+
+    const int8* l_backend = MATH_SIMD_AVX2 ? "AVX2" : (MATH_SIMD_SSE ? "SSE" : "scalar");
+    printf("pairs: %lld, batch width: %lld (%s)\n", (long long)l_pair_count, (long long)simd_f32::Width, l_backend);
+    printf("overlap2       : %f Mpairs/s, %lld overlapping\n", ((float64)l_pair_count / l_scalar_time) / 1000000.0, (long long)l_scalar_overlap_count);
+    printf("overlap2_batch : %f Mpairs/s, %lld overlapping\n", ((float64)l_pair_count / l_batch_time) / 1000000.0, (long long)l_batch_overlap_count);
+
+    l_right_batches.free();
+    l_rights.free();
+    l_lefts.free();
+
+    memleak_ckeck();
+};
@@ -1,5 +1,6 @@
 
 #include "Math2/math.hpp"
+#include "test_random_geometry.hpp"
 
 inline void math_tests()
 {
@@ -69,6 +70,50 @@ inline void assert_obb_overlap(const obb& p_left, const obb& p_right, const int8
     assert_true(p_left.overlap(p_right) == p_overlap_result);
     assert_true(p_left.overlap1(p_right) == p_overlap_result);
     assert_true(p_left.overlap2(p_right) == p_overlap_result);
+
+    obb_batch l_batch = obb_batch::build_empty();
+    l_batch.push_back(p_right);
+    assert_true(p_left.overlap2_batch(l_batch) == (uint32)p_overlap_result);
+};
+
+/*
+    The batch SAT test must give the same result as overlap2 for every lane, including partially filled batches.
+*/
+inline void obb_overlap_batch()
+{
+    uint32 l_seed = 98765;
+    uimax l_overlap_count = 0;
+    for (loop(l_iteration, 0, 512))
+    {
+        obb l_left = test_random_obb(&l_seed, 4.0f);
+        obb l_rights[simd_f32::Width];
+        uimax l_right_count = (l_iteration % simd_f32::Width) + 1;
+
+        obb_batch l_batch = obb_batch::build_empty();
+        for (loop(i, 0, l_right_count))
+        {
+            l_rights[i] = test_random_obb(&l_seed, 4.0f);
+            l_batch.push_back(l_rights[i]);
+        }
+
+        uint32 l_batch_result = l_left.overlap2_batch(l_batch);
+        for (loop(i, 0, simd_f32::Width))
+        {
+            int8 l_batch_overlap = (l_batch_result >> i) & 1;
+            if (i < l_right_count)
+            {
+                assert_true(l_batch_overlap == l_left.overlap2(l_rights[i]));
+                l_overlap_count += l_batch_overlap;
+            }
+            else
+            {
+                assert_true(l_batch_overlap == 0);
+            }
+        }
+    }
+
+    // Both overlapping and not overlapping pairs have been tested
+    assert_true(l_overlap_count != 0);
 };
 
 inline void geometry(){
@@ -102,6 +147,7 @@ int main()
     math_tests();
     color_tests();
     geometry();
+    obb_overlap_batch();
 
     memleak_ckeck();
 };
\ No newline at end of file
@@ -19,6 +19,8 @@ struct ShaderIndex
     uimax execution_order;
     Token(Shader) shader_index;
     Token(ShaderLayout) shader_layout;
+    // The model matrix is read as a per instance vertex input instead of a uniform buffer (see D3RendererInstancedDraws)
+    int8 instanced;
 };
 
 struct Mesh
@@ -26,11 +28,12 @@ struct Mesh
     Token(BufferGPU) vertices_buffer;
     Token(BufferGPU) indices_buffer;
     uimax indices_count;
+    BufferIndexType index_type;
 };
 
 struct RenderableObject
 {
-    Token(ShaderUniformBufferHostParameter) model;
+    Token(m44f) model;
     Token(Mesh) mesh;
 };
 
@@ -40,6 +43,7 @@ struct D3RendererHeap
     Pool<Material> materials;
     Pool<Mesh> meshes;
     Pool<RenderableObject> renderable_objects;
+    Pool<m44f> model_matrices;
 
     Vector<Token(ShaderIndex)> shaders_indexed;
     PoolOfVector<Token(Material)> shaders_to_materials;
@@ -51,7 +55,9 @@ struct D3RendererHeap
         m44f model_matrix;
     };
 
-    Vector<RenderableObject_ModelUpdateEvent> model_update_events;
+    // Events are pushed and consumed by the buffer_step of the same frame, they are allocated from the frame arena of the thread running the frame
+    Vector<RenderableObject_ModelUpdateEvent, FrameAllocator> model_update_events;
+    int8 model_matrices_changed;
 
     static D3RendererHeap allocate();
 
@@ -72,6 +78,9 @@ struct D3RendererHeap
     PoolOfVector<Token(RenderableObject)>::Element_ShadowVector get_renderableobjects_from_material(const Token(Material) p_material);
 
     void push_modelupdateevent(const RenderableObject_ModelUpdateEvent& p_modelupdateevent);
+
+    // The new Mesh is drawn from the next recorded frame, it is used to switch the LOD of a RenderableObject
+    void set_renderable_object_mesh(const Token(RenderableObject) p_renderable_object, const Token(Mesh) p_mesh);
 };
 
 struct D3RendererAllocator
@@ -94,7 +103,7 @@ struct D3RendererAllocator
 
     void free_mesh(const Token(Mesh) p_mesh);
 
-    Token(RenderableObject) allocate_renderable_object(const RenderableObject& p_renderable_object);
+    Token(RenderableObject) allocate_renderable_object(const Token(Mesh) p_mesh);
 
     void free_renderable_object(const Token(RenderableObject) p_rendereable_object);
 };
@@ -102,9 +111,13 @@ struct D3RendererAllocator
 namespace ColorStep_const
 {
 SliceN<ShaderLayoutParameterType, 1> shaderlayout_before = SliceN<ShaderLayoutParameterType, 1>{ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX};
-SliceN<ShaderLayoutParameterType, 1> shaderlayout_after = SliceN<ShaderLayoutParameterType, 1>{ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX};
+SliceN<ShaderLayoutParameterType, 1> shaderlayout_after = SliceN<ShaderLayoutParameterType, 1>{ShaderLayoutParameterType::UNIFORM_BUFFER_DYNAMIC_VERTEX};
 SliceN<ShaderLayout::VertexInputParameter, 2> shaderlayout_vertex_input = SliceN<ShaderLayout::VertexInputParameter, 2>{
     ShaderLayout::VertexInputParameter{PrimitiveSerializedTypes::Type::FLOAT32_3, 0}, ShaderLayout::VertexInputParameter{PrimitiveSerializedTypes::Type::FLOAT32_2, offsetof(Vertex, uv)}};
+// The model matrix is consumed by the vertex shader as a mat4 input, that takes four consecutive locations.
+SliceN<ShaderLayout::VertexInputParameter, 4> shaderlayout_instance_input = SliceN<ShaderLayout::VertexInputParameter, 4>{
+    ShaderLayout::VertexInputParameter{PrimitiveSerializedTypes::Type::FLOAT32_4, 0}, ShaderLayout::VertexInputParameter{PrimitiveSerializedTypes::Type::FLOAT32_4, sizeof(v4f)},
+    ShaderLayout::VertexInputParameter{PrimitiveSerializedTypes::Type::FLOAT32_4, sizeof(v4f) * 2}, ShaderLayout::VertexInputParameter{PrimitiveSerializedTypes::Type::FLOAT32_4, sizeof(v4f) * 3}};
 }; // namespace ColorStep_const
 
 struct ColorStep
@@ -115,6 +128,8 @@ struct ColorStep
     Span<v4f> clear_values;
 
     Token(ShaderLayout) global_buffer_layout;
+    // The camera is written to the global material buffer of the recorded frame, the previous frames may still read their own copy.
+    Camera camera;
     Material global_material;
 
     struct AllocateInfo
@@ -135,6 +150,82 @@ struct ColorStep
     void set_camera_view(GPUContext& p_gpu_context, const v3f& p_world_position, const v3f& p_forward, const v3f& p_up);
 
     Slice<Camera> get_camera(GPUContext& p_gpu_context);
+
+    void upload_camera(GPUContext& p_gpu_context);
+
+    Material& get_global_material();
+};
+
+/*
+    RenderableObjects of instanced shaders are not drawn one by one.
+    For every instanced shader, RenderableObjects that share the same Material and Mesh are grouped into a single indexed indirect draw.
+    Model matrices of a group are packed contiguously in the instance buffer and the group binds the instance buffer at it's first instance.
+    Draws are ordered by shader execution order, then by material.
+    Instance and indirect buffers are allocated per frame in flight, only the buffers of the recorded frame are written.
+*/
+struct D3RendererInstancedDraws
+{
+    struct Draw
+    {
+        Token(ShaderIndex) shader;
+        Token(Material) material;
+        Token(Mesh) mesh;
+        uimax first_instance;
+        uimax instance_count;
+    };
+
+    Vector<Draw> draws;
+    Vector<m44f> instance_matrices;
+    HashMap<Token(Mesh), uimax> mesh_to_draw;
+
+    SliceN<Token(BufferHost), GPUFrame_const::FRAMES_IN_FLIGHT> instance_buffers;
+    SliceN<Token(BufferHost), GPUFrame_const::FRAMES_IN_FLIGHT> indirect_buffers;
+
+    static D3RendererInstancedDraws allocate(BufferAllocator& p_buffer_allocator);
+
+    void free(BufferAllocator& p_buffer_allocator);
+
+    void build(BufferAllocator& p_buffer_allocator, D3RendererHeap& p_heap, const uimax p_frame_index);
+
+  private:
+    void push_material(D3RendererHeap& p_heap, const Token(ShaderIndex) p_shader, const Token(Material) p_material);
+
+    static void reallocate_if_too_small(BufferAllocator& p_buffer_allocator, Token(BufferHost)* in_out_buffer, const uimax p_size, const BufferUsageFlag p_usage_flag);
+};
+
+/*
+    Model matrices of all RenderableObjects are sub-allocated from a single persistently mapped uniform buffer.
+    The slot of a RenderableObject is the index of it's model matrix in D3RendererHeap::model_matrices, so the whole host pool is uploaded in one copy.
+    Slots are spaced by the device uniform buffer offset alignment. They are binded as the dynamic offset of a single descriptor.
+    Every frame in flight has it's own buffer. A frame buffer is uploaded when it is recorded, if matrices have changed since it's last upload.
+*/
+struct D3RendererModelBuffer
+{
+    struct Frame
+    {
+        uimax capacity;
+        Token(BufferHost) buffer;
+        Token(ShaderUniformBufferHostParameter) parameter;
+        int8 outdated;
+    };
+
+    uimax stride;
+    SliceN<Frame, GPUFrame_const::FRAMES_IN_FLIGHT> frames;
+
+    static D3RendererModelBuffer allocate(GPUContext& p_gpu_context);
+
+    void free(GPUContext& p_gpu_context);
+
+    uint32 get_dynamic_offset(const Token(m44f) p_model) const;
+
+    void mark_outdated();
+
+    void upload(GPUContext& p_gpu_context, Pool<m44f>& p_model_matrices);
+
+  private:
+    void allocate_frame_buffer(GPUContext& p_gpu_context, Frame& p_frame);
+
+    void free_frame_buffer(GPUContext& p_gpu_context, Frame& p_frame);
 };
 
 /*
@@ -144,6 +235,10 @@ struct D3Renderer
 {
     D3RendererAllocator allocator;
     ColorStep color_step;
+    D3RendererInstancedDraws instanced_draws;
+    D3RendererModelBuffer model_buffer;
+    // Frame of the GPUContext that the last buffer_step has written to, graphics_step binds the per frame buffers of that frame.
+    uimax frame_index;
 
     static D3Renderer allocate(GPUContext& p_gpu_context, const ColorStep::AllocateInfo& p_allocation_info);
 
@@ -164,10 +259,12 @@ inline D3RendererHeap D3RendererHeap::allocate()
     l_heap.materials = Pool<Material>::allocate(0);
     l_heap.meshes = Pool<Mesh>::allocate(0);
     l_heap.renderable_objects = Pool<RenderableObject>::allocate(0);
+    l_heap.model_matrices = Pool<m44f>::allocate(0);
     l_heap.shaders_indexed = Vector<Token(ShaderIndex)>::allocate(0);
     l_heap.shaders_to_materials = PoolOfVector<Token(Material)>::allocate_default();
     l_heap.material_to_renderable_objects = PoolOfVector<Token(RenderableObject)>::allocate_default();
-    l_heap.model_update_events = Vector<RenderableObject_ModelUpdateEvent>::allocate(0);
+    l_heap.model_update_events = Vector<RenderableObject_ModelUpdateEvent, FrameAllocator>::build_zero_size(NULL, 0);
+    l_heap.model_matrices_changed = 0;
     return l_heap;
 };
 
@@ -178,6 +275,7 @@ inline void D3RendererHeap::free()
     assert_true(!this->materials.has_allocated_elements());
     assert_true(!this->meshes.has_allocated_elements());
     assert_true(!this->renderable_objects.has_allocated_elements());
+    assert_true(!this->model_matrices.has_allocated_elements());
     assert_true(this->shaders_indexed.empty());
     assert_true(!this->shaders_to_materials.has_allocated_elements());
     assert_true(!this->material_to_renderable_objects.has_allocated_elements());
@@ -188,6 +286,7 @@ inline void D3RendererHeap::free()
     this->materials.free();
     this->meshes.free();
     this->renderable_objects.free();
+    this->model_matrices.free();
     this->shaders_indexed.free();
     this->shaders_to_materials.free();
     this->material_to_renderable_objects.free();
@@ -256,6 +355,11 @@ inline void D3RendererHeap::push_modelupdateevent(const RenderableObject_ModelUp
     this->model_update_events.push_back_element(p_modelupdateevent);
 };
 
+inline void D3RendererHeap::set_renderable_object_mesh(const Token(RenderableObject) p_renderable_object, const Token(Mesh) p_mesh)
+{
+    this->renderable_objects.get(p_renderable_object).mesh = p_mesh;
+};
+
 inline D3RendererAllocator D3RendererAllocator::allocate()
 {
     return D3RendererAllocator{D3RendererHeap::allocate()};
@@ -323,9 +427,11 @@ inline void D3RendererAllocator::free_mesh(const Token(Mesh) p_mesh)
     this->heap.meshes.release_element(p_mesh);
 };
 
-inline Token(RenderableObject) D3RendererAllocator::allocate_renderable_object(const RenderableObject& p_renderable_object)
+inline Token(RenderableObject) D3RendererAllocator::allocate_renderable_object(const Token(Mesh) p_mesh)
 {
-    return this->heap.renderable_objects.alloc_element(p_renderable_object);
+    // The slot may have been used by a freed RenderableObject
+    this->heap.model_matrices_changed = 1;
+    return this->heap.renderable_objects.alloc_element(RenderableObject{this->heap.model_matrices.alloc_element(m44f_const::IDENTITY), p_mesh});
 };
 
 inline void D3RendererAllocator::free_renderable_object(const Token(RenderableObject) p_rendereable_object)
@@ -338,6 +444,7 @@ inline void D3RendererAllocator::free_renderable_object(const Token(RenderableOb
         }
     }
 
+    this->heap.model_matrices.release_element(this->heap.renderable_objects.get(p_rendereable_object).model);
     this->heap.renderable_objects.release_element(p_rendereable_object);
 };
 
@@ -346,6 +453,15 @@ struct D3RendererAllocatorComposition
 
     inline static Token(Mesh)
         allocate_mesh_with_buffers(BufferMemory& p_buffer_memory, D3RendererAllocator& p_render_allocator, const Slice<Vertex>& p_initial_vertices, const Slice<uint32>& p_initial_indices)
+    {
+        return allocate_mesh_with_buffers(p_buffer_memory, p_render_allocator, p_initial_vertices, p_initial_indices.build_asint8(), BufferIndexType::UINT32);
+    };
+
+    /*
+        p_initial_indices_binary is interpreted with p_index_type. 16 bit indices halve the index buffer size of meshes that have less than 65536 vertices.
+    */
+    inline static Token(Mesh) allocate_mesh_with_buffers(BufferMemory& p_buffer_memory, D3RendererAllocator& p_render_allocator, const Slice<Vertex>& p_initial_vertices,
+                                                         const Slice<int8>& p_initial_indices_binary, const BufferIndexType p_index_type)
     {
         Mesh l_mesh;
         Slice<int8> l_initial_vertices_binary = p_initial_vertices.build_asint8();
@@ -353,12 +469,12 @@ struct D3RendererAllocatorComposition
                                                                               (BufferUsageFlag)((BufferUsageFlags)BufferUsageFlag::VERTEX | (BufferUsageFlags)BufferUsageFlag::TRANSFER_WRITE));
         BufferReadWrite::write_to_buffergpu(p_buffer_memory.allocator, p_buffer_memory.events, l_mesh.vertices_buffer, l_initial_vertices_binary);
 
-        Slice<int8> l_initial_indices_binary = p_initial_indices.build_asint8();
-        l_mesh.indices_buffer = p_buffer_memory.allocator.allocate_buffergpu(l_initial_indices_binary.Size,
+        l_mesh.indices_buffer = p_buffer_memory.allocator.allocate_buffergpu(p_initial_indices_binary.Size,
                                                                              (BufferUsageFlag)((BufferUsageFlags)BufferUsageFlag::INDEX | (BufferUsageFlags)BufferUsageFlag::TRANSFER_WRITE));
-        BufferReadWrite::write_to_buffergpu(p_buffer_memory.allocator, p_buffer_memory.events, l_mesh.indices_buffer, l_initial_indices_binary);
+        BufferReadWrite::write_to_buffergpu(p_buffer_memory.allocator, p_buffer_memory.events, l_mesh.indices_buffer, p_initial_indices_binary);
 
-        l_mesh.indices_count = p_initial_indices.Size;
+        l_mesh.index_type = p_index_type;
+        l_mesh.indices_count = p_initial_indices_binary.Size / (p_index_type == BufferIndexType::UINT16 ? sizeof(uint16) : sizeof(uint32));
 
         return p_render_allocator.allocate_mesh(l_mesh);
     };
@@ -390,24 +506,18 @@ struct D3RendererAllocatorComposition
         p_render_allocator.free_material(p_material);
     };
 
+    /*
+        The model matrix of the RenderableObject is stored in the D3RendererModelBuffer, no GPU buffer is allocated per RenderableObject.
+    */
     inline static Token(RenderableObject)
         allocate_renderable_object_with_buffers(BufferMemory& p_buffer_memory, GraphicsAllocator2& p_graphics_allocator, D3RendererAllocator& p_render_allocator, const Token(Mesh) p_mesh)
     {
-        RenderableObject l_renderable_object;
-        l_renderable_object.mesh = p_mesh;
-
-        Token(BufferHost) l_buffer = p_buffer_memory.allocator.allocate_bufferhost_empty(sizeof(m44f), BufferUsageFlag::UNIFORM);
-        l_renderable_object.model =
-            p_graphics_allocator.allocate_shaderuniformbufferhost_parameter(ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX, l_buffer, p_buffer_memory.allocator.host_buffers.get(l_buffer));
-
-        return p_render_allocator.allocate_renderable_object(l_renderable_object);
+        return p_render_allocator.allocate_renderable_object(p_mesh);
     };
 
     inline static void free_renderable_object_with_buffers(BufferMemory& p_buffer_memory, GraphicsAllocator2& p_graphics_allocator, D3RendererAllocator& p_render_allocator,
                                                            const Token(RenderableObject) p_renderable_object)
     {
-        RenderableObject& l_renderable_object = p_render_allocator.heap.renderable_objects.get(p_renderable_object);
-        GraphicsAllocatorComposition::free_shaderparameter_uniformbufferhost_with_buffer(p_buffer_memory, p_graphics_allocator, l_renderable_object.model);
         p_render_allocator.free_renderable_object(p_renderable_object);
     };
 
@@ -430,7 +540,7 @@ struct D3RendererAllocatorComposition
     inline static void free_renderable_object_external_ressources(BufferMemory& p_buffer_memory, GraphicsAllocator2& p_graphics_allocator, D3RendererAllocator& p_render_allocator,
                                                                   RenderableObject& p_renderable_object)
     {
-        GraphicsAllocatorComposition::free_shaderparameter_uniformbufferhost_with_buffer(p_buffer_memory, p_graphics_allocator, p_renderable_object.model);
+        p_render_allocator.heap.model_matrices.release_element(p_renderable_object.model);
         free_mesh_with_buffers(p_buffer_memory, p_render_allocator, p_renderable_object.mesh);
     };
 
@@ -446,6 +556,31 @@ struct D3RendererAllocatorComposition
         ShaderIndex l_shader_index;
         l_shader_index.execution_order = p_execution_order;
         l_shader_index.shader_layout = p_graphics_allocator.allocate_shader_layout(l_span, l_vertex_input, sizeof(Vertex));
+        l_shader_index.instanced = 0;
+
+        ShaderAllocateInfo l_shader_allocate_info{p_graphics_pass, p_shader_configuration, p_graphics_allocator.heap.shader_layouts.get(l_shader_index.shader_layout), p_vertex_shader,
+                                                  p_fragment_shader};
+        l_shader_index.shader_index = p_graphics_allocator.allocate_shader(l_shader_allocate_info);
+        return p_render_allocator.allocate_shader(l_shader_index);
+    };
+
+    /*
+        Unlike allocate_colorstep_shader_with_shaderlayout, the model matrix is not the last shader parameter.
+        It is read by the vertex shader from the location that follows the vertex inputs (layout(location = 2) in mat4 model).
+    */
+    inline static Token(ShaderIndex) allocate_colorstep_instanced_shader_with_shaderlayout(GraphicsAllocator2& p_graphics_allocator, D3RendererAllocator& p_render_allocator,
+                                                                                          const Slice<ShaderLayoutParameterType>& p_specific_parameters, const uimax p_execution_order,
+                                                                                          const GraphicsPass& p_graphics_pass, const ShaderConfiguration& p_shader_configuration,
+                                                                                          const ShaderModule& p_vertex_shader, const ShaderModule& p_fragment_shader)
+    {
+        Span<ShaderLayoutParameterType> l_span = Span<ShaderLayoutParameterType>::allocate_slice_2(ColorStep_const::shaderlayout_before.to_slice(), p_specific_parameters);
+        Span<ShaderLayout::VertexInputParameter> l_vertex_input = Span<ShaderLayout::VertexInputParameter>::allocate_slice(ColorStep_const::shaderlayout_vertex_input.to_slice());
+        Span<ShaderLayout::VertexInputParameter> l_instance_input = Span<ShaderLayout::VertexInputParameter>::allocate_slice(ColorStep_const::shaderlayout_instance_input.to_slice());
+
+        ShaderIndex l_shader_index;
+        l_shader_index.execution_order = p_execution_order;
+        l_shader_index.shader_layout = p_graphics_allocator.allocate_shader_layout_instanced(l_span, l_vertex_input, sizeof(Vertex), l_instance_input, sizeof(m44f));
+        l_shader_index.instanced = 1;
 
         ShaderAllocateInfo l_shader_allocate_info{p_graphics_pass, p_shader_configuration, p_graphics_allocator.heap.shader_layouts.get(l_shader_index.shader_layout), p_vertex_shader,
                                                   p_fragment_shader};
@@ -517,10 +652,10 @@ inline ColorStep ColorStep::allocate(GPUContext& p_gpu_context, const AllocateIn
     l_step.pass = GraphicsAllocatorComposition::allocate_graphicspass_with_associatedimages<2>(p_gpu_context.buffer_memory, p_gpu_context.graphics_allocator, l_attachments);
     l_step.global_buffer_layout = p_gpu_context.graphics_allocator.allocate_shader_layout(l_global_buffer_parameters, l_global_buffer_vertices_parameters, 0);
 
-    Camera l_empty_camera{};
+    l_step.camera = Camera{};
     l_step.global_material = Material::allocate_empty(p_gpu_context.graphics_allocator, 0);
     l_step.global_material.add_and_allocate_buffer_host_parameter_typed(p_gpu_context.graphics_allocator, p_gpu_context.buffer_memory.allocator,
-                                                                        p_gpu_context.graphics_allocator.heap.shader_layouts.get(l_step.global_buffer_layout), l_empty_camera);
+                                                                        p_gpu_context.graphics_allocator.heap.shader_layouts.get(l_step.global_buffer_layout), l_step.camera);
 
     return l_step;
 };
@@ -535,12 +670,7 @@ inline void ColorStep::free(GPUContext& p_gpu_context)
 
 inline void ColorStep::set_camera(GPUContext& p_gpu_context, const Camera& p_camera)
 {
-    p_gpu_context.buffer_memory.allocator.host_buffers
-        .get(p_gpu_context.graphics_allocator.heap.shader_uniform_buffer_host_parameters
-                 .get(p_gpu_context.graphics_allocator.heap.material_parameters.get_vector(this->global_material.parameters).get(0).uniform_host)
-                 .memory)
-        .get_mapped_effective_memory()
-        .copy_memory(Slice<Camera>::build_asint8_memory_singleelement(&p_camera));
+    this->camera = p_camera;
 };
 
 inline void ColorStep::set_camera_projection(GPUContext& p_gpu_context, const float32 p_near, const float32 p_far, const float32 p_fov)
@@ -555,16 +685,237 @@ inline void ColorStep::set_camera_view(GPUContext& p_gpu_context, const v3f& p_w
 
 inline Slice<Camera> ColorStep::get_camera(GPUContext& p_gpu_context)
 {
-    return slice_cast<Camera>(p_gpu_context.buffer_memory.allocator.host_buffers
-                                  .get(p_gpu_context.graphics_allocator.heap.shader_uniform_buffer_host_parameters
-                                           .get(p_gpu_context.graphics_allocator.heap.material_parameters.get_vector(this->global_material.parameters).get(0).uniform_host)
-                                           .memory)
-                                  .get_mapped_effective_memory());
+    return Slice<Camera>::build_memory_elementnb(&this->camera, 1);
+};
+
+inline void ColorStep::upload_camera(GPUContext& p_gpu_context)
+{
+    p_gpu_context.buffer_memory.allocator.host_buffers.get(this->global_material.get_buffer_host_parameter(p_gpu_context.graphics_allocator, 0))
+        .get_mapped_effective_memory()
+        .copy_memory(Slice<Camera>::build_asint8_memory_singleelement(&this->camera));
+};
+
+inline Material& ColorStep::get_global_material()
+{
+    return this->global_material;
+};
+
+inline D3RendererInstancedDraws D3RendererInstancedDraws::allocate(BufferAllocator& p_buffer_allocator)
+{
+    D3RendererInstancedDraws l_instanced_draws;
+    l_instanced_draws.draws = Vector<Draw>::allocate(0);
+    l_instanced_draws.instance_matrices = Vector<m44f>::allocate(0);
+    l_instanced_draws.mesh_to_draw = HashMap<Token(Mesh), uimax>::allocate_default();
+    for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+    {
+        l_instanced_draws.instance_buffers.get(i) = p_buffer_allocator.allocate_bufferhost_empty(sizeof(m44f) * 64, BufferUsageFlag::VERTEX);
+        l_instanced_draws.indirect_buffers.get(i) = p_buffer_allocator.allocate_bufferhost_empty(sizeof(DrawIndexedIndirectCommand) * 16, BufferUsageFlag::INDIRECT);
+    }
+    return l_instanced_draws;
+};
+
+inline void D3RendererInstancedDraws::free(BufferAllocator& p_buffer_allocator)
+{
+    this->draws.free();
+    this->instance_matrices.free();
+    this->mesh_to_draw.free();
+    for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+    {
+        p_buffer_allocator.free_bufferhost(this->instance_buffers.get(i));
+        p_buffer_allocator.free_bufferhost(this->indirect_buffers.get(i));
+    }
+};
+
+inline void D3RendererInstancedDraws::build(BufferAllocator& p_buffer_allocator, D3RendererHeap& p_heap, const uimax p_frame_index)
+{
+    this->draws.clear();
+    this->instance_matrices.clear();
+
+    for (loop(i, 0, p_heap.shaders_indexed.Size))
+    {
+        Token(ShaderIndex) l_shader = p_heap.shaders_indexed.get(i);
+        if (p_heap.shaders.get(l_shader).instanced)
+        {
+            auto l_materials = p_heap.get_materials_from_shader(l_shader);
+            for (loop(j, 0, l_materials.get_size()))
+            {
+                this->push_material(p_heap, l_shader, l_materials.get(j));
+            }
+        }
+    }
+
+    if (this->draws.Size == 0)
+    {
+        return;
+    }
+
+    Token(BufferHost)* l_instance_buffer = &this->instance_buffers.get(p_frame_index);
+    Token(BufferHost)* l_indirect_buffer = &this->indirect_buffers.get(p_frame_index);
+    reallocate_if_too_small(p_buffer_allocator, l_instance_buffer, this->instance_matrices.Size * sizeof(m44f), BufferUsageFlag::VERTEX);
+    reallocate_if_too_small(p_buffer_allocator, l_indirect_buffer, this->draws.Size * sizeof(DrawIndexedIndirectCommand), BufferUsageFlag::INDIRECT);
+
+    p_buffer_allocator.host_buffers.get(*l_instance_buffer).get_mapped_effective_memory().copy_memory(this->instance_matrices.to_slice().build_asint8());
+
+    Slice<DrawIndexedIndirectCommand> l_commands = slice_cast<DrawIndexedIndirectCommand>(p_buffer_allocator.host_buffers.get(*l_indirect_buffer).get_mapped_effective_memory());
+    for (loop(i, 0, this->draws.Size))
+    {
+        Draw& l_draw = this->draws.get(i);
+        // The first instance is applied by the instance buffer binding offset, so that the drawIndirectFirstInstance feature is not required.
+        l_commands.get(i) = DrawIndexedIndirectCommand{(uint32)p_heap.meshes.get(l_draw.mesh).indices_count, (uint32)l_draw.instance_count, 0, 0, 0};
+    }
+};
+
+inline void D3RendererInstancedDraws::push_material(D3RendererHeap& p_heap, const Token(ShaderIndex) p_shader, const Token(Material) p_material)
+{
+    uimax l_material_draws_begin = this->draws.Size;
+    auto l_renderable_objects = p_heap.get_renderableobjects_from_material(p_material);
+
+    // Counting instances of every mesh
+    for (loop(i, 0, l_renderable_objects.get_size()))
+    {
+        Token(Mesh) l_mesh = p_heap.renderable_objects.get(l_renderable_objects.get(i)).mesh;
+        uimax* l_draw_index = this->mesh_to_draw.get_value_nothashed(l_mesh);
+        if (l_draw_index == NULL)
+        {
+            this->mesh_to_draw.push_key_value_nothashed(l_mesh, this->draws.Size);
+            this->draws.push_back_element(Draw{p_shader, p_material, l_mesh, 0, 1});
+        }
+        else
+        {
+            this->draws.get(*l_draw_index).instance_count += 1;
+        }
+    }
+
+    uimax l_first_instance = this->instance_matrices.Size;
+    for (loop(i, l_material_draws_begin, this->draws.Size))
+    {
+        Draw& l_draw = this->draws.get(i);
+        l_draw.first_instance = l_first_instance;
+        l_first_instance += l_draw.instance_count;
+        l_draw.instance_count = 0;
+    }
+    this->instance_matrices.push_back_array_empty(l_first_instance - this->instance_matrices.Size);
+
+    // Packing model matrices, instance_count is used as the insertion cursor of the draw
+    for (loop(i, 0, l_renderable_objects.get_size()))
+    {
+        RenderableObject& l_renderable_object = p_heap.renderable_objects.get(l_renderable_objects.get(i));
+        Draw& l_draw = this->draws.get(*this->mesh_to_draw.get_value_nothashed(l_renderable_object.mesh));
+        this->instance_matrices.get(l_draw.first_instance + l_draw.instance_count) = p_heap.model_matrices.get(l_renderable_object.model);
+        l_draw.instance_count += 1;
+    }
+
+    for (loop(i, l_material_draws_begin, this->draws.Size))
+    {
+        this->mesh_to_draw.erase_key_nothashed(this->draws.get(i).mesh);
+    }
+};
+
+inline void D3RendererInstancedDraws::reallocate_if_too_small(BufferAllocator& p_buffer_allocator, Token(BufferHost)* in_out_buffer, const uimax p_size, const BufferUsageFlag p_usage_flag)
+{
+    uimax l_buffer_size = p_buffer_allocator.host_buffers.get(*in_out_buffer).size;
+    if (l_buffer_size < p_size)
+    {
+        while (l_buffer_size < p_size)
+        {
+            l_buffer_size *= 2;
+        }
+        p_buffer_allocator.free_bufferhost(*in_out_buffer);
+        *in_out_buffer = p_buffer_allocator.allocate_bufferhost_empty(l_buffer_size, p_usage_flag);
+    }
+};
+
+inline D3RendererModelBuffer D3RendererModelBuffer::allocate(GPUContext& p_gpu_context)
+{
+    D3RendererModelBuffer l_model_buffer;
+    // Alignments are powers of two
+    l_model_buffer.stride = sizeof(m44f);
+    if (p_gpu_context.instance.graphics_card.min_uniform_buffer_offset_alignment > l_model_buffer.stride)
+    {
+        l_model_buffer.stride = p_gpu_context.instance.graphics_card.min_uniform_buffer_offset_alignment;
+    }
+    for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+    {
+        Frame& l_frame = l_model_buffer.frames.get(i);
+        l_frame.capacity = 64;
+        l_frame.outdated = 1;
+        l_model_buffer.allocate_frame_buffer(p_gpu_context, l_frame);
+    }
+    return l_model_buffer;
+};
+
+inline void D3RendererModelBuffer::free(GPUContext& p_gpu_context)
+{
+    for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+    {
+        this->free_frame_buffer(p_gpu_context, this->frames.get(i));
+    }
+};
+
+inline uint32 D3RendererModelBuffer::get_dynamic_offset(const Token(m44f) p_model) const
+{
+    return (uint32)(tk_v(p_model) * this->stride);
+};
+
+inline void D3RendererModelBuffer::mark_outdated()
+{
+    for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+    {
+        this->frames.get(i).outdated = 1;
+    }
+};
+
+inline void D3RendererModelBuffer::upload(GPUContext& p_gpu_context, Pool<m44f>& p_model_matrices)
+{
+    Frame& l_frame = this->frames.get(p_gpu_context.frame_index);
+    if (!l_frame.outdated)
+    {
+        return;
+    }
+
+    uimax l_matrices_count = p_model_matrices.get_size();
+    if (l_matrices_count > l_frame.capacity)
+    {
+        while (l_matrices_count > l_frame.capacity)
+        {
+            l_frame.capacity *= 2;
+        }
+        this->free_frame_buffer(p_gpu_context, l_frame);
+        this->allocate_frame_buffer(p_gpu_context, l_frame);
+    }
+
+    Slice<int8> l_mapped_memory = p_gpu_context.buffer_memory.allocator.host_buffers.get(l_frame.buffer).get_mapped_effective_memory();
+    if (this->stride == sizeof(m44f))
+    {
+        l_mapped_memory.copy_memory(p_model_matrices.memory.to_slice().build_asint8());
+    }
+    else
+    {
+        for (loop(i, 0, l_matrices_count))
+        {
+            l_mapped_memory.copy_memory_at_index(i * this->stride, Slice<m44f>::build_asint8_memory_singleelement(&p_model_matrices.memory.get(i)));
+        }
+    }
+
+    l_frame.outdated = 0;
+};
+
+inline void D3RendererModelBuffer::allocate_frame_buffer(GPUContext& p_gpu_context, Frame& p_frame)
+{
+    p_frame.buffer = p_gpu_context.buffer_memory.allocator.allocate_bufferhost_empty(p_frame.capacity * this->stride, BufferUsageFlag::UNIFORM);
+    p_frame.parameter =
+        p_gpu_context.graphics_allocator.allocate_shaderuniformbufferhost_dynamic_parameter(p_frame.buffer, p_gpu_context.buffer_memory.allocator.host_buffers.get(p_frame.buffer), sizeof(m44f));
+};
+
+inline void D3RendererModelBuffer::free_frame_buffer(GPUContext& p_gpu_context, Frame& p_frame)
+{
+    GraphicsAllocatorComposition::free_shaderparameter_uniformbufferhost_with_buffer(p_gpu_context.buffer_memory, p_gpu_context.graphics_allocator, p_frame.parameter);
 };
 
 inline D3Renderer D3Renderer::allocate(GPUContext& p_gpu_context, const ColorStep::AllocateInfo& p_allocation_info)
 {
-    return D3Renderer{D3RendererAllocator::allocate(), ColorStep::allocate(p_gpu_context, p_allocation_info)};
+    return D3Renderer{D3RendererAllocator::allocate(), ColorStep::allocate(p_gpu_context, p_allocation_info), D3RendererInstancedDraws::allocate(p_gpu_context.buffer_memory.allocator),
+                      D3RendererModelBuffer::allocate(p_gpu_context), p_gpu_context.frame_index};
 };
 
 inline void D3Renderer::free(GPUContext& p_gpu_context)
@@ -573,6 +924,8 @@ inline void D3Renderer::free(GPUContext& p_gpu_context)
 
     this->allocator.free();
     this->color_step.free(p_gpu_context);
+    this->instanced_draws.free(p_gpu_context.buffer_memory.allocator);
+    this->model_buffer.free(p_gpu_context);
 };
 
 inline D3RendererHeap& D3Renderer::heap()
@@ -582,34 +935,74 @@ inline D3RendererHeap& D3Renderer::heap()
 
 inline void D3Renderer::buffer_step(GPUContext& p_gpu_context)
 {
+    this->frame_index = p_gpu_context.frame_index;
+
     for (loop(i, 0, this->heap().model_update_events.Size))
     {
         auto& l_event = this->heap().model_update_events.get(i);
+        this->heap().model_matrices.get(this->heap().renderable_objects.get(l_event.renderable_object).model) = l_event.model_matrix;
+        this->heap().model_matrices_changed = 1;
+    };
 
-        Slice<int8> l_mapped_memory =
-            p_gpu_context.buffer_memory.allocator.host_buffers
-                .get(p_gpu_context.graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(this->allocator.heap.renderable_objects.get(l_event.renderable_object).model).memory)
-                .get_mapped_effective_memory();
+    // The memory is given back to the frame arena before it is reset
+    this->heap().model_update_events.free();
 
-        l_mapped_memory.copy_memory(Slice<m44f>::build_asint8_memory_singleelement(&l_event.model_matrix));
-    };
+    if (this->heap().model_matrices_changed)
+    {
+        this->model_buffer.mark_outdated();
+        this->heap().model_matrices_changed = 0;
+    }
 
-    this->heap().model_update_events.clear();
+    this->model_buffer.upload(p_gpu_context, this->heap().model_matrices);
+    this->color_step.upload_camera(p_gpu_context);
+    this->instanced_draws.build(p_gpu_context.buffer_memory.allocator, this->heap(), this->frame_index);
 };
 
 inline void D3Renderer::graphics_step(GraphicsBinder& p_graphics_binder)
 {
+    Material& l_global_material = this->color_step.get_global_material();
     p_graphics_binder.bind_shader_layout(p_graphics_binder.graphics_allocator.heap.shader_layouts.get(this->color_step.global_buffer_layout));
-    p_graphics_binder.bind_material(this->color_step.global_material);
+    p_graphics_binder.bind_material(l_global_material);
 
     p_graphics_binder.begin_render_pass(p_graphics_binder.graphics_allocator.heap.graphics_pass.get(this->color_step.pass), this->color_step.clear_values.slice);
 
+    ShaderUniformBufferHostParameter& l_model_parameter =
+        p_graphics_binder.graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(this->model_buffer.frames.get(this->frame_index).parameter);
+
+    uimax l_instanced_draw_index = 0;
     for (loop(i, 0, this->heap().shaders_indexed.Size))
     {
         Token(ShaderIndex) l_shader_token = this->heap().shaders_indexed.get(i);
         ShaderIndex& l_shader_index = this->heap().shaders.get(l_shader_token);
         p_graphics_binder.bind_shader(p_graphics_binder.graphics_allocator.heap.shaders.get(l_shader_index.shader_index));
 
+        if (l_shader_index.instanced)
+        {
+            BufferHost& l_instance_buffer = p_graphics_binder.buffer_allocator.host_buffers.get(this->instanced_draws.instance_buffers.get(this->frame_index));
+            BufferHost& l_indirect_buffer = p_graphics_binder.buffer_allocator.host_buffers.get(this->instanced_draws.indirect_buffers.get(this->frame_index));
+
+            while (l_instanced_draw_index < this->instanced_draws.draws.Size && tk_eq(this->instanced_draws.draws.get(l_instanced_draw_index).shader, l_shader_token))
+            {
+                Token(Material) l_material = this->instanced_draws.draws.get(l_instanced_draw_index).material;
+                p_graphics_binder.bind_material(this->heap().materials.get(l_material));
+
+                while (l_instanced_draw_index < this->instanced_draws.draws.Size && tk_eq(this->instanced_draws.draws.get(l_instanced_draw_index).material, l_material))
+                {
+                    D3RendererInstancedDraws::Draw& l_draw = this->instanced_draws.draws.get(l_instanced_draw_index);
+                    Mesh& l_mesh = this->allocator.heap.meshes.get(l_draw.mesh);
+                    p_graphics_binder.bind_vertex_buffer_gpu(p_graphics_binder.buffer_allocator.gpu_buffers.get(l_mesh.vertices_buffer));
+                    p_graphics_binder.bind_instance_buffer_host(l_instance_buffer, l_draw.first_instance * sizeof(m44f));
+                    p_graphics_binder.bind_index_buffer_gpu(p_graphics_binder.buffer_allocator.gpu_buffers.get(l_mesh.indices_buffer), l_mesh.index_type);
+                    p_graphics_binder.draw_indexed_indirect(l_indirect_buffer, l_instanced_draw_index * sizeof(DrawIndexedIndirectCommand));
+                    l_instanced_draw_index += 1;
+                }
+
+                p_graphics_binder.pop_material_bind(this->heap().materials.get(l_material));
+            }
+
+            continue;
+        }
+
         auto l_materials = this->heap().get_materials_from_shader(l_shader_token);
         for (loop(j, 0, l_materials.get_size()))
         {
@@ -623,11 +1016,11 @@ inline void D3Renderer::graphics_step(GraphicsBinder& p_graphics_binder)
                 Token(RenderableObject) l_renderable_object_token = l_renderable_objects.get(k);
                 RenderableObject& l_renderable_object = this->heap().renderable_objects.get(l_renderable_object_token);
 
-                p_graphics_binder.bind_shaderbufferhost_parameter(p_graphics_binder.graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_renderable_object.model));
+                p_graphics_binder.bind_shaderbufferhost_dynamic_parameter(l_model_parameter, this->model_buffer.get_dynamic_offset(l_renderable_object.model));
 
                 Mesh& l_mesh = this->allocator.heap.meshes.get(l_renderable_object.mesh);
                 p_graphics_binder.bind_vertex_buffer_gpu(p_graphics_binder.buffer_allocator.gpu_buffers.get(l_mesh.vertices_buffer));
-                p_graphics_binder.bind_index_buffer_gpu(p_graphics_binder.buffer_allocator.gpu_buffers.get(l_mesh.indices_buffer), BufferIndexType::UINT32);
+                p_graphics_binder.bind_index_buffer_gpu(p_graphics_binder.buffer_allocator.gpu_buffers.get(l_mesh.indices_buffer), l_mesh.index_type);
                 p_graphics_binder.draw_indexed(l_mesh.indices_count);
 
                 p_graphics_binder.pop_shaderbufferhost_parameter();
@@ -639,5 +1032,5 @@ inline void D3Renderer::graphics_step(GraphicsBinder& p_graphics_binder)
 
     p_graphics_binder.end_render_pass();
 
-    p_graphics_binder.pop_material_bind(this->color_step.global_material);
+    p_graphics_binder.pop_material_bind(l_global_material);
 };
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "Render/render.hpp"
+#include "AssetCompiler/asset_compiler.hpp"
+
+/*
+    Headless rendering of the same scene, with the CPU waiting for the GPU at the end of every frame and with frames in flight.
+    Every frame, the model matrices of all RenderableObjects are updated before the frame is recorded.
+*/
+
+const uimax render_benchmark_object_count = 4096;
+const uimax render_benchmark_frame_count = 500;
+
+inline void render_benchmark_build_cube(Vertex* out_vertices, uint32* out_indices)
+{
+    v3f l_positions[8] = {v3f{-0.5f, -0.5f, -0.5f}, v3f{0.5f, -0.5f, -0.5f}, v3f{0.5f, 0.5f, -0.5f}, v3f{-0.5f, 0.5f, -0.5f},
+                          v3f{-0.5f, -0.5f, 0.5f},  v3f{0.5f, -0.5f, 0.5f},  v3f{0.5f, 0.5f, 0.5f},  v3f{-0.5f, 0.5f, 0.5f}};
+    uint32 l_indices[36] = {0, 1, 2, 2, 3, 0, 4, 6, 5, 6, 4, 7, 0, 4, 5, 5, 1, 0, 3, 2, 6, 6, 7, 3, 0, 3, 7, 7, 4, 0, 1, 5, 6, 6, 2, 1};
+
+    for (loop(i, 0, 8))
+    {
+        out_vertices[i] = Vertex{l_positions[i], v2f{0.0f, 0.0f}};
+    }
+    for (loop(i, 0, 36))
+    {
+        out_indices[i] = l_indices[i];
+    }
+};
+
+inline void render_benchmark_update_models(D3Renderer& p_renderer, const Slice<Token(RenderableObject)>& p_renderable_objects, const uimax p_frame)
+{
+    for (loop(i, 0, p_renderable_objects.Size))
+    {
+        float32 l_angle = (float32)(p_frame + i) * 0.01f;
+        v3f l_position = v3f{(float32)(i % 64) - 32.0f, (float32)(i / 64) - 32.0f, 0.0f};
+        p_renderer.heap().push_modelupdateevent(D3RendererHeap::RenderableObject_ModelUpdateEvent{
+            p_renderable_objects.get(i), m44f::trs(l_position, quat::rotate_around(v3f_const::UP, l_angle).to_axis(), v3f_const::ONE)});
+    }
+};
+
+// Returns the mean frame time in microseconds
+inline float64 render_benchmark_run(GPUContext& p_ctx, D3Renderer& p_renderer, const Slice<Token(RenderableObject)>& p_renderable_objects, const int8 p_frames_in_flight)
+{
+    time_t l_begin = clock_currenttime_mics();
+
+    for (loop(l_frame, 0, render_benchmark_frame_count))
+    {
+        if (p_frames_in_flight)
+        {
+            p_ctx.begin_frame();
+        }
+
+        render_benchmark_update_models(p_renderer, p_renderable_objects, l_frame);
+
+        p_renderer.buffer_step(p_ctx);
+        p_ctx.buffer_step_and_submit();
+        GraphicsBinder l_binder = p_ctx.creates_graphics_binder();
+        p_renderer.graphics_step(l_binder);
+        p_ctx.submit_graphics_binder(l_binder);
+
+        if (!p_frames_in_flight)
+        {
+            p_ctx.wait_for_completion();
+        }
+    }
+
+    p_ctx.wait_for_completion();
+
+    return (float64)(clock_currenttime_mics() - l_begin) / render_benchmark_frame_count;
+};
+
+int main()
+{
+    GPUContext l_ctx = GPUContext::allocate(Slice<GPUExtension>::build_default());
+    D3Renderer l_renderer = D3Renderer::allocate(l_ctx, ColorStep::AllocateInfo{v3ui{1024, 1024, 1}, 0});
+    ShaderCompiler l_shader_compiler = ShaderCompiler::allocate();
+
+    const int8* p_vertex_litteral =
+				MULTILINE(\
+                #version 450 \n
+
+						layout(location = 0) in vec3 pos; \n
+						layout(location = 1) in vec2 uv; \n
+
+						struct Camera \n
+				{ \n
+						mat4 view; \n
+						mat4 projection; \n
+				}; \n
+
+						layout(set = 0, binding = 0) uniform camera { Camera cam; }; \n
+						layout(set = 2, binding = 0) uniform model { mat4 mod; }; \n
+
+						void main()\n
+				{ \n
+						gl_Position = cam.projection * (cam.view * (mod * vec4(pos.xyz, 1.0f)));\n
+				}\n
+				);
+
+    const int8* p_fragment_litteral =
+				MULTILINE(\
+                #version 450\n
+
+						layout(location = 0) out vec4 outColor;\n
+
+						layout(set = 1, binding = 0) uniform color { vec3 col; }; \n
+
+						void main()\n
+				{ \n
+						outColor = vec4(col.xyz, 1.0f);\n
+				}\n
+				);
+
+    ShaderCompiled l_vertex_shader_compiled = l_shader_compiler.compile_shader(ShaderModuleStage::VERTEX, slice_int8_build_rawstr(p_vertex_litteral));
+    ShaderCompiled l_fragment_shader_compiled = l_shader_compiler.compile_shader(ShaderModuleStage::FRAGMENT, slice_int8_build_rawstr(p_fragment_litteral));
+
+    Token(ShaderModule) l_vertex_shader_module = l_ctx.graphics_allocator.allocate_shader_module(l_vertex_shader_compiled.get_compiled_binary());
+    Token(ShaderModule) l_fragment_shader_module = l_ctx.graphics_allocator.allocate_shader_module(l_fragment_shader_compiled.get_compiled_binary());
+
+    Token(ShaderIndex) l_shader = D3RendererAllocatorComposition::allocate_colorstep_shader_with_shaderlayout(
+        l_ctx.graphics_allocator, l_renderer.allocator, SliceN<ShaderLayoutParameterType, 1>{ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX_FRAGMENT}.to_slice(), 0,
+        l_ctx.graphics_allocator.heap.graphics_pass.get(l_renderer.color_step.pass), ShaderConfiguration{1, ShaderConfiguration::CompareOp::LessOrEqual},
+        l_ctx.graphics_allocator.heap.shader_modules.get(l_vertex_shader_module), l_ctx.graphics_allocator.heap.shader_modules.get(l_fragment_shader_module));
+
+    l_vertex_shader_compiled.free();
+    l_fragment_shader_compiled.free();
+
+    Material l_material = Material::allocate_empty(l_ctx.graphics_allocator, 1);
+    l_material.add_and_allocate_buffer_host_parameter_typed(l_ctx.graphics_allocator, l_ctx.buffer_memory.allocator,
+                                                            l_ctx.graphics_allocator.heap.shader_layouts.get(l_renderer.heap().shaders.get(l_shader).shader_layout), v3f{1.0f, 0.0f, 0.0f});
+    Token(Material) l_material_token = l_renderer.allocator.allocate_material(l_material);
+    l_renderer.heap().link_shader_with_material(l_shader, l_material_token);
+
+    Token(Mesh) l_mesh;
+    {
+        Vertex l_vertices[8];
+        uint32 l_indices[36];
+        render_benchmark_build_cube(l_vertices, l_indices);
+        l_mesh = D3RendererAllocatorComposition::allocate_mesh_with_buffers(l_ctx.buffer_memory, l_renderer.allocator, Slice<Vertex>::build_memory_elementnb(l_vertices, 8),
+                                                                            Slice<uint32>::build_memory_elementnb(l_indices, 36));
+    }
+
+    Span<Token(RenderableObject)> l_renderable_objects = Span<Token(RenderableObject)>::allocate(render_benchmark_object_count);
+    for (loop(i, 0, l_renderable_objects.Capacity))
+    {
+        l_renderable_objects.get(i) = D3RendererAllocatorComposition::allocate_renderable_object_with_buffers(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_mesh);
+        l_renderer.heap().link_material_with_renderable_object(l_material_token, l_renderable_objects.get(i));
+    }
+
+    l_renderer.color_step.set_camera_projection(l_ctx, 1.0f, 200.0f, 45.0f);
+    l_renderer.color_step.set_camera_view(l_ctx, v3f{0.0f, 0.0f, -80.0f}, v3f_const::FORWARD, v3f_const::UP);
+
+    // Mesh upload and first allocations are not measured
+    render_benchmark_run(l_ctx, l_renderer, l_renderable_objects.slice, 0);
+
+    float64 l_serialized_frame_time = render_benchmark_run(l_ctx, l_renderer, l_renderable_objects.slice, 0);
+    float64 l_overlapped_frame_time = render_benchmark_run(l_ctx, l_renderer, l_renderable_objects.slice, 1);
+
+    printf("objects: %lld, frames: %lld\n", (long long)render_benchmark_object_count, (long long)render_benchmark_frame_count);
+    printf("wait_for_completion every frame : %f us/frame\n", l_serialized_frame_time);
+    printf("%lld frames in flight            : %f us/frame\n", (long long)GPUFrame_const::FRAMES_IN_FLIGHT, l_overlapped_frame_time);
+
+    for (loop(i, 0, l_renderable_objects.Capacity))
+    {
+        l_renderer.heap().unlink_material_with_renderable_object(l_material_token, l_renderable_objects.get(i));
+        D3RendererAllocatorComposition::free_renderable_object_with_buffers(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_renderable_objects.get(i));
+    }
+    l_renderable_objects.free();
+    D3RendererAllocatorComposition::free_mesh_with_buffers(l_ctx.buffer_memory, l_renderer.allocator, l_mesh);
+    D3RendererAllocatorComposition::free_shader_recursively_with_gpu_ressources(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_shader);
+
+    l_ctx.graphics_allocator.free_shader_module(l_vertex_shader_module);
+    l_ctx.graphics_allocator.free_shader_module(l_fragment_shader_module);
+
+    l_shader_compiler.free();
+    l_renderer.free(l_ctx);
+    l_ctx.free();
+
+    memleak_ckeck();
+};
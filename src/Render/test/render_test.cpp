@@ -34,9 +34,9 @@ inline void bufferstep_test()
     l_ctx.buffer_step_and_submit();
     l_ctx.wait_for_completion();
 
-    assert_true(l_ctx.buffer_memory.allocator.host_buffers
-                    .get(l_ctx.graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_renderer.allocator.heap.renderable_objects.get(l_renderable_object).model).memory)
-                    .get_mapped_memory()
+    Slice<int8> l_model_buffer_memory = l_ctx.buffer_memory.allocator.host_buffers.get(l_renderer.model_buffer.frames.get(l_ctx.frame_index).buffer).get_mapped_effective_memory();
+    assert_true(Slice<int8>::build_memory_offset_elementnb(l_model_buffer_memory.Begin,
+                                                           l_renderer.model_buffer.get_dynamic_offset(l_renderer.allocator.heap.renderable_objects.get(l_renderable_object).model), sizeof(m44f))
                     .compare(Slice<m44f>::build_asint8_memory_singleelement(&m44f_const::IDENTITY)));
 
     Token(RenderableObject) l_renderable_object2 =
@@ -49,6 +49,102 @@ inline void bufferstep_test()
 
     assert_true(l_renderer.heap().model_update_events.Size == 0);
 
+    // All model matrices are uploaded to the same buffer, that grows when RenderableObjects exceed it's capacity
+    {
+        Token(Mesh) l_mesh = l_renderer.heap().renderable_objects.get(l_renderable_object).mesh;
+        Token(RenderableObject) l_renderable_objects[100];
+        for (loop(i, 0, 100))
+        {
+            l_renderable_objects[i] = D3RendererAllocatorComposition::allocate_renderable_object_with_buffers(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_mesh);
+            l_renderer.heap().push_modelupdateevent(D3RendererHeap::RenderableObject_ModelUpdateEvent{
+                l_renderable_objects[i], m44f::trs(v3f{(float32)i, 0.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE)});
+        }
+
+        l_renderer.buffer_step(l_ctx);
+
+        assert_true(l_renderer.model_buffer.frames.get(l_ctx.frame_index).capacity == 128);
+
+        l_model_buffer_memory = l_ctx.buffer_memory.allocator.host_buffers.get(l_renderer.model_buffer.frames.get(l_ctx.frame_index).buffer).get_mapped_effective_memory();
+        for (loop(i, 0, 100))
+        {
+            m44f l_model = m44f::trs(v3f{(float32)i, 0.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE);
+            assert_true(Slice<int8>::build_memory_offset_elementnb(l_model_buffer_memory.Begin,
+                                                                   l_renderer.model_buffer.get_dynamic_offset(l_renderer.allocator.heap.renderable_objects.get(l_renderable_objects[i]).model),
+                                                                   sizeof(m44f))
+                            .compare(Slice<m44f>::build_asint8_memory_singleelement(&l_model)));
+        }
+
+        for (loop(i, 0, 100))
+        {
+            D3RendererAllocatorComposition::free_renderable_object_with_buffers(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_renderable_objects[i]);
+        }
+    }
+
+    // Every frame in flight has it's own copy of the model matrices, the copy of the previous frame is left untouched
+    {
+        uimax l_previous_frame = l_ctx.frame_index;
+        m44f l_previous_model = m44f_const::IDENTITY;
+        m44f l_model = m44f::trs(v3f{1.0f, 2.0f, 3.0f}, m33f_const::IDENTITY, v3f_const::ONE);
+        Token(m44f) l_model_slot = l_renderer.allocator.heap.renderable_objects.get(l_renderable_object).model;
+
+        l_ctx.begin_frame();
+        assert_true(l_ctx.frame_index != l_previous_frame);
+
+        l_renderer.heap().push_modelupdateevent(D3RendererHeap::RenderableObject_ModelUpdateEvent{l_renderable_object, l_model});
+        l_renderer.buffer_step(l_ctx);
+        l_ctx.buffer_step_and_submit();
+        GraphicsBinder l_binder = l_ctx.creates_graphics_binder();
+        l_ctx.submit_graphics_binder(l_binder);
+
+        Slice<int8> l_current_memory = l_ctx.buffer_memory.allocator.host_buffers.get(l_renderer.model_buffer.frames.get(l_ctx.frame_index).buffer).get_mapped_effective_memory();
+        Slice<int8> l_previous_memory = l_ctx.buffer_memory.allocator.host_buffers.get(l_renderer.model_buffer.frames.get(l_previous_frame).buffer).get_mapped_effective_memory();
+        assert_true(Slice<int8>::build_memory_offset_elementnb(l_current_memory.Begin, l_renderer.model_buffer.get_dynamic_offset(l_model_slot), sizeof(m44f))
+                        .compare(Slice<m44f>::build_asint8_memory_singleelement(&l_model)));
+        assert_true(Slice<int8>::build_memory_offset_elementnb(l_previous_memory.Begin, l_renderer.model_buffer.get_dynamic_offset(l_model_slot), sizeof(m44f))
+                        .compare(Slice<m44f>::build_asint8_memory_singleelement(&l_previous_model)));
+        assert_true(l_renderer.model_buffer.frames.get(l_previous_frame).outdated);
+
+        l_ctx.wait_for_completion();
+    }
+
+    // The camera is written to the global material buffer of the recorded frame. The buffer of the other frame is refreshed when it's frame binds the global material.
+    {
+        Camera l_camera = Camera{m44f::trs(v3f{4.0f, 5.0f, 6.0f}, m33f_const::IDENTITY, v3f_const::ONE), m44f_const::IDENTITY};
+        ShaderUniformBufferHostFramesParameter& l_camera_parameter = l_ctx.graphics_allocator.heap.shader_uniform_buffer_host_frames_parameters.get(
+            l_ctx.graphics_allocator.heap.material_parameters.get_vector(l_renderer.color_step.global_material.parameters).get(0).uniform_host);
+
+        l_ctx.begin_frame();
+        uimax l_written_frame = l_ctx.frame_index;
+        l_renderer.color_step.set_camera(l_ctx, l_camera);
+        l_renderer.buffer_step(l_ctx);
+        l_ctx.buffer_step_and_submit();
+        GraphicsBinder l_binder = l_ctx.creates_graphics_binder();
+        l_ctx.submit_graphics_binder(l_binder);
+
+        assert_true(l_camera_parameter.written_frame == l_written_frame);
+        for (loop(i, 0, GPUFrame_const::FRAMES_IN_FLIGHT))
+        {
+            assert_true(l_camera_parameter.frames_outdated.get(i) == (i != l_written_frame));
+        }
+
+        l_ctx.begin_frame();
+        assert_true(l_ctx.frame_index != l_written_frame);
+        l_ctx.buffer_step_and_submit();
+        GraphicsBinder l_refresh_binder = l_ctx.creates_graphics_binder();
+        l_refresh_binder.bind_shader_layout(l_ctx.graphics_allocator.heap.shader_layouts.get(l_renderer.color_step.global_buffer_layout));
+        l_refresh_binder.bind_material(l_renderer.color_step.global_material);
+        l_refresh_binder.pop_material_bind(l_renderer.color_step.global_material);
+        l_ctx.submit_graphics_binder(l_refresh_binder);
+
+        assert_true(!l_camera_parameter.frames_outdated.get(l_ctx.frame_index));
+        Slice<int8> l_camera_memory = l_ctx.buffer_memory.allocator.host_buffers
+                                          .get(l_ctx.graphics_allocator.heap.shader_uniform_buffer_host_parameters.get(l_camera_parameter.frames.get(l_ctx.frame_index)).memory)
+                                          .get_mapped_effective_memory();
+        assert_true(l_camera_memory.compare(Slice<Camera>::build_asint8_memory_singleelement(&l_camera)));
+
+        l_ctx.wait_for_completion();
+    }
+
     D3RendererAllocatorComposition::free_renderable_object_with_mesh_and_buffers(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_renderable_object);
 
     l_renderer.free(l_ctx);
@@ -83,6 +179,134 @@ inline void shader_linkto_material_allocation_test()
     l_ctx.free();
 };
 
+inline void draw_test_build_cube(Vertex* out_vertices, uint32* out_indices)
+{
+    v3f l_positions[8] = {v3f{-1.0f, -1.0f, 1.0f}, v3f{-1.0f, 1.0f, 1.0f}, v3f{-1.0f, -1.0f, -1.0f}, v3f{-1.0f, 1.0f, -1.0f},
+                          v3f{1.0f, -1.0f, 1.0f},  v3f{1.0f, 1.0f, 1.0f},  v3f{1.0f, -1.0f, -1.0f},  v3f{1.0f, 1.0f, -1.0f}};
+
+    v2f l_uvs[14] = {v2f{0.625f, 0.0f},  v2f{0.375f, 0.25f}, v2f{0.375f, 0.0f},  v2f{0.625f, 0.25f}, v2f{0.375f, 0.5f},  v2f{0.625f, 0.5f},  v2f{0.375f, 0.75f},
+                     v2f{0.625f, 0.75f}, v2f{0.375f, 1.00f}, v2f{0.125f, 0.75f}, v2f{0.125f, 0.50f}, v2f{0.875f, 0.50f}, v2f{0.625f, 1.00f}, v2f{0.875f, 0.75f}};
+
+    Vertex l_vertices[14] = {Vertex{l_positions[1], l_uvs[0]},  Vertex{l_positions[2], l_uvs[1]}, Vertex{l_positions[0], l_uvs[2]},  Vertex{l_positions[3], l_uvs[3]},
+                             Vertex{l_positions[6], l_uvs[4]},  Vertex{l_positions[7], l_uvs[5]}, Vertex{l_positions[4], l_uvs[6]},  Vertex{l_positions[5], l_uvs[7]},
+                             Vertex{l_positions[0], l_uvs[8]},  Vertex{l_positions[0], l_uvs[9]}, Vertex{l_positions[2], l_uvs[10]}, Vertex{l_positions[3], l_uvs[11]},
+                             Vertex{l_positions[1], l_uvs[12]}, Vertex{l_positions[1], l_uvs[13]}};
+    uint32 l_indices[14 * 3] = {0, 1, 2, 3, 4, 1, 5, 6, 4, 7, 8, 6, 4, 9, 10, 11, 7, 5, 0, 3, 1, 3, 5, 4, 5, 7, 6, 7, 12, 8, 4, 6, 9, 11, 13, 7};
+
+    Slice<Vertex>::build_memory_elementnb(out_vertices, 14).copy_memory(Slice<Vertex>::build_memory_elementnb(l_vertices, 14));
+    Slice<uint32>::build_memory_elementnb(out_indices, 14 * 3).copy_memory(Slice<uint32>::build_memory_elementnb(l_indices, 14 * 3));
+};
+
+/*
+    Four cubes (two red on the x axis, two green on the y axis) viewed by the draw_test camera.
+*/
+inline void draw_test_assert_cubes_image(const Slice<color>& p_color_attachment)
+{
+    int l_index = 0;
+    for (; l_index <= 7; l_index++)
+    {
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+    }
+    {
+        for (loop(i, 0, 2))
+        {
+            assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+            l_index += 1;
+            assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+            l_index += 1;
+            assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+            l_index += 1;
+            assert_true(p_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
+            l_index += 1;
+            assert_true(p_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
+            l_index += 1;
+            assert_true(p_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
+            l_index += 1;
+            assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+            l_index += 1;
+            assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+            l_index += 1;
+        }
+    }
+    {
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+    }
+    {
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+    }
+    {
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+    }
+    {
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+    }
+    for (loop(i, 0, 7))
+    {
+        assert_true(p_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
+        l_index += 1;
+    }
+};
+
 inline void draw_test()
 {
     GPUContext l_ctx = GPUContext::allocate(Slice<GPUExtension>::build_default());
@@ -162,17 +386,9 @@ inline void draw_test()
     Token(RenderableObject) l_obj_1, l_obj_2, l_obj_3, l_obj_4;
 
     {
-        v3f l_positions[8] = {v3f{-1.0f, -1.0f, 1.0f}, v3f{-1.0f, 1.0f, 1.0f}, v3f{-1.0f, -1.0f, -1.0f}, v3f{-1.0f, 1.0f, -1.0f},
-                              v3f{1.0f, -1.0f, 1.0f},  v3f{1.0f, 1.0f, 1.0f},  v3f{1.0f, -1.0f, -1.0f},  v3f{1.0f, 1.0f, -1.0f}};
-
-        v2f l_uvs[14] = {v2f{0.625f, 0.0f},  v2f{0.375f, 0.25f}, v2f{0.375f, 0.0f},  v2f{0.625f, 0.25f}, v2f{0.375f, 0.5f},  v2f{0.625f, 0.5f},  v2f{0.375f, 0.75f},
-                         v2f{0.625f, 0.75f}, v2f{0.375f, 1.00f}, v2f{0.125f, 0.75f}, v2f{0.125f, 0.50f}, v2f{0.875f, 0.50f}, v2f{0.625f, 1.00f}, v2f{0.875f, 0.75f}};
-
-        Vertex l_vertices[14] = {Vertex{l_positions[1], l_uvs[0]},  Vertex{l_positions[2], l_uvs[1]}, Vertex{l_positions[0], l_uvs[2]},  Vertex{l_positions[3], l_uvs[3]},
-                                 Vertex{l_positions[6], l_uvs[4]},  Vertex{l_positions[7], l_uvs[5]}, Vertex{l_positions[4], l_uvs[6]},  Vertex{l_positions[5], l_uvs[7]},
-                                 Vertex{l_positions[0], l_uvs[8]},  Vertex{l_positions[0], l_uvs[9]}, Vertex{l_positions[2], l_uvs[10]}, Vertex{l_positions[3], l_uvs[11]},
-                                 Vertex{l_positions[1], l_uvs[12]}, Vertex{l_positions[1], l_uvs[13]}};
-        uint32 l_indices[14 * 3] = {0, 1, 2, 3, 4, 1, 5, 6, 4, 7, 8, 6, 4, 9, 10, 11, 7, 5, 0, 3, 1, 3, 5, 4, 5, 7, 6, 7, 12, 8, 4, 6, 9, 11, 13, 7};
+        Vertex l_vertices[14];
+        uint32 l_indices[14 * 3];
+        draw_test_build_cube(l_vertices, l_indices);
         l_obj_1 = D3RendererAllocatorComposition::allocate_renderable_object_with_mesh_and_buffers(
             l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, Slice<Vertex>::build_memory_elementnb(l_vertices, 14), Slice<uint32>::build_memory_elementnb(l_indices, 14 * 3));
         l_obj_2 = D3RendererAllocatorComposition::allocate_renderable_object_with_mesh_and_buffers(
@@ -227,111 +443,7 @@ inline void draw_test()
 
     Slice<color> l_color_attachment = slice_cast<color>(l_ctx.buffer_memory.allocator.host_buffers.get(l_color_attachment_token).get_mapped_memory());
 
-    {
-        int l_index = 0;
-        for (; l_index <= 7; l_index++)
-        {
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-        }
-        {
-            for (loop(i, 0, 2))
-            {
-                assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-                l_index += 1;
-                assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-                l_index += 1;
-                assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-                l_index += 1;
-                assert_true(l_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
-                l_index += 1;
-                assert_true(l_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
-                l_index += 1;
-                assert_true(l_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
-                l_index += 1;
-                assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-                l_index += 1;
-                assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-                l_index += 1;
-            }
-        }
-        {
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-        }
-        {
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-        }
-        {
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{uint8_max, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-        }
-        {
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, uint8_max, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-        }
-        for (loop(i, 0, 7))
-        {
-            assert_true(l_color_attachment.get(l_index) == color{0, 0, 0, uint8_max});
-            l_index += 1;
-        }
-    }
+    draw_test_assert_cubes_image(l_color_attachment);
 
     BufferAllocatorComposition::free_buffer_host_and_remove_event_references(l_ctx.buffer_memory.allocator, l_ctx.buffer_memory.events, l_color_attachment_token);
 
@@ -349,6 +461,178 @@ inline void draw_test()
     l_shader_compiler.free();
 };
 
+inline void instanced_draw_test()
+{
+    GPUContext l_ctx = GPUContext::allocate(Slice<GPUExtension>::build_default());
+    D3Renderer l_renderer = D3Renderer::allocate(l_ctx, ColorStep::AllocateInfo{v3ui{8, 8, 1}, 1});
+    ShaderCompiler l_shader_compiler = ShaderCompiler::allocate();
+
+    const int8* p_vertex_litteral =
+				MULTILINE(\
+                #version 450 \n
+
+						layout(location = 0) in vec3 pos; \n
+						layout(location = 1) in vec2 uv; \n
+						layout(location = 2) in mat4 model; \n
+
+						struct Camera \n
+				{ \n
+						mat4 view; \n
+						mat4 projection; \n
+				}; \n
+
+						layout(set = 0, binding = 0) uniform camera { Camera cam; }; \n
+
+						void main()\n
+				{ \n
+						gl_Position = cam.projection * (cam.view * (model * vec4(pos.xyz, 1.0f)));\n
+				}\n
+				);
+
+    const int8* p_fragment_litteral =
+				MULTILINE(\
+                #version 450\n
+
+						layout(location = 0) out vec4 outColor;\n
+
+						layout(set = 1, binding = 0) uniform color { vec3 col; }; \n
+
+						void main()\n
+				{ \n
+						outColor = vec4(col.xyz, 1.0f);\n
+				}\n
+				);
+
+    ShaderCompiled l_vertex_shader_compiled = l_shader_compiler.compile_shader(ShaderModuleStage::VERTEX, slice_int8_build_rawstr(p_vertex_litteral));
+    ShaderCompiled l_fragment_shader_compiled = l_shader_compiler.compile_shader(ShaderModuleStage::FRAGMENT, slice_int8_build_rawstr(p_fragment_litteral));
+
+    Token(ShaderModule) l_vertex_shader_module = l_ctx.graphics_allocator.allocate_shader_module(l_vertex_shader_compiled.get_compiled_binary());
+    Token(ShaderModule) l_fragment_shader_module = l_ctx.graphics_allocator.allocate_shader_module(l_fragment_shader_compiled.get_compiled_binary());
+
+    Token(ShaderIndex) l_shader = D3RendererAllocatorComposition::allocate_colorstep_instanced_shader_with_shaderlayout(
+        l_ctx.graphics_allocator, l_renderer.allocator, SliceN<ShaderLayoutParameterType, 1>{ShaderLayoutParameterType::UNIFORM_BUFFER_VERTEX_FRAGMENT}.to_slice(), 0,
+        l_ctx.graphics_allocator.heap.graphics_pass.get(l_renderer.color_step.pass), ShaderConfiguration{1, ShaderConfiguration::CompareOp::LessOrEqual},
+        l_ctx.graphics_allocator.heap.shader_modules.get(l_vertex_shader_module), l_ctx.graphics_allocator.heap.shader_modules.get(l_fragment_shader_module));
+
+    ShaderIndex l_shader_value = l_renderer.heap().shaders.get(l_shader);
+    assert_true(l_shader_value.instanced);
+
+    l_vertex_shader_compiled.free();
+    l_fragment_shader_compiled.free();
+
+    Material l_red_material = Material::allocate_empty(l_ctx.graphics_allocator, 1);
+    l_red_material.add_and_allocate_buffer_host_parameter_typed(l_ctx.graphics_allocator, l_ctx.buffer_memory.allocator, l_ctx.graphics_allocator.heap.shader_layouts.get(l_shader_value.shader_layout),
+                                                                v3f{1.0f, 0.0f, 0.0f});
+
+    Material l_green_material = Material::allocate_empty(l_ctx.graphics_allocator, 1);
+    l_green_material.add_and_allocate_buffer_host_parameter_typed(l_ctx.graphics_allocator, l_ctx.buffer_memory.allocator,
+                                                                  l_ctx.graphics_allocator.heap.shader_layouts.get(l_shader_value.shader_layout), v3f{0.0f, 1.0f, 0.0f});
+
+    Token(Material) l_red_material_token = l_renderer.allocator.allocate_material(l_red_material);
+    Token(Material) l_green_material_token = l_renderer.allocator.allocate_material(l_green_material);
+
+    l_renderer.heap().link_shader_with_material(l_shader, l_red_material_token);
+    l_renderer.heap().link_shader_with_material(l_shader, l_green_material_token);
+
+    // All cubes share the same mesh
+    Token(Mesh) l_mesh;
+    {
+        Vertex l_vertices[14];
+        uint32 l_indices[14 * 3];
+        draw_test_build_cube(l_vertices, l_indices);
+        l_mesh = D3RendererAllocatorComposition::allocate_mesh_with_buffers(l_ctx.buffer_memory, l_renderer.allocator, Slice<Vertex>::build_memory_elementnb(l_vertices, 14),
+                                                                            Slice<uint32>::build_memory_elementnb(l_indices, 14 * 3));
+    }
+
+    Token(RenderableObject) l_objs[4];
+    for (loop(i, 0, 4))
+    {
+        l_objs[i] = D3RendererAllocatorComposition::allocate_renderable_object_with_buffers(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_mesh);
+    }
+
+    m44f l_model = m44f::trs(v3f{2.0f, 0.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE);
+    l_renderer.heap().push_modelupdateevent(D3RendererHeap::RenderableObject_ModelUpdateEvent{l_objs[0], l_model});
+    l_model = m44f::trs(v3f{-2.0f, 0.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE);
+    l_renderer.heap().push_modelupdateevent(D3RendererHeap::RenderableObject_ModelUpdateEvent{l_objs[1], l_model});
+    l_model = m44f::trs(v3f{0.0f, 2.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE);
+    l_renderer.heap().push_modelupdateevent(D3RendererHeap::RenderableObject_ModelUpdateEvent{l_objs[2], l_model});
+    l_model = m44f::trs(v3f{0.0f, -2.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE);
+    l_renderer.heap().push_modelupdateevent(D3RendererHeap::RenderableObject_ModelUpdateEvent{l_objs[3], l_model});
+
+    l_renderer.heap().link_material_with_renderable_object(l_red_material_token, l_objs[0]);
+    l_renderer.heap().link_material_with_renderable_object(l_green_material_token, l_objs[2]);
+    l_renderer.heap().link_material_with_renderable_object(l_red_material_token, l_objs[1]);
+    l_renderer.heap().link_material_with_renderable_object(l_green_material_token, l_objs[3]);
+
+    {
+        quat l_camera_rotation = quat{-0.106073f, 0.867209f, -0.283699f, -0.395236f};
+        m33f l_camera_rotation_axis = l_camera_rotation.to_axis();
+        m44f l_view = m44f::view(v3f{5.0f, 5.0f, 5.0f}, l_camera_rotation_axis.Forward, l_camera_rotation_axis.Up);
+        m44f l_projection = m44f::perspective(45.0f, 1.0f, 1.0f, 30.0f);
+        l_renderer.color_step.set_camera(l_ctx, Camera{l_view, l_projection});
+    }
+
+    l_renderer.buffer_step(l_ctx);
+
+    // One draw per material, each one instancing the two cubes linked to the material
+    {
+        Vector<D3RendererInstancedDraws::Draw>& l_draws = l_renderer.instanced_draws.draws;
+        assert_true(l_draws.Size == 2);
+        assert_true(tk_eq(l_draws.get(0).material, l_red_material_token));
+        assert_true(l_draws.get(0).first_instance == 0);
+        assert_true(l_draws.get(0).instance_count == 2);
+        assert_true(tk_eq(l_draws.get(1).material, l_green_material_token));
+        assert_true(l_draws.get(1).first_instance == 2);
+        assert_true(l_draws.get(1).instance_count == 2);
+
+        assert_true(l_renderer.instanced_draws.instance_matrices.get(1) == m44f::trs(v3f{-2.0f, 0.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE));
+        assert_true(l_renderer.instanced_draws.instance_matrices.get(3) == m44f::trs(v3f{0.0f, -2.0f, 0.0f}, m33f_const::IDENTITY, v3f_const::ONE));
+    }
+
+    l_ctx.buffer_step_and_submit();
+
+    GraphicsBinder l_binder = GraphicsBinder::build(l_ctx.buffer_memory.allocator, l_ctx.graphics_allocator);
+    l_binder.start();
+    l_renderer.graphics_step(l_binder);
+    l_binder.end();
+
+    l_ctx.submit_graphics_binder(l_binder);
+    l_ctx.wait_for_completion();
+
+    Token(BufferHost) l_color_attachment_token =
+        GraphicsPassReader::read_graphics_pass_attachment_to_bufferhost(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_ctx.graphics_allocator.heap.graphics_pass.get(l_renderer.color_step.pass), 0);
+    {
+        BufferStep::step(l_ctx.buffer_memory.allocator, l_ctx.buffer_memory.events);
+        l_ctx.buffer_memory.allocator.device.command_buffer.submit();
+        l_ctx.buffer_memory.allocator.device.command_buffer.wait_for_completion();
+    }
+
+    Slice<color> l_color_attachment = slice_cast<color>(l_ctx.buffer_memory.allocator.host_buffers.get(l_color_attachment_token).get_mapped_memory());
+
+    draw_test_assert_cubes_image(l_color_attachment);
+
+    BufferAllocatorComposition::free_buffer_host_and_remove_event_references(l_ctx.buffer_memory.allocator, l_ctx.buffer_memory.events, l_color_attachment_token);
+
+    l_renderer.heap().unlink_material_with_renderable_object(l_red_material_token, l_objs[0]);
+    l_renderer.heap().unlink_material_with_renderable_object(l_green_material_token, l_objs[2]);
+    l_renderer.heap().unlink_material_with_renderable_object(l_red_material_token, l_objs[1]);
+    l_renderer.heap().unlink_material_with_renderable_object(l_green_material_token, l_objs[3]);
+    for (loop(i, 0, 4))
+    {
+        D3RendererAllocatorComposition::free_renderable_object_with_buffers(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_objs[i]);
+    }
+    D3RendererAllocatorComposition::free_mesh_with_buffers(l_ctx.buffer_memory, l_renderer.allocator, l_mesh);
+
+    D3RendererAllocatorComposition::free_shader_recursively_with_gpu_ressources(l_ctx.buffer_memory, l_ctx.graphics_allocator, l_renderer.allocator, l_shader);
+
+    l_ctx.graphics_allocator.free_shader_module(l_vertex_shader_module);
+    l_ctx.graphics_allocator.free_shader_module(l_fragment_shader_module);
+
+    l_renderer.free(l_ctx);
+    l_ctx.free();
+    l_shader_compiler.free();
+};
+
 int main()
 {
 #ifdef RENDER_DOC_DEBUG
@@ -362,6 +646,7 @@ int main()
     bufferstep_test();
     shader_linkto_material_allocation_test();
     draw_test();
+    instanced_draw_test();
 
     memleak_ckeck();
 };
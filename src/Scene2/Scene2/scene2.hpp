@@ -36,7 +36,7 @@ inline NodeComponent NodeComponent::build(const component_t p_type, const token_
 
 inline SceneTree SceneTree::allocate_default()
 {
-    SceneTree l_scene = SceneTree{NTree<Node>::allocate_default()};
+    SceneTree l_scene = SceneTree{NTree<Node>::allocate_default(), Vector<Token(Node)>::allocate(0), Vector<uimax>::allocate(0), Vector<m44f>::allocate(0), Span<uimax>::allocate(0), 0, 0};
 
     l_scene.allocate_root_node();
 
@@ -46,6 +46,10 @@ inline SceneTree SceneTree::allocate_default()
 inline void SceneTree::free()
 {
     this->node_tree.free();
+    this->hierarchy_nodes.free();
+    this->hierarchy_parents.free();
+    this->hierarchy_localtoworld.free();
+    this->node_to_hierarchy.free();
 };
 
 inline Token(Node) SceneTree::add_node(const transform& p_initial_local_transform, const Token(Node) p_parent)
@@ -73,6 +77,7 @@ inline void SceneTree::add_child(const NodeEntry& p_parent, const NodeEntry& p_c
 {
     if (this->node_tree.add_child(p_parent, p_child))
     {
+        this->hierarchy_mustBe_rebuilt = 1;
         this->mark_node_for_recalculation_recursive(p_child);
     }
 };
@@ -82,6 +87,12 @@ inline void SceneTree::remove_node(const NodeEntry& p_node)
     this->free_node_recurvise(p_node);
 };
 
+inline void SceneTree::make_node_orphan(NodeEntry& p_node)
+{
+    this->node_tree.make_node_orphan(p_node);
+    this->hierarchy_mustBe_rebuilt = 1;
+};
+
 inline v3f& SceneTree::get_localposition(const NodeEntry& p_node)
 {
     return p_node.Element->local_transform.position;
@@ -201,8 +212,12 @@ inline v3f SceneTree::get_worldscalefactor(const NodeEntry& p_node)
 
 inline m44f& SceneTree::get_localtoworld(const NodeEntry& p_node)
 {
+    if (this->hierarchy_mustBe_rebuilt)
+    {
+        this->rebuild_hierarchy();
+    }
     this->updatematrices_if_necessary(p_node);
-    return p_node.Element->localtoworld;
+    return this->hierarchy_localtoworld.get(this->node_to_hierarchy.get(tk_v(p_node.Node->index)));
 };
 
 inline m44f SceneTree::get_worldtolocal(const NodeEntry& p_node)
@@ -210,6 +225,34 @@ inline m44f SceneTree::get_worldtolocal(const NodeEntry& p_node)
     return this->get_localtoworld(p_node).inv();
 };
 
+inline void SceneTree::update_matrices()
+{
+    if (this->hierarchy_mustBe_rebuilt)
+    {
+        this->rebuild_hierarchy();
+    }
+
+    if (this->matrices_mustBe_updated)
+    {
+        for (vector_loop(&this->hierarchy_nodes, i))
+        {
+            Node& l_node = this->node_tree.get_value(this->hierarchy_nodes.get(i));
+            if (l_node.state.matrices_mustBe_recalculated)
+            {
+                m44f l_localtoworld = m44f::trs(l_node.local_transform.position, l_node.local_transform.rotation.to_axis(), l_node.local_transform.scale);
+                uimax l_parent = this->hierarchy_parents.get(i);
+                if (l_parent != (uimax)-1)
+                {
+                    l_localtoworld = this->hierarchy_localtoworld.get(l_parent) * l_localtoworld;
+                }
+                this->hierarchy_localtoworld.get(i) = l_localtoworld;
+                l_node.state.matrices_mustBe_recalculated = false;
+            }
+        }
+        this->matrices_mustBe_updated = 0;
+    }
+};
+
 inline void SceneTree::clear_nodes_state()
 {
     this->node_tree.traverse3(tk_b(NTreeNode, 0), [](const NodeEntry& p_node) { p_node.Element->state.haschanged_thisframe = false; });
@@ -218,17 +261,79 @@ inline void SceneTree::clear_nodes_state()
 inline Token(Node) SceneTree::allocate_node(const transform& p_initial_local_transform, const Token(Node) p_parent)
 {
     Token(Node) l_node = this->node_tree.push_value(Node::build(Node::State::build(1, 1), p_initial_local_transform), p_parent);
+    this->push_node_to_hierarchy(l_node, p_parent);
     return l_node;
 };
 
 inline Token(Node) SceneTree::allocate_root_node()
 {
     Token(Node) l_node = this->node_tree.push_root_value(Node::build(Node::State::build(1, 1), transform_const::ORIGIN));
+    this->push_node_to_hierarchy(l_node, tk_bd(Node));
     return l_node;
 };
 
+inline void SceneTree::push_node_to_hierarchy(const Token(Node) p_node, const Token(Node) p_parent)
+{
+    this->matrices_mustBe_updated = 1;
+
+    // If the hierarchy must be rebuilt, parent index may be outdated but will be recalculated anyway
+    uimax l_parent = (uimax)-1;
+    if (tk_v(p_parent) != (token_t)-1)
+    {
+        l_parent = this->node_to_hierarchy.get(tk_v(p_parent));
+    }
+
+    this->node_to_hierarchy.resize_until_capacity_met(tk_v(p_node) + 1);
+    this->node_to_hierarchy.get(tk_v(p_node)) = this->hierarchy_nodes.Size;
+    this->hierarchy_nodes.push_back_element(p_node);
+    this->hierarchy_parents.push_back_element(l_parent);
+    this->hierarchy_localtoworld.push_back_element(m44f{});
+};
+
+/*
+    Nodes are ordered by traversing every trees of the node_tree. Orphan nodes (that will be removed) are trees too.
+    localtoworld matrices are moved to their new index.
+*/
+inline void SceneTree::rebuild_hierarchy()
+{
+    Vector<Token(Node)> l_hierarchy_nodes = Vector<Token(Node)>::allocate(this->hierarchy_nodes.Size);
+    Vector<uimax> l_hierarchy_parents = Vector<uimax>::allocate(this->hierarchy_nodes.Size);
+    Vector<m44f> l_hierarchy_localtoworld = Vector<m44f>::allocate(this->hierarchy_nodes.Size);
+    this->node_to_hierarchy.resize_until_capacity_met(this->node_tree.Indices.get_size());
+
+    for (loop(i, 0, this->node_tree.Indices.get_size()))
+    {
+        Token(NTreeNode) l_tree_root = tk_b(NTreeNode, i);
+        if (!this->node_tree.Indices.is_element_free(l_tree_root) && !this->node_tree.get_from_node(l_tree_root).has_parent())
+        {
+            this->node_tree.traverse3(l_tree_root, [this, &l_hierarchy_nodes, &l_hierarchy_parents, &l_hierarchy_localtoworld](const NodeEntry& p_node) {
+                uimax l_parent = (uimax)-1;
+                if (p_node.has_parent())
+                {
+                    l_parent = this->node_to_hierarchy.get(tk_v(p_node.Node->parent));
+                }
+
+                uimax& l_node_to_hierarchy = this->node_to_hierarchy.get(tk_v(p_node.Node->index));
+                l_hierarchy_localtoworld.push_back_element(this->hierarchy_localtoworld.get(l_node_to_hierarchy));
+                l_node_to_hierarchy = l_hierarchy_nodes.Size;
+                l_hierarchy_nodes.push_back_element(tk_bf(Node, p_node.Node->index));
+                l_hierarchy_parents.push_back_element(l_parent);
+            });
+        }
+    }
+
+    this->hierarchy_nodes.free();
+    this->hierarchy_parents.free();
+    this->hierarchy_localtoworld.free();
+    this->hierarchy_nodes = l_hierarchy_nodes;
+    this->hierarchy_parents = l_hierarchy_parents;
+    this->hierarchy_localtoworld = l_hierarchy_localtoworld;
+    this->hierarchy_mustBe_rebuilt = 0;
+};
+
 inline void SceneTree::mark_node_for_recalculation_recursive(const NodeEntry& p_node)
 {
+    this->matrices_mustBe_updated = 1;
     this->node_tree.traverse3(tk_bf(NTreeNode, p_node.Node->index), [](const NodeEntry& p_node) { p_node.Element->mark_for_recaluclation(); });
 };
 
@@ -236,25 +341,27 @@ inline void SceneTree::updatematrices_if_necessary(const NodeEntry& p_node)
 {
     if (p_node.Element->state.matrices_mustBe_recalculated)
     {
-        p_node.Element->localtoworld = m44f::trs(p_node.Element->local_transform.position, p_node.Element->local_transform.rotation.to_axis(), p_node.Element->local_transform.scale);
+        m44f l_localtoworld = m44f::trs(p_node.Element->local_transform.position, p_node.Element->local_transform.rotation.to_axis(), p_node.Element->local_transform.scale);
 
         if (p_node.has_parent())
         {
             NodeEntry l_parent = this->get_node(tk_bf(Node, p_node.Node->parent));
-            p_node.Element->localtoworld = this->get_localtoworld(l_parent) * p_node.Element->localtoworld;
+            l_localtoworld = this->get_localtoworld(l_parent) * l_localtoworld;
         }
+        this->hierarchy_localtoworld.get(this->node_to_hierarchy.get(tk_v(p_node.Node->index))) = l_localtoworld;
         p_node.Element->state.matrices_mustBe_recalculated = false;
     }
 };
 
 inline void SceneTree::free_node_recurvise(const NodeEntry& p_node)
 {
-    Vector<NodeEntry> l_deleted_nodes = Vector<NodeEntry>::allocate(0);
+    Vector<NodeEntry, ScratchAllocator> l_deleted_nodes = Vector<NodeEntry, ScratchAllocator>::allocate(0);
     this->node_tree.get_nodes(p_node.Node->index, &l_deleted_nodes);
 
     Slice<NodeEntry> l_deleted_nodes_slice = l_deleted_nodes.to_slice();
     this->node_tree.remove_nodes_and_detach(l_deleted_nodes_slice);
     l_deleted_nodes.free();
+    this->hierarchy_mustBe_rebuilt = 1;
 };
 
 inline Scene::ComponentRemovedEvent Scene::ComponentRemovedEvent::build(const Token(Node) p_node, const NodeComponent& p_component_value)
@@ -317,6 +424,7 @@ inline void Scene::step()
 {
     this->destroy_orphan_nodes();
     this->destroy_component_removed_events();
+    this->tree.update_matrices();
     this->tree.clear_nodes_state();
 };
 
@@ -347,7 +455,7 @@ inline void Scene::remove_node(const NodeEntry& p_node)
     // get all components -> for pushing events
 
     NodeEntry l_node_copy = p_node;
-    this->tree.node_tree.make_node_orphan(l_node_copy);
+    this->tree.make_node_orphan(l_node_copy);
     this->orphan_nodes.push_back_element(tk_bf(Node, p_node.Node->index));
 
     this->tree.node_tree.traverse3(tk_bf(NTreeNode, p_node.Node->index), [this](const NodeEntry& p_tree_node) {
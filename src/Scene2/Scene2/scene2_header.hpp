@@ -6,7 +6,7 @@ using component_t = hash_t;
 
 /*
     Value associated to every node of the SceneTree.
-    The Node stores local_transform and localtoworld matrix.
+    The Node stores local_transform. The localtoworld matrix is stored by the SceneTree.
 */
 struct Node
 {
@@ -26,9 +26,6 @@ struct Node
     // transform
     transform local_transform;
 
-    /** This matrix will always be relative to the root Node (a Node without parent). */
-    m44f localtoworld;
-
     static Node build_default();
     static Node build(const State& p_state, const transform& p_local_transform);
 
@@ -54,6 +51,19 @@ struct SceneTree
 {
     NTree<Node> node_tree;
 
+    /*
+        localtoworld matrices are stored in hierarchy order : a parent Node is always before it's childs.
+        This allows to update all matrices with a single linear pass (see update_matrices) instead of recursively resolving parents.
+        The hierarchy order is rebuilt only when a Node is detached or removed. New Nodes are pushed at the end.
+        localtoworld matrices will always be relative to the root Node (a Node without parent).
+    */
+    Vector<Token(Node)> hierarchy_nodes;
+    Vector<uimax> hierarchy_parents; // (uimax)-1 if the Node has no parent
+    Vector<m44f> hierarchy_localtoworld;
+    Span<uimax> node_to_hierarchy;
+    int8 hierarchy_mustBe_rebuilt;
+    int8 matrices_mustBe_updated;
+
     static SceneTree allocate_default();
     void free();
 
@@ -66,6 +76,7 @@ struct SceneTree
     void add_child(const NodeEntry& p_parent, const NodeEntry& p_child);
 
     void remove_node(const NodeEntry& p_node);
+    void make_node_orphan(NodeEntry& p_node);
 
     v3f& get_localposition(const NodeEntry& p_node);
     quat& get_localrotation(const NodeEntry& p_node);
@@ -85,11 +96,16 @@ struct SceneTree
     m44f& get_localtoworld(const NodeEntry& p_node);
     m44f get_worldtolocal(const NodeEntry& p_node);
 
+    // Updates localtoworld matrices of all Nodes that must be recalculated, in hierarchy order.
+    void update_matrices();
+
     void clear_nodes_state();
 
   private:
     Token(Node) allocate_node(const transform& p_initial_local_transform, const Token(Node) p_parent);
     Token(Node) allocate_root_node();
+    void push_node_to_hierarchy(const Token(Node) p_node, const Token(Node) p_parent);
+    void rebuild_hierarchy();
     void mark_node_for_recalculation_recursive(const NodeEntry& p_node);
     void updatematrices_if_necessary(const NodeEntry& p_node);
 
@@ -95,7 +95,7 @@ struct SceneAsset
     */
     template <class ComponentResourceAllocatorFunc> inline void merge_to_scene(Scene* p_target_scene, const Token(Node) p_parent, const ComponentResourceAllocatorFunc& p_component_resource_allocator)
     {
-        Span<Token(Node)> l_allocated_nodes = Span<Token(Node)>::allocate(this->nodes.Indices.get_size());
+        Span<Token(Node), ScratchAllocator> l_allocated_nodes = Span<Token(Node), ScratchAllocator>::allocate(this->nodes.Indices.get_size());
         {
             this->nodes.traverse3(tk_b(NTreeNode, 0), [&](const NTree<transform>::Resolve& p_node) {
                 Token(Node) l_parent;
@@ -144,7 +144,7 @@ struct SceneAsset
     template <class ComponentResourceDeconstrcutorFunc>
     inline void scene_copied_to(Scene* p_scene, const Token(Node) p_start_node_included, const ComponentResourceDeconstrcutorFunc& p_component_resrouce_deconstructor)
     {
-        Span<Token(transform)> l_allocated_nodes = Span<Token(transform)>::allocate(p_scene->tree.node_tree.Indices.get_size());
+        Span<Token(transform), ScratchAllocator> l_allocated_nodes = Span<Token(transform), ScratchAllocator>::allocate(p_scene->tree.node_tree.Indices.get_size());
 
         {
             NodeEntry l_node = p_scene->tree.node_tree.get(p_start_node_included);
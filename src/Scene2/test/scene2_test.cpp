@@ -279,6 +279,49 @@ inline void math_hierarchy()
     l_scene.free_and_consume_component_events<DefaulSceneComponentReleaser>();
 };
 
+/*
+    localtoworld matrices are updated by the Scene step in hierarchy order.
+    When a node is attached to a node that comes after it in the hierarchy, the hierarchy is reordered.
+*/
+inline void math_hierarchy_update_matrices()
+{
+    Scene l_scene = Scene::allocate_default();
+
+    Token(Node) l_node_1 = l_scene.add_node(transform{v3f{1.0f, 0.0f, 0.0f}, quat_const::IDENTITY, v3f_const::ONE}, Scene_const::root_node);
+    Token(Node) l_node_2 = l_scene.add_node(transform{v3f{0.0f, 1.0f, 0.0f}, quat_const::IDENTITY, v3f_const::ONE}, l_node_1);
+    Token(Node) l_node_3 = l_scene.add_node(transform{v3f{0.0f, 0.0f, 1.0f}, quat_const::IDENTITY, v3f_const::ONE}, Scene_const::root_node);
+    Token(Node) l_node_4 = l_scene.add_node(transform{v3f{2.0f, 0.0f, 0.0f}, quat_const::IDENTITY, v3f{2.0f, 2.0f, 2.0f}}, l_node_3);
+
+    l_scene.step();
+    assert_true(l_scene.get_node(l_node_2).Element->state.matrices_mustBe_recalculated == 0);
+    assert_true(l_scene.get_node(l_node_4).Element->state.matrices_mustBe_recalculated == 0);
+    assert_true(l_scene.tree.get_worldposition(l_scene.get_node(l_node_2)) == v3f{1.0f, 1.0f, 0.0f});
+    assert_true(l_scene.tree.get_worldposition(l_scene.get_node(l_node_4)) == v3f{2.0f, 0.0f, 1.0f});
+
+    l_scene.tree.add_child(l_scene.get_node(l_node_4), l_scene.get_node(l_node_1));
+    l_scene.tree.set_localposition(l_scene.get_node(l_node_3), v3f{0.0f, 0.0f, 2.0f});
+    l_scene.step();
+
+    assert_true(l_scene.get_node(l_node_1).Element->state.matrices_mustBe_recalculated == 0);
+    assert_true(l_scene.get_node(l_node_2).Element->state.matrices_mustBe_recalculated == 0);
+    assert_true(l_scene.tree.get_worldposition(l_scene.get_node(l_node_1)) == v3f{4.0f, 0.0f, 2.0f});
+    assert_true(l_scene.tree.get_worldposition(l_scene.get_node(l_node_2)) == v3f{4.0f, 2.0f, 2.0f});
+
+    for (vector_loop(&l_scene.tree.hierarchy_parents, i))
+    {
+        assert_true(l_scene.tree.hierarchy_parents.get(i) == (uimax)-1 || l_scene.tree.hierarchy_parents.get(i) < i);
+    }
+
+    l_scene.remove_node(l_scene.get_node(l_node_2));
+    Token(Node) l_node_5 = l_scene.add_node(transform{v3f{0.0f, 1.0f, 0.0f}, quat_const::IDENTITY, v3f_const::ONE}, l_node_1);
+    l_scene.step();
+
+    assert_true(l_scene.tree.hierarchy_nodes.Size == 5);
+    assert_true(l_scene.tree.get_worldposition(l_scene.get_node(l_node_5)) == v3f{4.0f, 2.0f, 2.0f});
+
+    l_scene.free_and_consume_component_events<DefaulSceneComponentReleaser>();
+};
+
 struct CameraTestComponent
 {
     static constexpr component_t Type = HashRaw_constexpr(STR(CameraTestComponent));
@@ -557,6 +600,7 @@ int main()
     add_remove_component();
     component_consume();
     math_hierarchy();
+    math_hierarchy_update_matrices();
     json_deserialization();
     scenetreeasset_merge();
     scene_to_sceneasset();
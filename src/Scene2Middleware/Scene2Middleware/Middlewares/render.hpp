@@ -37,6 +37,10 @@ struct MeshRendererComponent
     Token(Node) scene_node;
     Token(RenderableObject) renderable_object;
     Dependencies dependencies;
+    // Mesh and LODs of the mesh ressource, copied when the RenderableObject is allocated
+    Token(Mesh) mesh;
+    MeshRessource::LODs lods;
+    uimax lod;
 
     inline static MeshRendererComponent build(const Token(Node) p_scene_node, const Dependencies& p_dependencies)
     {
@@ -74,7 +78,8 @@ struct RenderMiddleWare
                                 PoolIndexed<MeshRendererComponent>::allocate_default(), CameraComponent::build_default()};
     };
 
-    inline void free(D3Renderer& p_renderer, GPUContext& p_gpu_context, AssetDatabase& p_asset_database, RenderRessourceAllocator2& p_render_ressource_allocator, Scene* p_scene)
+    template <class t_AssetSource>
+    inline void free(D3Renderer& p_renderer, GPUContext& p_gpu_context, t_AssetSource& p_asset_source, RenderRessourceAllocator2& p_render_ressource_allocator, Scene* p_scene)
     {
 
 #if RENDER_BOUND_TEST
@@ -110,20 +115,31 @@ struct RenderMiddleWare
         }
     };
 
-    inline void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, AssetDatabase& p_asset_database)
+    template <class t_AssetSource>
+    inline void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, t_AssetSource& p_asset_source)
     {
         for (loop_reverse(i, 0, this->mesh_renderer_allocation_events.Size))
         {
             auto& l_event = this->mesh_renderer_allocation_events.get(i);
             MeshRendererComponent& l_mesh_renderer = this->mesh_renderers.get(l_event.allocated_ressource);
+            MeshRessource& l_mesh = p_render_ressource_allocator.mesh_unit.meshes.pool.get(l_mesh_renderer.dependencies.mesh);
+            MaterialRessource& l_material = p_render_ressource_allocator.material_unit.materials.pool.get(l_mesh_renderer.dependencies.material);
 
-            l_mesh_renderer.renderable_object = D3RendererAllocatorComposition::allocate_renderable_object_with_buffers(
-                p_gpu_context.buffer_memory, p_gpu_context.graphics_allocator, p_renderer.allocator, p_render_ressource_allocator.mesh_unit.meshes.pool.get(l_mesh_renderer.dependencies.mesh).mesh);
-            p_renderer.allocator.heap.link_material_with_renderable_object(p_render_ressource_allocator.material_unit.materials.pool.get(l_mesh_renderer.dependencies.material).material,
-                                                                           l_mesh_renderer.renderable_object);
+            // Streamed ressources may not be allocated yet
+            if (!l_mesh.header.allocated || !l_material.header.allocated)
+            {
+                continue;
+            }
+
+            l_mesh_renderer.renderable_object = D3RendererAllocatorComposition::allocate_renderable_object_with_buffers(p_gpu_context.buffer_memory, p_gpu_context.graphics_allocator,
+                                                                                                                        p_renderer.allocator, l_mesh.mesh);
+            p_renderer.allocator.heap.link_material_with_renderable_object(l_material.material, l_mesh_renderer.renderable_object);
+            l_mesh_renderer.mesh = l_mesh.mesh;
+            l_mesh_renderer.lods = l_mesh.lods;
+            l_mesh_renderer.lod = 0;
             l_mesh_renderer.allocated = 1;
 
-            this->mesh_renderer_allocation_events.pop_back();
+            this->mesh_renderer_allocation_events.erase_element_at_always(i);
         }
     };
 
@@ -163,6 +179,8 @@ struct RenderMiddleWare
 
         if (this->camera_component.allocated)
         {
+            this->select_lods(p_renderer, p_scene);
+
             NodeEntry l_camera_node = p_scene->get_node(this->camera_component.scene_node);
             if (this->camera_component.force_update)
             {
@@ -179,6 +197,41 @@ struct RenderMiddleWare
             }
         }
     };
+
+  private:
+    /*
+        The LOD of every MeshRenderer is selected from the camera distance, converted to mesh space with the greatest world scale of the Node.
+        The RenderableObject mesh is changed only when the selected LOD is not the current one.
+    */
+    inline void select_lods(D3Renderer& p_renderer, Scene* p_scene)
+    {
+        v3f l_camera_position = p_scene->tree.get_worldposition(p_scene->get_node(this->camera_component.scene_node));
+        for (loop(i, 0, this->mesh_renderers.Indices.Size))
+        {
+            MeshRendererComponent& l_mesh_renderer = this->mesh_renderers.get(this->mesh_renderers.Indices.get(i));
+            if (!l_mesh_renderer.allocated || l_mesh_renderer.lods.count == 0)
+            {
+                continue;
+            }
+
+            NodeEntry l_node = p_scene->get_node(l_mesh_renderer.scene_node);
+            v3f l_scale = p_scene->tree.get_worldscalefactor(l_node);
+            float32 l_max_scale = l_scale.x > l_scale.y ? l_scale.x : l_scale.y;
+            l_max_scale = l_max_scale > l_scale.z ? l_max_scale : l_scale.z;
+            float32 l_distance = (p_scene->tree.get_worldposition(l_node) - l_camera_position).length();
+            if (l_max_scale > 0.0f)
+            {
+                l_distance = l_distance / l_max_scale;
+            }
+
+            uimax l_lod = l_mesh_renderer.lods.select(l_mesh_renderer.lod, l_distance);
+            if (l_lod != l_mesh_renderer.lod)
+            {
+                p_renderer.heap().set_renderable_object_mesh(l_mesh_renderer.renderable_object, l_mesh_renderer.lods.get_mesh(l_mesh_renderer.mesh, l_lod));
+                l_mesh_renderer.lod = l_lod;
+            }
+        }
+    };
 };
 
 struct RenderMiddleWare_AllocationComposition
@@ -209,8 +262,9 @@ struct RenderMiddleWare_AllocationComposition
         return p_render_middleware.allocate_meshrenderer(MeshRendererComponent::Dependencies{l_material_ressource, l_mesh_ressource}, p_scene_node);
     };
 
+    template <class t_AssetSource>
     inline static Token(MeshRendererComponent)
-        allocate_meshrenderer_database_and_load_dependecies(RenderMiddleWare& p_render_middleware, RenderRessourceAllocator2& p_render_ressource_allocator, AssetDatabase& p_assrt_database,
+        allocate_meshrenderer_database_and_load_dependecies(RenderMiddleWare& p_render_middleware, RenderRessourceAllocator2& p_render_ressource_allocator, t_AssetSource& p_assrt_database,
                                                             const MeshRendererComponent::AssetDependencies& p_meshrenderer_asset_dependencied, const Token(Node) p_scene_node)
     {
         Token(MaterialRessource) l_material_ressource = MaterialRessourceComposition::allocate_or_increment_database_and_load_dependecies(
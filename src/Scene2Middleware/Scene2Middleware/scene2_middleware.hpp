@@ -21,10 +21,13 @@ struct SceneMiddleware
 
     static SceneMiddleware allocate_default();
 
-    void free(Scene* p_scene, Collision2& p_collision, D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, AssetDatabase& p_asset_database);
+    // The p_asset_source is the AssetDatabase or the AssetArchive that assets are read from
+    template <class t_AssetSource>
+    void free(Scene* p_scene, Collision2& p_collision, D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, t_AssetSource& p_asset_source);
 
     void deallocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator);
-    void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, AssetDatabase& p_asset_database);
+    template <class t_AssetSource>
+    void allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, t_AssetSource& p_asset_source);
     void step(Scene* p_scene, Collision2& p_collision, D3Renderer& p_renderer, GPUContext& p_gpu_context);
 };
 
@@ -33,11 +36,12 @@ inline SceneMiddleware SceneMiddleware::allocate_default()
     return SceneMiddleware{CollisionMiddleware::allocate_default(), RenderMiddleWare::allocate()};
 };
 
+template <class t_AssetSource>
 inline void SceneMiddleware::free(Scene* p_scene, Collision2& p_collision, D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator,
-                                  AssetDatabase& p_asset_database)
+                                  t_AssetSource& p_asset_source)
 {
     this->collision_middleware.free(p_collision, p_scene);
-    this->render_middleware.free(p_renderer, p_gpu_context, p_asset_database, p_render_ressource_allocator, p_scene);
+    this->render_middleware.free(p_renderer, p_gpu_context, p_asset_source, p_render_ressource_allocator, p_scene);
 };
 
 inline void SceneMiddleware::deallocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator)
@@ -45,13 +49,16 @@ inline void SceneMiddleware::deallocation_step(D3Renderer& p_renderer, GPUContex
     this->render_middleware.deallocation_step(p_renderer, p_gpu_context, p_render_ressource_allocator);
 };
 
-inline void SceneMiddleware::allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, AssetDatabase& p_asset_database)
+template <class t_AssetSource>
+inline void SceneMiddleware::allocation_step(D3Renderer& p_renderer, GPUContext& p_gpu_context, RenderRessourceAllocator2& p_render_ressource_allocator, t_AssetSource& p_asset_source)
 {
-    this->render_middleware.allocation_step(p_renderer, p_gpu_context, p_render_ressource_allocator, p_asset_database);
+    this->render_middleware.allocation_step(p_renderer, p_gpu_context, p_render_ressource_allocator, p_asset_source);
 };
 
 inline void SceneMiddleware::step(Scene* p_scene, Collision2& p_collision, D3Renderer& p_renderer, GPUContext& p_gpu_context)
 {
+    // Nodes moved since the last Scene step are updated at once before middlewares read their localtoworld matrices.
+    p_scene->tree.update_matrices();
     this->collision_middleware.step(p_collision, p_scene);
     this->render_middleware.step(p_renderer, p_gpu_context, p_scene);
 };
@@ -0,0 +1,17 @@
+#pragma once
+
+/*
+    Deterministic pseudo random numbers for tests and benchmarks, so that a failing case is replayed from it's seed.
+    This is a linear congruential generator : low bits of the state are not random, only the high bits must be used.
+*/
+inline uint32 test_random_next(uint32* in_out_seed)
+{
+    *in_out_seed = (*in_out_seed * 1103515245) + 12345;
+    return *in_out_seed;
+};
+
+inline float32 test_random_float(uint32* in_out_seed, const float32 p_min, const float32 p_max)
+{
+    uint32 l_random = test_random_next(in_out_seed);
+    return p_min + ((float32)((l_random >> 8) & 0xFFFF) / (float32)0xFFFF) * (p_max - p_min);
+};
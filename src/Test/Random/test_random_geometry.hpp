@@ -0,0 +1,14 @@
+#pragma once
+
+#include "./test_random.hpp"
+
+// Randomly rotated obb whose center is in [-p_center_extend, p_center_extend] and radiuses in [0.1, 2.0]
+inline obb test_random_obb(uint32* in_out_seed, const float32 p_center_extend)
+{
+    v3f l_center = v3f{test_random_float(in_out_seed, -p_center_extend, p_center_extend), test_random_float(in_out_seed, -p_center_extend, p_center_extend),
+                       test_random_float(in_out_seed, -p_center_extend, p_center_extend)};
+    v3f l_radiuses = v3f{test_random_float(in_out_seed, 0.1f, 2.0f), test_random_float(in_out_seed, 0.1f, 2.0f), test_random_float(in_out_seed, 0.1f, 2.0f)};
+    v3f l_rotation_axis = v3f{test_random_float(in_out_seed, -1.0f, 1.0f), test_random_float(in_out_seed, -1.0f, 1.0f), test_random_float(in_out_seed, 0.1f, 1.0f)}.normalize();
+    quat l_rotation = quat::rotate_around(l_rotation_axis, test_random_float(in_out_seed, 0.0f, Math_const::PI * 2.0f));
+    return obb{aabb{l_center, l_radiuses}, l_rotation.to_axis()};
+};
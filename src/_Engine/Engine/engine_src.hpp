@@ -3,6 +3,8 @@
 struct EngineConfiguration
 {
     Slice<int8> asset_database_path;
+    // When not empty, assets are read from this AssetArchive instead of the asset database (see AssetArchive::write_from_database)
+    Slice<int8> asset_archive_path;
     int8 headless;
     v2ui render_size;
     int8 render_target_host_readable;
@@ -22,6 +24,8 @@ struct Engine
 
     Clock clock;
     EngineLoop engine_loop;
+    // Jobs can be scheduled by the engine thread during the frame steps
+    JobSystem job_system;
 
     Collision2 collision;
     GPUContext gpu_context;
@@ -35,7 +39,12 @@ struct Engine
     Scene scene;
     SceneMiddleware scene_middleware;
 
+    // Set when assets are read from the asset_archive, the asset_database and the asset_streamer are not allocated
+    int8 use_asset_archive;
+    AssetArchive asset_archive;
     AssetDatabase asset_database;
+    // Meshes and textures are read from the asset database by the streaming thread
+    AssetStreamer asset_streamer;
 
     inline static Engine allocate(const EngineConfiguration& p_configuration)
     {
@@ -43,12 +52,22 @@ struct Engine
         l_engine.abort_condition = 0;
         l_engine.clock = Clock::allocate_default();
         l_engine.engine_loop = EngineLoop::allocate_default(1000000 / 60);
+        l_engine.job_system = JobSystem::allocate_default();
         l_engine.collision = Collision2::allocate();
         l_engine.gpu_context = GPUContext::allocate(SliceN<GPUExtension, 1>{GPUExtension::WINDOW_PRESENT}.to_slice());
         l_engine.renderer_ressource_allocator = RenderRessourceAllocator2::allocate();
         l_engine.scene = Scene::allocate_default();
         l_engine.scene_middleware = SceneMiddleware::allocate_default();
-        l_engine.asset_database = AssetDatabase::allocate(p_configuration.asset_database_path);
+        l_engine.use_asset_archive = p_configuration.asset_archive_path.Size != 0;
+        if (l_engine.use_asset_archive)
+        {
+            l_engine.asset_archive = AssetArchive::allocate(p_configuration.asset_archive_path);
+        }
+        else
+        {
+            l_engine.asset_database = AssetDatabase::allocate(p_configuration.asset_database_path);
+            l_engine.asset_streamer = AssetStreamer::allocate(p_configuration.asset_database_path);
+        }
 
         ColorStep::AllocateInfo l_colorstep_allocate_info{};
         l_colorstep_allocate_info.attachment_host_read = p_configuration.render_target_host_readable;
@@ -68,16 +87,16 @@ struct Engine
         if (!p_configuration.headless)
         {
             l_engine.window = WindowAllocator::allocate(p_configuration.render_size.x, p_configuration.render_size.y, slice_int8_build_rawstr(""));
-            Span<int8> l_quad_blit_vert = l_engine.asset_database.get_asset_blob(HashSlice(slice_int8_build_rawstr("internal/quad_blit.vert")));
-            Span<int8> l_quad_blit_frag = l_engine.asset_database.get_asset_blob(HashSlice(slice_int8_build_rawstr("internal/quad_blit.frag")));
+            Span<int8> l_quad_blit_vert = l_engine.get_asset_blob(HashSlice(slice_int8_build_rawstr("internal/quad_blit.vert")));
+            Span<int8> l_quad_blit_frag = l_engine.get_asset_blob(HashSlice(slice_int8_build_rawstr("internal/quad_blit.frag")));
             l_engine.present = GPUPresent::allocate(l_engine.gpu_context.instance, l_engine.gpu_context.buffer_memory, l_engine.gpu_context.graphics_allocator,
                                                         WindowAllocator::get_window(l_engine.window).handle, v3ui{p_configuration.render_size.x, p_configuration.render_size.y, 1},
                                                         l_engine.gpu_context.graphics_allocator.heap.renderpass_attachment_textures
                                                             .get_vector(l_engine.gpu_context.graphics_allocator.heap.graphics_pass.get(l_engine.renderer.color_step.pass).attachment_textures)
                                                             .get(0),
                                                         l_quad_blit_vert.slice, l_quad_blit_frag.slice);
-            l_quad_blit_vert.free();
-            l_quad_blit_frag.free();
+            l_engine.release_asset_blob(l_quad_blit_vert);
+            l_engine.release_asset_blob(l_quad_blit_frag);
         }
         else
         {
@@ -92,6 +111,30 @@ struct Engine
 
     void free_headless();
 
+    // Blob of the asset, from the asset archive or the asset database. It must be released with release_asset_blob.
+    inline Span<int8> get_asset_blob(const hash_t p_asset_id)
+    {
+        if (this->use_asset_archive)
+        {
+            return this->asset_archive.get_asset_blob(p_asset_id);
+        }
+        return this->asset_database.get_asset_blob(p_asset_id);
+    };
+
+    inline void release_asset_blob(Span<int8>& p_blob)
+    {
+        if (this->use_asset_archive)
+        {
+            this->asset_archive.release_asset_blob(p_blob);
+        }
+        else
+        {
+            this->asset_database.release_asset_blob(p_blob);
+        }
+    };
+
+    void free_asset_sources();
+
     inline void close()
     {
         this->abort_condition = 1;
@@ -116,12 +159,27 @@ struct Engine_ComponentReleaser
     };
 };
 
+inline void Engine::free_asset_sources()
+{
+    if (this->use_asset_archive)
+    {
+        this->scene_middleware.free(&this->scene, this->collision, this->renderer, this->gpu_context, this->renderer_ressource_allocator, this->asset_archive);
+        this->asset_archive.free();
+    }
+    else
+    {
+        this->scene_middleware.free(&this->scene, this->collision, this->renderer, this->gpu_context, this->renderer_ressource_allocator, this->asset_database);
+        this->asset_streamer.free();
+        this->asset_database.free();
+    }
+};
+
 inline void Engine::free()
 {
+    this->gpu_context.wait_for_completion();
     Engine_ComponentReleaser l_component_releaser = Engine_ComponentReleaser{*this};
     this->scene.consume_component_events_stateful(l_component_releaser);
-    this->scene_middleware.free(&this->scene, this->collision, this->renderer, this->gpu_context, this->renderer_ressource_allocator, this->asset_database);
-    this->asset_database.free();
+    this->free_asset_sources();
     this->collision.free();
     this->renderer_ressource_allocator.free(this->renderer, this->gpu_context);
     this->renderer.free(this->gpu_context);
@@ -129,19 +187,21 @@ inline void Engine::free()
     this->gpu_context.free();
     WindowAllocator::free(this->window);
     this->scene.free();
+    this->job_system.free();
 };
 
 inline void Engine::free_headless()
 {
+    this->gpu_context.wait_for_completion();
     Engine_ComponentReleaser l_component_releaser = Engine_ComponentReleaser{*this};
     this->scene.consume_component_events_stateful(l_component_releaser);
-    this->scene_middleware.free(&this->scene, this->collision, this->renderer, this->gpu_context, this->renderer_ressource_allocator, this->asset_database);
-    this->asset_database.free();
+    this->free_asset_sources();
     this->collision.free();
     this->renderer_ressource_allocator.free(this->renderer, this->gpu_context);
     this->renderer.free(this->gpu_context);
     this->gpu_context.free();
     this->scene.free();
+    this->job_system.free();
 };
 
 template <class ExternalCallbackStep> inline void Engine::main_loop(ExternalCallbackStep& p_callback_step)
@@ -158,11 +218,13 @@ struct EngineLoopFunctions
     inline static void new_frame(Engine& p_engine)
     {
         p_engine.clock.newframe();
+        p_engine.gpu_context.begin_frame();
 
         Window& l_window = WindowAllocator::get_window(p_engine.window);
         if (l_window.resize_event.ask)
         {
             l_window.consume_resize_event();
+            p_engine.gpu_context.wait_for_completion();
             p_engine.present.resize(v3ui{l_window.client_width, l_window.client_height, 1}, p_engine.gpu_context.buffer_memory, p_engine.gpu_context.graphics_allocator);
             p_engine.abort_condition = 1;
         }
@@ -177,6 +239,7 @@ struct EngineLoopFunctions
     inline static void new_frame_headless(Engine& p_engine)
     {
         p_engine.clock.newframe();
+        p_engine.gpu_context.begin_frame();
     };
 
     template <class ExternalCallbackStep> inline static void update(Engine& p_engine, const float32 p_delta, ExternalCallbackStep& p_callback_step)
@@ -185,21 +248,44 @@ struct EngineLoopFunctions
 
         p_callback_step.step(EngineExternalStep::BEFORE_COLLISION, p_engine);
 
-        p_engine.collision.step();
+        MemoryTag l_previous_tag = memory_tag_set(MemoryTag::COLLISION);
+        p_engine.collision.step_parallel(p_engine.job_system);
+        memory_tag_set(l_previous_tag);
 
         p_callback_step.step(EngineExternalStep::AFTER_COLLISION, p_engine);
         p_callback_step.step(EngineExternalStep::BEFORE_UPDATE, p_engine);
 
+        l_previous_tag = memory_tag_set(MemoryTag::SCENE);
         p_engine.scene_middleware.deallocation_step(p_engine.renderer, p_engine.gpu_context, p_engine.renderer_ressource_allocator);
+        if (p_engine.renderer_ressource_allocator.has_deallocation_events())
+        {
+            // Freed GPU ressources may still be used by the previous frames
+            p_engine.gpu_context.wait_for_completion();
+        }
+        memory_tag_set(MemoryTag::ASSET);
         p_engine.renderer_ressource_allocator.deallocation_step(p_engine.renderer, p_engine.gpu_context);
-        p_engine.renderer_ressource_allocator.allocation_step(p_engine.renderer, p_engine.gpu_context, p_engine.asset_database);
-        p_engine.scene_middleware.allocation_step(p_engine.renderer, p_engine.gpu_context, p_engine.renderer_ressource_allocator, p_engine.asset_database);
+        if (p_engine.use_asset_archive)
+        {
+            // Blobs of the archive are mapped, they are uploaded in place without being streamed
+            p_engine.renderer_ressource_allocator.allocation_step(p_engine.renderer, p_engine.gpu_context, p_engine.asset_archive);
+            memory_tag_set(MemoryTag::SCENE);
+            p_engine.scene_middleware.allocation_step(p_engine.renderer, p_engine.gpu_context, p_engine.renderer_ressource_allocator, p_engine.asset_archive);
+        }
+        else
+        {
+            p_engine.renderer_ressource_allocator.allocation_step_streamed(p_engine.renderer, p_engine.gpu_context, p_engine.asset_database, p_engine.asset_streamer,
+                                                                           RenderRessourceAllocator2_const::STREAMING_UPLOAD_BUDGET);
+            memory_tag_set(MemoryTag::SCENE);
+            p_engine.scene_middleware.allocation_step(p_engine.renderer, p_engine.gpu_context, p_engine.renderer_ressource_allocator, p_engine.asset_database);
+        }
 
         p_engine.scene_middleware.step(&p_engine.scene, p_engine.collision, p_engine.renderer, p_engine.gpu_context);
+        memory_tag_set(l_previous_tag);
     };
 
     inline static void render(Engine& p_engine)
     {
+        MemoryTag l_previous_tag = memory_tag_set(MemoryTag::RENDER);
         p_engine.renderer.buffer_step(p_engine.gpu_context);
         p_engine.gpu_context.buffer_step_and_submit();
         GraphicsBinder l_graphics_binder = p_engine.gpu_context.creates_graphics_binder();
@@ -209,25 +295,30 @@ struct EngineLoopFunctions
         l_graphics_binder.end();
         p_engine.gpu_context.submit_graphics_binder_and_notity_end(l_graphics_binder);
         p_engine.present.present(p_engine.gpu_context.graphics_end_semaphore);
-        p_engine.gpu_context.wait_for_completion();
+        memory_tag_set(l_previous_tag);
     };
 
     inline static void render_headless(Engine& p_engine)
     {
+        MemoryTag l_previous_tag = memory_tag_set(MemoryTag::RENDER);
         p_engine.renderer.buffer_step(p_engine.gpu_context);
         p_engine.gpu_context.buffer_step_and_submit();
         GraphicsBinder l_graphics_binder = p_engine.gpu_context.creates_graphics_binder();
         p_engine.renderer.graphics_step(l_graphics_binder);
         p_engine.gpu_context.submit_graphics_binder(l_graphics_binder);
-        p_engine.gpu_context.wait_for_completion();
+        memory_tag_set(l_previous_tag);
     };
 
     template <class ExternalCallbackStep> inline static void end_of_frame(Engine& p_engine, ExternalCallbackStep& p_callback_step)
     {
         Engine_ComponentReleaser l_component_releaser = Engine_ComponentReleaser{p_engine};
+        MemoryTag l_previous_tag = memory_tag_set(MemoryTag::SCENE);
         p_engine.scene.consume_component_events_stateful(l_component_releaser);
         p_engine.scene.step();
+        memory_tag_set(l_previous_tag);
         p_callback_step.step(EngineExternalStep::END_OF_FRAME, p_engine);
+        ThreadArenas::frame().reset();
+        memory_statistics_end_frame();
     };
 };
 
@@ -155,7 +155,7 @@ inline void boxcollision()
         l_tmp_file.erase_with_slicepath();
         AssetDatabase::initialize_database(l_database_path.to_slice());
     }
-    EngineConfiguration l_condfiguration;
+    EngineConfiguration l_condfiguration{};
     l_condfiguration.asset_database_path = l_database_path.to_slice();
     l_condfiguration.headless = 1;
     SandboxEngineRunner l_runner = SandboxEngineRunner::allocate(l_condfiguration, 1.0f / 60.0f);
@@ -268,6 +268,8 @@ inline void d3renderer_cube()
     String l_database_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
     l_database_path.append(slice_int8_build_rawstr("/d3renderer_cube/asset.db"));
     {
+        // The database may have been written by a previous schema version
+        AssetDatabase::initialize_database(l_database_path.to_slice());
     }
     EngineConfiguration l_configuration{};
     l_configuration.asset_database_path = l_database_path.to_slice();
@@ -280,10 +282,38 @@ inline void d3renderer_cube()
     l_runner.main_loop(l_sandbox_environment);
 }
 
+/*
+    Same scene as d3renderer_cube, but assets are read from an AssetArchive packed from the d3renderer_cube asset database.
+    Rendered frames are compared against the same reference images.
+*/
+inline void d3renderer_cube_archive()
+{
+    String l_database_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_database_path.append(slice_int8_build_rawstr("/d3renderer_cube/asset.db"));
+    String l_archive_path = String::allocate_elements(slice_int8_build_rawstr(ASSET_FOLDER_PATH));
+    l_archive_path.append(slice_int8_build_rawstr("/d3renderer_cube/asset.pack"));
+    {
+        AssetDatabase l_asset_database = AssetDatabase::allocate_reader(l_database_path.to_slice());
+        AssetArchive::write_from_database(l_asset_database, l_archive_path.to_slice());
+        l_asset_database.free();
+    }
+    EngineConfiguration l_configuration{};
+    l_configuration.asset_archive_path = l_archive_path.to_slice();
+    l_configuration.render_size = v2ui{800, 600};
+    l_configuration.render_target_host_readable = 1;
+    SandboxEngineRunner l_runner = SandboxEngineRunner::allocate(EngineConfiguration{l_configuration}, 1.0f / 60.0f);
+    l_archive_path.free();
+    l_database_path.free();
+
+    D3RendererCubeSandboxEnvironment l_sandbox_environment = D3RendererCubeSandboxEnvironment::build_default();
+    l_runner.main_loop(l_sandbox_environment);
+}
+
 int main()
 {
     boxcollision();
     d3renderer_cube();
+    d3renderer_cube_archive();
 
     memleak_ckeck();
 };
\ No newline at end of file